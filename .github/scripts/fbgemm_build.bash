@@ -92,7 +92,8 @@ __build_fbgemm_library_bazel () {
   #
   # shellcheck disable=SC2086
   print_exec conda run --no-capture-output ${env_prefix} \
-    CC="${cc_path}" CXX="${cxx_path}" bazel build -s :*
+    CC="${cc_path}" CXX="${cxx_path}" bazel build -s \
+    --define=FBGEMM_KERNEL_CACHE_BUILD_ID="$(git rev-parse HEAD)" :*
 }
 
 build_fbgemm_library () {
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <numeric>
 #include <random>
 #include <type_traits>
 
@@ -164,6 +165,27 @@ aligned_vector<float> getRandomSparseVector(
   return res;
 }
 
+void getRandomBags(
+    int batch_size,
+    int64_t num_rows,
+    int average_len,
+    std::default_random_engine& generator,
+    std::vector<int>& offsets,
+    std::vector<int64_t>& indices) {
+  std::uniform_int_distribution<int> length_distribution(
+      1, 2 * average_len - 1);
+  std::uniform_int_distribution<int64_t> index_distribution(0, num_rows - 1);
+  offsets.resize(batch_size + 1);
+  offsets[0] = 0;
+  for (int i = 0; i < batch_size; ++i) {
+    offsets[i + 1] = offsets[i] + length_distribution(generator);
+  }
+  indices.resize(offsets[batch_size]);
+  for (auto& index : indices) {
+    index = index_distribution(generator);
+  }
+}
+
 template <typename T>
 aligned_vector<T> getRandomBlockSparseMatrix(
     int Rows,
@@ -228,4 +250,42 @@ template aligned_vector<int32_t> getRandomBlockSparseMatrix(
     int32_t low,
     int32_t high);
 
+template <typename T>
+aligned_vector<T> getRandomNMSparseMatrix(
+    int Rows,
+    int Cols,
+    int nnz,
+    int group,
+    T low,
+    T high) {
+  aligned_vector<T> res(Rows * Cols, 0);
+
+  std::mt19937 gen(345);
+
+  std::uniform_int_distribution<int> dis(low, high);
+  std::vector<int> pos(group);
+
+  for (int i = 0; i < Rows; ++i) {
+    for (int j = 0; j < Cols; j += group) {
+      std::iota(pos.begin(), pos.end(), 0);
+      std::shuffle(pos.begin(), pos.end(), gen);
+      for (int p = 0; p < nnz; ++p) {
+        if (j + pos[p] < Cols) {
+          res[i * Cols + j + pos[p]] = dis(gen);
+        }
+      }
+    }
+  }
+
+  return res;
+}
+
+template aligned_vector<int8_t> getRandomNMSparseMatrix(
+    int Rows,
+    int Cols,
+    int nnz,
+    int group,
+    int8_t low,
+    int8_t high);
+
 } // namespace fbgemm
@@ -8,7 +8,9 @@
 
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <random>
 #include <vector>
 
 #if defined(__x86_64__) || defined(__i386__) || \
@@ -88,6 +90,15 @@ NOINLINE float cache_evict(const T& vec) {
   return dummy;
 }
 
+/**
+ * Evicts every argument from the cache, e.g. all the inputs and outputs of a
+ * kernel between measured iterations.
+ */
+template <typename... Ts>
+void cache_evict_all(const Ts&... vecs) {
+  (cache_evict(vecs), ...);
+}
+
 /**
  * Parse application command line arguments
  *
@@ -530,4 +541,30 @@ aligned_vector<T> getRandomBlockSparseMatrix(
     T low = 0,
     T high = 9);
 
+/**
+ * Random matrix with N:M structured sparsity: in every group of group
+ * consecutive columns of a row, nnz random positions are filled.
+ */
+template <typename T>
+aligned_vector<T> getRandomNMSparseMatrix(
+    int Rows,
+    int Cols,
+    int nnz = 2,
+    int group = 4,
+    T low = 1,
+    T high = 9);
+
+/**
+ * Random pooled embedding lookups: batch_size bags with lengths uniform in
+ * [1, 2 * average_len - 1] and indices uniform in [0, num_rows). Indices may
+ * repeat, so lookups into a large table mostly miss the cache.
+ */
+void getRandomBags(
+    int batch_size,
+    int64_t num_rows,
+    int average_len,
+    std::default_random_engine& generator,
+    std::vector<int>& offsets,
+    std::vector<int64_t>& indices);
+
 } // namespace fbgemm
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "./BenchUtils.h"
+#include "fbgemm/FbgemmEmbedding.h"
+
+using namespace std;
+using namespace fbgemm;
+
+static vector<vector<int>> GetInputs_() {
+  vector<vector<int>> input_dims = {
+      // num tables, batch size, num rows, emb dim, avg length,
+      // every how many tables has 20x the avg length
+      {64, 512, 100000, 64, 5, 8},
+      {320, 256, 100000, 64, 5, 16},
+      {320, 256, 100000, 128, 20, 32},
+  };
+  return input_dims;
+}
+
+void run_benchmark(
+    int num_tables,
+    int batch_size,
+    int num_rows,
+    int embedding_dim,
+    int average_len,
+    int skew_every) {
+  default_random_engine generator;
+  uniform_int_distribution<int> rowDist(0, num_rows - 1);
+  normal_distribution<float> embeddingDist;
+
+  vector<vector<float>> embedding_tables(num_tables);
+  vector<vector<int64_t>> indices(num_tables);
+  vector<vector<int64_t>> offsets(num_tables);
+  vector<float> output(
+      static_cast<size_t>(batch_size) * num_tables * embedding_dim);
+  vector<EmbeddingSpMDMTableArgs<float, int64_t, int64_t>> tables(num_tables);
+  int64_t bytes = 0;
+  for (int t = 0; t < num_tables; ++t) {
+    embedding_tables[t].resize(static_cast<size_t>(num_rows) * embedding_dim);
+    for (auto& v : embedding_tables[t]) {
+      v = embeddingDist(generator);
+    }
+    const int len = t % skew_every == 0 ? 20 * average_len : average_len;
+    uniform_int_distribution<int> lengthDist(1, 2 * len - 1);
+    offsets[t].push_back(0);
+    for (int b = 0; b < batch_size; ++b) {
+      const int length = lengthDist(generator);
+      for (int i = 0; i < length; ++i) {
+        indices[t].push_back(rowDist(generator));
+      }
+      offsets[t].push_back(indices[t].size());
+    }
+    bytes += indices[t].size() * (embedding_dim * sizeof(float) + 8) +
+        batch_size * embedding_dim * sizeof(float);
+
+    tables[t].block_size = embedding_dim;
+    tables[t].output_size = batch_size;
+    tables[t].data_size = num_rows;
+    tables[t].input = embedding_tables[t].data();
+    tables[t].indices = indices[t].data();
+    tables[t].offsets = offsets[t].data();
+    tables[t].out = output.data() + t * embedding_dim;
+    tables[t].output_stride = num_tables * embedding_dim;
+  }
+
+  auto kernel = GenerateEmbeddingSpMDMWithStrides<float, int64_t, int64_t>(
+      embedding_dim,
+      /*has_weight=*/false,
+      /*normalize_by_lengths=*/false,
+      /*prefetch=*/16,
+      /*is_weight_positional=*/false,
+      /*use_offsets=*/true,
+      num_tables * embedding_dim);
+
+  bool success = true;
+  // One table per task, which is how the tables are scheduled without the
+  // grouped API.
+  double t_per_table = measureWithWarmup(
+      [&]() {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int t = 0; t < num_tables; ++t) {
+          bool ok = kernel(
+              batch_size,
+              indices[t].size(),
+              num_rows,
+              tables[t].input,
+              tables[t].indices,
+              tables[t].offsets,
+              nullptr,
+              tables[t].out);
+          if (!ok) {
+            success = false;
+          }
+        }
+      },
+      3,
+      10);
+  double t_grouped = measureWithWarmup(
+      [&]() {
+        success = success &&
+            EmbeddingSpMDMGrouped(tables.data(), num_tables, false);
+      },
+      3,
+      10);
+  if (!success) {
+    cerr << "fbgemm embedding failed" << endl;
+  }
+
+  cout << "num tables" << setw(6) << num_tables << setw(12) << "batch size"
+       << setw(6) << batch_size << setw(10) << "emb dim" << setw(6)
+       << embedding_dim << setw(12) << "avg length" << setw(6) << average_len
+       << setw(12) << "skew every" << setw(6) << skew_every << endl;
+  cout << setw(16) << "per table: " << setw(10) << bytes / 1e9 / t_per_table
+       << " GB/s" << setw(8) << " time " << setw(12) << t_per_table << endl;
+  cout << setw(16) << "grouped: " << setw(10) << bytes / 1e9 / t_grouped
+       << " GB/s" << setw(8) << " time " << setw(12) << t_grouped << endl;
+}
+
+int main() {
+#ifdef _OPENMP
+  cout << "threads " << omp_get_max_threads() << endl;
+#endif
+  for (auto& input : GetInputs_()) {
+    run_benchmark(input[0], input[1], input[2], input[3], input[4], input[5]);
+  }
+  return 0;
+}
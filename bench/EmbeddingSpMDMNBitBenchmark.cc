@@ -15,6 +15,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -366,7 +367,352 @@ int run_benchmark(
   return 0;
 }
 
-int main() {
+// Sets the fp16 scale and bias that follow the packed elements of each row.
+static void set_fused_scale_bias(
+    uint8_t* fused_embedding_table,
+    int64_t num_rows,
+    int bit_rate,
+    int embedding_dim) {
+  int num_elem_per_byte = 8 / bit_rate;
+  int data_bytes = (embedding_dim + num_elem_per_byte - 1) / num_elem_per_byte;
+  int fused_embedding_dim = data_bytes + 2 * sizeof(float16);
+  for (int64_t i = 0; i < num_rows; i++) {
+    float16* scale_bias = reinterpret_cast<float16*>(
+        fused_embedding_table + i * fused_embedding_dim + data_bytes);
+    float scale = 2.0f;
+    float bias = 1.0f;
+    FloatToFloat16_ref(&scale, scale_bias, 1, true /* clip */);
+    FloatToFloat16_ref(&bias, scale_bias + 1, 1, true /* clip */);
+  }
+}
+
+static void print_bandwidth(const char* name, double bytes, double t) {
+  cout << name << ", " << bytes / 1e9 / t << ", GB/s, time, " << t;
+}
+
+// Pipelined prefetching mode for tables much larger than LLC: reports the
+// DRAM bandwidth achieved with the JIT kernel for each prefetch group size and
+// distance. Indices are uniformly random so almost every row is a DRAM access.
+void run_pipelined_benchmark(
+    int bit_rate,
+    int batch_size,
+    int num_rows,
+    int embedding_dim,
+    int average_len,
+    const vector<int>& prefetch_groups,
+    const vector<int>& prefetch_distances) {
+  int num_elem_per_byte = 8 / bit_rate;
+  int fused_embedding_dim =
+      (embedding_dim + num_elem_per_byte - 1) / num_elem_per_byte +
+      2 * sizeof(float16);
+  default_random_engine generator;
+
+  vector<uint8_t> fused_embedding_table(
+      static_cast<size_t>(num_rows) * fused_embedding_dim, 2);
+  set_fused_scale_bias(
+      fused_embedding_table.data(), num_rows, bit_rate, embedding_dim);
+
+  vector<int> offsets;
+  vector<int64_t> indices;
+  getRandomBags(batch_size, num_rows, average_len, generator, offsets, indices);
+  int lengths_sum = offsets[batch_size];
+  vector<float> output(static_cast<size_t>(batch_size) * embedding_dim);
+
+  constexpr int NUM_WARMUP = 2;
+  constexpr int NUM_ITER = 10;
+  constexpr int CACHE_LINE_LEN = 64;
+  // Rows are not cache line aligned, so count the lines touched by each row.
+  double bytes_dram = 0;
+  for (int64_t index : indices) {
+    int64_t begin = index * fused_embedding_dim;
+    int64_t end = begin + fused_embedding_dim - 1;
+    bytes_dram +=
+        (end / CACHE_LINE_LEN - begin / CACHE_LINE_LEN + 1) * CACHE_LINE_LEN;
+  }
+
+  for (int prefetch_distance : prefetch_distances) {
+    for (int prefetch_group : prefetch_groups) {
+      auto kernel = GenerateEmbeddingSpMDMNBitWithStrides<int64_t>(
+          bit_rate,
+          embedding_dim,
+          /*has_weight=*/false,
+          /*normalize_by_lengths=*/false,
+          prefetch_distance,
+          /*is_weight_positional=*/false,
+          /*use_offsets=*/true,
+          /*output_stride=*/-1,
+          /*input_stride=*/-1,
+          /*scale_bias_last=*/true,
+          /*is_bf16_out=*/false,
+          prefetch_group);
+      bool success = true;
+      double t = measureWithWarmup(
+          [&]() {
+            success = kernel(
+                batch_size,
+                lengths_sum,
+                num_rows,
+                fused_embedding_table.data(),
+                indices.data(),
+                offsets.data(),
+                nullptr,
+                output.data());
+          },
+          NUM_WARMUP,
+          NUM_ITER,
+          [&]() { cache_evict_all(indices, offsets, output); });
+      if (!success) {
+        cout << "ERROR: kernel failed" << endl;
+      }
+      cout << "bit_rate, " << bit_rate << ", emb dim, " << embedding_dim
+           << ", prefetch distance, " << prefetch_distance
+           << ", prefetch group, " << prefetch_group << ", ";
+      print_bandwidth("DRAM b/w", bytes_dram, t);
+      cout << endl;
+    }
+  }
+}
+
+// Gathers from a table allocated with each policy. With tables much larger
+// than what the TLB covers with 4KB pages, nearly every row lookup is a TLB
+// miss and a page walk, which huge pages avoid.
+void run_alloc_policy_benchmark(
+    int bit_rate,
+    int batch_size,
+    int64_t num_rows,
+    int embedding_dim,
+    int average_len,
+    const vector<AllocPolicy>& policies) {
+  int num_elem_per_byte = 8 / bit_rate;
+  int fused_embedding_dim =
+      (embedding_dim + num_elem_per_byte - 1) / num_elem_per_byte +
+      2 * sizeof(float16);
+  const size_t table_bytes = num_rows * fused_embedding_dim;
+  default_random_engine generator;
+
+  vector<int> offsets;
+  vector<int64_t> indices;
+  getRandomBags(batch_size, num_rows, average_len, generator, offsets, indices);
+  int lengths_sum = offsets[batch_size];
+  vector<float> output(static_cast<size_t>(batch_size) * embedding_dim);
+
+  auto kernel = GenerateEmbeddingSpMDMNBit<int64_t>(
+      bit_rate,
+      embedding_dim,
+      /*has_weight=*/false,
+      /*normalize_by_lengths=*/false,
+      /*prefetch=*/16);
+
+  constexpr int NUM_WARMUP = 2;
+  constexpr int NUM_ITER = 10;
+  for (const AllocPolicy& policy : policies) {
+    uint8_t* fused_embedding_table = static_cast<uint8_t*>(
+        fbgemmAlignedAllocWithPolicy(64, table_bytes, policy));
+    // The first touch places the pages, so time it as well.
+    double t_touch = measureWithWarmup(
+        [&]() { memset(fused_embedding_table, 2, table_bytes); }, 0, 1);
+    set_fused_scale_bias(
+        fused_embedding_table, num_rows, bit_rate, embedding_dim);
+
+    bool success = true;
+    double t = measureWithWarmup(
+        [&]() {
+          success = kernel(
+              batch_size,
+              lengths_sum,
+              num_rows,
+              fused_embedding_table,
+              indices.data(),
+              offsets.data(),
+              nullptr,
+              output.data());
+        },
+        NUM_WARMUP,
+        NUM_ITER,
+        [&]() { cache_evict_all(indices, offsets, output); });
+    fbgemmAlignedFree(fused_embedding_table);
+    if (!success) {
+      cout << "ERROR: kernel failed" << endl;
+    }
+    cout << "bit_rate, " << bit_rate << ", emb dim, " << embedding_dim
+         << ", table, " << table_bytes / 1e9 << ", GB, " << policy.toString()
+         << ", first touch, " << t_touch << ", s, ns per row, "
+         << t * 1e9 / lengths_sum << ", time, " << t << endl;
+  }
+}
+
+// FP8 tables (1 byte per element, no scale/bias) through the SIMD kernels
+// behind GenerateEmbeddingSpMDMFP8WithStrides, compared to the reference.
+void run_fp8_benchmark(
+    int batch_size,
+    int num_rows,
+    int embedding_dim,
+    int average_len,
+    bool prefetch) {
+  default_random_engine generator;
+  normal_distribution<float> embedding_distribution;
+  // e4m3 with bias 7, with random bytes covering every encoding
+  constexpr int exponent_bits = 4;
+  constexpr int exponent_bias = 7;
+
+  uniform_int_distribution<int> byte_distribution(0, 255);
+  vector<uint8_t> table(static_cast<size_t>(num_rows) * embedding_dim);
+  for (auto& v : table) {
+    v = byte_distribution(generator);
+  }
+
+  vector<int> offsets;
+  vector<int64_t> indices;
+  getRandomBags(batch_size, num_rows, average_len, generator, offsets, indices);
+  int lengths_sum = offsets[batch_size];
+  vector<float> weights(lengths_sum);
+  for (auto& w : weights) {
+    w = embedding_distribution(generator);
+  }
+
+  vector<float> output(static_cast<size_t>(batch_size) * embedding_dim);
+  vector<float> output_ref(output.size());
+
+  constexpr int NUM_WARMUP = 10;
+  constexpr int NUM_ITER = 100;
+  double bytes = static_cast<double>(lengths_sum) * embedding_dim;
+
+  for (bool has_weight : {false, true}) {
+    auto kernel = GenerateEmbeddingSpMDMFP8WithStrides<int64_t, int>(
+        embedding_dim,
+        /*normalize_by_lengths=*/false,
+        /*is_weight_positional=*/false,
+        /*use_offsets=*/true,
+        /*output_stride=*/-1,
+        /*input_stride=*/-1,
+        exponent_bits,
+        exponent_bias,
+        /*is_bf16_out=*/false,
+        prefetch ? 16 : 0);
+    const float* weights_ptr = has_weight ? weights.data() : nullptr;
+
+    for (bool flush_cache : {false, true}) {
+      bool success = false, success_ref = false;
+      auto flush = [&]() {
+        if (flush_cache) {
+          cache_evict_all(table, indices, offsets, weights, output);
+        }
+      };
+      double t_ref = measureWithWarmup(
+          [&]() {
+            success_ref = EmbeddingSpMDMFP8_ref(
+                embedding_dim,
+                batch_size,
+                lengths_sum,
+                num_rows,
+                table.data(),
+                indices.data(),
+                offsets.data(),
+                weights_ptr,
+                /*normalize_by_lengths=*/false,
+                output_ref.data(),
+                /*is_weight_positional=*/false,
+                /*use_offsets=*/true,
+                /*output_stride=*/-1,
+                /*input_stride=*/-1,
+                exponent_bits,
+                exponent_bias);
+          },
+          NUM_WARMUP,
+          NUM_ITER,
+          flush);
+      double t = measureWithWarmup(
+          [&]() {
+            success = kernel(
+                batch_size,
+                lengths_sum,
+                num_rows,
+                table.data(),
+                indices.data(),
+                offsets.data(),
+                weights_ptr,
+                output.data());
+          },
+          NUM_WARMUP,
+          NUM_ITER,
+          flush);
+
+      if (!success || !success_ref || output != output_ref) {
+        cout << "ERROR: FP8 kernel and reference differ" << endl;
+      }
+      cout << (has_weight ? "SLW(WEIGHTED), " : "SLS, ")
+           << (flush_cache ? "cache flushed, " : "cache not flushed, ")
+           << (prefetch ? "prefetch on, " : "prefetch off, ");
+      print_bandwidth("b/w", bytes, t);
+      cout << ", ";
+      print_bandwidth("ref b/w", bytes, t_ref);
+      cout << ", speedup, " << t_ref / t << endl;
+    } // flush_cache
+  } // has_weight
+}
+
+int main(int argc, const char* argv[]) {
+  if (parseArgumentBool(argc, argv, "--fp8", false)) {
+    for (auto& input : GetInputs_()) {
+      cout << "fp8, batch size, " << input[0] << ", num rows, " << input[1]
+           << ", emb dim, " << input[2] << ", avg length, " << input[3]
+           << endl;
+      for (bool prefetch : {false, true}) {
+        run_fp8_benchmark(input[0], input[1], input[2], input[3], prefetch);
+      }
+    }
+    return 0;
+  }
+
+  if (parseArgumentBool(argc, argv, "--pipelined", false)) {
+    // e.g. --pipelined --prefetch_group=8 --prefetch_distance=32
+    int group = parseArgumentInt(argc, argv, "--prefetch_group=", 0, 0);
+    int distance = parseArgumentInt(argc, argv, "--prefetch_distance=", 0, 0);
+    vector<int> groups =
+        group > 0 ? vector<int>{group} : vector<int>{1, 2, 4, 8, 16};
+    vector<int> distances =
+        distance > 0 ? vector<int>{distance} : vector<int>{16, 32, 64};
+    for (int bit_rate : {4, 2}) {
+      for (int embedding_dim : {64, 128, 256}) {
+        // A table of 20M rows is much larger than LLC.
+        run_pipelined_benchmark(
+            bit_rate, 256, 20000000, embedding_dim, 80, groups, distances);
+      }
+    }
+    return 0;
+  }
+
+  if (parseArgumentBool(argc, argv, "--alloc_policies", false)) {
+    // e.g. --alloc_policies --num_rows=50000000 --numa_node=1
+    int64_t num_rows =
+        parseArgumentInt(argc, argv, "--num_rows=", 20000000, 20000000);
+    int numa_node = parseArgumentInt(argc, argv, "--numa_node=", -1, -1);
+    vector<AllocPolicy> policies;
+    for (auto hugePages :
+         {HugePageMode::NONE,
+          HugePageMode::TRANSPARENT,
+          HugePageMode::EXPLICIT_2MB,
+          HugePageMode::EXPLICIT_1GB}) {
+      AllocPolicy policy;
+      policy.hugePages = hugePages;
+      policies.push_back(policy);
+      policy.numa = NumaMode::INTERLEAVE;
+      policies.push_back(policy);
+      if (numa_node >= 0) {
+        policy.numa = NumaMode::BIND;
+        policy.numaNode = numa_node;
+        policies.push_back(policy);
+      }
+    }
+    for (int bit_rate : {4, 2}) {
+      for (int embedding_dim : {64, 128}) {
+        run_alloc_policy_benchmark(
+            bit_rate, 1024, num_rows, embedding_dim, 80, policies);
+      }
+    }
+    return 0;
+  }
+
   int batch_size;
   int num_rows;
   int embedding_dim;
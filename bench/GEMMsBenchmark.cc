@@ -23,6 +23,8 @@
 
 #include "./BenchUtils.h"
 #include "fbgemm/Fbgemm.h"
+#include "fbgemm/FbgemmFP16.h"
+#include "fbgemm/FbgemmThreadPool.h"
 #include "src/RefImplementations.h"
 #include "test/QuantizationHelpers.h"
 
@@ -45,6 +47,11 @@ void performance_test(
     {M?M:128, N?N:128, K?K:128},
     {M?M:256, N?N:512, K?K:256},
     {M?M:1024, N?N:1024, K?K:1024},
+    // skinny GEMMs of inference, see fbgemmIsSkinnyGemm
+    {M?M:1, N?N:4096, K?K:4096},
+    {M?M:16, N?N:4096, K?K:4096},
+    {M?M:64, N?N:4096, K?K:4096},
+    {M?M:16, N?N:256, K?K:4096},
   };
 
   // clang-format on
@@ -58,6 +65,11 @@ void performance_test(
   constexpr int NWARMUP = 4;
   constexpr int NITER = 10;
 
+  // FP16 GEMMs only split k of skinny GEMMs when they run on a pool
+  ThreadPoolOptions poolOptions;
+  poolOptions.numThreads = fbgemm_get_max_threads();
+  FbgemmThreadPool pool(poolOptions);
+
   if (timebreak) {
     cout
         << "WARNING: the timer may be inaccurate when used by multiple threads."
@@ -337,9 +349,52 @@ void performance_test(
 
     cout << ", " << setw(5) << fixed << setw(5) << setprecision(1)
          << NITER * nops / ttot << endl;
-    cout << endl;
 
     compare_buffers(Cint32_ref.data(), Cint32_fb_acc16.data(), m, n, n, 5);
+
+    // The small integers of A and B are exact in fp16 and so are the sums
+    PackedGemmMatrixFP16 packedB_fp16(
+        matrix_op_t::NoTranspose, k, n, 1.0f, Bfp32.data());
+    aligned_vector<float> Cfp32_fb_fp16(m * n);
+    aligned_vector<int32_t> Cint32_fb_fp16(m * n);
+
+    runType = "FBGEMM_fp16_pool";
+    ttot = measureWithWarmup(
+        [&]() {
+          cblas_gemm_compute(
+              pool,
+              matrix_op_t::NoTranspose,
+              m,
+              Afp32.data(),
+              packedB_fp16,
+              0.0f,
+              Cfp32_fb_fp16.data());
+        },
+        NWARMUP,
+        NITER,
+        [&]() {
+          if (flush) {
+            llc_flush(llc);
+          }
+        });
+    ttot *= 1e9; // convert to ns
+
+    cout << setw(6) << m << ", " << setw(6) << n << ", " << setw(6) << k << ", "
+         << setw(16) << runType << ", ";
+
+    if (timebreak) {
+      cout << setw(16) << 0 << ", " << setw(16) << 0 << ", " << setw(16) << 0
+           << ", " << setw(16) << ttot / 1e3 << ", ";
+    }
+
+    cout << setw(5) << fixed << setw(5) << setprecision(1) << nops / ttot
+         << endl;
+    cout << endl;
+
+    for (size_t i = 0; i < Cfp32_fb_fp16.size(); ++i) {
+      Cint32_fb_fp16[i] = (int32_t)Cfp32_fb_fp16[i];
+    }
+    compare_buffers(Cint32_ref.data(), Cint32_fb_fp16.data(), m, n, n, 5);
   }
 }
 
@@ -355,6 +410,10 @@ int main(int argc, const char** argv) {
   const int N = parseArgumentInt(argc, argv, "--N=", 0, 0);
   const int K = parseArgumentInt(argc, argv, "--K=", 0, 0);
   const bool timebreak = parseArgumentBool(argc, argv, "--timebreak", false);
+  // Compare against partitioning skinny GEMMs like any other GEMM
+  if (parseArgumentBool(argc, argv, "--no-skinny-partition", false)) {
+    fbgemmSetSkinnyGemmPartition(false);
+  }
 
   performance_test(M, N, K, timebreak);
   return 0;
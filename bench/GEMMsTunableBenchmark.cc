@@ -21,6 +21,7 @@
 
 #include "bench/BenchUtils.h"
 #include "fbgemm/Fbgemm.h"
+#include "fbgemm/FbgemmAutotune.h"
 #include "src/RefImplementations.h"
 #include "test/QuantizationHelpers.h"
 
@@ -207,7 +208,80 @@ void performance_test(
   }
 }
 
-int main(int /* unused */, char** /* unused */) {
+// GOPS of fbgemmPacked called without blocking factors, i.e. with those of
+// the tuning table if it has an entry for the shape.
+double gemm_gops(const vector<int>& shape) {
+  constexpr int NWARMUP = 4;
+  constexpr int NITER = 10;
+  int m = shape[0];
+  int n = shape[1];
+  int k = shape[2];
+
+  aligned_vector<uint8_t> Aint8(m * k);
+  aligned_vector<int8_t> Bint8(k * n);
+  aligned_vector<int32_t> Cint32_ref(m * n);
+  aligned_vector<int32_t> Cint32_fb(m * n);
+  randFill<uint8_t>(Aint8, 0, 5);
+  randFill<int8_t>(Bint8, -4, 4);
+  avoidOverflow(m, n, k, Aint8.data(), Bint8.data());
+  matmul_u8i8acc32_ref(
+      m, n, k, k, n, n, Aint8.data(), Bint8.data(), Cint32_ref.data());
+
+  PackBMatrix<int8_t> packedB(
+      matrix_op_t::NoTranspose, k, n, Bint8.data(), n, nullptr, 1);
+  double ttot = measureWithWarmup(
+      [&]() {
+        PackAMatrix<uint8_t> packA(
+            matrix_op_t::NoTranspose, m, k, Aint8.data(), k, nullptr, 1);
+        DoNothing<int32_t, int32_t> doNothing32BitObj;
+        memCopy<> memcopyObj(doNothing32BitObj);
+        fbgemmPacked(
+            packA,
+            packedB,
+            Cint32_fb.data(),
+            Cint32_fb.data(),
+            n,
+            memcopyObj,
+            fbgemm_get_thread_num(),
+            fbgemm_get_num_threads());
+      },
+      NWARMUP,
+      NITER,
+      [&]() { cache_evict(Cint32_fb); },
+      /*use_openmp=*/true);
+  if (compare_buffers(Cint32_ref.data(), Cint32_fb.data(), m, n, n, 5)) {
+    return 0.0;
+  }
+  return 2.0 * m * n * k / ttot / 1e9;
+}
+
+// Tunes each shape with fbgemmAutotuneBlockingFactors and compares
+// fbgemmPacked before and after. Set FBGEMM_BLOCKING_FACTORS_DB to keep the
+// results for later runs.
+void autotune_test(const vector<vector<int>>& shapes) {
+  AutotuneOptions options;
+#ifdef _OPENMP
+  options.numThreads = omp_get_max_threads();
+#endif
+  cout << setw(8) << "M, " << setw(8) << "N, " << setw(8) << "K, " << setw(14)
+       << "Before GOPS, " << setw(14) << "Tuned GOPS, " << setw(5) << "MCB, "
+       << setw(5) << "NCB, " << setw(5) << "KCB, " << setw(5) << "MR, "
+       << setw(5) << "NR" << endl;
+  for (auto const& shape : shapes) {
+    double before = gemm_gops(shape);
+    BlockingFactors params =
+        fbgemmAutotuneBlockingFactors(shape[0], shape[1], shape[2], options);
+    double after = gemm_gops(shape);
+    cout << setw(6) << shape[0] << ", " << setw(6) << shape[1] << ", "
+         << setw(6) << shape[2] << ", " << fixed << setprecision(1)
+         << setw(12) << before << ", " << setw(12) << after << ", " << setw(3)
+         << params.MCB << ", " << setw(3) << params.NCB << ", " << setw(3)
+         << params.KCB << ", " << setw(3) << params.MR << ", " << setw(3)
+         << params.NR << endl;
+  }
+}
+
+int main(int argc, const char* argv[]) {
 #ifdef _OPENMP
   // Use 1 thread unless OMP_NUM_THREADS is explicit set.
   const char* val = getenv("OMP_NUM_THREADS");
@@ -268,6 +342,11 @@ int main(int /* unused */, char** /* unused */) {
   };
   // clang-format on
 
+  if (parseArgumentBool(argc, argv, "--autotune", false)) {
+    autotune_test(shapes);
+    return 0;
+  }
+
   vector<int> MCBs;
   vector<int> NCBs;
   vector<int> KCBs;
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "bench/BenchUtils.h"
+#include "fbgemm/FbgemmFP16.h"
+#include "fbgemm/FbgemmInt4.h"
+#include "fbgemm/Utils.h"
+
+using namespace std;
+using namespace fbgemm;
+
+// Small batch inference against large dense weights, where the weight
+// bandwidth dominates: compares fp16 weights with int4 weights on the fp32
+// (W4-FP32) and quantized activation (W4A8) paths.
+int main(int argc, const char* argv[]) {
+  const bool flush = !parseArgumentBool(argc, argv, "--no-flush", false);
+  const int group_size =
+      parseArgumentInt(argc, argv, "--group-size=", 128, 128);
+
+  // m, n, k
+  const vector<vector<int>> shapes = {
+      {1, 4096, 4096},
+      {8, 4096, 4096},
+      {32, 4096, 4096},
+      {1, 11008, 4096},
+      {8, 11008, 4096},
+      {1, 4096, 11008},
+      {8, 4096, 11008},
+  };
+  constexpr int NWARMUP = 4;
+  constexpr int NITER = 20;
+
+  vector<char> llc(flush ? 128 * 1024 * 1024 : 0);
+  auto flush_fn = [&]() {
+    if (flush) {
+      llc_flush(llc);
+    }
+  };
+
+  cout << setw(6) << "m" << setw(7) << "n" << setw(7) << "k" << setw(12)
+       << "type" << setw(12) << "B_MB" << setw(12) << "ms" << setw(12)
+       << "GFLOPS" << setw(12) << "B_GB/s" << endl;
+  auto print = [&](const vector<int>& s,
+                   const char* type,
+                   double bytes,
+                   double secs) {
+    const double flops = 2.0 * s[0] * s[1] * s[2];
+    cout << setw(6) << s[0] << setw(7) << s[1] << setw(7) << s[2] << setw(12)
+         << type << setw(12) << fixed << setprecision(2) << bytes / 1e6
+         << setw(12) << secs * 1e3 << setw(12) << flops / secs / 1e9
+         << setw(12) << bytes / secs / 1e9 << endl;
+  };
+
+  for (const auto& s : shapes) {
+    const int m = s[0], n = s[1], k = s[2];
+    aligned_vector<float> A(m * k), B(k * n), C(m * n);
+    aligned_vector<uint8_t> A_u8(m * k);
+    randFill<float>(A, -1.0f, 1.0f);
+    randFill<float>(B, -1.0f, 1.0f);
+    randFill<uint8_t>(A_u8, 0, 255);
+
+    PackedGemmMatrixFP16 Bp_fp16(
+        matrix_op_t::NoTranspose, k, n, 1.0f, B.data());
+    PackedInt4GemmMatrixB Bp_int4(
+        matrix_op_t::NoTranspose, k, n, B.data(), group_size);
+
+    double secs = measureWithWarmup(
+        [&]() {
+          cblas_gemm_compute(
+              matrix_op_t::NoTranspose,
+              m,
+              A.data(),
+              Bp_fp16,
+              0.0f,
+              C.data(),
+              fbgemm_get_thread_num(),
+              fbgemm_get_num_threads());
+        },
+        NWARMUP,
+        NITER,
+        flush_fn,
+        true /*useOpenMP*/);
+    print(s, "fp16", 2.0 * k * n, secs);
+
+    secs = measureWithWarmup(
+        [&]() {
+          fbgemmInt4Gemm(
+              m,
+              A.data(),
+              k,
+              Bp_int4,
+              0.0f,
+              C.data(),
+              n,
+              fbgemm_get_thread_num(),
+              fbgemm_get_num_threads());
+        },
+        NWARMUP,
+        NITER,
+        flush_fn,
+        true /*useOpenMP*/);
+    print(s, "int4_fp32", Bp_int4.packedBytes(), secs);
+
+    secs = measureWithWarmup(
+        [&]() {
+          fbgemmInt4Gemm(
+              m,
+              A_u8.data(),
+              k,
+              0.02f,
+              128,
+              Bp_int4,
+              0.0f,
+              C.data(),
+              n,
+              fbgemm_get_thread_num(),
+              fbgemm_get_num_threads());
+        },
+        NWARMUP,
+        NITER,
+        flush_fn,
+        true /*useOpenMP*/);
+    print(s, "int4_u8", Bp_int4.packedBytes(), secs);
+  }
+  return 0;
+}
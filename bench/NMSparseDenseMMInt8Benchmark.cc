@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "bench/BenchUtils.h"
+#include "fbgemm/FbgemmSparse.h"
+#include "fbgemm/Utils.h"
+#include "fbgemm/spmmUtils.h"
+#include "src/RefImplementations.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace fbgemm;
+
+// 2:4 pruned weights (50% density) run through the BCSR and the N:M sparse
+// formats. GFLOPS are effective, i.e., counted as if the weights were dense.
+int main(int, char**) {
+  vector<vector<int>> shapes = getSparseMatrixShapes();
+
+  // C is MxN -> CT is NxM
+  // A is MxK -> AT is KxM
+  // B is KxN -> BT is NxK
+
+  cout << setw(7) << "index" << setw(7) << "m" << setw(7) << "n" << setw(7)
+       << "k" << setw(15) << "BCSR_GFLOPS" << setw(15) << "2:4_GFLOPS"
+       << endl;
+
+  int index = 0;
+  for (auto const& s : shapes) {
+    int m = s[0];
+    int n = s[1];
+    int k = s[2];
+
+    auto aData = getRandomBlockSparseMatrix<uint8_t>(
+        m, k, 1.0, 1 /* rowBlockSize */, 1 /* colBlockSize */);
+    auto btData = getRandomNMSparseMatrix<int8_t>(n, k, 2, 4, -9, 9);
+
+    aligned_vector<uint8_t> atData(k * m);
+    aligned_vector<int8_t> bData(k * n);
+    aligned_vector<int32_t> cData(m * n);
+    aligned_vector<int32_t> ctDataRef(n * m);
+    aligned_vector<uint8_t> ctDataRef_u8(n * m);
+    aligned_vector<int32_t> ctDataIntrin_i32(n * m);
+    aligned_vector<uint8_t> ctDataIntrin_u8(n * m);
+
+    transpose_matrix(m, k, aData.data(), k, atData.data(), m);
+    transpose_matrix(n, k, btData.data(), k, bData.data(), n);
+
+    unique_ptr<BCSRMatrix<>> bcsr = fbgemmDenseToBCSR(n, k, btData.data());
+    auto nm = fbgemmDenseToNMSparse<2, 4>(n, k, btData.data());
+
+    // output scale and zero point
+    float scale = 32.0f;
+    int32_t zero_point = 2;
+
+    int32_t act_zero_point = 2;
+
+    // symmetric quant for weights
+    aligned_vector<int32_t> weight_zero_point(n);
+    randFill<int32_t>(weight_zero_point, 0, 0);
+
+    aligned_vector<float> act_times_w_scale(n);
+    randFill<float>(act_times_w_scale, -8.0f, 8.0f);
+
+    // Both formats compute the same row offsets
+    trRequantizationParams_t reqParams = {
+        act_zero_point,
+        weight_zero_point.data(),
+        zero_point,
+        scale,
+        nm->row_offsets.data(),
+        nullptr,
+        nullptr,
+        act_times_w_scale.data()};
+
+    int ldat = m;
+    int ldct = m;
+
+    double effective_flop = 2.0 * m * n * k;
+
+    constexpr int NWARMUP = 20;
+    constexpr int NITER = 100;
+
+    auto secs_bcsr = measureWithWarmup(
+        [&]() {
+          fbgemmSparseDenseInt8MM<false, QuantizationGranularity::TENSOR>(
+              m,
+              bcsr,
+              atData.data(),
+              ldat,
+              ctDataIntrin_i32.data(),
+              ctDataIntrin_u8.data(),
+              ldct,
+              reqParams);
+        },
+        NWARMUP,
+        NITER,
+        [&]() {
+          cache_evict(atData);
+          cache_evict(bcsr->rowBPtr);
+          cache_evict(bcsr->colBIdx);
+          cache_evict(bcsr->values);
+          cache_evict(ctDataIntrin_i32);
+          cache_evict(ctDataIntrin_u8);
+        });
+
+    auto secs_nm = measureWithWarmup(
+        [&]() {
+          fbgemmSparseDenseInt8MM<false, QuantizationGranularity::TENSOR>(
+              m,
+              nm,
+              atData.data(),
+              ldat,
+              ctDataIntrin_i32.data(),
+              ctDataIntrin_u8.data(),
+              ldct,
+              reqParams);
+        },
+        NWARMUP,
+        NITER,
+        [&]() {
+          cache_evict(atData);
+          cache_evict(nm->values);
+          cache_evict(nm->meta);
+          cache_evict(ctDataIntrin_i32);
+          cache_evict(ctDataIntrin_u8);
+        });
+
+    matmul_u8i8acc32_ref(
+        m,
+        n,
+        k,
+        k, // lda
+        n, // ldb
+        n, // ldc
+        aData.data(),
+        bData.data(),
+        cData.data());
+    transpose_matrix(m, n, cData.data(), n, ctDataRef.data(), m);
+
+    // ctDataRef is nxm
+    block_type_t block{0, n, 0, m};
+    trRequantizeRef<false, QuantizationGranularity::TENSOR>(
+        ctDataRef_u8.data(), ctDataRef.data(), block, m, m, reqParams);
+
+    // Compare results of the last (N:M) run
+    for (size_t i = 0; i < ctDataRef.size(); i++) {
+      if (std::abs(ctDataRef_u8[i] - ctDataIntrin_u8[i]) > 0) {
+        fprintf(
+            stderr,
+            "Error: Results differ ref %d and test %d at %ld\n",
+            ctDataRef_u8[i],
+            ctDataIntrin_u8[i],
+            i);
+        return 1;
+      }
+    }
+
+    cout << "[" << setw(5) << index << "]" << setw(7) << m << setw(7) << n
+         << setw(7) << k << fixed << setw(15) << setprecision(5)
+         << effective_flop / secs_bcsr / 1e9 << setw(15)
+         << effective_flop / secs_nm / 1e9 << endl;
+    ++index;
+  }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench/BenchUtils.h"
+#include "fbgemm/FbgemmEmbedding.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+// Scalar reference vs. the SIMD lookup over tables from cache resident to
+// DRAM sized, at the load factors pruned tables are built with.
+int main() {
+  constexpr int64_t num_indices = 1 << 20;
+  constexpr int NWARMUP = 2;
+  constexpr int NITER = 10;
+
+  cout << setw(12) << "capacity" << setw(8) << "load" << setw(12) << "ref_ns"
+       << setw(12) << "simd_ns" << setw(10) << "speedup" << endl;
+
+  mt19937 gen(1);
+  uniform_int_distribution<int32_t> key_dist(0, (1 << 30) - 1);
+  for (const int64_t capacity : {1 << 12, 1 << 16, 1 << 20, 1 << 24}) {
+    for (const double load : {0.5, 0.75, 0.9}) {
+      const int64_t num_inserted = capacity * load;
+      vector<int32_t> sparse_ids(num_inserted), dense_ids(num_inserted);
+      for (int64_t i = 0; i < num_inserted; ++i) {
+        sparse_ids[i] = key_dist(gen);
+        dense_ids[i] = i;
+      }
+      vector<int32_t> hash_table(2 * capacity, -1);
+      pruned_hashmap_insert_ref(
+          sparse_ids.data(),
+          dense_ids.data(),
+          num_inserted,
+          hash_table.data(),
+          capacity);
+
+      // 90% of the lookups hit
+      vector<int32_t> indices(num_indices);
+      uniform_int_distribution<int64_t> pick_dist(0, num_inserted - 1);
+      for (auto& idx : indices) {
+        idx = gen() % 10 ? sparse_ids[pick_dist(gen)] : key_dist(gen);
+      }
+      vector<int32_t> dense_indices_ref(num_indices);
+      vector<int32_t> dense_indices(num_indices);
+
+      const double secs_ref = measureWithWarmup(
+          [&]() {
+            pruned_hashmap_lookup_ref(
+                indices.data(),
+                num_indices,
+                hash_table.data(),
+                capacity,
+                dense_indices_ref.data());
+          },
+          NWARMUP,
+          NITER);
+      const double secs = measureWithWarmup(
+          [&]() {
+            pruned_hashmap_lookup(
+                indices.data(),
+                num_indices,
+                hash_table.data(),
+                capacity,
+                dense_indices.data());
+          },
+          NWARMUP,
+          NITER);
+
+      if (dense_indices != dense_indices_ref) {
+        cerr << "pruned_hashmap_lookup differs from the reference for "
+             << "capacity = " << capacity << " load = " << load << endl;
+        return 1;
+      }
+      cout << setw(12) << capacity << setw(8) << setprecision(2) << load
+           << fixed << setprecision(2) << setw(12)
+           << secs_ref * 1e9 / num_indices << setw(12)
+           << secs * 1e9 / num_indices << setw(10) << secs_ref / secs
+           << defaultfloat << endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "bench/BenchUtils.h"
+#include "fbgemm/Utils.h"
+
+using namespace std;
+using namespace fbgemm;
+
+// Serial baseline: sort the positions by key, then walk the runs.
+static int64_t unique_serial(
+    const vector<int64_t>& keys,
+    vector<int64_t>& unique_keys,
+    vector<int32_t>& inverse,
+    vector<int32_t>& counts,
+    vector<int32_t>& positions) {
+  iota(positions.begin(), positions.end(), 0);
+  stable_sort(positions.begin(), positions.end(), [&](int32_t a, int32_t b) {
+    return keys[a] < keys[b];
+  });
+  int64_t u = -1;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const auto key = keys[positions[i]];
+    if (i == 0 || key != unique_keys[u]) {
+      unique_keys[++u] = key;
+      counts[u] = 0;
+    }
+    inverse[positions[i]] = u;
+    ++counts[u];
+  }
+  return u + 1;
+}
+
+int main(int argc, const char* argv[]) {
+  const bool zipf = parseArgumentBool(argc, argv, "--zipf", false);
+
+  cout << "max_threads " << fbgemm_get_max_threads() << endl;
+  cout << setw(12) << "n" << setw(12) << "max_key" << setw(12) << "unique"
+       << setw(14) << "serial_ms" << setw(14) << "parallel_ms" << setw(10)
+       << "speedup" << endl;
+
+  mt19937 gen(1);
+  for (const int64_t n : {100000, 1000000, 10000000}) {
+    for (const int64_t max_key : {1000, 1000000, 100000000}) {
+      vector<int64_t> keys(n);
+      if (zipf) {
+        // Power law over the ids, hot ids spread over the key space
+        uniform_real_distribution<double> dist(0.0, 1.0);
+        for (auto& k : keys) {
+          const auto r = static_cast<int64_t>(
+              max_key * pow(dist(gen), 4.0)); // skewed toward 0
+          k = (r * 2654435761LL) % (max_key + 1);
+        }
+      } else {
+        uniform_int_distribution<int64_t> dist(0, max_key);
+        for (auto& k : keys) {
+          k = dist(gen);
+        }
+      }
+
+      vector<int64_t> unique_keys(n), unique_keys_ref(n);
+      vector<int32_t> inverse(n), inverse_ref(n);
+      vector<int32_t> counts(n), counts_ref(n);
+      vector<int32_t> positions(n), positions_ref(n);
+
+      int64_t num_unique_ref = 0;
+      const double secs_serial = measureWithWarmup(
+          [&]() {
+            num_unique_ref = unique_serial(
+                keys, unique_keys_ref, inverse_ref, counts_ref, positions_ref);
+          },
+          1,
+          5);
+
+      int64_t num_unique = 0;
+      const double secs_parallel = measureWithWarmup(
+          [&]() {
+            num_unique = unique_parallel<int64_t, int32_t>(
+                keys.data(),
+                n,
+                max_key,
+                unique_keys.data(),
+                inverse.data(),
+                counts.data(),
+                positions.data());
+          },
+          1,
+          5);
+
+      if (num_unique != num_unique_ref || inverse != inverse_ref ||
+          positions != positions_ref ||
+          !equal(
+              counts.begin(),
+              counts.begin() + num_unique,
+              counts_ref.begin())) {
+        cerr << "unique_parallel differs from the serial reference for n = "
+             << n << " max_key = " << max_key << endl;
+        return 1;
+      }
+
+      cout << setw(12) << n << setw(12) << max_key << setw(12) << num_unique
+           << fixed << setprecision(3) << setw(14) << secs_serial * 1e3
+           << setw(14) << secs_parallel * 1e3 << setw(10) << setprecision(2)
+           << secs_serial / secs_parallel << endl;
+    }
+  }
+  return 0;
+}
@@ -5,7 +5,10 @@
 
 def get_fbgemm_base_srcs():
     return [
+        "src/CodeCacheRegistry.cc",
+        "src/FbgemmThreadPool.cc",
         "src/GenerateI8Depthwise.cc",
+        "src/PersistentCodeCache.cc",
         "src/RefImplementations.cc",
         "src/Utils.cc",
     ]
@@ -14,15 +17,20 @@ def get_fbgemm_generic_srcs(with_base = False):
     return [
         "src/EmbeddingSpMDM.cc",
         "src/EmbeddingSpMDMNBit.cc",
+        "src/EmbeddingSpMDMGrouped.cc",
         "src/ExecuteKernel.cc",
         "src/ExecuteKernelU8S8.cc",
         "src/Fbgemm.cc",
+        "src/FbgemmAutotune.cc",
+        "src/FbgemmBF16.cc",
         "src/FbgemmBfloat16Convert.cc",
         "src/FbgemmConv.cc",
         "src/FbgemmFPCommon.cc",
         "src/FbgemmFP16.cc",
         "src/FbgemmFloat16Convert.cc",
         "src/FbgemmI64.cc",
+        "src/FbgemmInt4.cc",
+        "src/FbgemmPackSerialize.cc",
         "src/FbgemmSparseDense.cc",
         "src/FbgemmI8Spmdm.cc",
         "src/GenerateKernelDirectConvU8S8S32ACC32.cc",
@@ -39,6 +47,7 @@ def get_fbgemm_generic_srcs(with_base = False):
         "src/PackAWithIm2Col.cc",
         "src/PackAWithQuantRowOffset.cc",
         "src/PackAWithRowOffset.cc",
+        "src/PackAWithRowwiseQuantRowOffset.cc",
         "src/PackBMatrix.cc",
         "src/PackMatrix.cc",
         "src/PackWeightMatrixForGConv.cc",
@@ -47,6 +56,7 @@ def get_fbgemm_generic_srcs(with_base = False):
         "src/QuantUtils.cc",
         "src/RowWiseSparseAdagradFused.cc",
         "src/SparseAdagrad.cc",
+        "src/SparseOptimizers.cc",
         "src/spmmUtils.cc",
         "src/TransposeUtils.cc",
     ] + (get_fbgemm_base_srcs() if with_base else [])
@@ -55,6 +65,8 @@ def get_fbgemm_public_headers():
     return [
         "include/fbgemm/ConvUtils.h",
         "include/fbgemm/Fbgemm.h",
+        "include/fbgemm/FbgemmAutotune.h",
+        "include/fbgemm/FbgemmBF16.h",
         "include/fbgemm/FbgemmBuild.h",
         "include/fbgemm/FbgemmConvert.h",
         "include/fbgemm/FbgemmEmbedding.h",
@@ -64,8 +76,13 @@ def get_fbgemm_public_headers():
         "include/fbgemm/FbgemmI8DepthwiseAvx2.h",
         "include/fbgemm/FbgemmI8DirectconvAvx2.h",
         "include/fbgemm/FbgemmI8Spmdm.h",
+        "include/fbgemm/FbgemmInt4.h",
+        "include/fbgemm/FbgemmKernelCache.h",
         "include/fbgemm/FbgemmPackMatrixB.h",
+        "include/fbgemm/FbgemmPackSerialize.h",
+        "include/fbgemm/FbgemmReplicatedWeights.h",
         "include/fbgemm/FbgemmSparse.h",
+        "include/fbgemm/FbgemmThreadPool.h",
         "include/fbgemm/OutputProcessing-inl.h",
         "include/fbgemm/PackingTraits-inl.h",
         "include/fbgemm/QuantUtils.h",
@@ -89,20 +106,28 @@ def get_fbgemm_avx2_srcs(msvc = False):
         "src/FbgemmI8Depthwise3DAvx2.cc",
         "src/FbgemmI8DepthwiseAvx2.cc",
         "src/FbgemmI8DepthwisePerChannelQuantAvx2.cc",
+        "src/FbgemmInt4Avx2.cc",
         "src/FbgemmSparseDenseAvx2.cc",
         "src/FbgemmSparseDenseInt8Avx2.cc",
         "src/OptimizedKernelsAvx2.cc",
         "src/PackDepthwiseConvMatrixAvx2.cc",
         "src/QuantUtilsAvx2.cc",
+        "src/SparseOptimizersAvx2.cc",
         "src/spmmUtilsAvx2.cc",
         "src/UtilsAvx2.cc",
     ]
 
 def get_fbgemm_inline_avx2_srcs(msvc = False, buck = False):
-    intrinsics_srcs = ["src/FbgemmFP16UKernelsIntrinsicAvx2.cc"]
+    intrinsics_srcs = [
+        "src/FbgemmBF16UKernelsIntrinsicAvx2.cc",
+        "src/FbgemmFP16UKernelsIntrinsicAvx2.cc",
+    ]
 
     #FP16 kernels contain inline assembly and inline assembly syntax for MSVC is different.
-    asm_srcs = ["src/FbgemmFP16UKernelsAvx2.cc"]
+    asm_srcs = [
+        "src/FbgemmBF16UKernelsAvx2.cc",
+        "src/FbgemmFP16UKernelsAvx2.cc",
+    ]
     if buck:
         return select({
             "DEFAULT": asm_srcs if not msvc else intrinsics_srcs,
@@ -117,6 +142,7 @@ def get_fbgemm_avx512_srcs(msvc = False):
         "src/FbgemmBfloat16ConvertAvx512.cc",
         "src/EmbeddingSpMDMAvx512.cc",
         "src/FbgemmFloat16ConvertAvx512.cc",
+        "src/FbgemmInt4Avx512.cc",
         "src/FbgemmSparseDenseAvx512.cc",
         "src/FbgemmSparseDenseInt8Avx512.cc",
         "src/FbgemmSparseDenseVectorInt8Avx512.cc",
@@ -126,10 +152,14 @@ def get_fbgemm_avx512_srcs(msvc = False):
 
 def get_fbgemm_inline_avx512_srcs(msvc = False, buck = False):
     intrinsics_srcs = [
+        "src/FbgemmBF16UKernelsIntrinsicAvx512.cc",
+        "src/FbgemmBF16UKernelsIntrinsicAvx512_256.cc",
         "src/FbgemmFP16UKernelsIntrinsicAvx512.cc",
         "src/FbgemmFP16UKernelsIntrinsicAvx512_256.cc",
     ]
     asm_srcs = [
+        "src/FbgemmBF16UKernelsAvx512.cc",
+        "src/FbgemmBF16UKernelsAvx512_256.cc",
         "src/FbgemmFP16UKernelsAvx512.cc",
         "src/FbgemmFP16UKernelsAvx512_256.cc",
     ]
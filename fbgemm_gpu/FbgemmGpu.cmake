@@ -53,20 +53,20 @@ set(third_party_include_directories
 
 set(COMMON_OPTIMIZERS
     adagrad
+    adam
+    lamb
+    lars_sgd
+    partial_rowwise_adam
+    partial_rowwise_lamb
     rowwise_adagrad
+    rowwise_adagrad_with_counter
     sgd)
 
 # To be populated in the subsequent diffs
 set(CPU_ONLY_OPTIMIZERS "")
 
 set(GPU_ONLY_OPTIMIZERS
-    adam
-    lamb
-    partial_rowwise_adam
-    partial_rowwise_lamb
-    lars_sgd
-    none
-    rowwise_adagrad_with_counter)
+    none)
 
 set(DEPRECATED_OPTIMIZERS
     approx_sgd
@@ -697,6 +697,66 @@ target_compile_options(fbgemm_gpu_py PRIVATE
   -Wno-deprecated-declarations)
 
 
+################################################################################
+# FBGEMM_GPU KV DB
+################################################################################
+
+if(FBGEMM_BUILD_KV_DB)
+  # The KV DB backend of SSD TBE, which is built on folly and RocksDB
+  list(APPEND CMAKE_MODULE_PATH ${CMAKEMODULES})
+  find_package(MKL REQUIRED)
+  find_package(folly CONFIG REQUIRED)
+  find_package(RocksDB CONFIG REQUIRED)
+
+  set(fbgemm_gpu_kv_db_sources
+    src/ssd_split_embeddings_cache/kv_db_table_batched_embeddings.cpp)
+
+  # get_cuda and set_cuda, which the SSD TBE ops call on CUDA and ROCm alike
+  if(NOT FBGEMM_CPU_ONLY)
+    set(fbgemm_gpu_kv_db_cuda_sources
+      src/ssd_split_embeddings_cache/kv_db_table_batched_embeddings_cuda.cpp)
+    if(USE_ROCM)
+      get_hipified_list(
+        "${fbgemm_gpu_kv_db_cuda_sources}" fbgemm_gpu_kv_db_cuda_sources)
+      set_source_files_properties(${fbgemm_gpu_kv_db_cuda_sources}
+                                  PROPERTIES HIP_SOURCE_PROPERTY_FORMAT 1)
+    endif()
+    list(APPEND fbgemm_gpu_kv_db_sources ${fbgemm_gpu_kv_db_cuda_sources})
+  endif()
+
+  if(USE_ROCM)
+    hip_add_library(fbgemm_gpu_kv_db STATIC
+      ${fbgemm_gpu_kv_db_sources}
+      HIPCC_OPTIONS
+      ${HIP_HCC_FLAGS})
+
+    target_include_directories(fbgemm_gpu_kv_db PUBLIC
+      ${FBGEMM_HIP_INCLUDE})
+  else()
+    add_library(fbgemm_gpu_kv_db STATIC
+      ${fbgemm_gpu_kv_db_sources})
+  endif()
+
+  set_target_properties(fbgemm_gpu_kv_db PROPERTIES
+    POSITION_INDEPENDENT_CODE ON)
+
+  target_include_directories(fbgemm_gpu_kv_db PUBLIC
+    ${fbgemm_sources_include_directories}
+    ${MKL_INCLUDE_DIR})
+
+  target_link_libraries(fbgemm_gpu_kv_db PUBLIC
+    ${TORCH_LIBRARIES}
+    Folly::folly
+    RocksDB::rocksdb)
+
+  add_executable(kv_db_table_batched_embeddings_benchmark
+    bench/kv_db_table_batched_embeddings_benchmark.cpp)
+
+  target_link_libraries(kv_db_table_batched_embeddings_benchmark
+    fbgemm_gpu_kv_db)
+endif()
+
+
 ################################################################################
 # FBGEMM_GPU Install
 ################################################################################
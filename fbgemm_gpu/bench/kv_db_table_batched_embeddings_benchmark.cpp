@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// Drives the CPU-only RocksDB embedding backend with Zipfian index streams,
+// and compares a synchronous get / compute / set loop with a pipeline where
+// the get of the next batch overlaps the compute and the set of the current
+// one, except for the rows that the two batches share.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/ssd_split_embeddings_cache/ssd_table_batched_embeddings.h"
+
+using namespace std;
+
+namespace {
+
+constexpr int64_t kNumRows = 1 << 20;
+constexpr int64_t kEmbeddingDim = 128;
+constexpr int64_t kLookupsPerBatch = 1 << 16;
+constexpr int kNumBatches = 50;
+constexpr int kNumShards = 8;
+// Time the trainer spends on the forward and backward of a batch
+constexpr auto kComputeTime = chrono::milliseconds(5);
+
+// Draws row ids from a Zipfian distribution over [0, num_rows). Hot rows are
+// scattered over the id space, so that they do not all land in one shard.
+class ZipfianGenerator {
+ public:
+  ZipfianGenerator(int64_t num_rows, double alpha, uint64_t seed)
+      : num_rows_(num_rows), cdf_(num_rows), gen_(seed) {
+    double sum = 0;
+    for (int64_t i = 0; i < num_rows; ++i) {
+      sum += 1.0 / pow(i + 1, alpha);
+      cdf_[i] = sum;
+    }
+    for (auto& c : cdf_) {
+      c /= sum;
+    }
+  }
+
+  int64_t operator()() {
+    const auto rank = min<int64_t>(
+        lower_bound(cdf_.begin(), cdf_.end(), dist_(gen_)) - cdf_.begin(),
+        num_rows_ - 1);
+    return (rank * kScatter) % num_rows_;
+  }
+
+ private:
+  // A prime that does not divide num_rows, so that scattering is a bijection
+  static constexpr int64_t kScatter = 2654435761;
+
+  const int64_t num_rows_;
+  vector<double> cdf_;
+  mt19937_64 gen_;
+  uniform_real_distribution<double> dist_{0.0, 1.0};
+};
+
+// The unique rows of a batch, which is what the SSD TBE cache asks the
+// backend for. The rows that are not in the previous batch come first, so
+// that they can be fetched while the previous batch is still being written.
+struct Batch {
+  at::Tensor indices;
+  at::Tensor count;
+  // Rows [0, num_fresh) are not in the previous batch
+  int64_t num_fresh;
+  at::Tensor fresh_count;
+  at::Tensor shared_count;
+};
+
+vector<Batch> generate_batches(double alpha) {
+  ZipfianGenerator zipf(kNumRows, alpha, /*seed=*/alpha * 1000);
+  vector<Batch> batches;
+  vector<int64_t> prev_ids;
+  for (int b = 0; b < kNumBatches; ++b) {
+    vector<int64_t> ids(kLookupsPerBatch);
+    for (auto& id : ids) {
+      id = zipf();
+    }
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    auto sorted_ids = ids;
+    const int64_t num_fresh =
+        stable_partition(
+            ids.begin(),
+            ids.end(),
+            [&](int64_t id) {
+              return !binary_search(prev_ids.begin(), prev_ids.end(), id);
+            }) -
+        ids.begin();
+    prev_ids = std::move(sorted_ids);
+
+    auto indices = at::full({kLookupsPerBatch}, -1, at::kLong);
+    copy(ids.begin(), ids.end(), indices.data_ptr<int64_t>());
+    const int64_t count = ids.size();
+    batches.push_back(
+        {indices,
+         at::scalar_tensor(count, at::kLong),
+         num_fresh,
+         at::scalar_tensor(num_fresh, at::kLong),
+         at::scalar_tensor(count - num_fresh, at::kLong)});
+  }
+  return batches;
+}
+
+// Stands in for the trainer: waits for the compute time and applies an update
+// to the fetched rows, which are then written back
+void compute(const at::Tensor& weights, const at::Tensor& count) {
+  const auto start = chrono::steady_clock::now();
+  weights.narrow(0, 0, count.item<int64_t>()).add_(1e-3);
+  while (chrono::steady_clock::now() - start < kComputeTime) {
+  }
+}
+
+double run_sync(
+    kv_db::EmbeddingKVDB& db,
+    const vector<Batch>& batches,
+    const at::Tensor& weights) {
+  const auto start = chrono::steady_clock::now();
+  for (const auto& batch : batches) {
+    db.get(batch.indices, weights, batch.count);
+    compute(weights, batch.count);
+    db.set(batch.indices, weights, batch.count);
+  }
+  return chrono::duration<double>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Double buffers the weights. The get of batch b + 1 only starts once the set
+// of batch b - 1, which reads the same buffer, has completed. A get must not
+// overlap a set of the same rows, so only the rows of batch b + 1 that are not
+// in batch b are fetched while batch b is computed and written back. The rows
+// the two batches share are fetched once the set of batch b has completed.
+double run_pipelined(
+    kv_db::EmbeddingKVDB& db,
+    const vector<Batch>& batches,
+    const array<at::Tensor, 2>& weights) {
+  const auto start = chrono::steady_clock::now();
+  auto get_future =
+      db.get_async(batches[0].indices, weights[0], batches[0].fresh_count);
+  auto set_future = folly::makeSemiFuture();
+  for (int b = 0; b < kNumBatches; ++b) {
+    const auto& batch = batches[b];
+    std::move(get_future).get();
+    std::move(set_future).get();
+    if (b > 0) {
+      const auto num_shared = kLookupsPerBatch - batch.num_fresh;
+      db.get(
+          batch.indices.narrow(0, batch.num_fresh, num_shared),
+          weights[b % 2].narrow(0, batch.num_fresh, num_shared),
+          batch.shared_count);
+    }
+    if (b + 1 < kNumBatches) {
+      get_future = db.get_async(
+          batches[b + 1].indices,
+          weights[(b + 1) % 2],
+          batches[b + 1].fresh_count);
+    }
+    compute(weights[b % 2], batch.count);
+    set_future = db.set_async(batch.indices, weights[b % 2], batch.count, b);
+  }
+  std::move(set_future).get();
+  return chrono::duration<double>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main() {
+  cout << setw(8) << "alpha" << setw(14) << "unique/batch" << setw(14)
+       << "shared/batch" << setw(12) << "sync_ms" << setw(16) << "pipelined_ms"
+       << setw(10) << "speedup" << endl;
+
+  for (const double alpha : {0.8, 1.0, 1.2}) {
+    char path_template[] = "/tmp/kv_db_benchmark_XXXXXX";
+    const string path = mkdtemp(path_template);
+    {
+      auto db = make_shared<ssd::EmbeddingRocksDB>(
+          path,
+          kNumShards,
+          /*num_threads=*/kNumShards,
+          /*memtable_flush_period=*/0,
+          /*memtable_flush_offset=*/0,
+          /*l0_files_per_compact=*/4,
+          /*max_D=*/kEmbeddingDim,
+          /*rate_limit_mbps=*/0,
+          /*size_ratio=*/10,
+          /*compaction_trigger=*/8,
+          /*write_buffer_size=*/256 * 1024 * 1024,
+          /*max_write_buffer_num=*/4,
+          /*uniform_init_lower=*/-0.01,
+          /*uniform_init_upper=*/0.01);
+
+      const auto batches = generate_batches(alpha);
+      int64_t num_unique = 0;
+      int64_t num_shared = 0;
+      for (const auto& batch : batches) {
+        num_unique += batch.count.item<int64_t>();
+        num_shared += batch.shared_count.item<int64_t>();
+      }
+      const array<at::Tensor, 2> weights = {
+          at::empty({kLookupsPerBatch, kEmbeddingDim}, at::kFloat),
+          at::empty({kLookupsPerBatch, kEmbeddingDim}, at::kFloat)};
+
+      // Warm up, which also writes the rows of the batches to the DB
+      run_sync(*db, batches, weights[0]);
+      const double secs_sync = run_sync(*db, batches, weights[0]);
+      const double secs_pipelined = run_pipelined(*db, batches, weights);
+
+      cout << setw(8) << alpha << setw(14) << num_unique / kNumBatches
+           << setw(14) << num_shared / kNumBatches << fixed << setprecision(2)
+           << setw(12) << secs_sync * 1e3 / kNumBatches << setw(16)
+           << secs_pipelined * 1e3 / kNumBatches << setw(10)
+           << secs_sync / secs_pipelined << defaultfloat << endl;
+    }
+    filesystem::remove_all(path);
+  }
+  return 0;
+}
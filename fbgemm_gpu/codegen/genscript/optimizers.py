@@ -552,23 +552,85 @@ def rowwise_adagrad_with_counter() -> Dict[str, Any]:
     exp_reg_correction = SHFL_SYNC(exp_reg_correction, 0);
     """
     split_weight_update_cpu = """
-        at::acc_type<grad_t, true> g_local_sum_square = 0.0;
+        // prev_iter and row_counter are rowwise states like momentum1 so they
+        // share its offsets
+        const auto offset_idx = momentum1_offsets_data[feature_begin] + idx;
+        at::acc_type<grad_t, true> tail_id_threshold_val = tail_id_threshold;
+        TORCH_CHECK(max_counter != 0.0); // avoid divide by zero error
+        if (is_tail_id_thresh_ratio == 1) {
+            tail_id_threshold_val = floorf(tail_id_threshold * max_counter);
+        }
+        if (counter_halflife > 0) { // decay based on counter_halflife
+            // if id occurs multiple times in a batch, iter_delta=1
+            const auto iter_delta = prev_iter_host[offset_idx] == 0 ? 1.0 : iter * 1.0 - prev_iter_host[offset_idx];
+            prev_iter_host[offset_idx] = iter * 1.0;
+            const auto counter_log_rho = logf(2.0) / counter_halflife;
+            row_counter_host[offset_idx] = 1.0 + expf(-iter_delta * counter_log_rho) * row_counter_host[offset_idx];
+        } else if (counter_halflife == 0) { // count only 1 (appear or not)
+            row_counter_host[offset_idx] = 1.0;
+        } else { // count raw appearance without decaying
+            row_counter_host[offset_idx] += 1.0;
+        }
+        const auto row_counter = row_counter_host[offset_idx];
+        const at::acc_type<grad_t, true> freq = counter_halflife / row_counter;
+
+        at::acc_type<grad_t, true> g_sum_square = 0.0;
+        at::acc_type<grad_t, true> w_sum_square = 0.0;
         for (int64_t d = 0; d < D; ++d) {
-            g_local_sum_square += grad_buffer[d] * grad_buffer[d];
+            const at::acc_type<grad_t, true> weight = host_weights_data[embedding_begin + d];
+            auto grad = grad_buffer[d];
+            // for L2 regularization (weight_decay_mode=1)
+            // add weight_decay to gradient before other computation
+            if (weight_decay_mode == 1) {
+                grad += weight_decay * weight;
+            }
+            g_sum_square += grad * grad;
+            // cow_clip (regularization_mode=4) requires weight norm
+            w_sum_square += weight * weight;
         }
-        auto g_avg_square = g_local_sum_square / D;
-        auto offset_idx = momentum1_offsets_data[feature_begin] + idx;
+        const auto g_avg_square = g_sum_square / D;
+
         at::acc_type<grad_t, true> new_sum_square_grads = momentum1_host[offset_idx] + g_avg_square;
         momentum1_host[offset_idx] = new_sum_square_grads;
-        at::acc_type<grad_t, true> multiplier;
-        multiplier = learning_rate / (sqrtf(new_sum_square_grads) + eps);
-        const auto iter_delta = iter * 1.0 - prev_iter_host[offset_idx];
-        prev_iter_host[offset_idx] = iter * 1.0;
-        const auto exp_reg = 1.0 / (weight_decay * multiplier + 1.0);
-        const auto exp_reg_correction = powf(exp_reg, iter_delta);
+        const at::acc_type<grad_t, true> multiplier = learning_rate / (sqrtf(new_sum_square_grads) + eps);
+        const auto adjustment_enabled = adjustment_iter <= 0 || (adjustment_iter > 0 && iter > adjustment_iter);
+
+        at::acc_type<grad_t, true> adjusted_multiplier = multiplier;
+        if (regularization_mode == 3) { // counter-based regularization (regularization_mode=3)
+            if (learning_rate_mode >= 0 && adjustment_enabled) {
+                if (row_counter > tail_id_threshold_val) {
+                    if (learning_rate_mode == 0) {
+                        adjusted_multiplier = multiplier * std::max(std::min(powf(max_counter / (row_counter + 1.0), adjustment_ub), 10.0f), 1.0f);
+                    } else if (learning_rate_mode == 1) {
+                        adjusted_multiplier = multiplier * std::min(std::max(powf((row_counter + 1.0) / max_counter, adjustment_ub), 0.1f), 1.0f);
+                    } else if (learning_rate_mode == 2) {
+                        adjusted_multiplier = learning_rate / (sqrtf(adjustment_ub * row_counter) + eps);
+                    }
+                }
+            }
+        } else if (regularization_mode == 4) { // cow-clip (regularization_mode=4)
+            const auto clip_thresh = row_counter * std::max(weight_norm_coefficient * sqrtf(w_sum_square), lower_bound);
+            adjusted_multiplier = std::min(1.0f, clip_thresh / sqrtf(g_sum_square)) * multiplier;
+        }
+
+        at::acc_type<grad_t, true> exp_reg_correction = 1.0;
+        if (regularization_mode == 3) { // counter-based regularization (regularization_mode=3)
+            if (adjustment_enabled) {
+                if (weight_decay_mode == 2) { // Decoupled weight decay (weight_decay_mode=2)
+                    exp_reg_correction = 1.0 - freq * weight_decay * learning_rate;
+                } else if (weight_decay_mode == 1) { // L2 regularization (coupled wd)
+                    exp_reg_correction = 1.0 - freq * weight_decay * multiplier;
+                }
+            }
+        } else if (regularization_mode == 4) { // cow-clip (regularization_mode=4)
+            if (weight_decay_mode == 2) { // Decoupled weight decay (weight_decay_mode=2)
+                exp_reg_correction = 1.0 - weight_decay * learning_rate;
+            } else if (weight_decay_mode == 1) { // L2 regularization (coupled wd)
+                exp_reg_correction = 1.0 - weight_decay * adjusted_multiplier;
+            }
+        }
         for (int64_t d = 0; d < D; ++d) {
-            const auto weight = host_weights_data[embedding_begin + d];
-            host_weights_data[embedding_begin + d] = exp_reg_correction * weight - exp_reg * multiplier * grad_buffer[d];
+            host_weights_data[embedding_begin + d] = exp_reg_correction * host_weights_data[embedding_begin + d] - adjusted_multiplier * grad_buffer[d];
         }
     """
 
@@ -601,7 +663,7 @@ def rowwise_adagrad_with_counter() -> Dict[str, Any]:
         "split_weight_update": split_weight_update,
         "split_post_update": "",
         "split_weight_update_cpu": split_weight_update_cpu,
-        "has_cpu_support": False,
+        "has_cpu_support": True,
         "has_gpu_support": True,
         "has_vbe_support": True,
         "has_global_weight_decay_support": False,
@@ -838,7 +900,20 @@ def lamb() -> Dict[str, Any]:
     split_weight_update = """
       weight_new.fma_(grad, -learning_rate * true_ratio);
     """
-    split_weight_update_cpu = ""
+    split_weight_update_cpu = """
+        fbgemm::SparseLambRowUpdate(
+            D,
+            reinterpret_cast<fbgemm_weight_t*>(&host_weights_data[embedding_begin]),
+            grad_buffer,
+            &momentum1_host[momentum1_offsets_data[feature_begin] + idx * D],
+            &momentum2_host[momentum2_offsets_data[feature_begin] + idx * D],
+            learning_rate,
+            eps,
+            beta1,
+            beta2,
+            weight_decay,
+            iter);
+    """
 
     return {
         "optimizer": "lamb",
@@ -859,7 +934,7 @@ def lamb() -> Dict[str, Any]:
         "split_weight_update": split_weight_update,
         "split_post_update": "",
         "split_weight_update_cpu": split_weight_update_cpu,
-        "has_cpu_support": False,
+        "has_cpu_support": True,
         "has_gpu_support": True,
         "has_vbe_support": False,
         "has_global_weight_decay_support": False,
@@ -932,7 +1007,21 @@ def partial_rowwise_lamb() -> Dict[str, Any]:
     split_weight_update = """
       weight_new.fma_(grad, -learning_rate * true_ratio);
     """
-    split_weight_update_cpu = ""  # TODO
+    split_weight_update_cpu = """
+        fbgemm::SparseLambRowUpdate(
+            D,
+            reinterpret_cast<fbgemm_weight_t*>(&host_weights_data[embedding_begin]),
+            grad_buffer,
+            &momentum1_host[momentum1_offsets_data[feature_begin] + idx * D],
+            &momentum2_host[momentum2_offsets_data[feature_begin] + idx],
+            learning_rate,
+            eps,
+            beta1,
+            beta2,
+            weight_decay,
+            iter,
+            /*rowwise=*/true);
+    """
 
     return {
         "optimizer": "partial_rowwise_lamb",
@@ -952,7 +1041,7 @@ def partial_rowwise_lamb() -> Dict[str, Any]:
         "split_weight_update": split_weight_update,
         "split_post_update": "",
         "split_weight_update_cpu": split_weight_update_cpu,
-        "has_cpu_support": False,
+        "has_cpu_support": True,
         "has_gpu_support": True,
         "has_vbe_support": False,
         "has_global_weight_decay_support": False,
@@ -988,7 +1077,20 @@ def adam() -> Dict[str, Any]:
       weight_new.acc.z -= learning_rate * (m_t.acc.z / (1.0 - powf(beta1, iter)) / (sqrtf((v_t.acc.z / (1.0 - powf(beta2, iter)))) + eps) + weight_decay * weight_new.acc.z);
       weight_new.acc.w -= learning_rate * (m_t.acc.w / (1.0 - powf(beta1, iter)) / (sqrtf((v_t.acc.w / (1.0 - powf(beta2, iter)))) + eps) + weight_decay * weight_new.acc.w);
     """
-    split_weight_update_cpu = ""  # TODO
+    split_weight_update_cpu = """
+        fbgemm::SparseAdamRowUpdate(
+            D,
+            reinterpret_cast<fbgemm_weight_t*>(&host_weights_data[embedding_begin]),
+            grad_buffer,
+            &momentum1_host[momentum1_offsets_data[feature_begin] + idx * D],
+            &momentum2_host[momentum2_offsets_data[feature_begin] + idx * D],
+            learning_rate,
+            eps,
+            beta1,
+            beta2,
+            weight_decay,
+            iter);
+    """
 
     return {
         "optimizer": "adam",
@@ -1009,7 +1111,7 @@ def adam() -> Dict[str, Any]:
         "split_weight_update": split_weight_update,
         "split_post_update": "",
         "split_weight_update_cpu": split_weight_update_cpu,
-        "has_cpu_support": False,
+        "has_cpu_support": True,
         "has_gpu_support": True,
         "has_vbe_support": False,
         "has_global_weight_decay_support": False,
@@ -1057,7 +1159,21 @@ def partial_rowwise_adam() -> Dict[str, Any]:
       weight_new.acc.z -= learning_rate * (m_t.acc.z / (1.0 - powf(beta1, iter)) / (sqrtf(v_hat_t) + eps) + weight_decay * weight_new.acc.z);
       weight_new.acc.w -= learning_rate * (m_t.acc.w / (1.0 - powf(beta1, iter)) / (sqrtf(v_hat_t) + eps) + weight_decay * weight_new.acc.w);
     """
-    split_weight_update_cpu = ""  # TODO
+    split_weight_update_cpu = """
+        fbgemm::SparseAdamRowUpdate(
+            D,
+            reinterpret_cast<fbgemm_weight_t*>(&host_weights_data[embedding_begin]),
+            grad_buffer,
+            &momentum1_host[momentum1_offsets_data[feature_begin] + idx * D],
+            &momentum2_host[momentum2_offsets_data[feature_begin] + idx],
+            learning_rate,
+            eps,
+            beta1,
+            beta2,
+            weight_decay,
+            iter,
+            /*rowwise=*/true);
+    """
 
     return {
         "optimizer": "partial_rowwise_adam",
@@ -1085,7 +1201,7 @@ def partial_rowwise_adam() -> Dict[str, Any]:
         "split_weight_update": split_weight_update,
         "split_post_update": "",
         "split_weight_update_cpu": split_weight_update_cpu,
-        "has_cpu_support": False,
+        "has_cpu_support": True,
         "has_gpu_support": True,
         "has_vbe_support": False,
         "has_global_weight_decay_support": False,
@@ -1133,7 +1249,17 @@ def lars_sgd() -> Dict[str, Any]:
       weight_new.acc.z -= m1.acc.z;
       weight_new.acc.w -= m1.acc.w;
     """
-    split_weight_update_cpu = ""  # TODO
+    split_weight_update_cpu = """
+        fbgemm::SparseLarsSgdRowUpdate(
+            D,
+            reinterpret_cast<fbgemm_weight_t*>(&host_weights_data[embedding_begin]),
+            grad_buffer,
+            &momentum1_host[momentum1_offsets_data[feature_begin] + idx * D],
+            learning_rate,
+            eta,
+            momentum,
+            weight_decay);
+    """
 
     return {
         "optimizer": "lars_sgd",
@@ -1151,7 +1277,7 @@ def lars_sgd() -> Dict[str, Any]:
         "split_weight_update": split_weight_update,
         "split_post_update": "",
         "split_weight_update_cpu": split_weight_update_cpu,
-        "has_cpu_support": False,
+        "has_cpu_support": True,
         "has_gpu_support": True,
         "has_vbe_support": False,
         "has_global_weight_decay_support": False,
@@ -23,7 +23,10 @@
 #include <immintrin.h>
 #include <emmintrin.h>
 #endif
+#include <algorithm>
 #include <cstring>
+#include <functional>
+#include <vector>
 
 using namespace fbgemm_gpu;
 
@@ -41,6 +44,72 @@ inline uint32_t pruned_hash_function(uint32_t h) {
     return h;
 }
 
+// Chunks per thread to aim for when splitting the tables of a TBE forward.
+// More chunks balance better, fewer chunks have less per call overhead.
+constexpr int64_t kChunksPerThread = 8;
+// Don't split below this many bytes so that the kernel call overhead stays
+// small relative to the work.
+constexpr int64_t kMinChunkBytes = 32 * 1024;
+
+struct TableChunk {
+    int32_t table;
+    int64_t begin;
+    int64_t end;
+};
+
+// Splits [0, size) into ranges of about target_bytes each. cost(i) is the
+// cost of [0, i) and must be monotonic.
+template <typename CostFn>
+void split_by_cost(
+    int32_t table,
+    int64_t size,
+    int64_t target_bytes,
+    const CostFn& cost,
+    std::vector<TableChunk>& chunks) {
+    int64_t begin = 0;
+    while (begin < size) {
+        const int64_t begin_cost = cost(begin);
+        int64_t lo = begin + 1, hi = size;
+        while (lo < hi) {
+            const int64_t mid = lo + (hi - lo) / 2;
+            if (cost(mid) - begin_cost >= target_bytes) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        chunks.push_back({table, begin, lo});
+        begin = lo;
+    }
+}
+
+// Don't split the indices of a pruned lookup below this many, so that the
+// kernel call overhead stays small relative to the work.
+constexpr int64_t kMinLookupChunkIndices = 2048;
+
+// Splits the indices of every table, [offsets[t * B], offsets[(t + 1) * B]),
+// into ranges of about the same length, so that a few large tables are
+// spread over all the threads instead of one thread per table.
+std::vector<TableChunk> split_lookup_indices(
+    const int32_t* offsets,
+    int32_t T,
+    int32_t B) {
+    const int64_t chunk_indices = std::max(
+        kMinLookupChunkIndices,
+        (offsets[T * B] - offsets[0]) /
+            (at::get_num_threads() * kChunksPerThread));
+    std::vector<TableChunk> chunks;
+    for (const auto t : c10::irange(T)) {
+        const int64_t indices_end = offsets[(t + 1) * B];
+        for (int64_t begin = offsets[t * B]; begin < indices_end;
+             begin += chunk_indices) {
+            chunks.push_back(
+                {t, begin, std::min(begin + chunk_indices, indices_end)});
+        }
+    }
+    return chunks;
+}
+
 } // namespace
 
 void pruned_hashmap_insert_{{ wdesc }}_cpu(
@@ -223,6 +292,22 @@ Tensor int_nbit_split_embedding{{ "_nobag" if nobag else "" }}_codegen_forward_{
             int32_t num_indices_m_1 = indices.numel() - 1;
             int32_t D_start_ = 0;
 
+            {% if nobag %}
+            // Virtual offsets for the nobag case. Lengths are all ones, so the
+            // offsets of the index at position p are p and p + 1.
+            const auto offsets_nobag = at::arange(0, offsets_acc[T * B] + 1, offsets.options());
+            const index_t* offsets_nobag_ptr = offsets_nobag.data_ptr<index_t>();
+            {% endif %}
+
+            // A kernel per table that pools a range of its bags (its indices
+            // for nobag) and the costs to split the tables into such ranges:
+            // row_bytes per index plus bag_bytes per bag.
+            std::vector<std::function<bool(int64_t, int64_t)>> table_kernels(T);
+            std::vector<size_t> table_num_rows(T);
+            std::vector<int64_t> row_bytes(T);
+            std::vector<int64_t> bag_bytes(T);
+            int64_t total_bytes = 0;
+
             for (const auto t : c10::irange(T)) {
                 {% if not nobag %}
                 const auto* D_offsets_acc = D_offsets.data_ptr<int32_t>();
@@ -248,43 +333,33 @@ Tensor int_nbit_split_embedding{{ "_nobag" if nobag else "" }}_codegen_forward_{
                 int tt;
                 for (tt = t + 1; tt < T && weights_offsets_acc[tt] == weights_offsets_acc[t]; ++tt);
                 const size_t num_rows = ((tt == T ? weight_tensor.numel() : weights_offsets_acc[tt]) - weights_offsets_acc[t]) / D_bytes;
+                table_num_rows[t] = num_rows;
                 const index_t* offsets_begin_ptr = offsets_acc + t * B;
 
-                bool success = true;
                 const bool has_weight = {{ "true" if weighted else "false" }};
                 const bool normalize_by_lengths = static_cast<PoolingMode>(pooling_mode) == PoolingMode::MEAN;
 
                 const index_t index_size = offsets_acc[(t + 1) * B] - *offsets_begin_ptr;
                 const int32_t output_stride = {{ "total_D" if not nobag else "adjusted_D" }};
 
-                {% if nobag %}
-                // Create virtual offsets for the nobag case. Lengths are all ones.
-                const auto offsets_nobag = at::arange(*offsets_begin_ptr, offsets_acc[(t + 1) * B] + 1, offsets.options());
-                const index_t* offsets_nobag_ptr = offsets_nobag.data_ptr<index_t>();
-                TORCH_CHECK(offsets_nobag.numel() == index_size + 1);
-                TORCH_CHECK(offsets_nobag_ptr[index_size] - offsets_nobag_ptr[0] == index_size);
+                row_bytes[t] = D_bytes + sizeof(index_t) + (has_weight ? sizeof(float) : 0);
+                bag_bytes[t] = static_cast<int64_t>(D) * sizeof(output_t) + sizeof(index_t);
+                {% if not nobag %}
+                total_bytes += row_bytes[t] * index_size + bag_bytes[t] * B;
+                {% else %}
+                total_bytes += (row_bytes[t] + bag_bytes[t]) * index_size;
                 {% endif %}
 
-                const float* indice_weights_ptr = nullptr;
                 // int8 output only enabled for nobag case with ref impl
                 const bool nobag_op = {{ "false" if not nobag else "output_is_int8" }};
-                {% if weighted %}
-                indice_weights_ptr = indice_weights_acc + *offsets_begin_ptr;
-                {% endif %}
 
-                {% macro generate_and_exec_kernel(weight_type, use_base, use_nbit, use_fp8) %}
+                {% macro generate_table_kernel(weight_type, use_base, use_nbit, use_fp8) %}
                 {% set has_asmjit = use_base or use_nbit %}
                 {% set kernel_name = "GenerateEmbeddingSpMDMWithStrides"
                     if use_base else ("GenerateEmbeddingSpMDMNBitWithStrides"
                     if use_nbit else "GenerateEmbeddingSpMDMFP8WithStrides")
                  %}
                 using fbgemm_out_t = {{ "base_fbgemm_out_t" if use_base else "other_fbgemm_out_t" }};
-                // TODO: merge nobag int8 path with normal asmjit dispatch
-                {% if nobag %}
-                    const index_t* offset_ptr = (output_is_int8)? offsets_begin_ptr: offsets_nobag_ptr;
-                {% else %}
-                    const index_t* offset_ptr = offsets_begin_ptr;
-                {% endif %}
                 const auto kernel = fbgemm::{{ kernel_name }}<
                     {% if use_base %}
                     {{ weight_type }},
@@ -325,26 +400,54 @@ Tensor int_nbit_split_embedding{{ "_nobag" if nobag else "" }}_codegen_forward_{
                     {% endif %}
                     /*is_bf16_out=*/output_is_bf16
                 );
-                success = kernel(
-                    {{ "B" if not nobag else "index_size"}},
-                    index_size,
-                    num_rows,
-                    reinterpret_cast<const {{ weight_type }}*>(weights),
-                    indices_acc + *offsets_begin_ptr,
-                    offset_ptr,
-                    indice_weights_ptr,
-                    reinterpret_cast<fbgemm_out_t*>(output_acc + D_start));
+                {% if not nobag %}
+                table_kernels[t] = [=](int64_t b_begin, int64_t b_end) {
+                    const index_t* offset_ptr = offsets_begin_ptr + b_begin;
+                    return kernel(
+                        b_end - b_begin,
+                        offset_ptr[b_end - b_begin] - offset_ptr[0],
+                        num_rows,
+                        reinterpret_cast<const {{ weight_type }}*>(weights),
+                        indices_acc + offset_ptr[0],
+                        offset_ptr,
+                        {% if weighted %}
+                        indice_weights_acc + offset_ptr[0],
+                        {% else %}
+                        nullptr,
+                        {% endif %}
+                        reinterpret_cast<fbgemm_out_t*>(output_acc + D_start + b_begin * output_stride));
+                };
+                {% else %}
+                // Each index is a bag of its own. The pooling kernels read it
+                // from the virtual offsets, while the no_bag kernel (int8
+                // output) reads no offsets at all, so it gets none: the real
+                // offsets don't line up with a range of indices.
+                const index_t index_begin = *offsets_begin_ptr;
+                const index_t* const chunk_offsets_ptr =
+                    nobag_op ? nullptr : offsets_nobag_ptr + index_begin;
+                table_kernels[t] = [=](int64_t l_begin, int64_t l_end) {
+                    return kernel(
+                        l_end - l_begin,
+                        l_end - l_begin,
+                        num_rows,
+                        reinterpret_cast<const {{ weight_type }}*>(weights),
+                        indices_acc + index_begin + l_begin,
+                        chunk_offsets_ptr == nullptr ? nullptr : chunk_offsets_ptr + l_begin,
+                        nullptr,
+                        reinterpret_cast<fbgemm_out_t*>(output_acc + D_start + l_begin * output_stride));
+                };
+                {% endif %}
                 {% endmacro %}
 
                 if (weight_ty == SparseType::FP32) {
-                    {{ generate_and_exec_kernel("float", True, False, False) }}
+                    {{ generate_table_kernel("float", True, False, False) }}
                 } else if (weight_ty == SparseType::FP16) {
-                    {{ generate_and_exec_kernel("float16", True, False, False) }}
+                    {{ generate_table_kernel("float16", True, False, False) }}
                 } else if (weight_ty == SparseType::INT8) {
-                    {{ generate_and_exec_kernel("uint8_t", True, False, False) }}
+                    {{ generate_table_kernel("uint8_t", True, False, False) }}
                 } else if (weight_ty == SparseType::FP8) {
                     assert(fp8_exponent_bits > 0 && fp8_exponent_bias > 0);
-                    {{ generate_and_exec_kernel("uint8_t", False, False, True) }}
+                    {{ generate_table_kernel("uint8_t", False, False, True) }}
                 } else if (weight_ty == SparseType::INT4 || weight_ty == SparseType::INT2) {
                     int bit_rate;
                     switch (weight_ty) {
@@ -358,20 +461,51 @@ Tensor int_nbit_split_embedding{{ "_nobag" if nobag else "" }}_codegen_forward_{
                           throw std::logic_error(
                               "Unsupported SparseType: " + std::to_string(static_cast<int>(weight_ty)));
                     }
-                    {{ generate_and_exec_kernel("uint8_t", False, True, False) }}
+                    {{ generate_table_kernel("uint8_t", False, True, False) }}
                 } else {
                     throw std::logic_error(
                         "Unsupported SparseType: " + std::to_string(static_cast<int>(weight_ty)));
                 }
-                if (!success) {
+            }
+
+            // Split every table into ranges of about the same cost, so that
+            // one large table or a few tables with long bags are spread over
+            // all the threads instead of bounding the latency on one.
+            const int64_t target_bytes = std::max(
+                kMinChunkBytes,
+                total_bytes / (at::get_num_threads() * kChunksPerThread));
+            std::vector<TableChunk> chunks;
+            for (const auto t : c10::irange(T)) {
+                const index_t* offsets_begin_ptr = offsets_acc + t * B;
+                {% if not nobag %}
+                split_by_cost(t, B, target_bytes, [&](int64_t b) {
+                    return row_bytes[t] * (offsets_begin_ptr[b] - offsets_begin_ptr[0]) + bag_bytes[t] * b;
+                }, chunks);
+                {% else %}
+                split_by_cost(t, offsets_begin_ptr[B] - offsets_begin_ptr[0], target_bytes, [&](int64_t l) {
+                    return (row_bytes[t] + bag_bytes[t]) * l;
+                }, chunks);
+                {% endif %}
+            }
+
+            // Each chunk is written by one thread only
+            std::vector<uint8_t> chunk_success(chunks.size(), 1);
+            at::parallel_for(0, static_cast<int64_t>(chunks.size()), 1, [&](int64_t c_begin, int64_t c_end) {
+                for (const auto c : c10::irange(c_begin, c_end)) {
+                    const auto& chunk = chunks[c];
+                    chunk_success[c] = table_kernels[chunk.table](chunk.begin, chunk.end);
+                }
+            });
+            for (const auto c : c10::irange(chunks.size())) {
+                if (!chunk_success[c]) {
                     fbgemm_gpu::report_embedding_error(
-                        t,
+                        chunks[c].table,
                         B,
                         0,
                         B,
                         offsets_acc,
                         indices_acc,
-                        num_rows,
+                        table_num_rows[chunks[c].table],
                         /*allow_minus_one=*/true);
                 }
             }
@@ -401,45 +535,32 @@ Tensor pruned_hashmap_lookup_{{ wdesc }}_cpu(
     auto* dense_indices_acc = dense_indices.data_ptr<int32_t>();
 
     const auto* offsets_acc = offsets.data_ptr<int32_t>();
-    const auto hash_table_acc = hash_table.accessor<int32_t, 2>();
+    TORCH_CHECK(hash_table.is_contiguous());
+    const auto* hash_table_acc = hash_table.data_ptr<int32_t>();
     const auto hash_table_offsets_acc = hash_table_offsets.accessor<int64_t, 1>();
-for (const auto t : c10::irange(T)) {
-        int64_t table_start = hash_table_offsets_acc[t];
-        int64_t table_end = hash_table_offsets_acc[t + 1];
-        int64_t capacity = table_end - table_start;
-for (const auto b : c10::irange(B)) {
-            int32_t indices_start = offsets_acc[t * B + b];
-            int32_t indices_end = offsets_acc[t * B + b + 1];
-            int32_t L = indices_end - indices_start;
-
-            if (table_start == table_end) {
-for (const auto l : c10::irange(L)) {
-                    dense_indices_acc[indices_start + l] = indices_acc[indices_start + l];
-                }
-            } else {
-for (const auto l : c10::irange(L)) {
-                    int32_t idx = indices_acc[indices_start + l];
-                    uint32_t slot = pruned_hash_function(static_cast<uint32_t>(idx)) % capacity;
-                    while (true) {
-                        int32_t slot_sparse_idx = hash_table_acc[table_start + static_cast<int64_t>(slot)][0];
-
-                        // empty slot
-                        if (slot_sparse_idx == -1) {
-                            dense_indices_acc[indices_start + l] = -1;
-                            break;
-                        }
-                        // already exists
-                        if (slot_sparse_idx == idx) {
-                            dense_indices_acc[indices_start + l] = hash_table_acc[table_start + static_cast<int64_t>(slot)][1];
-                            break;
-                        }
-                        // linear probe
-                        slot = (slot + 1) % capacity;
-                    }
-                }
-            }
-        }
-    }
+    const auto chunks = split_lookup_indices(offsets_acc, T, B);
+    at::parallel_for(0, static_cast<int64_t>(chunks.size()), 1, [&](int64_t c_begin, int64_t c_end) {
+      for (const auto c : c10::irange(c_begin, c_end)) {
+          const auto& chunk = chunks[c];
+          int64_t table_start = hash_table_offsets_acc[chunk.table];
+          int64_t table_end = hash_table_offsets_acc[chunk.table + 1];
+          int64_t capacity = table_end - table_start;
+          if (capacity > 0) {
+              // SIMD hashing and probing of the chunk's indices
+              fbgemm::pruned_hashmap_lookup(
+                  indices_acc + chunk.begin,
+                  chunk.end - chunk.begin,
+                  hash_table_acc + 2 * table_start,
+                  capacity,
+                  dense_indices_acc + chunk.begin);
+          } else {
+              std::memcpy(
+                  dense_indices_acc + chunk.begin,
+                  indices_acc + chunk.begin,
+                  (chunk.end - chunk.begin) * sizeof(int32_t));
+          }
+      }
+    });
     return dense_indices;
 }
 
@@ -464,23 +585,23 @@ Tensor pruned_array_lookup_cpu(
 
     const auto index_remappings_acc = index_remappings.data_ptr<int32_t>();
     const auto index_remappings_offsets_acc = index_remappings_offsets.data_ptr<int64_t>();
-    at::parallel_for(0, T, 1, [&](int64_t begin, int64_t end) {
-      for (const auto t : c10::irange(begin, end)) {
-          int64_t index_remappings_start = index_remappings_offsets_acc[t];
-          int64_t index_remappings_end = index_remappings_offsets_acc[t + 1];
+    const auto chunks = split_lookup_indices(offsets_acc, T, B);
+    at::parallel_for(0, static_cast<int64_t>(chunks.size()), 1, [&](int64_t c_begin, int64_t c_end) {
+      for (const auto c : c10::irange(c_begin, c_end)) {
+          const auto& chunk = chunks[c];
+          int64_t index_remappings_start = index_remappings_offsets_acc[chunk.table];
+          int64_t index_remappings_end = index_remappings_offsets_acc[chunk.table + 1];
           int64_t capacity = index_remappings_end - index_remappings_start;
-          int32_t indices_start = offsets_acc[t * B];
-          int32_t indices_end = offsets_acc[(t + 1) * B];
           if (capacity > 0) {
-            for (const auto i : c10::irange(indices_start,indices_end)) {
+            for (const auto i : c10::irange(chunk.begin, chunk.end)) {
                   int32_t idx = indices_acc[i];
                   dense_indices_acc[i] = index_remappings_acc[index_remappings_start + idx];
               }
           } else {
               std::memcpy(
-                  dense_indices_acc + indices_start,
-                  indices_acc + indices_start,
-                  (indices_end - indices_start) * sizeof(int32_t));
+                  dense_indices_acc + chunk.begin,
+                  indices_acc + chunk.begin,
+                  (chunk.end - chunk.begin) * sizeof(int32_t));
           }
       }
     });
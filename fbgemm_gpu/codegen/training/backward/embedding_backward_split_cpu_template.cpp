@@ -120,7 +120,10 @@ for (const auto t : c10::irange(num_tables)) {
     constexpr bool use_fbgemm = std::is_same<scalar_t, float>::value
                                 && std::is_same<scalar_t, grad_t>::value;
     // || std::is_same<scalar_t, at::Half>::value;
-    if (use_fbgemm && !is_shared_table) {
+    // The fbgemm kernel folds L2 weight decay into the gradient, while the
+    // decoupled weight decay modes are left to the generic update below
+    if (use_fbgemm && !is_shared_table && weight_decay_mode != 2 &&
+        weight_decay_mode != 5) {
       // fbgemm handles common case of no shared table
       using fbgemm_weight_t = typename ::internal::half2float16<scalar_t>::type;
       auto spmdm_kernel = fbgemm::GenerateEmbeddingSpMDMWithStrides<
@@ -136,7 +139,11 @@ for (const auto t : c10::irange(num_tables)) {
           /*output_stride=*/-1,
           /*input_stride=*/grad_stride);
       auto rowwise_adagrad_kernel =
-          fbgemm::GenerateSparseAdaGrad</*IndexType=*/int>(D, /*rowwise=*/true);
+          fbgemm::GenerateSparseAdaGrad</*IndexType=*/int>(
+              D,
+              /*rowwise=*/true,
+              /*prefetch=*/16,
+              /*use_weight_decay=*/weight_decay_mode == 1);
 
       constexpr int C_BLOCK = 64;
       at::parallel_for(0, num_non_zero_columns, C_BLOCK, [&](int64_t c0, int64_t c1) {
@@ -178,7 +185,7 @@ for (const auto t : c10::irange(num_tables)) {
               col_segment_indices + c,
               eps,
               -learning_rate,
-              /*weight_decay=*/0,
+              /*weight_decay=*/weight_decay_mode == 1 ? weight_decay : 0,
               /*counter=*/nullptr,
               /*counter_halflife=*/0);
 
@@ -195,6 +202,10 @@ for (const auto t : c10::irange(num_tables)) {
       // no fbgemm
       // TODO: to parallelize, we should easily identify segments belong to
       // the same column.
+      {% if "fbgemm_weight_t" in split_weight_update_cpu %}
+      // The update calls an fbgemm row kernel on the aggregated gradient
+      using fbgemm_weight_t = typename ::internal::half2float16<scalar_t>::type;
+      {% endif %}
       at::acc_type<grad_t, true> grad_buffer[D];
 for (const auto c : c10::irange(num_non_zero_columns)) {
         int64_t idx = col_segment_indices[c];
@@ -403,9 +414,9 @@ for (const auto d : c10::irange(D)) {
 
 TORCH_LIBRARY_FRAGMENT(fbgemm, m) {
   {% if not dense %}
-  m.def("split_embedding_backward_codegen_{{ optimizer }}_cpu(Tensor grad_output, Tensor(a!) host_weights, Tensor weights_placements, Tensor weights_offsets, Tensor D_offsets, int max_D, Tensor hash_size_cumsum, int total_hash_size_bits, Tensor indices, Tensor offsets,int pooling_mode, Tensor indice_weights, bool stochastic_rounding, {{ (args.split_function_args | join(", ")).replace("double", "float").replace("int64_t", "int").replace("Tensor momentum1_host", "Tensor(b!) momentum1_host")}}, int output_dtype = 0) -> ()");
+  m.def("split_embedding_backward_codegen_{{ optimizer }}_cpu(Tensor grad_output, Tensor(a!) host_weights, Tensor weights_placements, Tensor weights_offsets, Tensor D_offsets, int max_D, Tensor hash_size_cumsum, int total_hash_size_bits, Tensor indices, Tensor offsets,int pooling_mode, Tensor indice_weights, bool stochastic_rounding, {{ (args.split_function_args | join(", ")).replace("double", "float").replace("int64_t", "int").replace("Tensor momentum1_host", "Tensor(b!) momentum1_host").replace("Tensor momentum2_host", "Tensor(c!) momentum2_host").replace("Tensor prev_iter_host", "Tensor(d!) prev_iter_host").replace("Tensor row_counter_host", "Tensor(e!) row_counter_host")}}, int output_dtype = 0) -> ()");
   {% else %}
-  m.def("split_embedding_backward_codegen_{{ optimizer }}_cpu(Tensor grad_output, Tensor(a!) host_weights, Tensor weights_offsets, Tensor D_offsets, int max_D, Tensor hash_size_cumsum, int total_hash_size_bits, Tensor indices, Tensor offsets,int pooling_mode, Tensor indice_weights, {{ (args.split_function_args | join(", ")).replace("double", "float").replace("int64_t", "int").replace("Tensor momentum1_host", "Tensor(b!) momentum1_host")}}) -> Tensor");
+  m.def("split_embedding_backward_codegen_{{ optimizer }}_cpu(Tensor grad_output, Tensor(a!) host_weights, Tensor weights_offsets, Tensor D_offsets, int max_D, Tensor hash_size_cumsum, int total_hash_size_bits, Tensor indices, Tensor offsets,int pooling_mode, Tensor indice_weights, {{ (args.split_function_args | join(", ")).replace("double", "float").replace("int64_t", "int").replace("Tensor momentum1_host", "Tensor(b!) momentum1_host").replace("Tensor momentum2_host", "Tensor(c!) momentum2_host").replace("Tensor prev_iter_host", "Tensor(d!) prev_iter_host").replace("Tensor row_counter_host", "Tensor(e!) row_counter_host")}}) -> Tensor");
   {% endif %}
   DISPATCH_TO_CPU("split_embedding_backward_codegen_{{ optimizer }}_cpu", split_embedding_backward_codegen_{{ optimizer }}_cpu);
 }
@@ -76,25 +76,62 @@ void split_embedding_forward_cpu_kernel(
       std::is_same<output_t, float>::value &&
       std::is_same<ind_weights_t, float>::value;
 
+  using fbgemm_weight_t = typename std::conditional<
+      std::is_same<weights_t, at::Half>::value,
+      fbgemm::float16,
+      weights_t>::type;
+
+  const auto get_hash_size = [&](int64_t t) {
+    int64_t hash_size;
+    int64_t t_temp = t + 1;
+    do {
+      hash_size = hash_size_cumsum_data[t_temp] - hash_size_cumsum_data[t];
+      ++t_temp;
+    } while (hash_size == 0);
+    return hash_size;
+  };
+
+  if (use_fbgemm) {
+    // Schedule the bags of all the tables together so that the tables with
+    // large pooling factors are spread over all the threads.
+    std::vector<
+        fbgemm::EmbeddingSpMDMTableArgs<fbgemm_weight_t, int64_t, int64_t>>
+        tables(T);
+    for (const auto t : c10::irange(T)) {
+      auto& table = tables[t];
+      table.block_size = D_offsets_data[t + 1] - D_offsets_data[t];
+      table.output_size = B;
+      table.data_size = get_hash_size(t);
+      table.input = reinterpret_cast<const fbgemm_weight_t*>(
+          weights_data + weights_offsets_data[t]);
+      table.indices = indices_data;
+      table.offsets = offsets_data + t * B;
+      table.weights = indice_weights.defined()
+          ? reinterpret_cast<const float*>(indice_weights_data)
+          : nullptr;
+      table.out = reinterpret_cast<float*>(output_data + D_offsets_data[t]);
+      table.output_stride = output_stride;
+    }
+    if (fbgemm::EmbeddingSpMDMGrouped(
+            tables.data(),
+            T,
+            static_cast<PoolingMode>(pooling_mode) == PoolingMode::MEAN,
+            /*prefetch=*/16,
+            at::get_num_threads())) {
+      return;
+    }
+    // Fall through to find and report the out of bound index.
+  }
+
   at::parallel_for(0, B, 0, [&](int64_t b_begin, int64_t b_end) {
     for (const auto t : c10::irange(T)) {
       const auto D_begin = D_offsets_data[t];
       const auto D = D_offsets_data[t + 1] - D_offsets_data[t];
       const auto table_begin = weights_offsets_data[t];
-
-      int64_t hash_size;
-      int t_temp = t + 1;
-      do {
-        hash_size = hash_size_cumsum_data[t_temp] - hash_size_cumsum_data[t];
-        ++t_temp;
-      } while (hash_size == 0);
+      const auto hash_size = get_hash_size(t);
 
       bool success = true;
       if (use_fbgemm) {
-        using fbgemm_weight_t = typename std::conditional<
-            std::is_same<weights_t, at::Half>::value,
-            fbgemm::float16,
-            weights_t>::type;
         auto kernel = fbgemm::GenerateEmbeddingSpMDMWithStrides<
             fbgemm_weight_t,
             /*IndexType=*/int64_t,
@@ -403,8 +440,6 @@ void csr2csc_template_(
       fbgemm::fbgemmAlignedAlloc(64, NS * sizeof(value_t)));
   int* tmpBuf1Keys =
       static_cast<int*>(fbgemm::fbgemmAlignedAlloc(64, NS * sizeof(int)));
-  value_t* tmpBuf1Values = static_cast<value_t*>(
-      fbgemm::fbgemmAlignedAlloc(64, NS * sizeof(value_t)));
 
   const auto FBo = csr_offsets[table_to_feature_offset[0] * B];
   for (int feature = table_to_feature_offset[0];
@@ -435,92 +470,51 @@ void csr2csc_template_(
     }
   }
 
-  int* sorted_col_row_index_keys;
-  value_t* sorted_col_row_index_values;
-  std::tie(sorted_col_row_index_keys, sorted_col_row_index_values) =
-      fbgemm::radix_sort_parallel(
-          tmpBufKeys,
-          tmpBufValues,
-          tmpBuf1Keys,
-          tmpBuf1Values,
-          NS,
-          num_embeddings);
-
-  int max_thds = omp_get_max_threads();
-  int num_uniq[max_thds][64];
-  for (const auto i : c10::irange(max_thds)) {
-    num_uniq[i][0] = 0;
-  }
-
-  int U = 0;
-  if (at::get_num_threads() > 1) {
-    // This block is not needed for single thread
-#pragma omp parallel
-    {
-      int tid = omp_get_thread_num();
-      num_uniq[tid][0] = 0;
-#pragma omp for schedule(static)
-      for (int i = 1; i < NS; i++) {
-        if (sorted_col_row_index_keys[i] != sorted_col_row_index_keys[i - 1]) {
-          num_uniq[tid][0]++;
-        }
-      }
-    }
-    num_uniq[0][0] += 1;
-    for (const auto i : c10::irange(1, max_thds)) {
-      num_uniq[i][0] += num_uniq[i - 1][0];
-    }
-    U = num_uniq[max_thds - 1][0];
-  }
-
+  // Columns are the unique indices, and the (stable) sorted positions tell
+  // which rows and weights belong to each column.
   csc.column_segment_ptr =
       static_cast<int*>(fbgemm::fbgemmAlignedAlloc(64, (NS + 1) * sizeof(int)));
   csc.column_segment_indices =
       static_cast<int*>(fbgemm::fbgemmAlignedAlloc(64, NS * sizeof(int)));
+  int* sorted_positions = tmpBuf1Keys;
+  const int U = fbgemm::unique_parallel<int, int>(
+      tmpBufKeys,
+      NS,
+      num_embeddings,
+      csc.column_segment_indices,
+      /*inverse=*/nullptr,
+      /*counts=*/csc.column_segment_ptr + 1,
+      sorted_positions);
+
   csc.column_segment_ptr[0] = 0;
-  const pair_t* sorted_col_row_index_values_pair =
-      reinterpret_cast<const pair_t*>(sorted_col_row_index_values);
-  const int* sorted_col_row_index_values_int =
-      reinterpret_cast<const int*>(sorted_col_row_index_values);
-  if (IS_VALUE_PAIR) {
-    csc.row_indices[0] = sorted_col_row_index_values_pair[0].first % B;
-    csc.weights[0] = sorted_col_row_index_values_pair[0].second;
-    csc.column_segment_ids[0] = sorted_col_row_index_values_pair[0].first / B;
-  } else {
-    csc.row_indices[0] = sorted_col_row_index_values_int[0] % B;
-    csc.column_segment_ids[0] = sorted_col_row_index_values_int[0] / B;
+  for (const auto u : c10::irange(U)) {
+    csc.column_segment_ptr[u + 1] += csc.column_segment_ptr[u];
   }
-  csc.column_segment_indices[0] = sorted_col_row_index_keys[0];
+
+  const pair_t* col_row_index_values_pair =
+      reinterpret_cast<const pair_t*>(tmpBufValues);
+  const int* col_row_index_values_int =
+      reinterpret_cast<const int*>(tmpBufValues);
 
 #pragma omp parallel
   {
-    int tid = omp_get_thread_num();
-    int* tstart =
-        (tid == 0 ? csc.column_segment_indices + 1
-                  : csc.column_segment_indices + num_uniq[tid - 1][0]);
-
-    int* t_offs =
-        (tid == 0 ? csc.column_segment_ptr + 1
-                  : csc.column_segment_ptr + num_uniq[tid - 1][0]);
-
     if (!IS_VALUE_PAIR && !is_shared_table) {
-      // For non shared table, no need for computing modulo.
-      // As an optimization, pointer swap instead of copying.
-#pragma omp master
-      std::swap(
-          csc.row_indices,
-          *reinterpret_cast<int**>(
-              sorted_col_row_index_values == tmpBufValues ? &tmpBufValues
-                                                          : &tmpBuf1Values));
+      // For non shared table, no need for computing modulo, and
+      // column_segment_ids are not read.
+#pragma omp for schedule(static)
+      for (int i = 0; i < NS; ++i) {
+        csc.row_indices[i] = col_row_index_values_int[sorted_positions[i]];
+      }
     } else {
 #ifdef FBCODE_CAFFE2
       libdivide::divider<int> divisor(B);
 #endif
 
 #pragma omp for schedule(static)
-      for (int i = 1; i < NS; ++i) {
-        int v = IS_VALUE_PAIR ? sorted_col_row_index_values_pair[i].first
-                              : sorted_col_row_index_values_int[i];
+      for (int i = 0; i < NS; ++i) {
+        const int p = sorted_positions[i];
+        int v = IS_VALUE_PAIR ? col_row_index_values_pair[p].first
+                              : col_row_index_values_int[p];
 #ifdef FBCODE_CAFFE2
         int q = v / divisor;
 #else
@@ -529,36 +523,18 @@ void csr2csc_template_(
         csc.column_segment_ids[i] = q;
         csc.row_indices[i] = v - q * B;
         if (IS_VALUE_PAIR) {
-          csc.weights[i] = sorted_col_row_index_values_pair[i].second;
+          csc.weights[i] = col_row_index_values_pair[p].second;
         }
       }
     }
-
-#pragma omp for schedule(static)
-    for (int i = 1; i < NS; ++i) {
-      if (sorted_col_row_index_keys[i] != sorted_col_row_index_keys[i - 1]) {
-        *tstart = sorted_col_row_index_keys[i];
-        *t_offs = i;
-        tstart++;
-        t_offs++;
-      }
-    }
-
-    if (at::get_num_threads() == 1 && tid == 0) {
-      // Special handling of single thread case
-      U = t_offs - csc.column_segment_ptr;
-    }
-
   } // omp parallel
 
   csc.num_non_zero_columns = U;
-  csc.column_segment_ptr[U] = NS;
   column_ptr_curr += NS;
 
   fbgemm::fbgemmAlignedFree(tmpBufKeys);
   fbgemm::fbgemmAlignedFree(tmpBufValues);
   fbgemm::fbgemmAlignedFree(tmpBuf1Keys);
-  fbgemm::fbgemmAlignedFree(tmpBuf1Values);
 
   assert(column_ptr_curr == nnz);
 }
@@ -743,10 +743,18 @@ class SplitTableBatchedEmbeddingBagsCodegen(nn.Module):
         if self.use_cpu:
             # Construct optimizer states
             assert optimizer in (
+                OptimType.ADAM,
                 OptimType.EXACT_ADAGRAD,
                 OptimType.EXACT_ROWWISE_ADAGRAD,
                 OptimType.EXACT_SGD,
+                OptimType.LAMB,
+                OptimType.LARS_SGD,
+                OptimType.PARTIAL_ROWWISE_ADAM,
+                OptimType.PARTIAL_ROWWISE_LAMB,
             ), f"Optimizer {optimizer} is not supported in CPU mode."
+            assert optimizer_state_dtypes is None or all(
+                dtype == SparseType.FP32 for dtype in optimizer_state_dtypes.values()
+            ), "Only FP32 optimizer states are supported in CPU mode."
         else:
             assert optimizer in (
                 OptimType.ADAM,
@@ -1450,9 +1458,12 @@ class SplitTableBatchedEmbeddingBagsCodegen(nn.Module):
                 self._max_counter_update_freq > 0
                 and self.iter.item() % self._max_counter_update_freq == 0
             ):
-                row_counter_dev = self.row_counter_dev.detach()
-                if row_counter_dev.numel() > 0:
-                    self.max_counter[0] = torch.max(row_counter_dev).cpu().item() + 1
+                # The counters are only kept in the host tensor on CPU
+                row_counter = (
+                    self.row_counter_host if self.use_cpu else self.row_counter_dev
+                ).detach()
+                if row_counter.numel() > 0:
+                    self.max_counter[0] = torch.max(row_counter).cpu().item() + 1
                 else:
                     self.max_counter[0] = 1
 
@@ -13,6 +13,7 @@
 #include <torch/library.h>
 #include "ATen/Parallel.h"
 
+#include "fbgemm/Utils.h"
 #include "fbgemm_gpu/dispatch_macros.h"
 #include "fbgemm_gpu/sparse_ops.h"
 #include "fbgemm_gpu/sparse_ops_utils.h"
@@ -1589,6 +1590,119 @@ Tensor jagged_slice_forward_cpu(
   return output_values;
 }
 
+/// Deduplicate the indices of every table (jagged_unique_indices). The
+/// indices are linearized with hash_size_cumsum so that one parallel unique
+/// handles all tables at once.
+/// @param hash_size_cumsum - cumulative hash sizes of the T tables
+/// @param hash_size_offsets - groups of tables whose output lengths are
+///                            distributed together
+/// @param offsets - offsets of the T * B bags in indices
+/// @param indices - the indices to deduplicate
+/// @return output lengths and offsets per bag, the unique (delinearized)
+///         indices, and the position of every index in the unique indices
+std::tuple<Tensor, Tensor, Tensor, Tensor> jagged_unique_indices_cpu(
+    const Tensor& hash_size_cumsum,
+    const Tensor& hash_size_offsets,
+    const Tensor& offsets,
+    const Tensor& indices) {
+  TENSOR_ON_CPU(hash_size_cumsum);
+  TENSOR_ON_CPU(hash_size_offsets);
+  TENSOR_ON_CPU(offsets);
+  TENSOR_ON_CPU(indices);
+
+  const auto total_B = offsets.size(0) - 1;
+  const auto T = hash_size_cumsum.size(0) - 1;
+  TORCH_CHECK(T > 0, "hash_size_cumsum must describe at least one table");
+  const auto B = total_B / T;
+  const auto num_indices = indices.numel();
+
+  const auto hash_size_cumsum_contig = hash_size_cumsum.contiguous();
+  const auto hash_size_offsets_contig = hash_size_offsets.contiguous();
+  const auto offsets_contig = offsets.contiguous();
+  const auto indices_contig = indices.contiguous();
+
+  Tensor linear_indices = at::empty_like(indices_contig);
+  Tensor linear_unique_indices = at::empty_like(indices_contig);
+  Tensor reverse_index = at::empty_like(indices_contig);
+  Tensor unique_indices;
+  Tensor output_lengths = at::zeros({total_B}, offsets.options());
+
+  AT_DISPATCH_INDEX_TYPES(
+      indices.scalar_type(), "jagged_unique_indices_cpu", [&] {
+        const auto* hash_size_cumsum_data =
+            hash_size_cumsum_contig.data_ptr<index_t>();
+        const auto* hash_size_offsets_data =
+            hash_size_offsets_contig.data_ptr<index_t>();
+        const auto* offsets_data = offsets_contig.data_ptr<index_t>();
+        const auto* indices_data = indices_contig.data_ptr<index_t>();
+        auto* linear_indices_data = linear_indices.data_ptr<index_t>();
+        auto* linear_unique_data = linear_unique_indices.data_ptr<index_t>();
+        auto* reverse_index_data = reverse_index.data_ptr<index_t>();
+
+        at::parallel_for(0, total_B, 1, [&](int64_t begin, int64_t end) {
+          for (const auto b_t : c10::irange(begin, end)) {
+            const auto hash_offset = hash_size_cumsum_data[b_t / B];
+            for (auto i = offsets_data[b_t]; i < offsets_data[b_t + 1]; ++i) {
+              linear_indices_data[i] = hash_offset + indices_data[i];
+            }
+          }
+        });
+
+        const auto num_unique = fbgemm::unique_parallel<index_t, index_t>(
+            linear_indices_data,
+            num_indices,
+            hash_size_cumsum_data[T],
+            linear_unique_data,
+            reverse_index_data,
+            /*counts=*/nullptr);
+
+        // Delinearize with the table that every unique index falls into
+        unique_indices = at::empty({num_unique}, indices.options());
+        auto* unique_data = unique_indices.data_ptr<index_t>();
+        at::parallel_for(0, num_unique, 1024, [&](int64_t begin, int64_t end) {
+          for (const auto u : c10::irange(begin, end)) {
+            const auto linear_index = linear_unique_data[u];
+            const auto t = std::upper_bound(
+                               hash_size_cumsum_data,
+                               hash_size_cumsum_data + T + 1,
+                               linear_index) -
+                hash_size_cumsum_data - 1;
+            unique_data[u] = linear_index - hash_size_cumsum_data[t];
+          }
+        });
+
+        // The unique indices of the tables in [hash_size_offsets[t],
+        // hash_size_offsets[t + 1]) are spread evenly over their bags, like
+        // in the CUDA kernel
+        auto* lengths_data = output_lengths.data_ptr<index_t>();
+        at::parallel_for(0, T, 1, [&](int64_t begin, int64_t end) {
+          for (const auto t : c10::irange(begin, end)) {
+            const auto offset_begin = hash_size_offsets_data[t] * B;
+            const auto offset_end = hash_size_offsets_data[t + 1] * B;
+            const auto reverse_begin = offsets_data[offset_begin];
+            const auto reverse_end = offsets_data[offset_end];
+            if (reverse_begin == reverse_end) {
+              continue;
+            }
+            const auto [min_it, max_it] = std::minmax_element(
+                reverse_index_data + reverse_begin,
+                reverse_index_data + reverse_end);
+            const index_t total_length = *max_it - *min_it + 1;
+            const index_t num_lengths = offset_end - offset_begin;
+            const index_t div_length = total_length / num_lengths;
+            const index_t r_length = total_length % num_lengths;
+            for (const auto i : c10::irange(num_lengths)) {
+              lengths_data[offset_begin + i] =
+                  i < r_length ? div_length + 1 : div_length;
+            }
+          }
+        });
+      });
+
+  Tensor output_offsets = asynchronous_complete_cumsum_cpu(output_lengths);
+  return {output_lengths, output_offsets, unique_indices, reverse_index};
+}
+
 } // namespace fbgemm_gpu
 
 TORCH_LIBRARY_FRAGMENT(fbgemm, m) {
@@ -1798,6 +1912,8 @@ TORCH_LIBRARY_IMPL(fbgemm, CPU, m) {
   DISPATCH_TO_CPU(
       "jagged_dense_bmm_forward", fbgemm_gpu::jagged_dense_bmm_forward);
   DISPATCH_TO_CPU("jagged_slice_forward", fbgemm_gpu::jagged_slice_forward_cpu);
+  DISPATCH_TO_CPU(
+      "jagged_unique_indices", fbgemm_gpu::jagged_unique_indices_cpu);
 }
 
 TORCH_LIBRARY_IMPL(fbgemm, CompositeExplicitAutograd, m) {
@@ -37,8 +37,6 @@ using Tensor = at::Tensor;
 namespace {
 
 constexpr size_t kCacheMaxThreads = 512;
-constexpr int32_t kCacheLocationMissing = -1;
-constexpr int64_t kCacheStateInvalid = -1;
 
 constexpr int32_t kCacheSetBits = 24;
 constexpr int32_t kLFUCounterBits = 40;
@@ -12,6 +12,8 @@
 #include <ATen/AccumulateType.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/core/TensorAccessor.h>
+#include <c10/util/irange.h>
+#include <cstring>
 #include <limits>
 #include <mutex>
 
@@ -23,6 +25,19 @@
 
 using Tensor = at::Tensor;
 
+namespace {
+
+constexpr int32_t kCacheLocationMissing = -1;
+constexpr int64_t kCacheStateInvalid = -1;
+
+// Indices per task of the parallel CPU cache lookups
+constexpr int64_t kCacheLookupGrainSize = 4096;
+
+// Cache sets per task of the parallel CPU cache inserts
+constexpr int64_t kCacheInsertGrainSize = 64;
+
+} // namespace
+
 namespace fbgemm_gpu {
 
 Tensor linearize_cache_indices_cpu(
@@ -38,6 +53,18 @@ Tensor linearize_cache_indices_from_row_idx_cpu(
     Tensor update_table_indices,
     Tensor update_row_indices);
 
+std::tuple<Tensor, Tensor, std::optional<Tensor>> get_unique_indices_cpu(
+    const Tensor& linear_indices,
+    const int64_t max_indices,
+    const bool compute_count);
+
+std::tuple<Tensor, Tensor, std::optional<Tensor>, std::optional<Tensor>>
+get_unique_indices_with_inverse_cpu(
+    const Tensor& linear_indices,
+    const int64_t max_indices,
+    const bool compute_count,
+    const bool compute_inverse_indices);
+
 void lru_cache_populate_byte_cpu(
     Tensor weights,
     Tensor cache_hash_size_cumsum,
@@ -103,4 +130,68 @@ Tensor direct_mapped_lxu_cache_lookup_cpu(
     bool gather_cache_stats,
     std::optional<Tensor> uvm_cache_stats);
 
+void lxu_cache_locking_counter_decrement_cpu(
+    Tensor lxu_cache_locking_counter,
+    Tensor lxu_cache_locations);
+
+void lxu_cache_locations_update_cpu(
+    Tensor lxu_cache_locations,
+    Tensor lxu_cache_locations_new,
+    std::optional<Tensor> num_uniq_cache_indices);
+
+// Copies rows from the byte weights of their tables into the rows of the
+// populate_byte caches.
+class LxuCacheRowInserter {
+ public:
+  LxuCacheRowInserter(
+      const Tensor& weights,
+      const Tensor& cache_hash_size_cumsum,
+      const Tensor& cache_index_table_map,
+      const Tensor& weights_offsets,
+      const Tensor& weights_tys,
+      const Tensor& D_offsets,
+      const Tensor& lxu_cache_weights,
+      const int64_t row_alignment)
+      : weights_(weights.contiguous()),
+        cache_hash_size_cumsum_(cache_hash_size_cumsum.contiguous()),
+        cache_index_table_map_(cache_index_table_map.contiguous()),
+        weights_offsets_(weights_offsets.contiguous()),
+        weights_tys_(weights_tys.contiguous()),
+        D_offsets_(D_offsets.contiguous()),
+        cache_weights_(lxu_cache_weights.data_ptr<uint8_t>()),
+        cache_row_bytes_(lxu_cache_weights.size(1)),
+        row_alignment_(row_alignment) {
+    TORCH_CHECK(lxu_cache_weights.is_contiguous());
+  }
+
+  void insert(const int64_t linear_cache_index, const int64_t cache_loc)
+      const {
+    const int32_t t =
+        cache_index_table_map_.data_ptr<int32_t>()[linear_cache_index];
+    const auto weight_ty =
+        static_cast<SparseType>(weights_tys_.data_ptr<uint8_t>()[t]);
+    const int64_t idx = linear_cache_index -
+        cache_hash_size_cumsum_.data_ptr<int64_t>()[t];
+    const auto* D_offsets = D_offsets_.data_ptr<int32_t>();
+    const int32_t D_bytes = nbit::padded_row_size_in_bytes(
+        D_offsets[t + 1] - D_offsets[t], weight_ty, row_alignment_);
+    std::memcpy(
+        cache_weights_ + cache_loc * cache_row_bytes_,
+        weights_.data_ptr<uint8_t>() +
+            weights_offsets_.data_ptr<int64_t>()[t] + idx * D_bytes,
+        D_bytes);
+  }
+
+ private:
+  const Tensor weights_;
+  const Tensor cache_hash_size_cumsum_;
+  const Tensor cache_index_table_map_;
+  const Tensor weights_offsets_;
+  const Tensor weights_tys_;
+  const Tensor D_offsets_;
+  uint8_t* const cache_weights_;
+  const int64_t cache_row_bytes_;
+  const int64_t row_alignment_;
+};
+
 } // namespace fbgemm_gpu
@@ -6,7 +6,14 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <ATen/Parallel.h>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
 #include "common.h"
+#include "fbgemm/FbgemmEmbedding.h"
 
 using Tensor = at::Tensor;
 using namespace fbgemm_gpu;
@@ -26,7 +33,124 @@ DLL_PUBLIC void lfu_cache_populate_byte_cpu(
     Tensor lxu_cache_weights,
     Tensor lfu_state,
     int64_t row_alignment) {
-  return;
+  TENSORS_ON_SAME_DEVICE(weights, linear_cache_indices);
+  TENSOR_ON_CPU(weights);
+  TENSOR_ON_CPU(lxu_cache_state);
+  TENSOR_ON_CPU(lxu_cache_weights);
+  TENSOR_ON_CPU(lfu_state);
+  TORCH_CHECK(lxu_cache_state.is_contiguous());
+  TORCH_CHECK(lfu_state.is_contiguous());
+
+  TORCH_CHECK(
+      linear_cache_indices.numel() < std::numeric_limits<int32_t>::max());
+  if (linear_cache_indices.numel() == 0 || lxu_cache_state.numel() == 0) {
+    // nothing to do
+    return;
+  }
+
+  // Get unique indices
+  Tensor unique_indices, unique_indices_length;
+  std::optional<Tensor> unique_indices_count;
+  std::tie(unique_indices, unique_indices_length, unique_indices_count) =
+      get_unique_indices_cpu(
+          linear_cache_indices,
+          total_cache_hash_size,
+          /*compute_count=*/true);
+  const int32_t N_unique = unique_indices_length.data_ptr<int32_t>()[0];
+
+  const auto lxu_cache_locations = lxu_cache_lookup_cpu(
+      unique_indices,
+      lxu_cache_state,
+      total_cache_hash_size,
+      /*gather_cache_stats=*/false,
+      /*uvm_cache_stats=*/std::nullopt,
+      /*num_uniq_cache_indices=*/unique_indices_length,
+      /*lxu_cache_locations_output=*/std::nullopt);
+  const auto* locations = lxu_cache_locations.data_ptr<int32_t>();
+  const auto* counts = unique_indices_count->data_ptr<int32_t>();
+  auto* lfu = lfu_state.data_ptr<int64_t>();
+  auto* state = lxu_cache_state.data_ptr<int64_t>();
+  const int32_t C = lxu_cache_state.size(0);
+  const int32_t ways = lxu_cache_state.size(1);
+
+  // Update the LFU counts, and collect the uncached indices as (cache set,
+  // LFU count, index)
+  std::vector<std::tuple<int32_t, int64_t, int64_t>> misses;
+  AT_DISPATCH_INDEX_TYPES(
+      unique_indices.scalar_type(), "lfu_cache_find_uncached_cpu", [&] {
+        const auto* indices = unique_indices.data_ptr<index_t>();
+        for (const auto n : c10::irange(N_unique)) {
+          const int64_t idx = indices[n];
+          lfu[idx] += counts[n];
+          if (locations[n] < 0 && idx != total_cache_hash_size) {
+            misses.emplace_back(fbgemm::lxu_cache_slot(idx, C), lfu[idx], idx);
+          }
+        }
+      });
+
+  // Sort so the highest LFU counts come first in the segment of each set
+  std::stable_sort(
+      misses.begin(), misses.end(), [](const auto& a, const auto& b) {
+        return std::get<0>(a) != std::get<0>(b)
+            ? std::get<0>(a) < std::get<0>(b)
+            : std::get<1>(a) > std::get<1>(b);
+      });
+  std::vector<int64_t> set_starts;
+  for (const auto i : c10::irange(misses.size())) {
+    if (i == 0 || std::get<0>(misses[i]) != std::get<0>(misses[i - 1])) {
+      set_starts.push_back(i);
+    }
+  }
+  set_starts.push_back(misses.size());
+
+  // Replace the least frequently used ways of each set while the incoming
+  // index is used at least as often
+  const LxuCacheRowInserter inserter(
+      weights,
+      cache_hash_size_cumsum,
+      cache_index_table_map,
+      weights_offsets,
+      weights_tys,
+      D_offsets,
+      lxu_cache_weights,
+      row_alignment);
+  at::parallel_for(
+      0,
+      set_starts.size() - 1,
+      kCacheInsertGrainSize,
+      [&](int64_t begin, int64_t end) {
+        std::vector<int32_t> slots(ways);
+        std::vector<int64_t> costs(ways);
+        for (const auto s : c10::irange(begin, end)) {
+          const int64_t start = set_starts[s];
+          const int64_t SL = set_starts[s + 1] - start;
+          const int32_t cache_set = std::get<0>(misses[start]);
+          auto* set_state = state + static_cast<int64_t>(cache_set) * ways;
+          for (const auto w : c10::irange(ways)) {
+            costs[w] = set_state[w] != kCacheStateInvalid ? lfu[set_state[w]]
+                                                          : -1;
+          }
+          std::iota(slots.begin(), slots.end(), 0);
+          std::stable_sort(slots.begin(), slots.end(), [&](auto a, auto b) {
+            return costs[a] < costs[b];
+          });
+
+          for (int64_t l = 0; l < std::min<int64_t>(SL, ways); ++l) {
+            const int32_t insert_slot = slots[l];
+            const int64_t insert_lfu_cost = std::get<1>(misses[start + l]);
+            const int64_t insert_idx = std::get<2>(misses[start + l]);
+            if (costs[insert_slot] > insert_lfu_cost) {
+              // All the remaining ways are used more often, and all the
+              // remaining indices less often
+              break;
+            }
+            inserter.insert(
+                insert_idx,
+                static_cast<int64_t>(cache_set) * ways + insert_slot);
+            set_state[insert_slot] = insert_idx;
+          }
+        }
+      });
 }
 
 } // namespace fbgemm_gpu
@@ -6,27 +6,207 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <ATen/Parallel.h>
+#include <algorithm>
+
 #include "common.h"
 
+#include "fbgemm/Utils.h"
+
 using Tensor = at::Tensor;
 
 namespace fbgemm_gpu {
 
 DLL_PUBLIC Tensor linearize_cache_indices_cpu(
-    const Tensor& /*cache_hash_size_cumsum*/,
+    const Tensor& cache_hash_size_cumsum,
     const Tensor& indices,
-    const Tensor& /*offsets*/,
-    const std::optional<Tensor>& /*B_offsets*/,
-    const int64_t /*max_B*/,
-    const int64_t /*indices_base_offset*/) {
-  return at::empty_like(indices);
+    const Tensor& offsets,
+    const std::optional<Tensor>& B_offsets,
+    const int64_t max_B,
+    const int64_t indices_base_offset) {
+  TENSOR_ON_CPU(cache_hash_size_cumsum);
+  TENSOR_ON_CPU(indices);
+  TENSOR_ON_CPU(offsets);
+
+  const auto T = cache_hash_size_cumsum.size(0) - 1;
+  TORCH_CHECK(T > 0);
+  const int64_t total_B = offsets.size(0) - 1;
+  const auto num_indices = indices.numel();
+
+  auto linear_cache_indices =
+      at::empty(indices.sizes(), indices.options().dtype(at::kLong));
+  if (total_B == 0 || num_indices == 0) {
+    return linear_cache_indices;
+  }
+
+  Tensor table_offsets;
+  if (B_offsets.has_value()) {
+    TORCH_CHECK(max_B >= 0, "Invalid max_B ", max_B, ". max_B must be >= 0");
+    table_offsets =
+        at::index_select(offsets, 0, B_offsets.value().slice(0, 1, T, 1));
+  } else {
+    const auto B = total_B / T;
+    TORCH_CHECK(
+        B >= 0,
+        "Invalid B ",
+        B,
+        ". Please check the size of offsets and cache_hash_size_cumsum.");
+    table_offsets = offsets.slice(0, B, B * T, B);
+  }
+  table_offsets = table_offsets.contiguous();
+  const auto cumsum = cache_hash_size_cumsum.contiguous();
+  const auto* cumsum_ptr = cumsum.data_ptr<int64_t>();
+  const auto max_offset = cumsum_ptr[T];
+  const auto indices_contig = indices.contiguous();
+  auto* linear_ptr = linear_cache_indices.data_ptr<int64_t>();
+
+  AT_DISPATCH_INDEX_TYPES(
+      table_offsets.scalar_type(), "linearize_cache_indices_cpu_1", [&] {
+        using offset_t = index_t;
+        const auto* table_offsets_ptr = table_offsets.data_ptr<offset_t>();
+        const int64_t num_table_offsets = table_offsets.numel();
+        AT_DISPATCH_INDEX_TYPES(
+            indices.scalar_type(), "linearize_cache_indices_cpu_2", [&] {
+              const auto* indices_ptr = indices_contig.data_ptr<index_t>();
+              at::parallel_for(
+                  0,
+                  num_indices,
+                  kCacheLookupGrainSize,
+                  [&](int64_t begin, int64_t end) {
+                    // Indices are laid out table by table, so find the table
+                    // of the first index and walk forward from there
+                    int64_t t = std::upper_bound(
+                                    table_offsets_ptr,
+                                    table_offsets_ptr + num_table_offsets,
+                                    begin + indices_base_offset) -
+                        table_offsets_ptr;
+                    for (const auto i : c10::irange(begin, end)) {
+                      while (t < num_table_offsets &&
+                             table_offsets_ptr[t] <= i + indices_base_offset) {
+                        ++t;
+                      }
+                      const auto curr_offset = cumsum_ptr[t];
+                      linear_ptr[i] = curr_offset >= 0 && indices_ptr[i] >= 0
+                          ? indices_ptr[i] + curr_offset
+                          : max_offset;
+                    }
+                  });
+            });
+      });
+  return linear_cache_indices;
 }
 
 DLL_PUBLIC Tensor linearize_cache_indices_from_row_idx_cpu(
-    Tensor /*cache_hash_size_cumsum*/,
-    Tensor /*update_table_indices*/,
+    Tensor cache_hash_size_cumsum,
+    Tensor update_table_indices,
     Tensor update_row_indices) {
-  return at::empty_like(update_row_indices);
+  TENSOR_ON_CPU(cache_hash_size_cumsum);
+  TENSOR_ON_CPU(update_table_indices);
+  TENSOR_ON_CPU(update_row_indices);
+
+  const auto T = cache_hash_size_cumsum.size(0) - 1;
+  TORCH_CHECK(T > 0);
+
+  auto linear_cache_indices = at::empty_like(update_row_indices);
+  const auto num_indices = update_row_indices.numel();
+  if (num_indices == 0) {
+    return linear_cache_indices;
+  }
+
+  const auto cumsum = cache_hash_size_cumsum.contiguous();
+  const auto* cumsum_ptr = cumsum.data_ptr<int64_t>();
+  const auto max_offset = cumsum_ptr[T];
+  const auto table_indices = update_table_indices.contiguous();
+  const auto row_indices = update_row_indices.contiguous();
+  AT_DISPATCH_INDEX_TYPES(
+      row_indices.scalar_type(),
+      "linearize_cache_indices_from_row_idx_cpu",
+      [&] {
+        const auto* table_ptr = table_indices.data_ptr<index_t>();
+        const auto* row_ptr = row_indices.data_ptr<index_t>();
+        auto* linear_ptr = linear_cache_indices.data_ptr<index_t>();
+        for (const auto i : c10::irange(num_indices)) {
+          const auto curr_offset = cumsum_ptr[table_ptr[i]];
+          linear_ptr[i] = curr_offset >= 0 && row_ptr[i] >= 0
+              ? row_ptr[i] + curr_offset
+              : max_offset;
+        }
+      });
+  return linear_cache_indices;
+}
+
+DLL_PUBLIC
+std::tuple<Tensor, Tensor, std::optional<Tensor>, std::optional<Tensor>>
+get_unique_indices_cpu_impl(
+    const Tensor& linear_indices,
+    const int64_t max_indices,
+    const bool compute_count,
+    const bool compute_inverse_indices) {
+  TENSOR_ON_CPU(linear_indices);
+
+  TORCH_CHECK(linear_indices.numel() < std::numeric_limits<int32_t>::max());
+  const int32_t N = linear_indices.numel();
+  const auto linear_indices_contig = linear_indices.contiguous();
+  auto unique_indices = at::empty_like(linear_indices_contig);
+  auto unique_indices_length =
+      at::empty({1}, linear_indices.options().dtype(at::kInt));
+  std::optional<Tensor> unique_indices_count = c10::nullopt;
+  std::optional<Tensor> linear_index_positions_sorted = c10::nullopt;
+  if (compute_count) {
+    unique_indices_count =
+        at::empty({N}, linear_indices.options().dtype(at::kInt));
+  }
+  if (compute_inverse_indices) {
+    linear_index_positions_sorted =
+        at::empty({N}, linear_indices.options().dtype(at::kInt));
+  }
+
+  AT_DISPATCH_INDEX_TYPES(
+      linear_indices.scalar_type(), "get_unique_indices_cpu", [&] {
+        unique_indices_length.data_ptr<int32_t>()[0] =
+            fbgemm::unique_parallel<index_t, int32_t>(
+                linear_indices_contig.data_ptr<index_t>(),
+                N,
+                max_indices,
+                unique_indices.data_ptr<index_t>(),
+                /*inverse=*/nullptr,
+                compute_count ? unique_indices_count->data_ptr<int32_t>()
+                              : nullptr,
+                compute_inverse_indices
+                    ? linear_index_positions_sorted->data_ptr<int32_t>()
+                    : nullptr);
+      });
+
+  return std::make_tuple(
+      unique_indices,
+      unique_indices_length,
+      unique_indices_count,
+      linear_index_positions_sorted);
+}
+
+DLL_PUBLIC
+std::tuple<Tensor, Tensor, std::optional<Tensor>> get_unique_indices_cpu(
+    const Tensor& linear_indices,
+    const int64_t max_indices,
+    const bool compute_count) {
+  const auto ret = get_unique_indices_cpu_impl(
+      linear_indices,
+      max_indices,
+      compute_count,
+      /*compute_inverse_indices=*/false);
+
+  return {std::get<0>(ret), std::get<1>(ret), std::get<2>(ret)};
+}
+
+DLL_PUBLIC
+std::tuple<Tensor, Tensor, std::optional<Tensor>, std::optional<Tensor>>
+get_unique_indices_with_inverse_cpu(
+    const Tensor& linear_indices,
+    const int64_t max_indices,
+    const bool compute_count,
+    const bool compute_inverse_indices) {
+  return get_unique_indices_cpu_impl(
+      linear_indices, max_indices, compute_count, compute_inverse_indices);
 }
 
 } // namespace fbgemm_gpu
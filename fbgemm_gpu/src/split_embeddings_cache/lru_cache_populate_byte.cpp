@@ -6,7 +6,17 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <ATen/Parallel.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "common.h"
+#include "fbgemm/FbgemmEmbedding.h"
+#include "fbgemm_gpu/split_embeddings_cache_cuda.cuh"
 
 using Tensor = at::Tensor;
 
@@ -28,7 +38,138 @@ DLL_PUBLIC void lru_cache_populate_byte_cpu(
     int64_t row_alignment,
     bool gather_cache_stats,
     std::optional<Tensor> uvm_cache_stats) {
-  return;
+  TENSORS_ON_SAME_DEVICE(weights, linear_cache_indices);
+  TENSOR_ON_CPU(weights);
+  TENSOR_ON_CPU(lxu_cache_state);
+  TENSOR_ON_CPU(lxu_cache_weights);
+  TENSOR_ON_CPU(lru_state);
+  TORCH_CHECK(lxu_cache_state.is_contiguous());
+  TORCH_CHECK(lru_state.is_contiguous());
+  int32_t* stats = nullptr;
+  if (gather_cache_stats) {
+    TORCH_CHECK(uvm_cache_stats.has_value());
+    TENSOR_ON_CPU(uvm_cache_stats.value());
+    stats = uvm_cache_stats->data_ptr<int32_t>();
+  }
+
+  TORCH_CHECK(
+      linear_cache_indices.numel() < std::numeric_limits<int32_t>::max());
+  const int32_t N = linear_cache_indices.numel();
+  if (N == 0 || lxu_cache_state.numel() == 0) {
+    // nothing to do
+    return;
+  }
+  if (stats) {
+    stats[uvm_cache_stats_index::num_calls] += 1;
+    stats[uvm_cache_stats_index::num_requested_indices] += N;
+  }
+
+  // Get unique indices
+  Tensor unique_indices, unique_indices_length;
+  std::tie(unique_indices, unique_indices_length, std::ignore) =
+      get_unique_indices_cpu(
+          linear_cache_indices,
+          total_cache_hash_size,
+          /*compute_count=*/false);
+  const int32_t N_unique = unique_indices_length.data_ptr<int32_t>()[0];
+  if (stats) {
+    stats[uvm_cache_stats_index::num_unique_indices] += N_unique;
+  }
+
+  // Find uncached indices, and refresh the time stamp of the cached ones
+  const auto lxu_cache_locations = lxu_cache_lookup_cpu(
+      unique_indices,
+      lxu_cache_state,
+      total_cache_hash_size,
+      /*gather_cache_stats=*/false,
+      /*uvm_cache_stats=*/std::nullopt,
+      /*num_uniq_cache_indices=*/unique_indices_length,
+      /*lxu_cache_locations_output=*/std::nullopt);
+  const auto* locations = lxu_cache_locations.data_ptr<int32_t>();
+  auto* lru = lru_state.data_ptr<int64_t>();
+  auto* state = lxu_cache_state.data_ptr<int64_t>();
+  const int32_t C = lxu_cache_state.size(0);
+  const int32_t ways = lxu_cache_state.size(1);
+
+  // Uncached indices grouped by cache set, in index order within a set
+  std::vector<std::pair<int32_t, int64_t>> misses;
+  AT_DISPATCH_INDEX_TYPES(
+      unique_indices.scalar_type(), "lru_cache_find_uncached_cpu", [&] {
+        const auto* indices = unique_indices.data_ptr<index_t>();
+        for (const auto n : c10::irange(N_unique)) {
+          const int64_t idx = indices[n];
+          if (locations[n] >= 0) {
+            lru[locations[n]] = time_stamp;
+          } else if (idx != total_cache_hash_size) {
+            misses.emplace_back(fbgemm::lxu_cache_slot(idx, C), idx);
+          }
+        }
+      });
+  std::stable_sort(
+      misses.begin(), misses.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+      });
+  if (stats) {
+    stats[uvm_cache_stats_index::num_unique_misses] += misses.size();
+  }
+
+  std::vector<int64_t> set_starts;
+  for (const auto i : c10::irange(misses.size())) {
+    if (i == 0 || misses[i].first != misses[i - 1].first) {
+      set_starts.push_back(i);
+    }
+  }
+  set_starts.push_back(misses.size());
+
+  // Insert the rows of each set over its least recently used ways, but never
+  // evict a row that has been used in this iteration
+  const LxuCacheRowInserter inserter(
+      weights,
+      cache_hash_size_cumsum,
+      cache_index_table_map,
+      weights_offsets,
+      weights_tys,
+      D_offsets,
+      lxu_cache_weights,
+      row_alignment);
+  std::atomic<int64_t> n_conflict_misses{0};
+  at::parallel_for(
+      0,
+      set_starts.size() - 1,
+      kCacheInsertGrainSize,
+      [&](int64_t begin, int64_t end) {
+        std::vector<int32_t> slots(ways);
+        for (const auto s : c10::irange(begin, end)) {
+          const int64_t start = set_starts[s];
+          const int64_t SL = set_starts[s + 1] - start;
+          const int32_t cache_set = misses[start].first;
+          auto* set_lru = lru + static_cast<int64_t>(cache_set) * ways;
+          std::iota(slots.begin(), slots.end(), 0);
+          std::stable_sort(slots.begin(), slots.end(), [&](auto a, auto b) {
+            return set_lru[a] < set_lru[b];
+          });
+
+          int64_t n_inserted = 0;
+          for (int64_t l = 0; l < std::min<int64_t>(SL, ways); ++l) {
+            const int32_t insert_slot = slots[l];
+            if (set_lru[insert_slot] == time_stamp) {
+              break;
+            }
+            const int64_t insert_idx = misses[start + l].second;
+            const int64_t cache_loc =
+                static_cast<int64_t>(cache_set) * ways + insert_slot;
+            inserter.insert(insert_idx, cache_loc);
+            state[cache_loc] = insert_idx;
+            set_lru[insert_slot] = time_stamp;
+            n_inserted++;
+          }
+          n_conflict_misses += SL - n_inserted;
+        }
+      });
+  if (stats) {
+    stats[uvm_cache_stats_index::num_conflict_unique_misses] +=
+        n_conflict_misses;
+  }
 }
 
 DLL_PUBLIC void direct_mapped_lru_cache_populate_byte_cpu(
@@ -48,7 +189,95 @@ DLL_PUBLIC void direct_mapped_lru_cache_populate_byte_cpu(
     int64_t row_alignment,
     bool gather_cache_stats,
     std::optional<Tensor> uvm_cache_stats) {
-  return;
+  TENSORS_ON_SAME_DEVICE(weights, linear_cache_indices);
+  TENSOR_ON_CPU(weights);
+  TENSOR_ON_CPU(lxu_cache_state);
+  TENSOR_ON_CPU(lxu_cache_weights);
+  TENSOR_ON_CPU(lru_state);
+  TENSOR_ON_CPU(lxu_cache_miss_timestamp);
+  TORCH_CHECK(lxu_cache_state.is_contiguous());
+  TORCH_CHECK(lru_state.is_contiguous());
+  TORCH_CHECK(lxu_cache_miss_timestamp.is_contiguous());
+  int32_t* stats = nullptr;
+  if (gather_cache_stats) {
+    TORCH_CHECK(uvm_cache_stats.has_value());
+    TENSOR_ON_CPU(uvm_cache_stats.value());
+    stats = uvm_cache_stats->data_ptr<int32_t>();
+  }
+
+  TORCH_CHECK(
+      linear_cache_indices.numel() < std::numeric_limits<int32_t>::max());
+  const int32_t N = linear_cache_indices.numel();
+  if (N == 0 || lxu_cache_state.numel() == 0) {
+    // nothing to do
+    return;
+  }
+  if (stats) {
+    stats[uvm_cache_stats_index::num_calls] += 1;
+    stats[uvm_cache_stats_index::num_requested_indices] += N;
+  }
+
+  // Each hit refreshes the time stamp of its set, and the first miss of a set
+  // in this iteration claims it for insertion
+  const int32_t C = lxu_cache_state.size(0);
+  auto* state = lxu_cache_state.data_ptr<int64_t>();
+  auto* lru = lru_state.data_ptr<int64_t>();
+  auto* miss_timestamp = lxu_cache_miss_timestamp.data_ptr<int64_t>();
+  std::vector<std::pair<int32_t, int64_t>> inserts;
+  const auto indices_contig = linear_cache_indices.contiguous();
+  AT_DISPATCH_INDEX_TYPES(
+      indices_contig.scalar_type(),
+      "direct_mapped_lru_cache_find_uncached_cpu",
+      [&] {
+        const auto* indices = indices_contig.data_ptr<index_t>();
+        for (const auto n : c10::irange(N)) {
+          const int64_t idx = indices[n];
+          if (idx == total_cache_hash_size) {
+            // Invalid or pruned row
+            continue;
+          }
+          const int32_t cache_set = fbgemm::lxu_cache_slot(idx, C);
+          if (state[cache_set] == idx) {
+            lru[cache_set] = time_stamp;
+          } else if (miss_timestamp[cache_set] < time_stamp + 1) {
+            miss_timestamp[cache_set] = time_stamp + 1;
+            inserts.emplace_back(cache_set, idx);
+          }
+        }
+      });
+
+  // Insert the claimed rows, unless their set was hit in this iteration
+  const LxuCacheRowInserter inserter(
+      weights,
+      cache_hash_size_cumsum,
+      cache_index_table_map,
+      weights_offsets,
+      weights_tys,
+      D_offsets,
+      lxu_cache_weights,
+      row_alignment);
+  std::atomic<int64_t> n_inserted{0};
+  at::parallel_for(
+      0,
+      inserts.size(),
+      kCacheInsertGrainSize,
+      [&](int64_t begin, int64_t end) {
+        for (const auto i : c10::irange(begin, end)) {
+          const auto [cache_set, insert_idx] = inserts[i];
+          if (lru[cache_set] == time_stamp) {
+            continue;
+          }
+          inserter.insert(insert_idx, cache_set);
+          state[cache_set] = insert_idx;
+          lru[cache_set] = time_stamp;
+          n_inserted++;
+        }
+      });
+  if (stats) {
+    // As in the CUDA op, the conflict slot counts the inserted rows of a
+    // direct mapped cache
+    stats[uvm_cache_stats_index::num_conflict_unique_misses] += n_inserted;
+  }
 }
 
 } // namespace fbgemm_gpu
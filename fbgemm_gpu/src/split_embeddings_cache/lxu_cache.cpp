@@ -6,22 +6,104 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <ATen/Parallel.h>
+#include <atomic>
+#include <vector>
+
 #include "common.h"
+#include "fbgemm/FbgemmEmbedding.h"
+#include "fbgemm_gpu/split_embeddings_cache_cuda.cuh"
 
 using Tensor = at::Tensor;
 
+namespace {
+
+// Looks up the first N indices and returns the number of misses. Each way of
+// a set is compared with SIMD in fbgemm::lxu_cache_lookup.
+int64_t lxu_cache_lookup_n(
+    const Tensor& linear_cache_indices,
+    const int64_t N,
+    const Tensor& lxu_cache_state,
+    const int64_t invalid_index,
+    const Tensor& lxu_cache_locations) {
+  auto* locations = lxu_cache_locations.data_ptr<int32_t>();
+  if (lxu_cache_state.numel() == 0) {
+    // No cache
+    std::fill(locations, locations + N, kCacheLocationMissing);
+    return 0;
+  }
+  const auto indices = linear_cache_indices.contiguous();
+  const auto state = lxu_cache_state.contiguous();
+  const auto* state_ptr = state.data_ptr<int64_t>();
+  const int32_t C = state.size(0);
+  const int32_t ways = state.size(1);
+
+  std::atomic<int64_t> num_misses{0};
+  AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "lxu_cache_lookup_cpu", [&] {
+    const auto* indices_ptr = indices.data_ptr<index_t>();
+    at::parallel_for(
+        0, N, kCacheLookupGrainSize, [&](int64_t begin, int64_t end) {
+          num_misses += fbgemm::lxu_cache_lookup(
+              indices_ptr + begin,
+              end - begin,
+              state_ptr,
+              C,
+              ways,
+              invalid_index,
+              locations + begin);
+        });
+  });
+  return num_misses;
+}
+
+} // namespace
+
 namespace fbgemm_gpu {
 
 DLL_PUBLIC Tensor lxu_cache_lookup_cpu(
     Tensor linear_cache_indices,
-    Tensor /* lxu_cache_state */,
-    int64_t /* invalid_index */,
-    bool /* gather_cache_stats */,
-    std::optional<Tensor> /* uvm_cache_stats */,
-    std::optional<Tensor> /* num_uniq_cache_indices */,
+    Tensor lxu_cache_state,
+    int64_t invalid_index,
+    bool gather_cache_stats,
+    std::optional<Tensor> uvm_cache_stats,
+    std::optional<Tensor> num_uniq_cache_indices,
     std::optional<Tensor> lxu_cache_locations_output) {
-  return lxu_cache_locations_output.value_or(empty_like(
-      linear_cache_indices, linear_cache_indices.options().dtype(at::kInt)));
+  TENSOR_ON_CPU(linear_cache_indices);
+  TENSOR_ON_CPU(lxu_cache_state);
+  const auto uniq_lookup = num_uniq_cache_indices.has_value();
+  TORCH_CHECK(
+      !uniq_lookup || !gather_cache_stats,
+      "Unique lxu_cache_locations generation does not support gather_cache_stats=true");
+  if (gather_cache_stats) {
+    TORCH_CHECK(uvm_cache_stats.has_value());
+    TENSOR_ON_CPU(uvm_cache_stats.value());
+  }
+
+  const auto lxu_cache_locations =
+      lxu_cache_locations_output.value_or(empty_like(
+          linear_cache_indices,
+          linear_cache_indices.options().dtype(at::kInt)));
+  TORCH_CHECK(lxu_cache_locations.is_contiguous());
+
+  const int64_t N = uniq_lookup
+      ? num_uniq_cache_indices->data_ptr<int32_t>()[0]
+      : linear_cache_indices.numel();
+  if (N == 0) {
+    // nothing to do
+    return lxu_cache_locations;
+  }
+
+  const auto num_misses = lxu_cache_lookup_n(
+      linear_cache_indices,
+      N,
+      lxu_cache_state,
+      invalid_index,
+      lxu_cache_locations);
+  if (gather_cache_stats) {
+    uvm_cache_stats->data_ptr<int32_t>()
+        [uvm_cache_stats_index::num_conflict_misses] += num_misses;
+  }
+  return lxu_cache_locations;
 }
 
 DLL_PUBLIC Tensor direct_mapped_lxu_cache_lookup_cpu(
@@ -30,8 +112,82 @@ DLL_PUBLIC Tensor direct_mapped_lxu_cache_lookup_cpu(
     int64_t invalid_index,
     bool gather_cache_stats,
     std::optional<Tensor> uvm_cache_stats) {
-  return empty_like(
+  TENSOR_ON_CPU(linear_cache_indices);
+  TENSOR_ON_CPU(lxu_cache_state);
+  if (gather_cache_stats) {
+    TORCH_CHECK(uvm_cache_stats.has_value());
+    TENSOR_ON_CPU(uvm_cache_stats.value());
+  }
+
+  auto lxu_cache_locations = empty_like(
       linear_cache_indices, linear_cache_indices.options().dtype(at::kInt));
+  if (linear_cache_indices.numel() == 0) {
+    // nothing to do
+    return lxu_cache_locations;
+  }
+
+  // A direct mapped cache is a one way cache, so that the location of a row
+  // is its cache set
+  const auto num_misses = lxu_cache_lookup_n(
+      linear_cache_indices,
+      linear_cache_indices.numel(),
+      lxu_cache_state,
+      invalid_index,
+      lxu_cache_locations);
+  if (gather_cache_stats) {
+    uvm_cache_stats->data_ptr<int32_t>()
+        [uvm_cache_stats_index::num_conflict_misses] += num_misses;
+  }
+  return lxu_cache_locations;
+}
+
+DLL_PUBLIC void lxu_cache_locking_counter_decrement_cpu(
+    Tensor lxu_cache_locking_counter,
+    Tensor lxu_cache_locations) {
+  TENSOR_ON_CPU(lxu_cache_locking_counter);
+  TENSOR_ON_CPU(lxu_cache_locations);
+  TORCH_CHECK(lxu_cache_locking_counter.is_contiguous());
+
+  const auto N = lxu_cache_locations.numel();
+  if (N == 0) {
+    return;
+  }
+
+  // Duplicate cache locations only decrement once
+  auto* counter = lxu_cache_locking_counter.data_ptr<int32_t>();
+  std::vector<bool> decremented(lxu_cache_locking_counter.numel(), false);
+  const auto locations = lxu_cache_locations.contiguous();
+  const auto* locations_ptr = locations.data_ptr<int32_t>();
+  for (const auto n : c10::irange(N)) {
+    const auto location = locations_ptr[n];
+    if (location >= 0 && !decremented[location]) {
+      decremented[location] = true;
+      counter[location] -= 1;
+    }
+  }
+}
+
+DLL_PUBLIC void lxu_cache_locations_update_cpu(
+    Tensor lxu_cache_locations,
+    Tensor lxu_cache_locations_new,
+    std::optional<Tensor> num_uniq_cache_indices) {
+  TENSOR_ON_CPU(lxu_cache_locations);
+  TENSOR_ON_CPU(lxu_cache_locations_new);
+  TORCH_CHECK(lxu_cache_locations.is_contiguous());
+
+  const auto uniq_lookup = num_uniq_cache_indices.has_value();
+  const int64_t N = uniq_lookup
+      ? num_uniq_cache_indices->data_ptr<int32_t>()[0]
+      : lxu_cache_locations.numel();
+  auto* locations = lxu_cache_locations.data_ptr<int32_t>();
+  const auto locations_new = lxu_cache_locations_new.contiguous();
+  const auto* locations_new_ptr = locations_new.data_ptr<int32_t>();
+  for (const auto n : c10::irange(N)) {
+    if (uniq_lookup ||
+        (locations[n] == kCacheLocationMissing && locations_new_ptr[n] >= 0)) {
+      locations[n] = locations_new_ptr[n];
+    }
+  }
 }
 
 } // namespace fbgemm_gpu
@@ -60,6 +60,9 @@ TORCH_LIBRARY_FRAGMENT(fbgemm, m) {
   DISPATCH_TO_CPU(
       "linearize_cache_indices_from_row_idx",
       linearize_cache_indices_from_row_idx_cpu);
+  DISPATCH_TO_CPU("get_unique_indices", get_unique_indices_cpu);
+  DISPATCH_TO_CPU(
+      "get_unique_indices_with_inverse", get_unique_indices_with_inverse_cpu);
   DISPATCH_TO_CPU("lru_cache_populate_byte", lru_cache_populate_byte_cpu);
   DISPATCH_TO_CPU(
       "direct_mapped_lru_cache_populate_byte",
@@ -68,6 +71,11 @@ TORCH_LIBRARY_FRAGMENT(fbgemm, m) {
   DISPATCH_TO_CPU("lxu_cache_lookup", lxu_cache_lookup_cpu);
   DISPATCH_TO_CPU(
       "direct_mapped_lxu_cache_lookup", direct_mapped_lxu_cache_lookup_cpu);
+  DISPATCH_TO_CPU(
+      "lxu_cache_locking_counter_decrement",
+      lxu_cache_locking_counter_decrement_cpu);
+  DISPATCH_TO_CPU(
+      "lxu_cache_locations_update", lxu_cache_locations_update_cpu);
 }
 
 } // namespace
@@ -10,72 +10,51 @@
 
 namespace kv_db {
 
-folly::CPUThreadPoolExecutor* CudaExecutor::get_executor() {
-  static auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(1);
+namespace {
+
+// Enough for the get and the set lanes of a few DBs to run at the same time
+constexpr size_t kKVDBExecutorThreads = 4;
+
+} // namespace
+
+folly::CPUThreadPoolExecutor* KVDBExecutor::get_executor() {
+  static auto executor =
+      std::make_unique<folly::CPUThreadPoolExecutor>(kKVDBExecutorThreads);
   return executor.get();
 }
 
-void hostAsynchronousThreadPoolExecutor(void (*f)(void*), void* userData) {
-  CudaExecutor::get_executor()->add([f, userData]() { f(userData); });
-}
+EmbeddingKVDB::EmbeddingKVDB()
+    : get_executor_(folly::SerialExecutor::create(
+          folly::getKeepAliveToken(KVDBExecutor::get_executor()))),
+      set_executor_(folly::SerialExecutor::create(
+          folly::getKeepAliveToken(KVDBExecutor::get_executor()))) {}
 
-void EmbeddingKVDB::get_cuda(
+folly::SemiFuture<folly::Unit> EmbeddingKVDB::get_async(
     const at::Tensor& indices,
     const at::Tensor& weights,
     const at::Tensor& count) {
   // take reference to self to avoid lifetime issues.
   auto self = shared_from_this();
-  std::function<void()>* functor =
-      new std::function<void()>([=]() { self->get(indices, weights, count); });
-  auto callFunctor =
-      [](cudaStream_t /*stream*/, cudaError_t status, void* userData) -> void {
-    AT_CUDA_CHECK(status);
-    auto* f = reinterpret_cast<std::function<void()>*>(userData);
-    AT_CUDA_CHECK(cudaGetLastError());
-    (*f)();
-    // delete f; // unfortunately, this invoke destructors that call CUDA
-    // API functions (e.g. caching host allocators issue cudaGetDevice(..),
-    // etc)
-    hostAsynchronousThreadPoolExecutor(
-        [](void* userData) {
-          auto* fn = reinterpret_cast<std::function<void()>*>(userData);
-          delete fn;
-        },
-        userData);
-  };
-  AT_CUDA_CHECK(cudaStreamAddCallback(
-      at::cuda::getCurrentCUDAStream(), callFunctor, functor, 0));
+  return folly::via(
+             get_executor_.copy(),
+             [=]() { self->get(indices, weights, count); })
+      .semi();
 }
 
-void EmbeddingKVDB::set_cuda(
+folly::SemiFuture<folly::Unit> EmbeddingKVDB::set_async(
     const at::Tensor& indices,
     const at::Tensor& weights,
     const at::Tensor& count,
     const int64_t timestep) {
   // take reference to self to avoid lifetime issues.
   auto self = shared_from_this();
-  std::function<void()>* functor = new std::function<void()>([=]() {
-    self->set(indices, weights, count);
-    self->flush_or_compact(timestep);
-  });
-  auto callFunctor =
-      [](cudaStream_t /*stream*/, cudaError_t status, void* userData) -> void {
-    AT_CUDA_CHECK(status);
-    auto* f = reinterpret_cast<std::function<void()>*>(userData);
-    AT_CUDA_CHECK(cudaGetLastError());
-    (*f)();
-    // delete f; // unfortunately, this invoke destructors that call CUDA
-    // API functions (e.g. caching host allocators issue cudaGetDevice(..),
-    // etc)
-    hostAsynchronousThreadPoolExecutor(
-        [](void* userData) {
-          auto* fn = reinterpret_cast<std::function<void()>*>(userData);
-          delete fn;
-        },
-        userData);
-  };
-  AT_CUDA_CHECK(cudaStreamAddCallback(
-      at::cuda::getCurrentCUDAStream(), callFunctor, functor, 0));
+  return folly::via(
+             set_executor_.copy(),
+             [=]() {
+               self->set(indices, weights, count);
+               self->flush_or_compact(timestep);
+             })
+      .semi();
 }
 
 } // namespace kv_db
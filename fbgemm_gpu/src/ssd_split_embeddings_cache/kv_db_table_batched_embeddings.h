@@ -23,6 +23,7 @@
 #include <folly/Random.h>
 #include <folly/concurrency/UnboundedQueue.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/SerialExecutor.h>
 #include <folly/futures/Future.h>
 #include <folly/hash/Hash.h>
 
@@ -34,20 +35,27 @@
 #include <rocksdb/table.h>
 #include <rocksdb/table_properties.h>
 
-#include <ATen/cuda/CUDAContext.h>
-#include <cuda_runtime.h>
-
 #include "fbgemm_gpu/dispatch_macros.h"
 
 namespace kv_db {
 
-class CudaExecutor {
+// Thread pool that runs the requests of the asynchronous KV DB API. Each
+// request blocks one of its threads until the backend has served it.
+class KVDBExecutor {
  public:
   static folly::CPUThreadPoolExecutor* get_executor();
 };
 
+// A KV DB backed embedding store. The backend only touches host memory, so
+// it can be used on CPU-only hosts. get_cuda and set_cuda additionally order
+// the requests with the current CUDA stream, and are defined in
+// kv_db_table_batched_embeddings_cuda.cpp, which is HIPified for ROCm.
+// get_async and set_async are only a C++ API for now: the ops of SSD TBE
+// do not expose them.
 class EmbeddingKVDB : public std::enable_shared_from_this<EmbeddingKVDB> {
  public:
+  EmbeddingKVDB();
+
   virtual ~EmbeddingKVDB() {}
 
   virtual void set(
@@ -64,6 +72,28 @@ class EmbeddingKVDB : public std::enable_shared_from_this<EmbeddingKVDB> {
 
   virtual void flush() = 0;
 
+  // Fetches the rows of indices into weights on the KVDBExecutor. The future
+  // completes once weights hold the rows.
+  //
+  // Gets run in order with each other, and so do sets, but a get may overlap
+  // a set. This lets the get of the next batch overlap the compute and the
+  // set of the current one. The caller must not get rows while a set of the
+  // same rows is still in flight, and must keep the tensors unchanged until
+  // the future completes.
+  folly::SemiFuture<folly::Unit> get_async(
+      const at::Tensor& indices,
+      const at::Tensor& weights,
+      const at::Tensor& count);
+
+  // Writes the rows of indices from weights on the KVDBExecutor, then flushes
+  // or compacts the DB as scheduled for timestep. See get_async for the
+  // ordering guarantees.
+  folly::SemiFuture<folly::Unit> set_async(
+      const at::Tensor& indices,
+      const at::Tensor& weights,
+      const at::Tensor& count,
+      const int64_t timestep);
+
   // The function attaches the CUDA callback logic to the compute
   // stream to ensure that the data retrieval is carried out properly.
   // It internally invokes get to fetch values from the KV database.
@@ -80,6 +110,10 @@ class EmbeddingKVDB : public std::enable_shared_from_this<EmbeddingKVDB> {
 
  private:
   virtual void flush_or_compact(const int64_t timestep) = 0;
+
+  // Serial lanes on the KVDBExecutor for get_async and set_async
+  folly::Executor::KeepAlive<folly::SerialExecutor> get_executor_;
+  folly::Executor::KeepAlive<folly::SerialExecutor> set_executor_;
 }; // class EmbeddingKVDB
 
 } // namespace kv_db
@@ -36,16 +36,11 @@ VERBOSITY: Verbosity = Verbosity.verbose
 
 @optests.generate_opcheck_tests(fast=True)
 class LXUCacheTest(unittest.TestCase):
-    @unittest.skipIf(*gpu_unavailable)
-    @given(
-        associativity=st.sampled_from([1, DEFAULT_ASSOC]),
-    )
-    @settings(deadline=None)
-    def test_lxu_cache_lookup(self, associativity: int) -> None:
+    def execute_lxu_cache_lookup(self, associativity: int, device: str) -> None:
         max_index: int = 8000
         # Use single cache set to avoid dealing with cache set hash algorithm.
-        lxu_cache_state_gpu = (
-            torch.arange(associativity, dtype=torch.int64).unsqueeze(0).cuda()
+        lxu_cache_state = (
+            torch.arange(associativity, dtype=torch.int64).unsqueeze(0).to(device)
         )
 
         # Testing all miss.
@@ -53,9 +48,9 @@ class LXUCacheTest(unittest.TestCase):
             torch.tensor([32, 33, 34, 35, 36, 100, 1000, 1725])
             if associativity <= 32
             else torch.tensor([64, 65, 66, 67, 68, 100, 1000, 1725])
-        ).cuda()
+        ).to(device)
         lxu_locations = torch.ops.fbgemm.lxu_cache_lookup(
-            linear_cache_indices_0, lxu_cache_state_gpu, max_index
+            linear_cache_indices_0, lxu_cache_state, max_index
         )
         torch.testing.assert_close(
             lxu_locations,
@@ -64,9 +59,9 @@ class LXUCacheTest(unittest.TestCase):
 
         # Testing all hits.
         cache_indices_1 = torch.randint(0, associativity, (associativity,))
-        linear_cache_indices_1 = cache_indices_1.cuda()
+        linear_cache_indices_1 = cache_indices_1.to(device)
         lxu_locations = torch.ops.fbgemm.lxu_cache_lookup(
-            linear_cache_indices_1, lxu_cache_state_gpu, max_index
+            linear_cache_indices_1, lxu_cache_state, max_index
         )
         torch.testing.assert_close(
             lxu_locations.cpu(),
@@ -85,9 +80,9 @@ class LXUCacheTest(unittest.TestCase):
                 miss_cache_indices_1,
                 hit_cache_indices_1,
             ]
-        ).cuda()
+        ).to(device)
         lxu_locations = torch.ops.fbgemm.lxu_cache_lookup(
-            linear_cache_indices_2, lxu_cache_state_gpu, max_index
+            linear_cache_indices_2, lxu_cache_state, max_index
         )
 
         expected_result = torch.cat(
@@ -105,12 +100,23 @@ class LXUCacheTest(unittest.TestCase):
 
     @unittest.skipIf(*gpu_unavailable)
     @given(
-        cache_sets=st.integers(min_value=10, max_value=300),
+        associativity=st.sampled_from([1, DEFAULT_ASSOC]),
     )
-    @settings(verbosity=VERBOSITY, max_examples=MAX_EXAMPLES, deadline=None)
-    def test_lxu_cache_locking_counter_decrement(
+    @settings(deadline=None)
+    def test_lxu_cache_lookup(self, associativity: int) -> None:
+        self.execute_lxu_cache_lookup(associativity, "cuda")
+
+    @given(
+        associativity=st.sampled_from([1, 4, DEFAULT_ASSOC]),
+    )
+    @settings(deadline=None)
+    def test_lxu_cache_lookup_cpu(self, associativity: int) -> None:
+        self.execute_lxu_cache_lookup(associativity, "cpu")
+
+    def execute_lxu_cache_locking_counter_decrement(
         self,
         cache_sets: int,
+        device: str,
     ) -> None:
         warp_size = DEFAULT_ASSOC
         N = cache_sets * warp_size
@@ -118,7 +124,7 @@ class LXUCacheTest(unittest.TestCase):
             low=1,
             high=3,
             size=[cache_sets, warp_size],
-            device="cuda",
+            device=device,
             dtype=torch.int32,
         )
         counter_ref = lxu_cache_locking_counter.tolist()
@@ -134,15 +140,36 @@ class LXUCacheTest(unittest.TestCase):
                 q, r = idx // warp_size, idx % warp_size
                 counter_ref[q][r] -= 1
 
-        counter_ref = torch.tensor(counter_ref, device="cuda", dtype=torch.int32)
+        counter_ref = torch.tensor(counter_ref, device=device, dtype=torch.int32)
         lxu_cache_locations = torch.tensor(
-            lxu_cache_locations_list, device="cuda", dtype=torch.int32
+            lxu_cache_locations_list, device=device, dtype=torch.int32
         )
         torch.ops.fbgemm.lxu_cache_locking_counter_decrement(
             lxu_cache_locking_counter, lxu_cache_locations
         )
         self.assertTrue(torch.equal(lxu_cache_locking_counter, counter_ref))
 
+    @unittest.skipIf(*gpu_unavailable)
+    @given(
+        cache_sets=st.integers(min_value=10, max_value=300),
+    )
+    @settings(verbosity=VERBOSITY, max_examples=MAX_EXAMPLES, deadline=None)
+    def test_lxu_cache_locking_counter_decrement(
+        self,
+        cache_sets: int,
+    ) -> None:
+        self.execute_lxu_cache_locking_counter_decrement(cache_sets, "cuda")
+
+    @given(
+        cache_sets=st.integers(min_value=10, max_value=300),
+    )
+    @settings(verbosity=VERBOSITY, max_examples=MAX_EXAMPLES, deadline=None)
+    def test_lxu_cache_locking_counter_decrement_cpu(
+        self,
+        cache_sets: int,
+    ) -> None:
+        self.execute_lxu_cache_locking_counter_decrement(cache_sets, "cpu")
+
     @unittest.skipIf(*gpu_unavailable)
     @given(
         T=st.integers(min_value=1, max_value=10),
@@ -941,6 +941,118 @@ class NBitFowardTest(unittest.TestCase):
             equal_nan=False,
         )
 
+    def _int8_unit_scale_tbe(
+        self, T_H: List[int], D: int
+    ) -> Tuple[IntNBitTableBatchedEmbeddingBagsCodegen, List[torch.Tensor]]:
+        """
+        Returns a pooled CPU TBE of int8 tables with a scale of 1 and a bias
+        of 0, and the rows of its tables.
+        """
+        quant_cc = IntNBitTableBatchedEmbeddingBagsCodegen(
+            embedding_specs=[
+                (
+                    "",
+                    H,
+                    D,
+                    SparseType.INT8,
+                    EmbeddingLocation.HOST,
+                )
+                for H in T_H
+            ],
+            pooling_mode=PoolingMode.SUM,
+            device="cpu",
+            output_dtype=SparseType.FP32,
+        )
+        quant_cc.fill_random_weights()
+        quant_cc.assign_embedding_weights(
+            [
+                (
+                    table_weight,
+                    torch.tensor([1, 0], dtype=torch.float16).view(torch.uint8),
+                )
+                for table_weight, _ in quant_cc.split_embedding_weights()
+            ]
+        )
+        tables_rows = [
+            T for T, _, _ in quant_cc.split_embedding_weights_with_scale_bias(0)
+        ]
+        return quant_cc, tables_rows
+
+    @given(
+        D=st.sampled_from([8, 64, 256]),
+        B=st.integers(min_value=1, max_value=64),
+        T=st.integers(min_value=2, max_value=10),
+        L=st.integers(min_value=0, max_value=10),
+        long_L=st.sampled_from([1000, 20000]),
+    )
+    @settings(
+        verbosity=VERBOSITY,
+        max_examples=MAX_EXAMPLES_LONG_RUNNING,
+        deadline=None,
+    )
+    def test_nbit_forward_cpu_skewed_pooling(
+        self,
+        D: int,
+        B: int,
+        T: int,
+        L: int,
+        long_L: int,
+    ) -> None:
+        """
+        The CPU forward splits the tables into ranges of bags of about the
+        same cost. Checks it with pooling factors far apart: one long bag in
+        the first table, long bags every few bags in the second one, empty
+        bags in the last one, and short bags elsewhere.
+        """
+        T_H = [np.random.randint(low=1, high=1000) for _ in range(T)]
+        quant_cc, tables_rows = self._int8_unit_scale_tbe(T_H, D)
+        lengths_list = [torch.randint(0, L + 1, (B,)) for _ in range(T)]
+        lengths_list[0][B // 2] = long_L
+        lengths_list[1][::4] = long_L // 10
+        lengths_list[-1].zero_()
+        indices_list = [
+            torch.randint(0, H, (int(length.sum().item()),))
+            for length, H in zip(lengths_list, T_H)
+        ]
+        indices = torch.cat(indices_list, 0)
+        offsets = torch.ops.fbgemm.asynchronous_complete_cumsum(
+            torch.cat(lengths_list, 0)
+        )
+        quant_cc_output = quant_cc(indices.int(), offsets.int())
+
+        ref_output = torch.cat(
+            [
+                torch.nn.functional.embedding_bag(
+                    table_indices,
+                    table_rows.float(),
+                    torch.ops.fbgemm.asynchronous_complete_cumsum(length)[:-1],
+                    mode="sum",
+                )
+                for table_indices, table_rows, length in zip(
+                    indices_list, tables_rows, lengths_list
+                )
+            ],
+            dim=1,
+        )
+        torch.testing.assert_close(quant_cc_output, ref_output)
+
+    def test_nbit_forward_cpu_index_out_of_bounds(self) -> None:
+        """
+        Out of bounds indices are reported after all the ranges of bags have
+        been pooled, with the position of the index.
+        """
+        T_H = [100, 200, 300]
+        B, L = 16, 8
+        quant_cc, _ = self._int8_unit_scale_tbe(T_H, D=32)
+        for t, H in enumerate(T_H):
+            indices_list = [torch.randint(0, h, (B * L,)) for h in T_H]
+            indices_list[t][-1] = H
+            offsets = torch.arange(0, len(T_H) * B * L + 1, L)
+            with self.assertRaisesRegex(
+                RuntimeError, f"Index {(t + 1) * B * L - 1} is out of bounds: {H}"
+            ):
+                quant_cc(torch.cat(indices_list, 0).int(), offsets.int())
+
     @unittest.skipIf(*gpu_unavailable)
     @given(
         nbit_weights_ty=st.sampled_from(
@@ -99,11 +99,18 @@ class BackwardOptimizersTest(unittest.TestCase):
             not use_cpu
             or optimizer
             in [
+                OptimType.ADAM,
                 OptimType.EXACT_ADAGRAD,
                 OptimType.EXACT_SGD,
                 OptimType.EXACT_ROWWISE_ADAGRAD,
+                OptimType.LAMB,
+                OptimType.LARS_SGD,
+                OptimType.PARTIAL_ROWWISE_ADAM,
+                OptimType.PARTIAL_ROWWISE_LAMB,
             ]
         )
+        # Low precision optimizer states are only supported on GPU
+        assume(not use_cpu or optimizer_state_dtypes is None)
         # weight decay mode is only supported in EXACT_ROWWISE_ADAGRAD
         assume(
             weight_decay_mode == WeightDecayMode.NONE
@@ -113,13 +120,6 @@ class BackwardOptimizersTest(unittest.TestCase):
                 in [
                     WeightDecayMode.L2,
                     WeightDecayMode.DECOUPLE,
-                ]
-            )
-            or (
-                not use_cpu
-                and optimizer == OptimType.EXACT_ROWWISE_ADAGRAD
-                and weight_decay_mode
-                in [
                     WeightDecayMode.COUNTER,
                     WeightDecayMode.COWCLIP,
                 ]
@@ -384,9 +384,7 @@ class BackwardOptimizersTest(unittest.TestCase):
                 # coalescing and floating point non-associativity.
                 # pyre-fixme[16]: `Optional` has no attribute `cpu`.
                 dense_cpu_grad = bs[t].weight.grad.cpu().to_dense()
-                if rowwise and not use_cpu:
-                    # We need to skip when using cpu because use_fbgemm (https://fburl.com/code/12131iub)
-                    # is true and the template code (https://fburl.com/code/1kctlup3) is not executed.
+                if rowwise:
                     if weight_decay_mode == WeightDecayMode.L2:
                         dense_cpu_grad += weight_decay * bs[t].weight.cpu()
                     elif weight_decay_mode in (
@@ -430,7 +428,7 @@ class BackwardOptimizersTest(unittest.TestCase):
                     )
                     + eps
                 )
-                if rowwise and not use_cpu:
+                if rowwise:
                     if weight_decay_mode == WeightDecayMode.DECOUPLE:
                         weights_ref = bs[t].weight.cpu() - lr * (
                             dense_cpu_grad / denom + weight_decay * bs[t].weight.cpu()
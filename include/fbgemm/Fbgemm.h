@@ -16,6 +16,7 @@
 #include <limits>
 #include <memory>
 #include <type_traits>
+#include <vector>
 #include "./ConvUtils.h"
 #include "./FbgemmBuild.h"
 #include "./FbgemmEmbedding.h"
@@ -268,6 +269,34 @@ class PackMatrix {
     return G_;
   }
 
+  /**
+   * @return The blocking factors picked from the tuning table of
+   *         FbgemmAutotune.h when the matrix was packed without any, nullptr
+   *         if there were none for its shape.
+   */
+  const BlockingFactors* tunedBlockingFactors() const {
+    return hasTunedParams_ ? &tunedParams_ : nullptr;
+  }
+
+  /**
+   * @return The number of columns of a block the packing buffer was sized
+   *         for, an upper bound of blockColSize().
+   */
+  std::int32_t blockColCapacity() const {
+    return bcolCapacity_ > 0 ? bcolCapacity_ : bcol_;
+  }
+
+  /**
+   * @brief Packs the following blocks with kcb <= blockColCapacity()
+   *        columns. fbgemmPacked uses it to pack A with the KCB of B when B
+   *        was packed with tuned blocking factors.
+   */
+  void setBlockColSize(std::int32_t kcb) {
+    assert(kcb <= blockColCapacity());
+    bcolCapacity_ = blockColCapacity();
+    bcol_ = kcb;
+  }
+
   /**
    * @return True if the last column block has fewer columns than the block
    *         size.
@@ -307,12 +336,15 @@ class PackMatrix {
   bool bufAllocatedHere_{false};
   const BlockingFactors*
       blocking_params; ///< MCB, KCB, NCB, MR, NR, NR_MIN, ROW_INTERLEAVE;
+  BlockingFactors tunedParams_{}; ///< valid if hasTunedParams_
+  bool hasTunedParams_{false};
 
  private:
   std::int32_t nrows_, ncols_;
   int G_;
   block_type_t packedBlock_; ///< The block in the source matrix just packed
   std::int32_t last_brow_, last_bcol_;
+  std::int32_t bcolCapacity_{0}; ///< 0 until setBlockColSize is called
 };
 
 /**
@@ -484,6 +516,24 @@ class FBGEMM_API PackBMatrix final
   ~PackBMatrix() {}
 
  private:
+  friend class PackedWeightSerializer;
+
+  /**
+   * @brief Wraps pmat, which is already packed with the given layout, without
+   *        packing. Used to load serialized weights; unpack() then writes
+   *        the matrix with the leading dimension of a dense one.
+   */
+  PackBMatrix(
+      matrix_op_t trans,
+      std::int32_t nRow,
+      std::int32_t nCol,
+      inpType* pmat,
+      int groups,
+      const BlockingFactors* params,
+      std::int32_t brow,
+      std::int32_t bcol,
+      std::int32_t row_interleave);
+
   matrix_op_t trans_;
   const T* smat_;
   std::int32_t ld_;
@@ -561,6 +611,18 @@ class FBGEMM_API PackWeightMatrixForGConv {
   }
 
  private:
+  friend class PackedWeightSerializer;
+
+  /**
+   * @brief Wraps pdata, which is already packed for GTogether groups at a
+   *        time, without packing. Used to load serialized weights.
+   */
+  PackWeightMatrixForGConv(
+      matrix_op_t trans,
+      const conv_param_t<SPATIAL_DIM>& conv_param,
+      inpType* pdata,
+      int GTogether);
+
   matrix_op_t trans_;
   const conv_param_t<SPATIAL_DIM> conv_param_;
   const T* sdata_;
@@ -666,6 +728,14 @@ class FBGEMM_API PackWeightsForConv {
   void unpack(T* origin_buf);
 
  private:
+  friend class PackedWeightSerializer;
+
+  /**
+   * @brief No packed weights yet. Used to load serialized weights.
+   */
+  explicit PackWeightsForConv(const conv_param_t<SPATIAL_DIM>& conv_param)
+      : conv_param_(conv_param) {}
+
   const conv_param_t<SPATIAL_DIM> conv_param_;
   // Packed weights if we use im2col based convolution implementation
   std::shared_ptr<PackBMatrix<T, accT>> W_im2col_packed_;
@@ -950,6 +1020,136 @@ class FBGEMM_API PackAWithQuantRowOffset final
   std::int32_t row_interleave_B_;
 };
 
+/**
+ * @brief Matrix packed for the first input matrix in GEMM (usually activation)
+ *        with dynamic per row (per token) quantization.
+ *        The source matrix is in fp32. The scale and zero point of every row
+ *        are chosen from the min and max of the whole row when its first
+ *        column block is packed, and the row is quantized and its row offset
+ *        accumulated in the same pass. No separate FindMinMax pass over A is
+ *        needed. Use with the per row ReQuantizeForFloat constructor.
+ */
+template <typename T, typename accT = std::int32_t>
+class FBGEMM_API PackAWithRowwiseQuantRowOffset final
+    : public PackMatrix<PackAWithRowwiseQuantRowOffset<T, accT>, T, accT> {
+ public:
+  using This = PackAWithRowwiseQuantRowOffset<T, accT>;
+  using BaseType = PackMatrix<This, T, accT>;
+  using inpType = T;
+  using accType = accT;
+
+  PackAWithRowwiseQuantRowOffset() = delete; // no default constructor
+  /**
+   * @param row_offset, row_scale, row_zero_point If nullptr, this constructor
+   *                   internally allocates a buffer of rowOffsetBufferSize()
+   *                   elements and owns it. The buffers hold the values of
+   *                   the rows of the block being packed.
+   */
+  PackAWithRowwiseQuantRowOffset(
+      matrix_op_t trans,
+      std::int32_t nRow,
+      std::int32_t nCol,
+      const float* smat,
+      std::int32_t ld,
+      inpType* pmat = nullptr,
+      int groups = 1,
+      std::int32_t* row_offset = nullptr,
+      float* row_scale = nullptr,
+      std::int32_t* row_zero_point = nullptr,
+      const BlockingFactors* params = nullptr);
+
+  /**
+   * Activation matrices are not constant so cannot amortize the cost of
+   * pre-packing.
+   */
+  bool isPrePacked() const {
+    return false;
+  }
+
+  /**
+   * @return True if this is used as A matrix.
+   */
+  static constexpr bool isA() {
+    return true;
+  }
+
+  /**
+   * @return offset of the element in the packed matrix that was at (i, j) in
+   *         the source matrix
+   */
+  std::int32_t addr(std::int32_t i, std::int32_t j) const;
+
+  /**
+   * @brief Packs a block of source matrix into pmat buffer.
+   */
+  void pack(const block_type_t& block);
+
+  /**
+   * @return A pointer to the row offset buffer.
+   */
+  std::int32_t* getRowOffsetBuffer() const {
+    return row_offset_;
+  }
+
+  /**
+   * @return A pointer to the quantization scales of the rows being packed.
+   */
+  const float* getRowScaleBuffer() const {
+    return row_scale_;
+  }
+
+  /**
+   * @return A pointer to the quantization zero points of the rows being
+   *         packed.
+   */
+  const std::int32_t* getRowZeroPointBuffer() const {
+    return row_zero_point_;
+  }
+
+  /**
+   * @brief Print the packed block.
+   */
+  void printPackedMatrix(std::string name);
+
+  /**
+   * @return Size of row offset buffer in number of elements
+   */
+  static int rowOffsetBufferSize(const BlockingFactors* params = nullptr);
+
+  ~PackAWithRowwiseQuantRowOffset() {
+    if (rowOffsetAllocatedHere) {
+      fbgemmAlignedFree(row_offset_);
+    }
+    if (rowScaleAllocatedHere) {
+      fbgemmAlignedFree(row_scale_);
+    }
+    if (rowZeroPointAllocatedHere) {
+      fbgemmAlignedFree(row_zero_point_);
+    }
+  }
+
+ private:
+  matrix_op_t trans_;
+  const float* smat_;
+  std::int32_t ld_;
+  std::int32_t* row_offset_{nullptr};
+  float* row_scale_{nullptr};
+  std::int32_t* row_zero_point_{nullptr};
+  bool rowOffsetAllocatedHere{false};
+  bool rowScaleAllocatedHere{false};
+  bool rowZeroPointAllocatedHere{false};
+  std::int32_t row_interleave_B_;
+  /// Quantization parameters of every row of A, computed by the first group
+  /// that packs the row and reused by the others. Empty with one group.
+  std::vector<TensorQuantizationParams> rowQParams_;
+  std::vector<bool> rowQParamsReady_;
+
+  /**
+   * @brief Quantization parameters of a row of A over all its columns.
+   */
+  TensorQuantizationParams rowQuantParams(std::int32_t row) const;
+};
+
 /*
  *
  * Post Processing of outputs
@@ -1316,6 +1516,43 @@ class FBGEMM_API ReQuantizeForFloat {
         ncols_(nCol),
         groups_(groups) {}
 
+  /**
+   * Requantizes an A that was quantized per row, e.g. packed with
+   * PackAWithRowwiseQuantRowOffset.
+   *
+   * @param Aq_scales Per-row scales of A for the current row block. Typically
+   *                  obtained by
+   *                  PackAWithRowwiseQuantRowOffset::getRowScaleBuffer().
+   * @param Aq_zero_points Per-row zero points of A, same layout as Aq_scales.
+   *
+   * The other parameters are the same as above.
+   */
+  ReQuantizeForFloat(
+      nextOPType& nextop,
+      const float* Aq_scales,
+      const std::int32_t* Aq_zero_points,
+      const float* Bq_scale,
+      const std::int32_t* Bq_zero_point,
+      const std::int32_t* row_offsets,
+      const std::int32_t* col_offsets,
+      const float* bias,
+      std::uint32_t nCol,
+      int groups = 1)
+      : ReQuantizeForFloat(
+            nextop,
+            0.0f,
+            Bq_scale,
+            0,
+            Bq_zero_point,
+            row_offsets,
+            col_offsets,
+            bias,
+            nCol,
+            groups) {
+    Aq_scales_ = Aq_scales;
+    Aq_zero_points_ = Aq_zero_points;
+  }
+
   template <inst_set_t instSet>
   inline int f(
       outT* out,
@@ -1324,6 +1561,21 @@ class FBGEMM_API ReQuantizeForFloat {
       int ld_out,
       int ld_in) const;
 
+  void setRowOffsets(const std::int32_t* row_offsets) {
+    q_row_offsets_ = row_offsets;
+  }
+
+  /**
+   * @brief Reads the quantization parameters of A per row from the given
+   *        buffers, e.g. the ones of PackAWithRowwiseQuantRowOffset.
+   */
+  void setRowQuantParams(
+      const float* Aq_scales,
+      const std::int32_t* Aq_zero_points) {
+    Aq_scales_ = Aq_scales;
+    Aq_zero_points_ = Aq_zero_points;
+  }
+
  private:
   nextOPType& nextop_;
   float Aq_scale_;
@@ -1335,6 +1587,8 @@ class FBGEMM_API ReQuantizeForFloat {
   const float* bias_;
   std::uint32_t ncols_;
   int groups_;
+  const float* Aq_scales_{nullptr};
+  const std::int32_t* Aq_zero_points_{nullptr};
 };
 
 // type specialized implementation in an include file
@@ -1380,6 +1634,58 @@ FBGEMM_API void fbgemmPacked(
     int num_threads,
     const BlockingFactors* blocking_params = nullptr);
 
+/**
+ * @brief The arguments of fbgemmPacked for one GEMM of fbgemmGroupedPacked.
+ */
+template <
+    typename packingAMatrix,
+    typename packingBMatrix,
+    typename cT,
+    typename processOutputType>
+struct GroupedGemmArgs {
+  PackMatrix<
+      packingAMatrix,
+      typename packingAMatrix::inpType,
+      typename packingAMatrix::accType>* packA;
+  PackMatrix<
+      packingBMatrix,
+      typename packingBMatrix::inpType,
+      typename packingBMatrix::accType>* packB;
+  cT* C;
+  std::int32_t* C_buffer;
+  std::uint32_t ldc;
+  const processOutputType* outProcess;
+};
+
+/**
+ * @brief Runs independent GEMMs of different shapes, e.g. the many small per
+ * feature MLPs of a model, in one parallel region.
+ *
+ * The tiles of all GEMMs, i.e. the MCB x NCB blocks of C of every group, are
+ * split into contiguous ranges of about the same number of multiply-adds, one
+ * per thread. Threads only meet at the end of the parallel region instead of
+ * after every GEMM, which dominates when each GEMM takes a few microseconds.
+ *
+ * Like for fbgemmPacked, every thread passes its own packing objects for A,
+ * and output processing objects reading their row offsets, and B must be
+ * prepacked. Every C_buffer must have as many rows as its C.
+ */
+template <
+    typename packingAMatrix,
+    typename packingBMatrix,
+    typename cT,
+    typename processOutputType>
+FBGEMM_API void fbgemmGroupedPacked(
+    const GroupedGemmArgs<
+        packingAMatrix,
+        packingBMatrix,
+        cT,
+        processOutputType>* gemms,
+    int num_gemms,
+    int thread_id,
+    int num_threads,
+    const BlockingFactors* blocking_params = nullptr);
+
 /**
  * @brief Perform small-channels-per-group groupwise convolution
  *        Note: Currently threading is not supported. This function does
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "./FbgemmBuild.h"
+#include "./Utils.h"
+
+namespace fbgemm {
+
+/**
+ * Autotuned blocking factors for the int8 GEMM (fbgemmPacked).
+ *
+ * The tuning table maps a GEMM shape (M, N, K per group), accumulation type
+ * and instruction set to the BlockingFactors that ran fastest for it. When no
+ * BlockingFactors are passed, PackBMatrix and fbgemmPacked look the shape up
+ * in the table instead of using the defaults of PackingTraits-inl.h. This
+ * also applies to the im2col and pointwise paths of fbgemmConv.
+ *
+ * B is packed knowing only N and K, so the table keeps one KCB per K and one
+ * NCB per (N, K); entries breaking that are rejected. B packed for (N, K)
+ * uses the entry with the largest M, or the tuned KCB of K with the default
+ * NCB if (N, K) has no entry. fbgemmPacked uses the entry of the actual M if
+ * B was packed with its KCB and NCB, else the factors B was packed with, and
+ * packs A with the resulting KCB. Tuned MCB and KCB never exceed the
+ * defaults, so A and buffers sized with the defaults (e.g.
+ * rowOffsetBufferSize()) stay large enough.
+ *
+ * Entries only apply to the B matrices packed after they are added; a B
+ * prepacked before keeps running with the factors it was packed with.
+ * Setting the FBGEMM_BLOCKING_FACTORS_DB environment variable to a file name
+ * loads the table from that file when it is first used and saves it at
+ * process exit if entries were added.
+ *
+ * 16-bit accumulation is not tuned on VNNI machines, which run it with 32-bit
+ * accumulation kernels.
+ */
+
+struct AutotuneOptions {
+  int warmupIterations{2};
+  int iterations{5}; ///< timed runs per candidate, the fastest one counts
+  int numThreads{1}; ///< threads running fbgemmPacked during tuning
+  int maxCandidates{64}; ///< candidates timed per shape
+  bool addToTable{true}; ///< add the best candidate to the tuning table
+};
+
+/**
+ * @brief Times fbgemmPacked for a series of blocking factors on random data
+ *        of the given shape and returns the fastest ones that computed the
+ *        correct result. Candidates are searched one group of factors at a
+ *        time (register blocking, NCB, KCB, MCB) starting from the defaults
+ *        and respecting the KCB and NCB already in the table for K and
+ *        (N, K).
+ * @param K the number of columns of A per group.
+ */
+template <typename accT = std::int32_t>
+FBGEMM_API BlockingFactors fbgemmAutotuneBlockingFactors(
+    int M,
+    int N,
+    int K,
+    const AutotuneOptions& options = AutotuneOptions());
+
+/**
+ * @brief Adds or replaces the entry of (M, N, K) for the current instruction
+ *        set.
+ * @return false if params are not valid for this instruction set or conflict
+ *         with the KCB or NCB of other entries with the same K or (N, K).
+ */
+template <typename accT = std::int32_t>
+FBGEMM_API bool fbgemmAddTunedBlockingFactors(
+    int M,
+    int N,
+    int K,
+    const BlockingFactors& params);
+
+/**
+ * @brief Copies the entry of (M, N, K) for the current instruction set into
+ *        params.
+ * @return false if there is none.
+ */
+template <typename accT = std::int32_t>
+FBGEMM_API bool fbgemmGetTunedBlockingFactors(
+    int M,
+    int N,
+    int K,
+    BlockingFactors* params);
+
+/**
+ * @brief Adds the entries of a file written by fbgemmSaveTunedBlockingFactors
+ *        to the table. Entries of other instruction sets are kept for saving
+ *        but never used.
+ * @return number of entries added, -1 if the file cannot be read or is not a
+ *         tuning table.
+ */
+FBGEMM_API std::int64_t fbgemmLoadTunedBlockingFactors(
+    const std::string& path);
+
+/**
+ * @brief Writes the table as text, one entry per line. The file is written
+ *        to a temporary name and renamed.
+ * @return true on success.
+ */
+FBGEMM_API bool fbgemmSaveTunedBlockingFactors(const std::string& path);
+
+/**
+ * @brief Removes all entries. Matrices already packed with tuned factors
+ *        keep them.
+ */
+FBGEMM_API void fbgemmClearTunedBlockingFactors();
+
+/**
+ * @return number of entries in the table, all instruction sets included.
+ */
+FBGEMM_API std::size_t fbgemmNumTunedBlockingFactors();
+
+} // namespace fbgemm
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// bf16 weight x fp32 activation GEMM. Mirrors the fp16 path in FbgemmFP16.h:
+// B is packed once into bf16 and widened to fp32 inside the microkernels, so
+// the weights take half the memory bandwidth of fp32 without losing range.
+
+#include <cpuinfo.h>
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "./FbgemmFPCommon.h"
+#include "./FbgemmPackMatrixB.h"
+#include "./Types.h"
+#include "./Utils.h"
+
+namespace fbgemm {
+
+template <>
+struct TypeConverter<BFloat16> {
+  BFloat16 operator()(float src) const {
+    return BFloat16{cpu_float2bfloat16(src)};
+  }
+};
+
+using PackedGemmMatrixBF16 = PackedGemmMatrixB<BFloat16>;
+
+extern template void cblas_gemm_compute<BFloat16>(
+    const matrix_op_t transa,
+    const int m,
+    const float* A,
+    const PackedGemmMatrixBF16& Bp,
+    const float beta,
+    float* C,
+    int thread_id,
+    int num_threads);
+
+extern template void cblas_gemm_compute_k_range<BFloat16>(
+    const matrix_op_t transa,
+    const int m,
+    const float* A,
+    const PackedGemmMatrixBF16& Bp,
+    const float beta,
+    float* C,
+    int k_begin,
+    int k_end,
+    int thread_id,
+    int num_threads);
+
+} // namespace fbgemm
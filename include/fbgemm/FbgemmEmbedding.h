@@ -116,6 +116,57 @@ GenerateEmbeddingSpMDMWithStrides(
     bool is_bf16_out = false,
     bool is_bf16_in = false);
 
+/**
+ * One table of a grouped EmbeddingSpMDM call. indices and weights are indexed
+ * with the values in offsets, which don't have to start at 0 (e.g., when the
+ * offsets of all the tables are concatenated as in table batched embedding).
+ */
+template <
+    typename InType,
+    typename IndexType,
+    typename OffsetType = std::int32_t,
+    typename OutType = float>
+struct EmbeddingSpMDMTableArgs {
+  std::int64_t block_size;
+  std::int64_t output_size; // number of bags
+  std::int64_t data_size; // number of rows in input
+  const InType* input;
+  const IndexType* indices;
+  const OffsetType* offsets; // output_size + 1 offsets
+  const float* weights{nullptr}; // optional, can be null for non-weighted sum
+  OutType* out;
+  std::int64_t output_stride{-1};
+  std::int64_t input_stride{-1};
+  bool scale_bias_last{true};
+};
+
+/**
+ * Pooled embedding lookups of many tables in one call.
+ *
+ * The bags of all the tables are split into (table, bag range) chunks of
+ * roughly equal estimated bytes touched, so that tables with skewed pooling
+ * factors are spread over all the threads instead of being handled by one.
+ * Each thread starts on its own contiguous range of chunks and steals chunks
+ * from the other threads once it runs out.
+ *
+ * @tparam InType can be float, float16, or uint8_t
+ * @param num_threads number of OpenMP threads, 0 for omp_get_max_threads()
+ * @return false if any table has an out of bound index. Outputs of the other
+ *         tables are still computed.
+ */
+template <
+    typename InType,
+    typename IndexType,
+    typename OffsetType = std::int32_t,
+    typename OutType = float>
+FBGEMM_API bool EmbeddingSpMDMGrouped(
+    const EmbeddingSpMDMTableArgs<InType, IndexType, OffsetType, OutType>*
+        tables,
+    int num_tables,
+    bool normalize_by_lengths,
+    int prefetch = 16,
+    int num_threads = 0);
+
 /**
  * @tparam IndexType can be int32_t or int64_t
  * @tparam OffsetType can be int32_t or int64_t
@@ -147,6 +198,12 @@ GenerateEmbeddingSpMDMNBit(
  *        of each row and are in fp16 for table batched embedding (TBE)
  *        in FBGEMM_GPU. If false, it can also take -1 indices (output from
  *        pruned embedding id mapping)
+ * @param prefetch_group If > 1, software pipelined prefetching for tables much
+ *        larger than LLC: once every prefetch_group indices, the whole rows
+ *        (including scale and bias) of the prefetch_group indices starting
+ *        prefetch indices ahead are prefetched together, so that many DRAM
+ *        accesses are in flight at once. Rounded down to a power of 2, at
+ *        most 32. If 1, a single row is prefetched per index as before.
  */
 template <
     typename IndexType,
@@ -169,7 +226,8 @@ GenerateEmbeddingSpMDMNBitWithStrides(
     std::int64_t output_stride = -1,
     std::int64_t input_stride = -1,
     bool scale_bias_last = true,
-    bool is_bf16_out = false);
+    bool is_bf16_out = false,
+    int prefetch_group = 1);
 
 /**
  * @param output_stride If -1, output_stride is same as block_size
@@ -179,6 +237,7 @@ GenerateEmbeddingSpMDMNBitWithStrides(
  *                      (normally 4 or 5)
  * @param exponent_bias is subtracted from the exponent to obtain the actual
  *                      exponent for the floating-point number
+ * @param prefetch is the prefetch distance in rows; 0 disables prefetching
  */
 template <
     typename IndexType,
@@ -198,7 +257,8 @@ GenerateEmbeddingSpMDMFP8WithStrides(
     std::int64_t input_stride = -1,
     int exponent_bits = 4,
     int exponent_bias = 7,
-    bool is_bf16_out = false);
+    bool is_bf16_out = false,
+    int prefetch = 16);
 
 template <
     typename InType,
@@ -330,6 +390,64 @@ GenerateRowWiseSparseAdaGradFused(
     bool use_stochastic_rounding = true,
     int grad_stride = -1);
 
+/**
+ * Adam, LAMB and LARS-SGD updates of one embedding row of block_size
+ * parameters from its already aggregated gradient, as done by the CPU split
+ * table batched embedding backward. The row and its momentums are read and
+ * written in one vectorized pass. The rowwise variants (partial rowwise Adam
+ * and LAMB) first reduce g to update their single second momentum, and LAMB
+ * and LARS-SGD take a second pass over w since their step depends on norms of
+ * the whole row.
+ * Weights can be either float or float16, which is rounded to nearest.
+ *
+ * @param v second momentums, a single value when rowwise is true
+ * @param iter step number starting from 1, used for bias correction
+ */
+template <typename DataType = float>
+FBGEMM_API void SparseAdamRowUpdate(
+    int block_size,
+    DataType* w, // input/output parameters
+    const float* g, // input gradients
+    float* m, // input/output first momentums
+    float* v, // input/output second momentums
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise = false);
+
+/**
+ * @param g input gradients, overwritten by the update direction
+ *          (r_t + weight_decay * w)
+ */
+template <typename DataType = float>
+FBGEMM_API void SparseLambRowUpdate(
+    int block_size,
+    DataType* w,
+    float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise = false);
+
+template <typename DataType = float>
+FBGEMM_API void SparseLarsSgdRowUpdate(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m, // input/output momentums
+    float lr,
+    float eta,
+    float momentum,
+    float weight_decay);
+
 namespace internal {
 // Specialization for block size 1 internally called by GenerateEmbeddingSpMDM
 template <typename InType, typename IndexType, typename OffsetType>
@@ -358,6 +476,125 @@ void compressed_indices_remap_avx512(
     IndexType* out_offsets,
     float* out_weights);
 
+void pruned_hashmap_lookup_avx2(
+    const std::int32_t* indices,
+    std::int64_t num_indices,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int32_t* dense_indices);
+
+void pruned_hashmap_lookup_avx512(
+    const std::int32_t* indices,
+    std::int64_t num_indices,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int32_t* dense_indices);
+
+template <typename IndexType>
+std::int64_t lxu_cache_lookup_avx2(
+    const IndexType* linear_cache_indices,
+    std::int64_t num_indices,
+    const std::int64_t* cache_state,
+    std::int32_t num_sets,
+    int ways,
+    std::int64_t invalid_index,
+    std::int32_t* cache_locations);
+
+template <typename IndexType>
+std::int64_t lxu_cache_lookup_avx512(
+    const IndexType* linear_cache_indices,
+    std::int64_t num_indices,
+    const std::int64_t* cache_state,
+    std::int32_t num_sets,
+    int ways,
+    std::int64_t invalid_index,
+    std::int32_t* cache_locations);
+
+template <typename DataType>
+void SparseAdamRowUpdateAvx2(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise);
+
+template <typename DataType>
+void SparseLambRowUpdateAvx2(
+    int block_size,
+    DataType* w,
+    float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise);
+
+template <typename DataType>
+void SparseLarsSgdRowUpdateAvx2(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float lr,
+    float eta,
+    float momentum,
+    float weight_decay);
+
+// FP8 kernels internally called by GenerateEmbeddingSpMDMFP8WithStrides. The
+// strides must already be resolved, i.e., not -1.
+template <typename IndexType, typename OffsetType, typename OutType>
+bool EmbeddingSpMDMFP8_avx2(
+    const std::int64_t block_size,
+    const std::int64_t output_size,
+    const std::int64_t index_size,
+    const std::int64_t data_size,
+    const std::uint8_t* input,
+    const IndexType* indices,
+    const OffsetType* offsets_or_lengths,
+    const float* weights, // optional, can be null for non-weighted sum
+    bool normalize_by_lengths,
+    OutType* out,
+    bool is_weight_positional,
+    bool use_offsets,
+    std::int64_t output_stride,
+    std::int64_t input_stride,
+    int exponent_bits,
+    int exponent_bias,
+    bool is_bf16_out,
+    int prefetch);
+
+template <typename IndexType, typename OffsetType, typename OutType>
+bool EmbeddingSpMDMFP8_avx512(
+    const std::int64_t block_size,
+    const std::int64_t output_size,
+    const std::int64_t index_size,
+    const std::int64_t data_size,
+    const std::uint8_t* input,
+    const IndexType* indices,
+    const OffsetType* offsets_or_lengths,
+    const float* weights, // optional, can be null for non-weighted sum
+    bool normalize_by_lengths,
+    OutType* out,
+    bool is_weight_positional,
+    bool use_offsets,
+    std::int64_t output_stride,
+    std::int64_t input_stride,
+    int exponent_bits,
+    int exponent_bias,
+    bool is_bf16_out,
+    int prefetch);
+
 } // namespace internal
 
 template <typename IndexType>
@@ -371,4 +608,60 @@ FBGEMM_API void compressed_indices_remap(
     IndexType* out_offsets,
     float* out_weights);
 
+/**
+ * Maps the sparse ids of one pruned embedding table to dense row ids through
+ * the table's hash map, as built by pruned_hashmap_insert in fbgemm_gpu.
+ *
+ * @param hash_table capacity x 2 array of (sparse id, dense id) pairs. An id
+ *                   lives at its MurmurHash3 fmix32 hash modulo capacity or,
+ *                   on collision, at the next free slot (linear probing).
+ *                   Empty slots have sparse id -1.
+ * @param capacity number of slots, must be positive
+ * @param dense_indices receives the dense id of every index, or -1 for ids
+ *                      that are not in the table (pruned rows)
+ */
+FBGEMM_API void pruned_hashmap_lookup(
+    const std::int32_t* indices,
+    std::int64_t num_indices,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int32_t* dense_indices);
+
+/**
+ * Set that linear cache index h_in maps to in a set-associative embedding
+ * row cache of fbgemm_gpu (LXU cache) with C sets: the MurmurHash3 64-bit
+ * finalizer of h_in modulo C, as in the CUDA cache kernels.
+ */
+inline std::uint32_t lxu_cache_slot(std::int64_t h_in, std::int32_t C) {
+  std::uint64_t h = static_cast<std::uint64_t>(h_in);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccd;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53;
+  h ^= h >> 33;
+  return h % static_cast<std::uint32_t>(C);
+}
+
+/**
+ * Finds the cache locations of linear cache indices in a set-associative
+ * embedding row cache.
+ *
+ * @param cache_state num_sets x ways linear indices of the cached rows, -1
+ *                    for empty ways. An index can only be cached in the ways
+ *                    of set lxu_cache_slot(index, num_sets).
+ * @param invalid_index indices equal to it (e.g. pruned rows) are skipped
+ * @param cache_locations receives set * ways + way for cached indices, and
+ *                        -1 for the others
+ * @return the number of indices other than invalid_index that are not cached
+ */
+template <typename IndexType>
+FBGEMM_API std::int64_t lxu_cache_lookup(
+    const IndexType* linear_cache_indices,
+    std::int64_t num_indices,
+    const std::int64_t* cache_state,
+    std::int32_t num_sets,
+    int ways,
+    std::int64_t invalid_index,
+    std::int32_t* cache_locations);
+
 } // namespace fbgemm
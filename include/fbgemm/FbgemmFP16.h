@@ -18,6 +18,7 @@
 #include <stdexcept>
 #include <vector>
 
+#include "./FbgemmFPCommon.h"
 #include "./FbgemmPackMatrixB.h"
 #include "./Types.h"
 #include "./Utils.h"
@@ -35,24 +36,25 @@ struct TypeConverter<float16> {
 
 using PackedGemmMatrixFP16 = PackedGemmMatrixB<float16>;
 
-template <typename T>
-FBGEMM_API void cblas_gemm_compute(
+extern template void cblas_gemm_compute<float16>(
     const matrix_op_t transa,
     const int m,
     const float* A,
-    const PackedGemmMatrixB<T>& Bp,
+    const PackedGemmMatrixFP16& Bp,
     const float beta,
     float* C,
-    int thread_id = 0,
-    int num_threads = 1);
+    int thread_id,
+    int num_threads);
 
-extern template void cblas_gemm_compute<float16>(
+extern template void cblas_gemm_compute_k_range<float16>(
     const matrix_op_t transa,
     const int m,
     const float* A,
     const PackedGemmMatrixFP16& Bp,
     const float beta,
     float* C,
+    int k_begin,
+    int k_end,
     int thread_id,
     int num_threads);
 
@@ -73,8 +73,25 @@ FBGEMM_API void cblas_gemm_compute(
     int thread_id = 0,
     int num_threads = 1);
 
+/**
+ * @brief cblas_gemm_compute over the rows [k_begin, k_end) of B, i.e.
+ * C = beta * C + A[:, k_begin:k_end] * B[k_begin:k_end, :], to split k across
+ * threads. k_begin must be a multiple of Bp.blockRowSize().
+ */
+template <typename T>
+FBGEMM_API void cblas_gemm_compute_k_range(
+    const matrix_op_t transa,
+    const int m,
+    const float* A,
+    const PackedGemmMatrixB<T>& Bp,
+    const float beta,
+    float* C,
+    int k_begin,
+    int k_end,
+    int thread_id = 0,
+    int num_threads = 1);
+
 #if defined(FBGEMM_EXPORTS)
-// autotuned kernel splits for various cases m = 1:mb_max
 template <typename T>
 void cblas_gemm_compute(
     const matrix_op_t transa,
@@ -85,6 +102,23 @@ void cblas_gemm_compute(
     float* C,
     int thread_id,
     int num_threads) {
+  cblas_gemm_compute_k_range(
+      transa, m, A, Bp, beta, C, 0, Bp.numRows(), thread_id, num_threads);
+}
+
+// autotuned kernel splits for various cases m = 1:mb_max
+template <typename T>
+void cblas_gemm_compute_k_range(
+    const matrix_op_t transa,
+    const int m,
+    const float* A,
+    const PackedGemmMatrixB<T>& Bp,
+    const float beta,
+    float* C,
+    int k_begin,
+    int k_end,
+    int thread_id,
+    int num_threads) {
   // ground truth
   assert(cpuinfo_initialize());
 #ifndef __aarch64__
@@ -93,6 +127,7 @@ void cblas_gemm_compute(
 #endif
   assert(transa == matrix_op_t::NoTranspose);
   (void)transa; // Suppress unused variable warning
+  assert(k_begin % Bp.blockRowSize() == 0 && k_end <= Bp.numRows());
 
   const auto iset = fbgemmInstructionSet();
   // private scratchpad storage
@@ -130,10 +165,10 @@ void cblas_gemm_compute(
   for (auto m0 = i_begin; m0 < i_end; m0 += mb_max) {
     int mb = std::min(mb_max, i_end - m0);
     assert(mb < static_cast<int64_t>(partition.size()));
-    for (auto k_ind = 0; k_ind < k; k_ind += Bp.blockRowSize()) {
+    for (auto k_ind = k_begin; k_ind < k_end; k_ind += Bp.blockRowSize()) {
       // set up proper accumulation to avoid "Nan" problem
       float beta_;
-      if (k_ind == 0) {
+      if (k_ind == k_begin) {
         // accumulate of beta != 0.0
         // do not!!! accumulate otherwise
         beta_ = beta;
@@ -142,7 +177,7 @@ void cblas_gemm_compute(
         beta_ = 1.0f;
       }
 
-      const int kb = std::min(Bp.blockRowSize(), Bp.numRows() - k_ind);
+      const int kb = std::min(Bp.blockRowSize(), k_end - k_ind);
 
       auto m1 = m0;
       auto const num_cycles = partition[mb].size();
@@ -49,9 +49,22 @@ class FBGEMM_API PackedDepthWiseConvMatrix {
   int addr(int r, int c);
 
  private:
+  friend class PackedWeightSerializer;
+
+  /**
+   * @brief Wraps pmat, which is already packed, without packing. Used to load
+   * serialized weights.
+   */
+  PackedDepthWiseConvMatrix(
+      int OC,
+      int kernel_prod,
+      std::int8_t* pmat,
+      bool bufAllocatedHere);
+
   const int OC_; /**< the number of output channels */
   const int kernel_prod_; /** the product of all kernel dims */
   std::int8_t* pmat_; /** packed weight */
+  bool bufAllocatedHere_{true}; /** whether pmat_ is freed on destruction */
 }; // PackedDepthWiseConvMatrix
 
 /**
@@ -54,7 +54,17 @@ class FBGEMM_API PackedDirectConvMatrix {
       int ncols_per_quant_group);
 
  private:
+  friend class PackedWeightSerializer;
+
+  /**
+   * @brief Wraps pmat, which is already packed, without packing. Used to load
+   * serialized weights.
+   */
+  PackedDirectConvMatrix(std::int8_t* pmat, bool bufAllocatedHere)
+      : pmat_(pmat), bufAllocatedHere_(bufAllocatedHere) {}
+
   std::int8_t* pmat_; /** packed weight */
+  bool bufAllocatedHere_{true}; /** whether pmat_ is freed on destruction */
   bool first_call{true};
 };
 
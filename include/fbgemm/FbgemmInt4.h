@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "fbgemm/Types.h"
+#include "fbgemm/Utils.h"
+
+namespace fbgemm {
+
+/**
+ * @brief Weight-only int4 B matrix (K x N) with group-wise quantization.
+ *
+ * Every column is split along K into groups of groupSize rows, each with its
+ * own float scale and integer zero point:
+ *   B[k][n] = scale[g][n] * (q[k][n] - zero_point[g][n]), g = k / groupSize
+ * where q is an unsigned 4-bit code in [0, 15].
+ *
+ * Columns are packed in blocks of COL_BLOCK (16) and rows in quads. The 32
+ * bytes of a (column block, row quad) tile hold, at byte 4 * c + r, the code
+ * of column c in the low nibble and of column c + 8 in the high nibble for
+ * row r of the quad. Masking out either nibble thus gives the 4 consecutive
+ * k bytes per 32-bit lane that the u8s8s32 acc32 kernels consume, and the fp32
+ * kernels unpack a row with a shift and a mask per lane.
+ */
+class FBGEMM_API PackedInt4GemmMatrixB {
+ public:
+  static constexpr int COL_BLOCK = 16;
+  static constexpr int ROW_BLOCK = 4;
+
+  /**
+   * Quantizes float weights with the min and max of every group of every
+   * column (zero is always representable).
+   * @param trans Transpose if smat is N x K.
+   * @param groupSize Must be a multiple of ROW_BLOCK that divides nrow.
+   */
+  PackedInt4GemmMatrixB(
+      matrix_op_t trans,
+      int nrow,
+      int ncol,
+      const float* smat,
+      int groupSize = 128);
+
+  /**
+   * Packs already quantized weights.
+   * @param qmat K x N row-major codes in [0, 15], one per byte.
+   * @param scales, zero_points (nrow / groupSize) x ncol row-major.
+   */
+  PackedInt4GemmMatrixB(
+      int nrow,
+      int ncol,
+      int groupSize,
+      const std::uint8_t* qmat,
+      const float* scales,
+      const std::int32_t* zero_points);
+
+  int numRows() const {
+    return nrow_;
+  }
+
+  int numCols() const {
+    return ncol_;
+  }
+
+  int groupSize() const {
+    return groupSize_;
+  }
+
+  int numGroups() const {
+    return nrow_ / groupSize_;
+  }
+
+  int numColBlocks() const {
+    return (ncol_ + COL_BLOCK - 1) / COL_BLOCK;
+  }
+
+  /// Leading dimension of the group-wise parameter arrays.
+  int paddedCols() const {
+    return numColBlocks() * COL_BLOCK;
+  }
+
+  /// Packed codes of column block jb, nrow / ROW_BLOCK tiles of 32 bytes.
+  const std::uint8_t* blockAddr(int jb) const {
+    return pmat_.data() +
+        static_cast<std::size_t>(jb) * nrow_ * COL_BLOCK / 2;
+  }
+
+  /// numGroups() x paddedCols(), zero for the padded columns.
+  const float* scales() const {
+    return scales_.data();
+  }
+
+  const std::int32_t* zeroPoints() const {
+    return zero_points_.data();
+  }
+
+  /// Sum of the codes of every group and column, used by the W4A8 kernels to
+  /// fold in the activation zero point.
+  const std::int32_t* groupColSums() const {
+    return col_sums_.data();
+  }
+
+  std::uint8_t quantizedValue(int k, int n) const;
+
+  /// Dequantizes into a K x N row-major matrix.
+  void unpack(float* dst) const;
+
+  /// Size in bytes of the packed codes and group-wise parameters.
+  std::size_t packedBytes() const;
+
+ private:
+  void initialize();
+  void pack(const std::uint8_t* qmat, int ld_k, int ld_n);
+  void computeColSums();
+
+  int nrow_, ncol_, groupSize_;
+  std::vector<std::uint8_t> pmat_;
+  std::vector<float> scales_;
+  std::vector<std::int32_t> zero_points_;
+  std::vector<std::int32_t> col_sums_;
+};
+
+/**
+ * @brief W4-FP32 GEMM: C = A * dequant(Bp) + beta * C.
+ *
+ * A is m x K row-major fp32 and C is m x N row-major fp32. Column blocks of Bp
+ * are split across threads, which suits the small m (memory bound) case the
+ * int4 format is meant for.
+ */
+FBGEMM_API void fbgemmInt4Gemm(
+    int m,
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int thread_id = 0,
+    int num_threads = 1);
+
+/**
+ * @brief W4A8 GEMM: C = A_scale * (A - A_zero_point) * dequant(Bp) + beta * C.
+ *
+ * A is m x K row-major uint8 quantized per tensor. Products are accumulated in
+ * int32 per group with the u8s8s32 multiply-add instructions and rescaled to
+ * fp32 once per group.
+ */
+FBGEMM_API void fbgemmInt4Gemm(
+    int m,
+    const std::uint8_t* A,
+    int lda,
+    float A_scale,
+    std::int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int thread_id = 0,
+    int num_threads = 1);
+
+namespace internal {
+
+// The kernels compute column blocks [jb_begin, jb_end) of C.
+// A_group_sums is m x numGroups: the sums of A over every group, minus
+// groupSize * A_zero_point for the W4A8 kernels.
+
+void Int4GemmFP32Avx2(
+    int m,
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const float* A_group_sums);
+
+void Int4GemmFP32Avx512(
+    int m,
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const float* A_group_sums);
+
+void Int4GemmU8Avx2(
+    int m,
+    const std::uint8_t* A,
+    int lda,
+    float A_scale,
+    std::int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const std::int32_t* A_group_sums);
+
+void Int4GemmU8Avx512(
+    int m,
+    const std::uint8_t* A,
+    int lda,
+    float A_scale,
+    std::int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const std::int32_t* A_group_sums);
+
+} // namespace internal
+
+} // namespace fbgemm
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fbgemm/FbgemmBuild.h"
+
+namespace fbgemm {
+
+/**
+ * Persistent JIT kernel cache.
+ *
+ * Kernels generated by the asmjit code generators can be written to disk and
+ * reused by later processes to avoid paying the code generation cost at
+ * startup. Entries are keyed by the code cache they belong to and by the
+ * existing kernel key tuple. The file additionally records the instruction
+ * set in use and the library build; a file written by a different build or
+ * for a different ISA is ignored and kernels are JIT'd as usual. Kernels that
+ * are missing from the file are JIT'd and added to it.
+ *
+ * Only position independent kernels are persisted; kernels whose key contains
+ * runtime pointers (e.g. the rowwise sparse adagrad fused kernels) are always
+ * JIT'd.
+ *
+ * Setting the FBGEMM_KERNEL_CACHE_PATH environment variable to a file name
+ * enables the cache for the whole process: the file is loaded when the library
+ * is initialized and saved at process exit if new kernels were generated.
+ */
+
+/**
+ * @brief Enable the persistent kernel cache and load kernels from path.
+ * @return number of kernels loaded, 0 if the file does not exist or was
+ *         written by a different build or for a different instruction set,
+ *         -1 if the file is corrupted.
+ */
+FBGEMM_API std::int64_t fbgemmLoadKernelCache(const std::string& path);
+
+/**
+ * @brief Write all loaded and newly JIT'd persistable kernels to path.
+ *        The file is written to a temporary name and renamed so concurrent
+ *        readers never observe a partial file.
+ * @return true on success.
+ */
+FBGEMM_API bool fbgemmSaveKernelCache(const std::string& path);
+
+/**
+ * @brief Write the signatures of all kernels generated so far in this process
+ *        to path, one "<code cache>\t<key>" line per kernel.
+ * @return true on success.
+ */
+FBGEMM_API bool fbgemmSaveKernelManifest(const std::string& path);
+
+/**
+ * @brief Install every kernel listed in a manifest written by
+ *        fbgemmSaveKernelManifest into the in-memory code caches, taking the
+ *        code from the persistent kernel cache. Signatures that are not in the
+ *        persistent cache are skipped and JIT'd lazily on first use.
+ * @return number of kernels installed, -1 if the manifest cannot be read.
+ */
+FBGEMM_API std::int64_t fbgemmPrewarmKernelCache(
+    const std::string& manifestPath);
+
+/**
+ * In-memory JIT code caches.
+ *
+ * Every kernel generator keeps its kernels in a code cache. Lookups of cached
+ * kernels don't take locks. By default the caches are unbounded; with a
+ * capacity set, each cache evicts kernels once it holds more than that many.
+ * LRU evicts the least recently used kernel, approximated with the CLOCK
+ * algorithm. LFU evicts the least frequently used kernel, approximated by
+ * aging reference bits.
+ *
+ * Kernel pointers handed out earlier may still be in use, so the code of
+ * evicted kernels is not freed right away. An evicted kernel that is
+ * requested again is put back into its cache without being regenerated.
+ * fbgemmReleaseEvictedKernels frees the code for good.
+ *
+ * The FBGEMM_KERNEL_CACHE_CAPACITY and FBGEMM_KERNEL_CACHE_POLICY ("LRU" or
+ * "LFU") environment variables set the initial capacity and policy.
+ */
+enum class KernelCacheEvictionPolicy {
+  LRU,
+  LFU,
+};
+
+struct KernelCacheStats {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0}; ///< lookups that generated or reloaded a kernel
+  std::uint64_t evictions{0};
+  std::uint64_t entries{0}; ///< kernels currently cached
+  std::uint64_t evicted{0}; ///< evicted kernels whose code is not released
+  std::uint64_t codegenNanoseconds{0}; ///< total time spent generating code
+  std::uint64_t codeBytes{0}; ///< code size of cached and evicted kernels
+};
+
+struct KernelCacheKeyStats {
+  std::string key; ///< kernel key tuple, comma separated
+  std::uint64_t hits{0}; ///< estimated, hits are sampled
+};
+
+struct KernelCacheInfo {
+  std::string name; ///< name of the generator class owning the cache
+  KernelCacheStats stats;
+  std::vector<KernelCacheKeyStats> hottestKeys; ///< most hit first
+};
+
+/// Executable memory mapped by the asmjit runtimes of all generators.
+struct JitMemoryStats {
+  std::uint64_t reservedBytes{0};
+  std::uint64_t usedBytes{0};
+};
+
+/**
+ * @brief Bound every code cache to maxEntries kernels, 0 means unbounded.
+ *        Takes effect at the next insertion into each cache.
+ */
+FBGEMM_API void fbgemmSetKernelCacheCapacity(
+    std::size_t maxEntries,
+    KernelCacheEvictionPolicy policy = KernelCacheEvictionPolicy::LRU);
+
+/**
+ * @brief Counters summed over all code caches. Thread local caches are not
+ *        included.
+ */
+FBGEMM_API KernelCacheStats fbgemmGetKernelCacheStats();
+
+/**
+ * @brief Stats of every code cache, including its numHottestKeys most hit
+ *        kernels. Thread local caches are not included.
+ */
+FBGEMM_API std::vector<KernelCacheInfo> fbgemmGetKernelCacheInfo(
+    std::size_t numHottestKeys = 8);
+
+FBGEMM_API JitMemoryStats fbgemmGetJitMemoryStats();
+
+/**
+ * @brief fbgemmGetKernelCacheStats, fbgemmGetKernelCacheInfo and
+ *        fbgemmGetJitMemoryStats as a JSON document.
+ */
+FBGEMM_API std::string fbgemmKernelCacheStatsToJson(
+    std::size_t numHottestKeys = 8);
+
+/**
+ * @brief Free the code of all evicted kernels.
+ *        Must not run concurrently with FBGEMM calls. Kernels previously
+ *        returned by the Generate* functions must not be used afterwards if
+ *        they were evicted.
+ * @return number of kernels released.
+ */
+FBGEMM_API std::size_t fbgemmReleaseEvictedKernels();
+
+} // namespace fbgemm
@@ -88,6 +88,36 @@ class PackedGemmMatrixB {
     initializeMemory();
   }
 
+  /**
+   * Wraps pmat, which is already packed with the given layout, e.g. when
+   * loading serialized weights. pmat is not freed by the destructor unless
+   * bufAllocatedHere is true.
+   */
+  PackedGemmMatrixB(
+      const int nrow,
+      const int ncol,
+      const int brow,
+      const int last_brow,
+      const int bcol,
+      const int nbrow,
+      const int nbcol,
+      const uint64_t size,
+      const int kernel_ncol_blocks,
+      T* pmat,
+      bool bufAllocatedHere = false)
+      : nrow_(nrow),
+        ncol_(ncol),
+        brow_(brow),
+        last_brow_(last_brow),
+        bcol_(bcol),
+        nbrow_(nbrow),
+        nbcol_(nbcol),
+        size_(size),
+        kernel_ncol_blocks_(kernel_ncol_blocks),
+        pmat_(pmat),
+        packed_(true),
+        bufAllocatedHere_(bufAllocatedHere) {}
+
   void initializeParam() {
     if (!cpuinfo_initialize()) {
       throw std::runtime_error("Failed to initialize cpuinfo!");
@@ -124,12 +154,14 @@ class PackedGemmMatrixB {
   void initializeMemory() {
     // allocate and initialize packed memory
     size_ = (blockRowSize() * nbrow_) * (blockColSize() * nbcol_);
-    pmat_ = static_cast<T*>(fbgemmAlignedAlloc(64, matSize() * sizeof(T)));
+    pmat_ = static_cast<T*>(fbgemmPackedWeightAlloc(64, matSize() * sizeof(T)));
     memset(pmat_, 0, matSize() * sizeof(T));
   }
 
   ~PackedGemmMatrixB() {
-    fbgemmAlignedFree(pmat_);
+    if (bufAllocatedHere_) {
+      fbgemmAlignedFree(pmat_);
+    }
   }
 
   void unpackFromSrc(const matrix_op_t trans, T* src_mat) {
@@ -256,6 +288,7 @@ class PackedGemmMatrixB {
   int kernel_ncol_blocks_;
   T* pmat_;
   bool packed_{false};
+  bool bufAllocatedHere_{true};
 };
 
 } // namespace fbgemm
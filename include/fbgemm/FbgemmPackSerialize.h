@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "./FbgemmBuild.h"
+#include "./Utils.h"
+
+namespace fbgemm {
+
+/**
+ * Version of the packed weight file format. Bumped whenever the file layout
+ * or the layout of a packed type changes; files of other versions are
+ * rejected.
+ */
+constexpr std::uint32_t kPackedWeightFormatVersion = 1;
+
+/**
+ * @brief Writes packed weights to a file, so that they are packed once
+ * offline instead of at every model load.
+ *
+ * A file holds any number of named packed objects of these types:
+ *   - PackBMatrix<int8_t, int32_t> and PackBMatrix<int8_t, int16_t>
+ *   - PackWeightsForConv<1|2|3>
+ *   - PackWeightMatrixForGConv<int8_t, int32_t|int16_t, 1|2|3>
+ *   - PackedDepthWiseConvMatrix
+ *   - PackedGemmMatrixFP16 and PackedGemmMatrixBF16
+ *   - BCSRMatrix<int8_t, 1, 4>
+ *
+ * Along with the packed buffers, each object's layout (shape, groups, block
+ * sizes, row interleave and the BlockingFactors it was packed with) is saved.
+ * Packed layouts depend on the instruction set, so the file is tagged with
+ * fbgemmInstructionSet() and can only be loaded on the same one. Integers are
+ * stored in native byte order.
+ */
+class FBGEMM_API PackedWeightWriter {
+ public:
+  /**
+   * @brief Creates or truncates path. Throws std::runtime_error on failure.
+   */
+  explicit PackedWeightWriter(const std::string& path);
+
+  /**
+   * @brief Closes the file if close() was not called, ignoring errors.
+   */
+  ~PackedWeightWriter();
+
+  PackedWeightWriter(const PackedWeightWriter&) = delete;
+  PackedWeightWriter& operator=(const PackedWeightWriter&) = delete;
+
+  /**
+   * @brief Appends packed under name. Throws std::runtime_error if name is
+   * already used or on I/O errors.
+   */
+  template <typename PackedT>
+  void add(const std::string& name, const PackedT& packed);
+
+  /**
+   * @brief Writes the index of the file. Throws std::runtime_error on I/O
+   * errors.
+   */
+  void close();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Loads packed weights written by PackedWeightWriter.
+ */
+class FBGEMM_API PackedWeightReader {
+ public:
+  /**
+   * @param useMmap If true, the file is mapped read only and the loaded
+   *                objects point into the mapping without copying, so the
+   *                reader must outlive them. Otherwise the packed buffers are
+   *                copied into memory allocated with fbgemmPackedWeightAlloc
+   *                and owned by the loaded objects. BCSRMatrix is always
+   *                copied.
+   *
+   * Throws std::runtime_error if the file can't be read, is not a packed
+   * weight file, or was written by another format version or for another
+   * instruction set.
+   */
+  explicit PackedWeightReader(const std::string& path, bool useMmap = true);
+  ~PackedWeightReader();
+
+  PackedWeightReader(const PackedWeightReader&) = delete;
+  PackedWeightReader& operator=(const PackedWeightReader&) = delete;
+
+  /**
+   * @return The names of the objects in the file, in the order they were
+   *         added.
+   */
+  std::vector<std::string> names() const;
+
+  bool contains(const std::string& name) const;
+
+  /**
+   * @brief Loads the object saved under name. Throws std::runtime_error if
+   * there is none or if it has another type.
+   */
+  template <typename PackedT>
+  std::unique_ptr<PackedT> load(const std::string& name) const;
+
+  /**
+   * @return The blocking factors the object saved under name was packed with,
+   *         or nullptr if it was packed with the default ones. They have to
+   *         be passed to fbgemmPacked or fbgemmConv as at pack time. Owned by
+   *         the reader.
+   */
+  const BlockingFactors* blockingFactors(const std::string& name) const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace fbgemm
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "./Fbgemm.h"
+#include "./FbgemmFP16.h"
+#include "./Utils.h"
+
+namespace fbgemm {
+
+/**
+ * @brief Read only packed weights with one copy per NUMA node.
+ *
+ * On multi-socket machines, threads on one socket that share a packed weight
+ * matrix read it from the memory of the other socket half of the time. This
+ * packs a copy of the weights bound to each node and hands each thread the
+ * copy of the node it runs on.
+ *
+ * @tparam PackedT Packed weight class whose buffers are allocated with
+ *                 fbgemmPackedWeightAlloc, e.g. PackBMatrix,
+ *                 PackWeightsForConv or PackedGemmMatrixFP16.
+ */
+template <typename PackedT>
+class ReplicatedPackedWeights {
+ public:
+  using packedType = PackedT;
+
+  /**
+   * @brief Packs the weights once per node.
+   *
+   * The arguments are those of the PackedT constructor. With emulated nodes
+   * (see fbgemmSetEmulatedNumaNodes) the replicas are separate copies that
+   * are not bound to a node. Each replica allocates its own buffer, so a
+   * pmat buffer passed by the caller is rejected: the replicas would all
+   * share it.
+   */
+  template <typename... Args>
+  explicit ReplicatedPackedWeights(const Args&... args) {
+    const int numNodes = fbgemmGetNumNumaNodes();
+    replicas_.reserve(numNodes);
+    for (int node = 0; node < numNodes; ++node) {
+      AllocPolicy policy = fbgemmGetPackedWeightAllocPolicy();
+      if (numNodes > 1 && !fbgemmIsNumaEmulated()) {
+        policy.numa = NumaMode::BIND;
+        policy.numaNode = node;
+        policy.minSize = 0;
+      }
+      PackedWeightAllocPolicyScope scope(policy);
+      replicas_.push_back(std::make_unique<PackedT>(args...));
+      const void* buf = packedBuffer(*replicas_.back());
+      if (buf != nullptr && (isArg(buf, args) || ...)) {
+        throw std::runtime_error(
+            "ReplicatedPackedWeights allocates a buffer per replica and does "
+            "not take a pmat buffer");
+      }
+    }
+  }
+
+  ReplicatedPackedWeights(const ReplicatedPackedWeights&) = delete;
+  ReplicatedPackedWeights& operator=(const ReplicatedPackedWeights&) = delete;
+
+  int numReplicas() const {
+    return static_cast<int>(replicas_.size());
+  }
+
+  /**
+   * @return The replica on the given node.
+   */
+  PackedT& replica(int node) {
+    return *replicas_[node % replicas_.size()];
+  }
+
+  const PackedT& replica(int node) const {
+    return *replicas_[node % replicas_.size()];
+  }
+
+  /**
+   * @return The replica on the node of the calling thread.
+   */
+  PackedT& local() {
+    return replica(fbgemmGetCurrentNumaNode());
+  }
+
+  const PackedT& local() const {
+    return replica(fbgemmGetCurrentNumaNode());
+  }
+
+ private:
+  static const void* packedBuffer(PackedT& packed) {
+    if constexpr (requires { packed.pmat(); }) {
+      return packed.pmat();
+    } else if constexpr (requires { packed.getBuf(); }) {
+      return packed.getBuf();
+    } else {
+      return nullptr;
+    }
+  }
+
+  template <typename Arg>
+  static bool isArg(const void* buf, const Arg& arg) {
+    if constexpr (std::is_pointer_v<Arg>) {
+      return static_cast<const void*>(arg) == buf;
+    } else {
+      return false;
+    }
+  }
+
+  std::vector<std::unique_ptr<PackedT>> replicas_;
+};
+
+template <int SPATIAL_DIM = 2, typename ACC_T = std::int32_t>
+using ReplicatedPackWeightsForConv = ReplicatedPackedWeights<
+    PackWeightsForConv<SPATIAL_DIM, std::int8_t, ACC_T>>;
+
+/**
+ * @brief fbgemmPacked with the B replica of the calling thread's node.
+ */
+template <
+    typename packingAMatrix,
+    typename packingBMatrix,
+    typename cT,
+    typename processOutputType>
+void fbgemmPacked(
+    PackMatrix<
+        packingAMatrix,
+        typename packingAMatrix::inpType,
+        typename packingAMatrix::accType>& packA,
+    ReplicatedPackedWeights<packingBMatrix>& packB,
+    cT* C,
+    std::int32_t* C_buffer,
+    std::uint32_t ldc,
+    const processOutputType& outProcess,
+    int thread_id,
+    int num_threads,
+    const BlockingFactors* blocking_params = nullptr) {
+  fbgemmPacked(
+      packA,
+      packB.local(),
+      C,
+      C_buffer,
+      ldc,
+      outProcess,
+      thread_id,
+      num_threads,
+      blocking_params);
+}
+
+/**
+ * @brief fbgemmConv with the weight replica of the calling thread's node.
+ */
+template <
+    typename processOutputType,
+    int SPATIAL_DIM = 2,
+    typename ACC_T = std::int32_t>
+int fbgemmConv(
+    const conv_param_t<SPATIAL_DIM>& conv_p,
+    const std::uint8_t* activations,
+    ReplicatedPackWeightsForConv<SPATIAL_DIM, ACC_T>& packed_weights,
+    typename processOutputType::outType* out,
+    std::int32_t* outBuffer,
+    processOutputType& outProcess,
+    int thread_id,
+    int num_threads,
+    const BlockingFactors* blocking_params = nullptr) {
+  return fbgemmConv<processOutputType, SPATIAL_DIM, ACC_T>(
+      conv_p,
+      activations,
+      packed_weights.local(),
+      out,
+      outBuffer,
+      outProcess,
+      thread_id,
+      num_threads,
+      blocking_params);
+}
+
+/**
+ * @brief cblas_gemm_compute with the B replica of the calling thread's node.
+ */
+template <typename T>
+void cblas_gemm_compute(
+    const matrix_op_t transa,
+    const int m,
+    const float* A,
+    const ReplicatedPackedWeights<PackedGemmMatrixB<T>>& Bp,
+    const float beta,
+    float* C,
+    int thread_id = 0,
+    int num_threads = 1) {
+  cblas_gemm_compute(transa, m, A, Bp.local(), beta, C, thread_id, num_threads);
+}
+
+} // namespace fbgemm
@@ -88,6 +88,88 @@ struct FBGEMM_API BCSRMatrix {
   void unpack(DTYPE* dst);
 };
 
+/**
+ * N:M structured sparse format
+ * In every group of GROUP consecutive columns of a row at most NNZ elements
+ * are non-zero (e.g., 2:4 or 1:4). Each group keeps exactly NNZ values and a
+ * bitmask of their positions in the group. Groups with fewer non-zeros are
+ * padded with explicit zeros.
+ *
+ */
+template <typename T = std::int8_t, int NNZ_PER_GROUP = 2, int GROUP_SIZE = 4>
+struct FBGEMM_API NMSparseMatrix {
+  using DTYPE = T;
+  static constexpr int NNZ = NNZ_PER_GROUP; // Non-zeros per group
+  static constexpr int GROUP = GROUP_SIZE; // Group size along columns
+  static_assert(
+      (NNZ == 1 || NNZ == 2) && NNZ < GROUP && GROUP <= 4,
+      "only 1:GROUP and 2:GROUP sparsity with GROUP <= 4 are supported");
+  // Values of a row, group by group in column order. Rows are valuesStride()
+  // apart and zero-padded.
+  std::vector<DTYPE> values;
+  // Bitmask of the positions of the values of each group. Rows are
+  // numGroups() apart.
+  std::vector<std::uint8_t> meta;
+  // Pattern of each pair of consecutive values (see
+  // internal::nmSparsePairPatterns), derived from meta for the kernels. Rows
+  // are valuesStride() / 2 apart.
+  std::vector<std::uint8_t> pair_patterns;
+  // Sum of all elements in a row
+  std::vector<int32_t> row_offsets;
+  int R;
+  int C;
+
+  NMSparseMatrix(int Rows, int Cols) {
+    R = Rows;
+    C = Cols;
+    row_offsets.resize(R, 0);
+  }
+
+  int numGroups() const {
+    return (C + GROUP - 1) / GROUP;
+  }
+
+  /**
+   * @return Number of values stored per row, a multiple of 4 so the kernels
+   *         can consume them 4 at a time.
+   */
+  int valuesStride() const {
+    return (numGroups() * NNZ + 3) / 4 * 4;
+  }
+
+  /**
+   * @brief pack from dense to N:M sparse format
+   * @param src is the source matrix with data type DTYPE
+   * @param ld is the leading dimension
+   *
+   * Throws std::runtime_error if a group has more than NNZ non-zeros.
+   */
+  void pack(const DTYPE* src, size_t ld);
+
+  /**
+   * @brief pack from dense to N:M sparse format
+   * @param src is the source matrix with data type DTYPE
+   *
+   * leading dim of the matrix is assumed to be equal to C
+   */
+  void pack(const DTYPE* src);
+
+  /**
+   * @brief unpack from N:M sparse format to dense
+   * @param dst should be able to hold R*C elements of type DTYPE
+   * @param ld is the leading dimension
+   */
+  void unpack(DTYPE* dst, size_t ld) const;
+
+  /**
+   * @brief unpack from N:M sparse format to dense
+   * @param dst should be able to hold R*C elements of type DTYPE
+   *
+   * leading dimension of the matrix is assumed to be equal to C
+   */
+  void unpack(DTYPE* dst) const;
+};
+
 template <typename T>
 FBGEMM_API std::unique_ptr<CSRMatrix<T>>
 fbgemmDenseToCSR(int R, int C, const T* inp, int ld);
@@ -104,6 +186,14 @@ template <typename T = std::int8_t, int RB = 1, int CB = 4>
 FBGEMM_API std::unique_ptr<BCSRMatrix<T, RB, CB>>
 fbgemmDenseToBCSR(int R, int C, const T* inp);
 
+template <int NNZ = 2, int GROUP = 4, typename T = std::int8_t>
+FBGEMM_API std::unique_ptr<NMSparseMatrix<T, NNZ, GROUP>>
+fbgemmDenseToNMSparse(int R, int C, const T* inp, int ld);
+
+template <int NNZ = 2, int GROUP = 4, typename T = std::int8_t>
+FBGEMM_API std::unique_ptr<NMSparseMatrix<T, NNZ, GROUP>>
+fbgemmDenseToNMSparse(int R, int C, const T* inp);
+
 /**
  * @param accum       Controls accumulation.
  *                    1 means we're accumulating to the C Matrix.
@@ -153,6 +243,30 @@ FBGEMM_API void fbgemmSparseDenseInt8MM(
     int thread_id = 0,
     int num_threads = 1);
 
+/**
+ * Same as above with A in N:M structured sparse format. Only the NNZ / GROUP
+ * non-zeros of each row are multiplied, and rows of A (and C) are split
+ * across threads.
+ * Supported formats are 2:4 and 1:4.
+ */
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+FBGEMM_API void fbgemmSparseDenseInt8MM(
+    int N,
+    const std::unique_ptr<NMSparseMatrix<std::int8_t, NNZ, GROUP>>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum = false,
+    int thread_id = 0,
+    int num_threads = 1);
+
 namespace internal {
 
 void SparseDenseMMAvx2(
@@ -219,6 +333,53 @@ void SparseDenseInt8MVAvx512(
     int thread_id = 0,
     int num_threads = 1);
 
+// Rows [row_start, row_end) of the N:M sparse int8 GEMM
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+void SparseDenseInt8NMAvx2(
+    int N,
+    const NMSparseMatrix<std::int8_t, NNZ, GROUP>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum,
+    int row_start,
+    int row_end);
+
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+void SparseDenseInt8NMAvx512(
+    int N,
+    const NMSparseMatrix<std::int8_t, NNZ, GROUP>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum,
+    int row_start,
+    int row_end);
+
+/**
+ * Two consecutive values of a row of an N:M sparse matrix (a pair) come from
+ * 2 * GROUP / NNZ consecutive columns (a group for 2:4, two groups for 1:4) at
+ * one of a few pairs of positions (patterns). Fills pattern_pos with the
+ * positions of every pattern and returns the number of patterns (at most
+ * 16).
+ */
+template <int NNZ, int GROUP>
+int nmSparsePairPatterns(int pattern_pos[][2]);
+
 } // namespace internal
 
 } // namespace fbgemm
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./Fbgemm.h"
+#include "./FbgemmBuild.h"
+#include "./FbgemmFP16.h"
+#include "./Utils.h"
+
+namespace fbgemm {
+
+/**
+ * @brief Options of a FbgemmThreadPool.
+ */
+struct FBGEMM_API ThreadPoolOptions {
+  /**
+   * Number of threads including the submitting thread. 0 uses one thread per
+   * CPU the process may run on.
+   */
+  int numThreads{0};
+  /**
+   * Pin worker i to the i-th CPU the process may run on. The submitting
+   * thread is left alone. Off by default since pinned workers share their
+   * CPUs with any other pool or OpenMP team of the process.
+   */
+  bool pinThreads{false};
+  /**
+   * Number of pause iterations an idle worker, or a submitter waiting for the
+   * workers, spins before it blocks. Spinning keeps the wakeup latency of back
+   * to back calls low; blocking returns the CPU to other threads.
+   */
+  int spinIterations{1 << 14};
+};
+
+/**
+ * @brief A persistent pool of worker threads that runs the thread_id /
+ *        num_threads partitioned entry points of fbgemm.
+ *
+ * run(fn) calls fn(thread_id, num_threads) once for every thread_id in
+ * [0, num_threads), with thread_id 0 on the submitting thread, and returns
+ * when all calls have returned. An exception thrown by any call is rethrown
+ * by run.
+ *
+ * Submission is safe from anywhere: if the calling thread is already running
+ * a task of a FbgemmThreadPool or is inside an OpenMP parallel region, or the
+ * pool is busy with a job from another thread, fn(0, 1) runs on the caller
+ * instead of oversubscribing the machine or waiting for the pool.
+ */
+class FBGEMM_API FbgemmThreadPool {
+ public:
+  explicit FbgemmThreadPool(
+      const ThreadPoolOptions& options = ThreadPoolOptions());
+  ~FbgemmThreadPool();
+
+  FbgemmThreadPool(const FbgemmThreadPool&) = delete;
+  FbgemmThreadPool& operator=(const FbgemmThreadPool&) = delete;
+
+  /**
+   * @return Number of threads including the submitting thread.
+   */
+  int numThreads() const;
+
+  void run(const std::function<void(int thread_id, int num_threads)>& fn);
+
+  /**
+   * @brief run with at most num_threads threads, e.g. to not wake up more
+   *        threads than a small problem has work for.
+   */
+  void run(
+      int num_threads,
+      const std::function<void(int thread_id, int num_threads)>& fn);
+
+  /**
+   * @brief Splits [0, total_work) with fbgemmPartition1D and calls
+   *        fn(start, end) for the non-empty ranges.
+   */
+  void parallelFor(
+      std::int64_t total_work,
+      const std::function<void(std::int64_t start, std::int64_t end)>& fn);
+
+  /**
+   * @brief Scratch memory of the pool, e.g. for partial results of a job,
+   *        held by one caller at a time and freed with the pool.
+   *
+   * data() is nullptr if another caller holds it. That caller is running a
+   * job then, so a job of this one would run on the calling thread only.
+   */
+  class FBGEMM_API Scratch {
+   public:
+    Scratch(FbgemmThreadPool& pool, std::size_t size);
+    ~Scratch();
+
+    Scratch(const Scratch&) = delete;
+    Scratch& operator=(const Scratch&) = delete;
+
+    float* data() const {
+      return data_;
+    }
+
+   private:
+    FbgemmThreadPool& pool_;
+    float* data_{nullptr};
+  };
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief The pool shared by the library, created on first use.
+ *
+ * Its size is read from FBGEMM_NUM_THREADS and defaults to one thread per CPU
+ * the process may run on.
+ */
+FBGEMM_API FbgemmThreadPool& fbgemmGetDefaultThreadPool();
+
+/**
+ * @brief Whether the calling thread is running a task of a FbgemmThreadPool.
+ *        Code that would otherwise start its own threads, e.g. OpenMP regions,
+ *        should stay on the calling thread then.
+ */
+FBGEMM_API bool fbgemmInThreadPool();
+
+namespace internal {
+
+template <typename T, typename = void>
+struct hasSetRowOffsets : std::false_type {};
+
+template <typename T>
+struct hasSetRowOffsets<
+    T,
+    std::void_t<decltype(std::declval<T&>().setRowOffsets(nullptr))>>
+    : std::true_type {};
+
+template <typename T, typename packAType, typename = void>
+struct hasSetRowQuantParams : std::false_type {};
+
+template <typename T, typename packAType>
+struct hasSetRowQuantParams<
+    T,
+    packAType,
+    std::void_t<decltype(std::declval<T&>().setRowQuantParams(
+        std::declval<packAType&>().getRowScaleBuffer(),
+        std::declval<packAType&>().getRowZeroPointBuffer()))>>
+    : std::true_type {};
+
+} // namespace internal
+
+/**
+ * @brief fbgemmPacked across all threads of a pool.
+ *
+ * Every thread packs its own blocks of A, so this takes a callable that
+ * returns a new packing object for A instead of the object itself, e.g.
+ *
+ *   [&]() {
+ *     return PackAWithRowOffset<uint8_t>(
+ *         matrix_op_t::NoTranspose, m, k, A, k);
+ *   }
+ *
+ * Each thread works on its own copy of outProcess. If A's packing computes
+ * row offsets, the copy reads the row offsets of the thread's A, like
+ * fbgemmConv does. The same goes for the per-row quantization parameters of
+ * A when it is quantized while packing.
+ */
+template <
+    typename packAFactory,
+    typename packingBMatrix,
+    typename cT,
+    typename processOutputType>
+void fbgemmPacked(
+    FbgemmThreadPool& pool,
+    const packAFactory& makePackA,
+    PackMatrix<
+        packingBMatrix,
+        typename packingBMatrix::inpType,
+        typename packingBMatrix::accType>& packB,
+    cT* C,
+    std::int32_t* C_buffer,
+    std::uint32_t ldc,
+    const processOutputType& outProcess,
+    const BlockingFactors* blocking_params = nullptr) {
+  pool.run([&](int thread_id, int num_threads) {
+    auto packA = makePackA();
+    processOutputType threadOutProcess(outProcess);
+    if constexpr (internal::hasSetRowOffsets<processOutputType>::value) {
+      if (packA.getRowOffsetBuffer() != nullptr) {
+        threadOutProcess.setRowOffsets(packA.getRowOffsetBuffer());
+      }
+    }
+    if constexpr (internal::hasSetRowQuantParams<
+                      processOutputType,
+                      decltype(packA)>::value) {
+      threadOutProcess.setRowQuantParams(
+          packA.getRowScaleBuffer(), packA.getRowZeroPointBuffer());
+    }
+    fbgemmPacked(
+        packA,
+        packB,
+        C,
+        C_buffer,
+        ldc,
+        threadOutProcess,
+        thread_id,
+        num_threads,
+        blocking_params);
+  });
+}
+
+/**
+ * @brief fbgemmConv across all threads of a pool.
+ *
+ * Each thread works on its own copy of outProcess since fbgemmConv points it
+ * to the thread's row offsets.
+ */
+template <
+    typename processOutputType,
+    int SPATIAL_DIM = 2,
+    typename ACC_T = std::int32_t>
+int fbgemmConv(
+    FbgemmThreadPool& pool,
+    const conv_param_t<SPATIAL_DIM>& conv_p,
+    const std::uint8_t* activations,
+    PackWeightsForConv<SPATIAL_DIM, std::int8_t, ACC_T>& packed_weights,
+    typename processOutputType::outType* out,
+    std::int32_t* outBuffer,
+    const processOutputType& outProcess,
+    const BlockingFactors* blocking_params = nullptr) {
+  pool.run([&](int thread_id, int num_threads) {
+    processOutputType threadOutProcess(outProcess);
+    fbgemmConv<processOutputType, SPATIAL_DIM, ACC_T>(
+        conv_p,
+        activations,
+        packed_weights,
+        out,
+        outBuffer,
+        threadOutProcess,
+        thread_id,
+        num_threads,
+        blocking_params);
+  });
+  return 0;
+}
+
+/**
+ * @brief cblas_gemm_compute across all threads of a pool.
+ *
+ * A skinny GEMM (see fbgemmIsSkinnyGemm) with fewer column blocks of B than
+ * threads is also split along k. Each slice of the k blocks is computed by its
+ * own group of threads, the first one into C and the others into the scratch
+ * memory of the pool, which is then added to C.
+ */
+template <typename T>
+void cblas_gemm_compute(
+    FbgemmThreadPool& pool,
+    const matrix_op_t transa,
+    const int m,
+    const float* A,
+    const PackedGemmMatrixB<T>& Bp,
+    const float beta,
+    float* C) {
+  const int n = Bp.numCols(), k = Bp.numRows();
+  const int n_blocks = (n + Bp.blockColSize() - 1) / Bp.blockColSize();
+  const int k_blocks = (k + Bp.blockRowSize() - 1) / Bp.blockRowSize();
+  int k_slices = 1;
+  if (fbgemmIsSkinnyGemm(m) && n_blocks < pool.numThreads()) {
+    k_slices = std::min(k_blocks, pool.numThreads() / std::max(n_blocks, 1));
+  }
+  if (k_slices <= 1) {
+    pool.run([&](int thread_id, int num_threads) {
+      cblas_gemm_compute(transa, m, A, Bp, beta, C, thread_id, num_threads);
+    });
+    return;
+  }
+
+  const std::int64_t size = static_cast<std::int64_t>(m) * n;
+  FbgemmThreadPool::Scratch reduction_buffer(pool, (k_slices - 1) * size);
+  float* partials = reduction_buffer.data();
+  if (partials == nullptr) {
+    // The pool is busy with a job of another thread
+    cblas_gemm_compute(transa, m, A, Bp, beta, C);
+    return;
+  }
+
+  // The pool may run the job on fewer threads, e.g. on the caller only
+  int num_slices = 1;
+  pool.run([&](int thread_id, int num_threads) {
+    const int slices = std::min(k_slices, num_threads);
+    const int slice_threads = num_threads / slices;
+    const int slice = thread_id / slice_threads;
+    if (thread_id == 0) {
+      num_slices = slices;
+    }
+    if (slice >= slices) {
+      return;
+    }
+    std::int64_t kb_begin, kb_end;
+    fbgemmPartition1D(slice, slices, k_blocks, kb_begin, kb_end);
+    cblas_gemm_compute_k_range(
+        transa,
+        m,
+        A,
+        Bp,
+        slice == 0 ? beta : 0.0f,
+        slice == 0 ? C : partials + (slice - 1) * size,
+        static_cast<int>(kb_begin * Bp.blockRowSize()),
+        static_cast<int>(std::min<std::int64_t>(kb_end * Bp.blockRowSize(), k)),
+        thread_id % slice_threads,
+        slice_threads);
+  });
+
+  if (num_slices > 1) {
+    pool.parallelFor(size, [&](std::int64_t start, std::int64_t end) {
+      for (int s = 0; s < num_slices - 1; ++s) {
+        const float* partial = partials + s * size;
+        for (std::int64_t i = start; i < end; ++i) {
+          C[i] += partial[i];
+        }
+      }
+    });
+  }
+}
+
+} // namespace fbgemm
@@ -215,8 +215,11 @@ inline int ReQuantizeForFloat<FUSE_RELU, Q_GRAN, outT, inT, nextOPType>::f(
     for (int i = block.row_start; i < block.row_start + block.row_size; ++i) {
       for (int j = block.col_start; j < block.col_start + block.col_size; ++j) {
         inT raw = inp[(i - block.row_start) * ld_in + j - block.col_start];
-        if (Aq_zero_point_) {
-          raw -= Aq_zero_point_ * q_col_offsets_[j];
+        std::int32_t Aq_zero_point = Aq_zero_points_
+            ? Aq_zero_points_[i - block.row_start]
+            : Aq_zero_point_;
+        if (Aq_zero_point) {
+          raw -= Aq_zero_point * q_col_offsets_[j];
         }
         int Bq_zero_point_idx;
         if (Q_GRAN == QuantizationGranularity::TENSOR) {
@@ -232,7 +235,9 @@ inline int ReQuantizeForFloat<FUSE_RELU, Q_GRAN, outT, inT, nextOPType>::f(
           raw -= q_row_offsets_[i - block.row_start] *
               Bq_zero_point_[Bq_zero_point_idx];
         }
-        float res = raw * Aq_scale_ * Bq_scale_[Bq_zero_point_idx];
+        float Aq_scale =
+            Aq_scales_ ? Aq_scales_[i - block.row_start] : Aq_scale_;
+        float res = raw * Aq_scale * Bq_scale_[Bq_zero_point_idx];
         if (bias_) {
           res += bias_[j];
         }
@@ -256,9 +261,11 @@ inline int ReQuantizeForFloat<FUSE_RELU, Q_GRAN, outT, inT, nextOPType>::f(
         q_col_offsets_,
         bias_,
         ncols_,
-        groups_};
+        groups_,
+        Aq_scales_,
+        Aq_zero_points_};
 
-    if (Aq_zero_point_ == 0) {
+    if (Aq_zero_point_ == 0 && Aq_scales_ == nullptr) {
       if (b_symmetric) {
         if (bias_ == nullptr) {
           requantizeForFloatAvx2<true, true, Q_GRAN, false, FUSE_RELU>(
@@ -78,6 +78,16 @@ uint32_t FBGEMM_API Xor128(void);
 /// @brief Find the min and max value in a float matrix.
 void FBGEMM_API FindMinMax(const float* m, float* min, float* max, int64_t len);
 
+/// @ingroup fbgemm-quant-utils-avx2
+///
+/// @brief Quantizes a float vector to uint8 like QuantizeAvx2 and returns the
+/// sum of the quantized values, in a single pass over the data.
+FBGEMM_API std::int32_t QuantizeAndReduceAvx2(
+    const float* src,
+    std::uint8_t* dst,
+    int64_t len,
+    const TensorQuantizationParams& qparams);
+
 void RequantizeFixedPointAvx2(
     const std::int32_t* src,
     std::uint8_t* dst,
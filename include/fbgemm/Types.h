@@ -36,6 +36,14 @@ namespace fbgemm {
 using float16 = std::uint16_t;
 using bfloat16 = std::uint16_t;
 
+// bfloat16 is just an alias of std::uint16_t like float16, so it cannot select
+// a template specialization. Packed bf16 GEMM weights (PackedGemmMatrixBF16)
+// are stored as this distinct wrapper type instead.
+struct BFloat16 {
+  bfloat16 x;
+};
+static_assert(sizeof(BFloat16) == sizeof(bfloat16), "BFloat16 must be 2 bytes");
+
 // The IEEE754 standard species a binary16 as having the following format:
 // SEEEEEMMMMMMMMMM
 // 0432109876543210
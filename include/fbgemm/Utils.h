@@ -235,6 +235,23 @@ FBGEMM_API thread_type_t fbgemmGetThreadPartition(
     int thread_id,
     int n_align = 64);
 
+/**
+ * @brief Whether a GEMM with m rows is partitioned as a skinny GEMM, e.g. the
+ * m = 1..64 of inference. Skinny GEMMs have little to split along m, so
+ * fbgemmPacked splits the columns of C across threads in register blocks
+ * (NR_MIN) instead of cache blocks (NCB), and cblas_gemm_compute on a
+ * FbgemmThreadPool also splits k when there are fewer column blocks than
+ * threads.
+ */
+FBGEMM_API bool fbgemmIsSkinnyGemm(int m);
+
+/**
+ * @brief Turn the skinny GEMM partitioning on or off, e.g. to compare against
+ * it. The initial value is read from FBGEMM_SKINNY_GEMM_PARTITION and
+ * defaults to on.
+ */
+FBGEMM_API void fbgemmSetSkinnyGemmPartition(bool enable);
+
 template <int SIZE, typename T = std::int32_t>
 std::string arrayToString(const std::array<T, SIZE>& inp) {
   std::string out = "[";
@@ -360,11 +377,16 @@ FBGEMM_API void fbgemmPartition1DBlocked(
 
 /**
  * @brief A stable sorting algorithm. It sorts 8 bits at a time, hence in a
- * worst-case performing sizeof(K) / 8 passes. Providing meaningful max_value
- * may help reduce the number of passes performed by radix_sort. If
- * maybe_with_neg_vals is set to true, we are performing all possible passes,
- * up to a sign bit. If OpenMP is available in a build system, radix_sort works
- * in parallel.
+ * worst-case performing sizeof(K) passes, and up to 11 or 16 bits at a time
+ * for large inputs. Providing meaningful max_value may help reduce the
+ * number of passes performed by radix_sort, and passes in which all keys have
+ * the same digit are skipped. If maybe_with_neg_vals is set to true, we are
+ * performing all possible passes, up to a sign bit. radix_sort works in
+ * parallel, on OpenMP threads if OpenMP is available in a build system and on
+ * the threads of fbgemmGetDefaultThreadPool() otherwise.
+ *
+ * The sorted keys and values are in either the input or the tmp buffers; the
+ * returned pointers tell which.
  */
 template <typename K, typename V>
 FBGEMM_API std::pair<K*, V*> radix_sort_parallel(
@@ -377,11 +399,84 @@ FBGEMM_API std::pair<K*, V*> radix_sort_parallel(
     const bool maybe_with_neg_vals = false);
 
 /**
- * @brief Helper function that allows us to check whether radix_sort is
- * accelerated with OpenMP or not.
+ * @brief radix_sort_parallel of keys without values.
+ */
+template <typename K>
+FBGEMM_API K* radix_sort_parallel(
+    K* const inp_key_buf,
+    K* const tmp_key_buf,
+    const int64_t elements_count,
+    const int64_t max_value,
+    const bool maybe_with_neg_vals = false);
+
+/**
+ * @brief Parallel equivalent of unique(keys, sorted=True, return_inverse,
+ * return_counts). Sorts (key, position) pairs with radix_sort_parallel, or
+ * only the keys if neither inverse nor sorted_positions is requested, marks
+ * the first key of every run of equal keys and numbers the runs with a
+ * prefix sum over chunks of the input, so that no step is serial in
+ * elements_count.
+ * max_value and maybe_with_neg_vals bound the keys like in
+ * radix_sort_parallel and decide how many radix passes are performed.
+ *
+ * unique_keys must hold elements_count keys; the sorted unique keys are
+ * written to its beginning and their number is returned. The other outputs
+ * are optional (nullptr skips them):
+ *  - inverse[i] (elements_count) is the index of keys[i] in unique_keys,
+ *  - counts[u] (elements_count) is the number of occurrences of
+ *    unique_keys[u],
+ *  - sorted_positions[j] (elements_count) is the position in keys of the
+ *    j-th key in (stable) sorted order.
+ */
+template <typename K, typename I>
+FBGEMM_API int64_t unique_parallel(
+    const K* const keys,
+    const int64_t elements_count,
+    const int64_t max_value,
+    K* const unique_keys,
+    I* const inverse,
+    I* const counts,
+    I* const sorted_positions = nullptr,
+    const bool maybe_with_neg_vals = false);
+
+/**
+ * @brief Whether radix_sort_parallel runs on more than one thread when called
+ * from the calling thread, on OpenMP or on the library thread pool.
+ */
+FBGEMM_API bool is_radix_sort_accelerated();
+
+/**
+ * @brief Whether fbgemm is built with OpenMP. Deprecated: radix_sort_parallel
+ * also runs in parallel without OpenMP, use is_radix_sort_accelerated().
  */
 FBGEMM_API bool is_radix_sort_accelerated_with_openmp();
 
+/**
+ * @brief Number of NUMA nodes, or the number of emulated nodes if emulation
+ * is enabled.
+ */
+FBGEMM_API int fbgemmGetNumNumaNodes();
+
+/**
+ * @brief NUMA node of the CPU the calling thread is running on.
+ * No system call: the CPU comes from the vDSO and the CPU to node map is read
+ * once.
+ */
+FBGEMM_API int fbgemmGetCurrentNumaNode();
+
+/**
+ * @brief Emulate num_nodes NUMA nodes, with CPU i on node i % num_nodes, to
+ * exercise NUMA aware code on a single node machine.
+ * 0 turns emulation off. The initial value is read from
+ * FBGEMM_EMULATE_NUMA_NODES.
+ */
+FBGEMM_API void fbgemmSetEmulatedNumaNodes(int num_nodes);
+
+/**
+ * @brief Whether the NUMA nodes are emulated.
+ */
+FBGEMM_API bool fbgemmIsNumaEmulated();
+
 /**
  * Choosing which kernel (autovec/asmjit/ref) to use for nbit-CPU-TBE
  * Available kernels:
@@ -75,6 +75,10 @@ struct requantizationForFloatParams_t {
   const float* bias;
   std::uint32_t ncols;
   int groups;
+  // Per-row A quantization parameters (nullptr unless A was quantized per
+  // row); when set, they override A_scale and A_zero_point.
+  const float* A_scales;
+  const std::int32_t* A_zero_points;
 };
 
 /**
@@ -85,8 +89,102 @@ FBGEMM_API void*
 fbgemmAlignedAlloc(size_t align, size_t size, bool raiseException = false);
 
 /**
- * @brief Free memory allocated by fbgemmAlignedAlloc
+ * @brief Free memory allocated by fbgemmAlignedAlloc or
+ * fbgemmAlignedAllocWithPolicy
  */
 FBGEMM_API void fbgemmAlignedFree(void* p);
 
+/**
+ * @brief Page size backing an allocation.
+ */
+enum class FBGEMM_ENUM_CLASS_API HugePageMode {
+  NONE, ///< Regular pages from the default allocator.
+  TRANSPARENT, ///< 2MB aligned and advised for transparent huge pages.
+  EXPLICIT_2MB, ///< Reserved 2MB huge pages (hugetlbfs).
+  EXPLICIT_1GB, ///< Reserved 1GB huge pages (hugetlbfs).
+};
+
+/**
+ * @brief NUMA placement of an allocation.
+ */
+enum class FBGEMM_ENUM_CLASS_API NumaMode {
+  DEFAULT, ///< The node of the thread that first touches a page.
+  BIND, ///< All pages on AllocPolicy::numaNode.
+  INTERLEAVE, ///< Pages round robin over all allowed nodes.
+};
+
+/**
+ * @brief How fbgemmAlignedAllocWithPolicy places memory.
+ *
+ * Large read mostly buffers such as packed weights and embedding tables are
+ * accessed at random, so most of their accesses miss the TLB with regular
+ * pages. The policy is a best effort hint: explicit huge pages fall back to
+ * transparent huge pages when the reserved pool is exhausted, and a NUMA
+ * placement the kernel rejects falls back to the default placement.
+ */
+struct FBGEMM_API AllocPolicy {
+  HugePageMode hugePages{HugePageMode::NONE};
+  NumaMode numa{NumaMode::DEFAULT};
+  int numaNode{0};
+  /// Smaller allocations ignore the policy so that they don't each take a
+  /// huge page.
+  size_t minSize{1 << 20};
+
+  bool isDefault() const {
+    return hugePages == HugePageMode::NONE && numa == NumaMode::DEFAULT;
+  }
+
+  std::string toString() const;
+};
+
+/**
+ * @brief Allocate size bytes aligned to align with the given huge page and
+ * NUMA policy. Falls back to fbgemmAlignedAlloc when the policy is not
+ * supported on this platform. Free with fbgemmAlignedFree.
+ */
+FBGEMM_API void* fbgemmAlignedAllocWithPolicy(
+    size_t align,
+    size_t size,
+    const AllocPolicy& policy);
+
+/**
+ * @brief Set the policy used to allocate packed weights (PackBMatrix,
+ * PackedGemmMatrixB, and the convolution weight packers). Matrices packed
+ * before the call keep their memory.
+ *
+ * The initial policy is read from the environment:
+ * FBGEMM_HUGE_PAGES=thp|2mb|1gb and FBGEMM_NUMA=interleave|<node>.
+ */
+FBGEMM_API void fbgemmSetPackedWeightAllocPolicy(const AllocPolicy& policy);
+
+/**
+ * @brief The policy used to allocate packed weights.
+ */
+FBGEMM_API AllocPolicy fbgemmGetPackedWeightAllocPolicy();
+
+/**
+ * @brief Allocate the buffer of a packed weight matrix with the packed weight
+ * policy. Free with fbgemmAlignedFree.
+ */
+FBGEMM_API void* fbgemmPackedWeightAlloc(size_t align, size_t size);
+
+/**
+ * @brief Overrides the packed weight policy on the calling thread while in
+ * scope, e.g. to pack a copy of weights bound to a NUMA node without
+ * affecting other threads.
+ */
+class FBGEMM_API PackedWeightAllocPolicyScope {
+ public:
+  explicit PackedWeightAllocPolicyScope(const AllocPolicy& policy);
+  ~PackedWeightAllocPolicyScope();
+
+  PackedWeightAllocPolicyScope(const PackedWeightAllocPolicyScope&) = delete;
+  PackedWeightAllocPolicyScope& operator=(
+      const PackedWeightAllocPolicyScope&) = delete;
+
+ private:
+  const AllocPolicy* saved_;
+  AllocPolicy policy_;
+};
+
 } // namespace fbgemm
@@ -45,6 +45,24 @@ FBGEMM_API void sparseDenseInt8MMRef(
     int thread_id = 0,
     int num_threads = 1);
 
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+FBGEMM_API void sparseDenseInt8MMRef(
+    int N,
+    const std::unique_ptr<NMSparseMatrix<std::int8_t, NNZ, GROUP>>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum = false,
+    int thread_id = 0,
+    int num_threads = 1);
+
 template <bool FUSE_RELU, QuantizationGranularity Q_GRAN>
 FBGEMM_API void trRequantizeRef(
     uint8_t* out,
@@ -7,48 +7,326 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <future>
+#include <iterator>
 #include <map>
-
-#if __cplusplus >= 201402L && !defined(__APPLE__)
-// For C++14, use shared_timed_mutex.
-// some macOS C++14 compilers don't support shared_timed_mutex.
-#define FBGEMM_USE_SHARED_TIMED_MUTEX
-#endif
-
-#ifdef FBGEMM_USE_SHARED_TIMED_MUTEX
-#include <shared_mutex>
-#else
+#include <memory>
 #include <mutex>
-#endif
+#include <string>
+#include <vector>
 
 #ifdef FBCODE_CAFFE2
 #include <folly/container/F14Map.h>
 #endif
 
+#include "./CodeCacheRegistry.h"
+#include "./PersistentCodeCache.h"
+
 namespace fbgemm {
 
+/**
+ * @brief A kernel produced on a code cache miss, together with the JIT
+ * runtime that owns its code (nullptr if the cache must not release it).
+ */
+template <typename VALUE>
+struct CodeCacheValue {
+  VALUE value{};
+  asmjit::JitRuntime* runtime{nullptr};
+  std::mutex* runtimeMutex{nullptr};
+  std::size_t codeSize{0};
+  std::uint64_t codegenNanoseconds{0};
+};
+
+/**
+ * @brief Create the value for a code cache miss: take the kernel from the
+ * persistent kernel cache if it is enabled and holds it, otherwise JIT it and
+ * record the result for persistence.
+ */
+template <typename KEY, typename VALUE, typename GENFUNC>
+CodeCacheValue<VALUE> createCodeCacheValue(
+    const std::string& name,
+    const KEY& key,
+    GENFUNC& generatorFunction) {
+  using KeyCodec = CodeCacheKeyCodec<KEY>;
+  const auto start = std::chrono::steady_clock::now();
+  CodeCacheValue<VALUE> result;
+  JitCodeCapture capture;
+  bool loaded = false;
+  bool record = false;
+  std::string keyStr;
+  if constexpr (KeyCodec::persistable) {
+    PersistentCodeCache& store = PersistentCodeCache::instance();
+    if (!name.empty() && store.enabled()) {
+      keyStr = KeyCodec::serialize(key);
+      if (void* fn = store.find(name, keyStr)) {
+        // Owned by the persistent store, never released by the cache.
+        result.value = reinterpret_cast<VALUE>(fn);
+        loaded = true;
+      } else {
+        capture.copyCode = true;
+        record = true;
+      }
+    }
+  }
+  if (!loaded) {
+    result.value = generatorFunction();
+    result.runtime = capture.runtime;
+    result.runtimeMutex = capture.runtimeMutex;
+    result.codeSize = capture.codeSize;
+    if (record && capture.captured) {
+      PersistentCodeCache::instance().record(
+          name, keyStr, std::move(capture.code));
+    }
+  }
+  result.codegenNanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+  return result;
+}
+
 /**
  * @brief Thread safe cache for microkernels, ensures single creation per key.
+ *
+ * Lookups of existing keys are lock free: every thread looks keys up in its
+ * own snapshot of the cache and only takes the lock to refresh the snapshot
+ * after the cache changed, or on a miss. Snapshots are built incrementally
+ * (see Snapshot), so that inserting n kernels does not copy the map n times.
+ *
+ * Caches constructed with a name are registered with the CodeCacheRegistry,
+ * which provides stats and an optional LRU/LFU bound on the number of
+ * entries, and take part in the persistent kernel cache (see
+ * fbgemm/FbgemmKernelCache.h): on a miss the kernel is first looked up in the
+ * persistent store and newly JIT'd kernels are recorded to it.
+ *
  * @tparam KEY Type of unique key (typically a tuple)
  * @tparam VALUE Type of the microkernel function (Typically a function pointer)
  * @tparam THREAD_LOCAL use thread local and avoid locking (default false)
  */
 template <typename KEY, typename VALUE, bool THREAD_LOCAL = false>
-class CodeCache {
+class CodeCache : public RegisteredCodeCache {
  private:
+  using KeyCodec = CodeCacheKeyCodec<KEY>;
+
+  struct Entry {
+    explicit Entry(const KEY& k) : key(k) {}
+
+    const KEY key;
+    std::shared_future<VALUE> value;
+    // The following are guarded by mutex_.
+    bool ready{false};
+    asmjit::JitRuntime* runtime{nullptr};
+    std::mutex* runtimeMutex{nullptr};
+    std::size_t codeSize{0};
+    std::uint32_t age{0}; ///< LFU: aged history of the referenced bit
+    /// Set on every hit, cleared by the eviction sweeps.
+    std::atomic<bool> referenced{false};
+    /// Hits counted by codeCacheSampleHit.
+    std::atomic<std::uint64_t> sampledHits{0};
+    /// Written under mutex_. Snapshots may still hold evicted entries, which
+    /// lookups then treat as misses.
+    std::atomic<bool> evicted{false};
+  };
+
 #ifdef FBCODE_CAFFE2
-  folly::F14FastMap<KEY, std::shared_future<VALUE>> values_;
+  using Map = folly::F14FastMap<KEY, std::shared_ptr<Entry>>;
 #else
-  std::map<KEY, std::shared_future<VALUE>> values_;
+  using Map = std::map<KEY, std::shared_ptr<Entry>>;
 #endif
 
-#ifdef FBGEMM_USE_SHARED_TIMED_MUTEX
-  std::shared_timed_mutex mutex_;
-#else
+  /// An immutable view of values_, made of levels of decreasing size where
+  /// newer levels shadow older ones. Publishing an entry merges the levels
+  /// like a binary counter, so every entry is copied O(log n) times in total
+  /// instead of the whole map being copied on every miss.
+  struct Snapshot {
+    std::vector<std::shared_ptr<const Map>> levels; ///< oldest first
+    std::size_t size{0}; ///< entries over all levels
+
+    Entry* find(const KEY& key) const {
+      for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+        auto it = (*level)->find(key);
+        if (it != (*level)->end()) {
+          return it->second->evicted.load(std::memory_order_relaxed)
+              ? nullptr
+              : it->second.get();
+        }
+      }
+      return nullptr;
+    }
+  };
+
+  struct ThreadSnapshot {
+    std::uint64_t cacheId;
+    std::weak_ptr<const bool> cacheAlive; ///< expires with the cache
+    std::uint64_t version;
+    std::shared_ptr<const Snapshot> values;
+    /// Hits that looked at more than one level since the last refresh.
+    std::size_t deepHits;
+  };
+
+  struct alignas(64) HitCounter {
+    std::atomic<std::uint64_t> hits{0};
+  };
+
   std::mutex mutex_;
-#endif
+  // The following are guarded by mutex_.
+  Map values_;
+  std::vector<std::shared_ptr<Entry>> clock_; ///< entries, in eviction order
+  std::size_t clockHand_{0};
+  Map evicted_; ///< evicted entries whose code is not released yet
+  std::shared_ptr<const Snapshot> snapshot_{
+      std::make_shared<const Snapshot>()};
+  std::uint64_t misses_{0};
+  std::uint64_t evictions_{0};
+  std::uint64_t codegenNanoseconds_{0};
+
+  /// Bumped whenever snapshot_ is replaced.
+  alignas(64) std::atomic<std::uint64_t> version_{1};
+  std::array<HitCounter, kCodeCacheCounterShards> hits_;
+
+  std::string name_;
+
+  /// Unique per cache, unlike its address which a later cache may reuse.
+  const std::uint64_t id_{nextId_.fetch_add(1, std::memory_order_relaxed)};
+  const std::shared_ptr<const bool> alive_{std::make_shared<const bool>(true)};
+  static inline std::atomic<std::uint64_t> nextId_{0};
+
+  ThreadSnapshot& threadSnapshot() {
+    static thread_local std::vector<ThreadSnapshot> snapshots;
+    const std::uint64_t version = version_.load(std::memory_order_acquire);
+    for (auto& s : snapshots) {
+      if (s.cacheId == id_) {
+        if (s.version == version) {
+          return s;
+        }
+        break;
+      }
+    }
+    // Drop the snapshots of destroyed caches, which would otherwise pin their
+    // entries for the lifetime of the thread.
+    snapshots.erase(
+        std::remove_if(
+            snapshots.begin(),
+            snapshots.end(),
+            [](const ThreadSnapshot& s) { return s.cacheAlive.expired(); }),
+        snapshots.end());
+    auto snapshot = std::find_if(
+        snapshots.begin(), snapshots.end(), [this](const ThreadSnapshot& s) {
+          return s.cacheId == id_;
+        });
+    if (snapshot == snapshots.end()) {
+      snapshots.push_back({id_, alive_, 0, nullptr, 0});
+      snapshot = std::prev(snapshots.end());
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    snapshot->values = snapshot_;
+    snapshot->version = version_.load(std::memory_order_relaxed);
+    snapshot->deepHits = 0;
+    return *snapshot;
+  }
+
+  void countHit(Entry& entry) {
+    hits_[codeCacheCounterShard()].hits.fetch_add(
+        1, std::memory_order_relaxed);
+    // Only write when needed so hot entries stay shared across cores.
+    if (!entry.referenced.load(std::memory_order_relaxed)) {
+      entry.referenced.store(true, std::memory_order_relaxed);
+    }
+    if (codeCacheSampleHit()) {
+      entry.sampledHits.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Must be called with mutex_ held. Publishes a snapshot with entry added.
+  void publish(const std::shared_ptr<Entry>& entry) {
+    auto snapshot = std::make_shared<Snapshot>(*snapshot_);
+    Map level;
+    level[entry->key] = entry;
+    while (!snapshot->levels.empty() &&
+           snapshot->levels.back()->size() <= level.size()) {
+      snapshot->size -= snapshot->levels.back()->size();
+      for (const auto& kv : *snapshot->levels.back()) {
+        // Keeps the newer entry of a key found in both levels.
+        if (!kv.second->evicted.load(std::memory_order_relaxed)) {
+          level.insert(kv);
+        }
+      }
+      snapshot->levels.pop_back();
+    }
+    snapshot->size += level.size();
+    snapshot->levels.push_back(std::make_shared<const Map>(std::move(level)));
+    snapshot_ = std::move(snapshot);
+    version_.fetch_add(1, std::memory_order_release);
+  }
+
+  // Must be called with mutex_ held. Publishes values_ as a single level.
+  void publishAll() {
+    auto snapshot = std::make_shared<Snapshot>();
+    if (!values_.empty()) {
+      snapshot->levels.push_back(std::make_shared<const Map>(values_));
+      snapshot->size = values_.size();
+    }
+    snapshot_ = std::move(snapshot);
+    version_.fetch_add(1, std::memory_order_release);
+  }
+
+  // Must be called with mutex_ held.
+  void insert(const std::shared_ptr<Entry>& entry) {
+    const std::size_t capacity = CodeCacheRegistry::instance().capacity();
+    while (capacity > 0 && values_.size() >= capacity && evictOne()) {
+    }
+    values_[entry->key] = entry;
+    clock_.push_back(entry);
+  }
+
+  // Must be called with mutex_ held. Returns false if nothing is evictable.
+  bool evictOne() {
+    std::size_t victim = clock_.size();
+    if (CodeCacheRegistry::instance().policy() ==
+        KernelCacheEvictionPolicy::LFU) {
+      std::uint32_t minAge = UINT32_MAX;
+      for (std::size_t i = 0; i < clock_.size(); ++i) {
+        Entry& e = *clock_[i];
+        e.age = (e.age >> 1) |
+            (e.referenced.exchange(false, std::memory_order_relaxed)
+                 ? 0x80000000u
+                 : 0u);
+        if (e.ready && (victim == clock_.size() || e.age < minAge)) {
+          victim = i;
+          minAge = e.age;
+        }
+      }
+    } else {
+      // CLOCK: skip and clear referenced entries, at most two rounds.
+      for (std::size_t n = 0; n < 2 * clock_.size(); ++n) {
+        clockHand_ %= clock_.size();
+        Entry& e = *clock_[clockHand_];
+        if (e.ready &&
+            !e.referenced.exchange(false, std::memory_order_relaxed)) {
+          victim = clockHand_;
+          break;
+        }
+        ++clockHand_;
+      }
+    }
+    if (victim == clock_.size()) {
+      return false;
+    }
+    std::shared_ptr<Entry> entry = std::move(clock_[victim]);
+    clock_[victim] = std::move(clock_.back());
+    clock_.pop_back();
+    values_.erase(entry->key);
+    entry->evicted.store(true, std::memory_order_relaxed);
+    evicted_[entry->key] = std::move(entry);
+    ++evictions_;
+    return true;
+  }
 
  public:
   CodeCache(const CodeCache&) = delete;
@@ -56,42 +334,170 @@ class CodeCache {
 
   CodeCache() {}
 
+  explicit CodeCache(std::string name) : name_(std::move(name)) {
+    CodeCacheRegistry::instance().add(name_, this);
+  }
+
+  ~CodeCache() override {
+    if (!name_.empty()) {
+      CodeCacheRegistry::instance().remove(name_);
+    }
+  }
+
   template <typename GENFUNC>
   VALUE getOrCreate(const KEY& key, GENFUNC generatorFunction) {
-#ifdef FBGEMM_USE_SHARED_TIMED_MUTEX
-    std::shared_lock<std::shared_timed_mutex> sharedLock(mutex_);
-#else
-    std::unique_lock<std::mutex> uniqueLock(mutex_);
-#endif
+    ThreadSnapshot& snapshot = threadSnapshot();
+    if (Entry* entry = snapshot.values->find(key)) {
+      countHit(*entry);
+      // Once looking through the levels cost as much as merging them, merge
+      // them so that later hits only look up one map.
+      if (snapshot.values->levels.size() > 1 &&
+          ++snapshot.deepHits > snapshot.values->size) {
+        snapshot.deepHits = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (snapshot_->levels.size() > 1) {
+          publishAll();
+        }
+      }
+      return entry->value.get();
+    }
 
-    // Check for existence of the key
-    auto it = values_.find(key);
-    if (it != values_.end()) {
-      return it->second.get();
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Need to look up again because the snapshot may be stale.
+    auto cur = values_.find(key);
+    if (cur != values_.end()) {
+      std::shared_ptr<Entry> entry = cur->second;
+      lock.unlock();
+      countHit(*entry);
+      return entry->value.get();
+    }
+    ++misses_;
+
+    // Put evicted kernels back instead of generating them again.
+    auto evicted = evicted_.find(key);
+    if (evicted != evicted_.end()) {
+      std::shared_ptr<Entry> entry = std::move(evicted->second);
+      evicted_.erase(evicted);
+      entry->evicted.store(false, std::memory_order_relaxed);
+      insert(entry);
+      publish(entry);
+      lock.unlock();
+      return entry->value.get();
+    }
+
+    auto entry = std::make_shared<Entry>(key);
+    std::promise<VALUE> returnPromise;
+    entry->value = returnPromise.get_future().share();
+    insert(entry);
+    publish(entry);
+
+    lock.unlock();
+    // The value (code) generation is not happening under a lock
+    CodeCacheValue<VALUE> created =
+        createCodeCacheValue<KEY, VALUE>(name_, key, generatorFunction);
+    lock.lock();
+    entry->ready = true;
+    entry->runtime = created.runtime;
+    entry->runtimeMutex = created.runtimeMutex;
+    entry->codeSize = created.codeSize;
+    codegenNanoseconds_ += created.codegenNanoseconds;
+    lock.unlock();
+    returnPromise.set_value(created.value);
+    return created.value;
+  }
+
+  bool prewarm(const std::string& keyStr) override {
+    if constexpr (KeyCodec::persistable) {
+      KEY key;
+      if (!KeyCodec::deserialize(keyStr, key)) {
+        return false;
+      }
+      void* fn = PersistentCodeCache::instance().find(name_, keyStr);
+      if (fn == nullptr) {
+        return false;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (values_.find(key) == values_.end()) {
+        auto entry = std::make_shared<Entry>(key);
+        std::promise<VALUE> promise;
+        promise.set_value(reinterpret_cast<VALUE>(fn));
+        entry->value = promise.get_future().share();
+        entry->ready = true;
+        insert(entry);
+        publish(entry);
+      }
+      return true;
     } else {
-#ifdef FBGEMM_USE_SHARED_TIMED_MUTEX
-      sharedLock.unlock();
-      std::unique_lock<std::shared_timed_mutex> uniqueLock(mutex_);
-
-      // Need to look up again because there could be race condition from
-      // the time gap between sharedLock.unlock() and creating uniqueLock.
-      it = values_.find(key);
-      if (it == values_.end()) {
-#endif
-        std::promise<VALUE> returnPromise;
-        values_[key] = returnPromise.get_future().share();
-
-        uniqueLock.unlock();
-        // The value (code) generation is not happening under a lock
-        VALUE val = generatorFunction();
-        returnPromise.set_value(val);
-        return val;
-#ifdef FBGEMM_USE_SHARED_TIMED_MUTEX
-      } else {
-        return it->second.get();
+      return false;
+    }
+  }
+
+  std::vector<std::string> serializedKeys() override {
+    std::vector<std::string> keys;
+    if constexpr (KeyCodec::persistable) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (const auto& kv : values_) {
+        keys.push_back(KeyCodec::serialize(kv.first));
       }
-#endif
     }
+    return keys;
+  }
+
+  KernelCacheStats stats() override {
+    KernelCacheStats stats;
+    for (const auto& counter : hits_) {
+      stats.hits += counter.hits.load(std::memory_order_relaxed);
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.entries = values_.size();
+    stats.evicted = evicted_.size();
+    stats.codegenNanoseconds = codegenNanoseconds_;
+    for (const Map* map : {&values_, &evicted_}) {
+      for (const auto& kv : *map) {
+        stats.codeBytes += kv.second->codeSize;
+      }
+    }
+    return stats;
+  }
+
+  std::vector<KernelCacheKeyStats> hottestKeys(std::size_t n) override {
+    std::vector<std::pair<std::uint64_t, const KEY*>> hits;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto& kv : values_) {
+      hits.emplace_back(
+          kv.second->sampledHits.load(std::memory_order_relaxed), &kv.first);
+    }
+    n = std::min(n, hits.size());
+    std::partial_sort(
+        hits.begin(),
+        hits.begin() + n,
+        hits.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<KernelCacheKeyStats> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      keys[i].key = KeyCodec::describe(*hits[i].second);
+      keys[i].hits = hits[i].first * kCodeCacheHitSampling;
+    }
+    return keys;
+  }
+
+  std::size_t releaseEvicted() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::size_t released = 0;
+    for (auto& kv : evicted_) {
+      Entry& entry = *kv.second;
+      if (entry.runtime != nullptr) {
+        std::unique_lock<std::mutex> rtLock(*entry.runtimeMutex);
+        entry.runtime->release(entry.value.get());
+        ++released;
+      }
+    }
+    evicted_.clear();
+    // Make every thread drop its references to the released entries.
+    publishAll();
+    return released;
   }
 };
 
@@ -112,12 +518,19 @@ class CodeCache<KEY, VALUE, /*THREAD_LOCAL=*/true> {
   }
 #endif
 
+  std::string name_;
+
  public:
   CodeCache(const CodeCache&) = delete;
   CodeCache& operator=(const CodeCache&) = delete;
 
   CodeCache() {}
 
+  // Thread local caches are not registered (no stats, eviction or
+  // pre-warming), but still load kernels from and record kernels to the
+  // persistent store.
+  explicit CodeCache(std::string name) : name_(std::move(name)) {}
+
   template <typename GENFUNC>
   VALUE getOrCreate(const KEY& key, GENFUNC generatorFunction) {
     // Check for existence of the key
@@ -125,7 +538,8 @@ class CodeCache<KEY, VALUE, /*THREAD_LOCAL=*/true> {
     if (it != getValues_().end()) {
       return it->second;
     } else {
-      VALUE val = generatorFunction();
+      VALUE val =
+          createCodeCacheValue<KEY, VALUE>(name_, key, generatorFunction).value;
       getValues_()[key] = val;
       return val;
     }
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "./CodeCacheRegistry.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace fbgemm {
+
+CodeCacheRegistry& CodeCacheRegistry::instance() {
+  static CodeCacheRegistry registry;
+  return registry;
+}
+
+CodeCacheRegistry::CodeCacheRegistry() {
+  const char* capacity = std::getenv("FBGEMM_KERNEL_CACHE_CAPACITY");
+  if (capacity != nullptr) {
+    capacity_ = std::strtoull(capacity, nullptr, 10);
+  }
+  const char* policy = std::getenv("FBGEMM_KERNEL_CACHE_POLICY");
+  if (policy != nullptr) {
+    std::string val(policy);
+    std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+    if (val == "LFU") {
+      policy_ = KernelCacheEvictionPolicy::LFU;
+    }
+  }
+}
+
+void CodeCacheRegistry::add(
+    const std::string& name,
+    RegisteredCodeCache* cache) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  caches_[name] = cache;
+}
+
+void CodeCacheRegistry::remove(const std::string& name) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  caches_.erase(name);
+}
+
+std::vector<std::pair<std::string, RegisteredCodeCache*>>
+CodeCacheRegistry::caches() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return {caches_.begin(), caches_.end()};
+}
+
+void CodeCacheRegistry::addRuntime(asmjit::JitRuntime* runtime) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  runtimes_.insert(runtime);
+}
+
+JitMemoryStats CodeCacheRegistry::jitMemoryStats() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  JitMemoryStats stats;
+  for (asmjit::JitRuntime* runtime : runtimes_) {
+    const asmjit::JitAllocator::Statistics allocStats =
+        runtime->allocator()->statistics();
+    stats.reservedBytes += allocStats.reservedSize();
+    stats.usedBytes += allocStats.usedSize();
+  }
+  return stats;
+}
+
+namespace {
+
+void addStats(KernelCacheStats& total, const KernelCacheStats& stats) {
+  total.hits += stats.hits;
+  total.misses += stats.misses;
+  total.evictions += stats.evictions;
+  total.entries += stats.entries;
+  total.evicted += stats.evicted;
+  total.codegenNanoseconds += stats.codegenNanoseconds;
+  total.codeBytes += stats.codeBytes;
+}
+
+void writeJsonString(std::ostream& os, const std::string& str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      os << buf;
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+void writeJsonStats(std::ostream& os, const KernelCacheStats& stats) {
+  os << "\"entries\": " << stats.entries << ", \"hits\": " << stats.hits
+     << ", \"misses\": " << stats.misses
+     << ", \"evictions\": " << stats.evictions
+     << ", \"evicted\": " << stats.evicted
+     << ", \"codegen_ns\": " << stats.codegenNanoseconds
+     << ", \"code_bytes\": " << stats.codeBytes;
+}
+
+} // namespace
+
+void fbgemmSetKernelCacheCapacity(
+    std::size_t maxEntries,
+    KernelCacheEvictionPolicy policy) {
+  CodeCacheRegistry::instance().setCapacity(maxEntries, policy);
+}
+
+KernelCacheStats fbgemmGetKernelCacheStats() {
+  KernelCacheStats total;
+  for (const auto& cache : CodeCacheRegistry::instance().caches()) {
+    addStats(total, cache.second->stats());
+  }
+  return total;
+}
+
+std::vector<KernelCacheInfo> fbgemmGetKernelCacheInfo(
+    std::size_t numHottestKeys) {
+  std::vector<KernelCacheInfo> infos;
+  for (const auto& cache : CodeCacheRegistry::instance().caches()) {
+    KernelCacheInfo info;
+    info.name = cache.first;
+    info.stats = cache.second->stats();
+    info.hottestKeys = cache.second->hottestKeys(numHottestKeys);
+    infos.push_back(std::move(info));
+  }
+  return infos;
+}
+
+JitMemoryStats fbgemmGetJitMemoryStats() {
+  return CodeCacheRegistry::instance().jitMemoryStats();
+}
+
+std::string fbgemmKernelCacheStatsToJson(std::size_t numHottestKeys) {
+  const std::vector<KernelCacheInfo> infos =
+      fbgemmGetKernelCacheInfo(numHottestKeys);
+  const JitMemoryStats memory = fbgemmGetJitMemoryStats();
+  KernelCacheStats total;
+  for (const auto& info : infos) {
+    addStats(total, info.stats);
+  }
+
+  std::ostringstream os;
+  os << "{\n  \"jit_memory\": {\"reserved_bytes\": " << memory.reservedBytes
+     << ", \"used_bytes\": " << memory.usedBytes << "},\n  \"total\": {";
+  writeJsonStats(os, total);
+  os << "},\n  \"caches\": [";
+  for (std::size_t i = 0; i < infos.size(); ++i) {
+    os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    writeJsonString(os, infos[i].name);
+    os << ", ";
+    writeJsonStats(os, infos[i].stats);
+    os << ", \"hottest_keys\": [";
+    const auto& keys = infos[i].hottestKeys;
+    for (std::size_t k = 0; k < keys.size(); ++k) {
+      os << (k == 0 ? "" : ", ") << "{\"key\": ";
+      writeJsonString(os, keys[k].key);
+      os << ", \"hits\": " << keys[k].hits << "}";
+    }
+    os << "]}";
+  }
+  os << (infos.empty() ? "]\n}\n" : "\n  ]\n}\n");
+  return os.str();
+}
+
+std::size_t fbgemmReleaseEvictedKernels() {
+  std::size_t released = 0;
+  for (const auto& cache : CodeCacheRegistry::instance().caches()) {
+    released += cache.second->releaseEvicted();
+  }
+  return released;
+}
+
+} // namespace fbgemm
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <asmjit/asmjit.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fbgemm/FbgemmKernelCache.h"
+
+namespace fbgemm {
+
+/**
+ * @brief Interface through which process wide operations (stats, eviction,
+ * persistence manifests) reach the individual code caches.
+ */
+class RegisteredCodeCache {
+ public:
+  virtual ~RegisteredCodeCache() = default;
+
+  /**
+   * @brief Install the persisted kernel for the serialized key.
+   * @return false if the key is malformed or the kernel is not persisted.
+   */
+  virtual bool prewarm(const std::string& key) = 0;
+
+  /**
+   * @brief Serialized keys of all the kernels held by the cache, empty if the
+   * cache's keys are not persistable.
+   */
+  virtual std::vector<std::string> serializedKeys() = 0;
+
+  virtual KernelCacheStats stats() = 0;
+
+  /**
+   * @brief The n most hit kernels, most hit first.
+   */
+  virtual std::vector<KernelCacheKeyStats> hottestKeys(std::size_t n) = 0;
+
+  /**
+   * @brief Free the code of the evicted kernels.
+   * @return number of kernels released.
+   */
+  virtual std::size_t releaseEvicted() = 0;
+};
+
+/**
+ * @brief Process wide registry of the named code caches and of the settings
+ * shared by all of them.
+ */
+class CodeCacheRegistry {
+ public:
+  static CodeCacheRegistry& instance();
+
+  void add(const std::string& name, RegisteredCodeCache* cache);
+  void remove(const std::string& name);
+
+  /**
+   * @brief Snapshot of the registered caches. The caches live in static
+   * storage so the pointers stay valid until exit.
+   */
+  std::vector<std::pair<std::string, RegisteredCodeCache*>> caches();
+
+  /**
+   * @brief Remember a JIT runtime that kernels were added to, for
+   * fbgemmGetJitMemoryStats. Runtimes are function local statics that live
+   * until exit.
+   */
+  void addRuntime(asmjit::JitRuntime* runtime);
+  JitMemoryStats jitMemoryStats();
+
+  /// Maximum number of kernels per cache, 0 if unbounded.
+  std::size_t capacity() const {
+    return capacity_.load(std::memory_order_relaxed);
+  }
+  KernelCacheEvictionPolicy policy() const {
+    return policy_.load(std::memory_order_relaxed);
+  }
+  void setCapacity(std::size_t maxEntries, KernelCacheEvictionPolicy policy) {
+    policy_.store(policy, std::memory_order_relaxed);
+    capacity_.store(maxEntries, std::memory_order_relaxed);
+  }
+
+ private:
+  CodeCacheRegistry();
+
+  std::mutex mutex_;
+  std::map<std::string, RegisteredCodeCache*> caches_;
+  std::set<asmjit::JitRuntime*> runtimes_;
+  std::atomic<std::size_t> capacity_{0};
+  std::atomic<KernelCacheEvictionPolicy> policy_{
+      KernelCacheEvictionPolicy::LRU};
+};
+
+constexpr int kCodeCacheCounterShards = 64;
+
+/**
+ * @brief Per thread slot for sharded counters, so that threads bumping hit
+ * counters on different cores don't share cache lines.
+ */
+inline int codeCacheCounterShard() {
+  static std::atomic<int> nextThread{0};
+  static thread_local int shard =
+      nextThread.fetch_add(1, std::memory_order_relaxed) %
+      kCodeCacheCounterShards;
+  return shard;
+}
+
+constexpr int kCodeCacheHitSampling = 16;
+
+/**
+ * @brief Whether to count this hit in the per kernel hit counts. Only every
+ * kCodeCacheHitSampling-th hit of a thread is counted to keep the hot path
+ * from writing to shared cache lines.
+ */
+inline bool codeCacheSampleHit() {
+  static thread_local int countdown = 1;
+  if (--countdown == 0) {
+    countdown = kCodeCacheHitSampling;
+    return true;
+  }
+  return false;
+}
+
+} // namespace fbgemm
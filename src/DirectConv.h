@@ -216,12 +216,14 @@ template <typename TA, typename TB, typename TC, typename accT>
 CodeCache<
     std::tuple<bool, int, int, int, int, int, int>,
     typename DirectConvCodeGenBase<TA, TB, TC, accT>::jit_micro_kernel_fp>
-    DirectConvCodeGenBase<TA, TB, TC, accT>::codeCache_;
+    DirectConvCodeGenBase<TA, TB, TC, accT>::codeCache_(
+        codeCacheName<DirectConvCodeGenBase<TA, TB, TC, accT>>());
 
 template <typename TA, typename TB, typename TC, typename accT>
 CodeCache<
     std::tuple<bool, int, int, int>,
     typename DirectConvCodeGenBase<TA, TB, TC, accT>::jit_micro_kernel_fp_convT>
-    DirectConvCodeGenBase<TA, TB, TC, accT>::codeCacheT_;
+    DirectConvCodeGenBase<TA, TB, TC, accT>::codeCacheT_(
+        codeCacheName<DirectConvCodeGenBase<TA, TB, TC, accT>>("codeCacheT_"));
 
 } // namespace fbgemm
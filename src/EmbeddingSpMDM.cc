@@ -18,6 +18,7 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <mutex>
 #include <string>
@@ -180,7 +181,14 @@ CodeCache<
         outType,
         instSet,
         ROWWISE_SPARSE,
-        THREAD_LOCAL>::codeCache_;
+        THREAD_LOCAL>::codeCache_(codeCacheName<GenEmbeddingSpMDMLookup<
+                                      inType,
+                                      indxType,
+                                      offsetType,
+                                      outType,
+                                      instSet,
+                                      ROWWISE_SPARSE,
+                                      THREAD_LOCAL>>());
 
 template <
     typename inType,
@@ -992,11 +1000,7 @@ GenEmbeddingSpMDMLookup<
             offsetType,
             outType,
             ROWWISE_SPARSE>::jit_embedding_kernel fn;
-        asmjit::Error err;
-        {
-          std::unique_lock<std::mutex> lock(rtMutex_);
-          err = runtime().add(&fn, &code);
-        }
+        asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
         if (err) {
           std::cout << "Error: in fn add" << std::endl;
           return nullptr;
@@ -1319,14 +1323,90 @@ typename EmbeddingSpMDMKernelSignature<uint8_t, indxType, offsetType, outType>::
         int64_t input_stride /*=-1*/,
         int exponent_bits,
         int exponent_bias,
-        bool is_bf16_out) {
+        bool is_bf16_out,
+        [[maybe_unused]] int prefetch) {
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
   if (output_stride == -1) {
     output_stride = block_size;
   }
   if (input_stride == -1) {
     input_stride = block_size;
   }
-  // There is only the reference implementation for FP8 embedding
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  // The SIMD kernels rebase the exponent field in place, which requires all
+  // FP8 values, including the subnormals, to be normal numbers in FP32.
+  const bool simd_supported = exponent_bits >= 1 && exponent_bits <= 7 &&
+      exponent_bias >= 0 && exponent_bias <= 120 + exponent_bits;
+  if (simd_supported) {
+    const inst_set_t isa = fbgemmInstructionSet();
+#ifndef NO_AVX512
+    if (isZmm(isa)) {
+      return [=](int64_t output_size,
+                 int64_t index_size,
+                 int64_t data_size,
+                 const uint8_t* input,
+                 const indxType* indices,
+                 const offsetType* offsets_or_lengths,
+                 const float* weights,
+                 outType* out) {
+        return internal::EmbeddingSpMDMFP8_avx512(
+            block_size,
+            output_size,
+            index_size,
+            data_size,
+            input,
+            indices,
+            offsets_or_lengths,
+            weights,
+            normalize_by_lengths,
+            out,
+            is_weight_positional,
+            use_offsets,
+            output_stride,
+            input_stride,
+            exponent_bits,
+            exponent_bias,
+            is_bf16_out,
+            prefetch);
+      };
+    }
+#endif // NO_AVX512
+    if (isYmm(isa)) {
+      return [=](int64_t output_size,
+                 int64_t index_size,
+                 int64_t data_size,
+                 const uint8_t* input,
+                 const indxType* indices,
+                 const offsetType* offsets_or_lengths,
+                 const float* weights,
+                 outType* out) {
+        return internal::EmbeddingSpMDMFP8_avx2(
+            block_size,
+            output_size,
+            index_size,
+            data_size,
+            input,
+            indices,
+            offsets_or_lengths,
+            weights,
+            normalize_by_lengths,
+            out,
+            is_weight_positional,
+            use_offsets,
+            output_stride,
+            input_stride,
+            exponent_bits,
+            exponent_bias,
+            is_bf16_out,
+            prefetch);
+      };
+    }
+  }
+#endif // CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+
   return [=](int64_t output_size,
              int64_t index_size,
              int64_t data_size,
@@ -1535,7 +1615,8 @@ GenerateEmbeddingSpMDMRowWiseSparse(
       int64_t input_stride,                                                \
       int exponent_bits,                                                   \
       int exponent_bias,                                                   \
-      bool is_bf16_out);
+      bool is_bf16_out,                                                    \
+      int prefetch);
 
 #define INSTANTIATE_SPMDM_NOSTRIDE_BASE(                      \
     IN_TYPE, INDEX_TYPE, OFFSET_TYPE, OUT_TYPE, THREAD_LOCAL) \
@@ -1698,4 +1779,108 @@ INSTANTIATE_REMAP_BASE(int64_t)
 
 #undef INSTANTIATE_REMAP_BASE
 
+void pruned_hashmap_lookup(
+    const std::int32_t* indices,
+    std::int64_t num_indices,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int32_t* dense_indices) {
+  if (capacity <= 0) {
+    throw std::runtime_error("pruned_hashmap_lookup: capacity must be > 0");
+  }
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  // The SIMD kernels compute slots in 32-bit lanes
+  if (capacity <= std::numeric_limits<std::int32_t>::max()) {
+    const inst_set_t isa = fbgemmInstructionSet();
+#ifndef NO_AVX512
+    if (isZmm(isa)) {
+      internal::pruned_hashmap_lookup_avx512(
+          indices, num_indices, hash_table, capacity, dense_indices);
+      return;
+    }
+#endif // NO_AVX512
+    if (isYmm(isa)) {
+      internal::pruned_hashmap_lookup_avx2(
+          indices, num_indices, hash_table, capacity, dense_indices);
+      return;
+    }
+  }
+#endif // CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+
+  pruned_hashmap_lookup_ref(
+      indices, num_indices, hash_table, capacity, dense_indices);
+}
+
+template <typename IndexType>
+std::int64_t lxu_cache_lookup(
+    const IndexType* linear_cache_indices,
+    std::int64_t num_indices,
+    const std::int64_t* cache_state,
+    std::int32_t num_sets,
+    int ways,
+    std::int64_t invalid_index,
+    std::int32_t* cache_locations) {
+  if (num_sets <= 0 || ways <= 0) {
+    throw std::runtime_error("lxu_cache_lookup: empty cache");
+  }
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  // The SIMD kernels compare whole vectors of ways
+  const inst_set_t isa = fbgemmInstructionSet();
+#ifndef NO_AVX512
+  if (isZmm(isa) && ways % 8 == 0) {
+    return internal::lxu_cache_lookup_avx512(
+        linear_cache_indices,
+        num_indices,
+        cache_state,
+        num_sets,
+        ways,
+        invalid_index,
+        cache_locations);
+  }
+#endif // NO_AVX512
+  if (isYmm(isa) && ways % 4 == 0) {
+    return internal::lxu_cache_lookup_avx2(
+        linear_cache_indices,
+        num_indices,
+        cache_state,
+        num_sets,
+        ways,
+        invalid_index,
+        cache_locations);
+  }
+#endif // CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+
+  return lxu_cache_lookup_ref(
+      linear_cache_indices,
+      num_indices,
+      cache_state,
+      num_sets,
+      ways,
+      invalid_index,
+      cache_locations);
+}
+
+#define INSTANTIATE_LXU_CACHE_BASE(INDEX_TYPE)       \
+  template FBGEMM_API std::int64_t lxu_cache_lookup( \
+      const INDEX_TYPE* linear_cache_indices,        \
+      std::int64_t num_indices,                      \
+      const std::int64_t* cache_state,               \
+      std::int32_t num_sets,                         \
+      int ways,                                      \
+      std::int64_t invalid_index,                    \
+      std::int32_t* cache_locations);
+
+INSTANTIATE_LXU_CACHE_BASE(std::int32_t)
+INSTANTIATE_LXU_CACHE_BASE(std::int64_t)
+
+#undef INSTANTIATE_LXU_CACHE_BASE
+
 } // namespace fbgemm
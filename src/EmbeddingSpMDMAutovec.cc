@@ -282,7 +282,8 @@ bool EmbeddingSpMDMNBit_autovec(
     int64_t output_stride /*=-1*/,
     int64_t input_stride /*=-1*/,
     const bool scale_bias_last /*=true*/,
-    const bool is_bf16_out /*=false*/) {
+    const bool is_bf16_out /*=false*/,
+    int prefetch_group /*=1*/) {
   assert((bit_rate == 2 || bit_rate == 4) && "bit_rate must be 2 or 4");
   const int num_elem_per_byte = 8 / bit_rate;
 
@@ -306,6 +307,8 @@ bool EmbeddingSpMDMNBit_autovec(
   constexpr int64_t CACHE_LINE_SIZE = 64;
   const int64_t rows_to_prefetch =
       std::min(max_initial_prefetch_rows, max_prefetch_bytes / input_stride);
+  constexpr int kMaxPrefetchGroup = 32;
+  prefetch_group = std::min(prefetch_group, kMaxPrefetchGroup);
   const int64_t prefetch_stride = std::min(rows_to_prefetch, index_size);
   // The following prefetch loop is written in this way for better performance.
   // My understanding is that manually separating the case of input_stride being
@@ -338,74 +341,150 @@ bool EmbeddingSpMDMNBit_autovec(
     if (current + len > index_size) {
       return false;
     }
+    if (prefetch_group > 1) {
+      // Pipelined mode: look up a group of rows first and then accumulate
+      // them element by element, so that the loads of all the rows in the
+      // group are in flight together. The rows are still added in order, so
+      // the results are the same as with the row by row loop below.
+      const uint8_t* rows[kMaxPrefetchGroup];
+      float scales[kMaxPrefetchGroup];
+      float biases[kMaxPrefetchGroup];
+      for (int i0 = 0; i0 < len; i0 += prefetch_group) {
+        const int group_len = std::min(prefetch_group, len - i0);
+        for (int g = 0; g < group_len; ++g) {
+          const int64_t idx = indices[current + g];
+          if (idx < 0 || idx >= data_size) {
+            return false;
+          }
+          const int64_t prefetch_idx =
+              indices[std::min(current + g + prefetch_stride, index_size - 1)];
+          for (int64_t offset = 0; offset < input_stride;
+               offset += CACHE_LINE_SIZE) {
+            do_prefetch(
+                reinterpret_cast<const char*>(
+                    input + input_stride * prefetch_idx + offset),
+                0,
+                0);
+          }
+
+          const float16* scale_bias = reinterpret_cast<const float16*>(
+              input + input_stride * idx +
+              (scale_bias_last ? div_up(block_size, num_elem_per_byte) : 0));
+          float scale = cpu_half2float(scale_bias[0]);
+          float bias = cpu_half2float(scale_bias[1]);
+          if (weights) {
+            float weight = weights[is_weight_positional ? i0 + g : current + g];
+            scale *= weight;
+            bias *= weight;
+          }
+          rows[g] = input + input_stride * idx +
+              (scale_bias_last ? 0 : scale_bias_offset);
+          scales[g] = scale;
+          biases[g] = bias;
+        }
+
+        if (bit_rate == 4) {
+          const int64_t halfbufsz = (block_size + 1) / 2;
+          for (int64_t j = 0; j < halfbufsz; ++j) {
+            float acc1 = buf[j * 2];
+            float acc2 = buf[j * 2 + 1];
+            for (int g = 0; g < group_len; ++g) {
+              const uint8_t tmp = rows[g][j];
+              acc1 = std::fma(scales[g], float(tmp & 0xf), acc1 + biases[g]);
+              acc2 = std::fma(scales[g], float(tmp >> 4), acc2 + biases[g]);
+            }
+            buf[j * 2] = acc1;
+            buf[j * 2 + 1] = acc2;
+          }
+        } else if (bit_rate == 2) {
+          const int64_t qbufsz = (block_size + 3) / 4;
+          for (int64_t j = 0; j < qbufsz; ++j) {
+            float acc[4] = {
+                buf[j * 4], buf[j * 4 + 1], buf[j * 4 + 2], buf[j * 4 + 3]};
+            for (int g = 0; g < group_len; ++g) {
+              const uint8_t tmp = rows[g][j];
+              for (int k = 0; k < 4; ++k) {
+                const float quantized = float((tmp >> (2 * k)) & 0x3);
+                acc[k] = std::fma(scales[g], quantized, acc[k] + biases[g]);
+              }
+            }
+            for (int k = 0; k < 4; ++k) {
+              buf[j * 4 + k] = acc[k];
+            }
+          }
+        }
+        current += group_len;
+      }
+    } else {
 #if _OPENMP >= 202011
-    constexpr int tile_size = 4;
+      constexpr int tile_size = 4;
 #pragma omp tile sizes(tile_size)
 #endif
-    for (int i = 0; i < len; ++i) {
-      int64_t idx = indices[current];
-      if (idx < 0 || idx >= data_size) {
-        return false;
-      }
-      int64_t prefetch_idx =
-          indices[std::min(current + prefetch_stride, index_size - 1)];
-
-      do_prefetch(
-          reinterpret_cast<const char*>(input + input_stride * prefetch_idx),
-          0,
-          0);
-      if (input_stride > CACHE_LINE_SIZE) {
-        for (int64_t offset = CACHE_LINE_SIZE; offset < input_stride;
-             offset += CACHE_LINE_SIZE) {
-          do_prefetch(
-              reinterpret_cast<const char*>(
-                  input + input_stride * prefetch_idx + offset),
-              0,
-              0);
+      for (int i = 0; i < len; ++i) {
+        int64_t idx = indices[current];
+        if (idx < 0 || idx >= data_size) {
+          return false;
         }
-      }
+        int64_t prefetch_idx =
+            indices[std::min(current + prefetch_stride, index_size - 1)];
 
-      const float16* scale_bias = reinterpret_cast<const float16*>(
-          input + input_stride * idx +
-          (scale_bias_last ? div_up(block_size, num_elem_per_byte) : 0));
+        do_prefetch(
+            reinterpret_cast<const char*>(input + input_stride * prefetch_idx),
+            0,
+            0);
+        if (input_stride > CACHE_LINE_SIZE) {
+          for (int64_t offset = CACHE_LINE_SIZE; offset < input_stride;
+               offset += CACHE_LINE_SIZE) {
+            do_prefetch(
+                reinterpret_cast<const char*>(
+                    input + input_stride * prefetch_idx + offset),
+                0,
+                0);
+          }
+        }
 
-      float scale = cpu_half2float(scale_bias[0]);
-      float bias = cpu_half2float(scale_bias[1]);
-      if (weights) {
-        float weight = weights[is_weight_positional ? i : current];
-        scale *= weight;
-        bias *= weight;
-      }
+        const float16* scale_bias = reinterpret_cast<const float16*>(
+            input + input_stride * idx +
+            (scale_bias_last ? div_up(block_size, num_elem_per_byte) : 0));
 
-      const int64_t offset =
-          input_stride * idx + (scale_bias_last ? 0 : scale_bias_offset);
-      const uint8_t* input_row = input + offset;
-      if (bit_rate == 4) {
-        const size_t halfbufsz = (block_size + 1) / 2;
-        for (size_t j = 0; j < halfbufsz; ++j) {
-          float quantized1 = float(input_row[j] & 0xf);
-          float quantized2 = float(input_row[j] >> 4);
-          buf[j * 2] = std::fma(scale, quantized1, buf[j * 2] + bias);
-          buf[j * 2 + 1] = std::fma(scale, quantized2, buf[j * 2 + 1] + bias);
+        float scale = cpu_half2float(scale_bias[0]);
+        float bias = cpu_half2float(scale_bias[1]);
+        if (weights) {
+          float weight = weights[is_weight_positional ? i : current];
+          scale *= weight;
+          bias *= weight;
         }
-      } else if (bit_rate == 2) {
-        size_t qbufsz = (block_size + 3) / 4;
-        const uint8_t mask1 = 0x3;
-        const uint8_t mask2 = 0xC;
-        const uint8_t mask3 = 0x30;
-        for (size_t j = 0; j < qbufsz; ++j) {
-          uint8_t tmp = input[offset + j];
-          float quantized1 = float(tmp & mask1);
-          buf[j * 4] = std::fma(scale, quantized1, buf[j * 4] + bias);
-          float quantized2 = float((tmp & mask2) >> 2);
-          buf[j * 4 + 1] = std::fma(scale, quantized2, buf[j * 4 + 1] + bias);
-          float quantized3 = float((tmp & mask3) >> 4);
-          buf[j * 4 + 2] = std::fma(scale, quantized3, buf[j * 4 + 2] + bias);
-          float quantized4 = float(tmp >> 6);
-          buf[j * 4 + 3] = std::fma(scale, quantized4, buf[j * 4 + 3] + bias);
+
+        const int64_t offset =
+            input_stride * idx + (scale_bias_last ? 0 : scale_bias_offset);
+        const uint8_t* input_row = input + offset;
+        if (bit_rate == 4) {
+          const size_t halfbufsz = (block_size + 1) / 2;
+          for (size_t j = 0; j < halfbufsz; ++j) {
+            float quantized1 = float(input_row[j] & 0xf);
+            float quantized2 = float(input_row[j] >> 4);
+            buf[j * 2] = std::fma(scale, quantized1, buf[j * 2] + bias);
+            buf[j * 2 + 1] = std::fma(scale, quantized2, buf[j * 2 + 1] + bias);
+          }
+        } else if (bit_rate == 2) {
+          size_t qbufsz = (block_size + 3) / 4;
+          const uint8_t mask1 = 0x3;
+          const uint8_t mask2 = 0xC;
+          const uint8_t mask3 = 0x30;
+          for (size_t j = 0; j < qbufsz; ++j) {
+            uint8_t tmp = input[offset + j];
+            float quantized1 = float(tmp & mask1);
+            buf[j * 4] = std::fma(scale, quantized1, buf[j * 4] + bias);
+            float quantized2 = float((tmp & mask2) >> 2);
+            buf[j * 4 + 1] = std::fma(scale, quantized2, buf[j * 4 + 1] + bias);
+            float quantized3 = float((tmp & mask3) >> 4);
+            buf[j * 4 + 2] = std::fma(scale, quantized3, buf[j * 4 + 2] + bias);
+            float quantized4 = float(tmp >> 6);
+            buf[j * 4 + 3] = std::fma(scale, quantized4, buf[j * 4 + 3] + bias);
+          }
         }
+        ++current;
       }
-      ++current;
     }
 
     if (normalize_by_lengths && len) {
@@ -454,7 +533,8 @@ bool EmbeddingSpMDMNBit_autovec(
       int64_t output_stride,                                      \
       int64_t input_stride,                                       \
       const bool scale_bias_last,                                 \
-      const bool is_bf16_out);
+      const bool is_bf16_out,                                     \
+      int prefetch_group);
 
 #define INSTANTIATE_SPMDM_OUT_T(INDEX_TYPE, OFFSET_TYPE) \
   INSTANTIATE_SPMDM_BASE(INDEX_TYPE, OFFSET_TYPE, float) \
@@ -67,7 +67,8 @@ FBGEMM_API bool EmbeddingSpMDMNBit_autovec(
     std::int64_t output_stride = -1,
     std::int64_t input_stride = -1,
     const bool scale_bias_last = true,
-    const bool is_bf16_out = false);
+    const bool is_bf16_out = false,
+    int prefetch_group = 1);
 
 } // namespace fbgemm
 
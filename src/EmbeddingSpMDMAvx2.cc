@@ -7,7 +7,13 @@
  */
 
 #define FBGEMM_EXPORTS
+#include <immintrin.h>
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstring>
+#include <vector>
+#include "./MaskAvx2.h"
 #include "RefImplementations.h"
 #include "fbgemm/FbgemmEmbedding.h"
 
@@ -160,5 +166,437 @@ INSTANTIATE_SPMDM_INDEX_T(std::uint8_t)
 #undef INSTANTIATE_SPMDM_OFFSET_T
 #undef INSTANTIATE_SPMDM_BASE
 
+namespace {
+
+// Decodes 8 FP8 values to the same results as Float8ToFloat_ref. Normal
+// values are rebased by adding (127 - bias) to the exponent, and subnormals
+// are converted from their mantissa and scaled, so that no FP32 subnormal is
+// ever an operand (which would take a slow microcode assist).
+inline __m256 fp8_to_fp32_avx2(
+    __m128i src,
+    __m128i shift_v,
+    __m256i exponent_offset_v,
+    __m256i min_normal_v,
+    __m256 subnormal_scale_v) {
+  const __m256i x = _mm256_cvtepu8_epi32(src);
+  const __m256i sign = _mm256_slli_epi32(_mm256_srli_epi32(x, 7), 31);
+  const __m256i mag = _mm256_and_si256(x, _mm256_set1_epi32(0x7f));
+  const __m256 normal = _mm256_castsi256_ps(
+      _mm256_add_epi32(_mm256_sll_epi32(mag, shift_v), exponent_offset_v));
+  const __m256 subnormal =
+      _mm256_mul_ps(_mm256_cvtepi32_ps(mag), subnormal_scale_v);
+  const __m256 is_subnormal =
+      _mm256_castsi256_ps(_mm256_cmpgt_epi32(min_normal_v, mag));
+  return _mm256_or_ps(
+      _mm256_blendv_ps(normal, subnormal, is_subnormal),
+      _mm256_castsi256_ps(sign));
+}
+
+template <typename OutType>
+inline void store_fp8_output_avx2(
+    OutType* out,
+    const float* buf,
+    std::int64_t block_size,
+    float scale,
+    bool is_bf16_out) {
+  constexpr int VLEN = 8;
+  const __m256 scale_v = _mm256_set1_ps(scale);
+  std::int64_t j = 0;
+  for (; j + VLEN <= block_size; j += VLEN) {
+    const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(buf + j), scale_v);
+    if constexpr (std::is_same<OutType, float>::value) {
+      _mm256_storeu_ps(out + j, v);
+    } else if (is_bf16_out) {
+      // Same rounding as cpu_float2bfloat16
+      __m256i r = _mm256_srli_epi32(
+          _mm256_add_epi32(_mm256_castps_si256(v), _mm256_set1_epi32(1 << 15)),
+          16);
+      r = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0xd8);
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(out + j), _mm256_castsi256_si128(r));
+    } else {
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(out + j),
+          _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    }
+  }
+  for (; j < block_size; ++j) {
+    out[j] = convert_from_float_ref<OutType>(buf[j] * scale, is_bf16_out);
+  }
+}
+
+} // namespace
+
+template <typename IndexType, typename OffsetType, typename OutType>
+bool EmbeddingSpMDMFP8_avx2(
+    const std::int64_t block_size,
+    const std::int64_t output_size,
+    const std::int64_t index_size,
+    const std::int64_t data_size,
+    const std::uint8_t* input,
+    const IndexType* indices,
+    const OffsetType* offsets_or_lengths,
+    const float* weights,
+    bool normalize_by_lengths,
+    OutType* out,
+    bool is_weight_positional,
+    bool use_offsets,
+    std::int64_t output_stride,
+    std::int64_t input_stride,
+    int exponent_bits,
+    int exponent_bias,
+    bool is_bf16_out,
+    int prefetch) {
+  constexpr int VLEN = 8;
+  constexpr std::int64_t CACHE_LINE_LEN = 64;
+  const std::int64_t num_full_vecs = block_size / VLEN * VLEN;
+  const int rem = block_size % VLEN;
+  const __m256i mask_v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+      &avx2_ps_or_epi32_combined_mask[(VLEN - rem) % VLEN]));
+  const int mantissa_bits = 7 - exponent_bits;
+  const __m128i shift_v = _mm_cvtsi32_si128(23 - mantissa_bits);
+  const __m256i exponent_offset_v =
+      _mm256_set1_epi32((127 - exponent_bias) << 23);
+  const __m256i min_normal_v = _mm256_set1_epi32(1 << mantissa_bits);
+  // 2^(1 - bias - mantissa_bits)
+  const __m256 subnormal_scale_v = _mm256_castsi256_ps(
+      _mm256_set1_epi32((128 - exponent_bias - mantissa_bits) << 23));
+
+  std::vector<float> buf(block_size);
+
+  std::int64_t current = 0;
+  for (std::int64_t m = 0; m < output_size; ++m) {
+    std::fill(buf.begin(), buf.end(), 0.f);
+    const std::int64_t len = use_offsets
+        ? offsets_or_lengths[m + 1] - offsets_or_lengths[m]
+        : offsets_or_lengths[m];
+    if (current + len > index_size) {
+      return false;
+    }
+    for (std::int64_t i = 0; i < len; ++i, ++current) {
+      const std::int64_t idx = indices[current];
+      if (idx < 0 || idx >= data_size) {
+        return false;
+      }
+      if (prefetch) {
+        // Prefetched indices are validated only when they are reached
+        const std::int64_t pf_idx =
+            indices[std::min<std::int64_t>(current + prefetch, index_size - 1)];
+        if (pf_idx >= 0 && pf_idx < data_size) {
+          for (std::int64_t col = 0; col < block_size; col += CACHE_LINE_LEN) {
+            _mm_prefetch(
+                reinterpret_cast<const char*>(
+                    input + input_stride * pf_idx + col),
+                _MM_HINT_T0);
+          }
+        }
+      }
+
+      const __m256 w_v = _mm256_set1_ps(
+          weights ? weights[is_weight_positional ? i : current] : 1.f);
+      const std::uint8_t* row = input + input_stride * idx;
+      std::int64_t j = 0;
+      for (; j < num_full_vecs; j += VLEN) {
+        const __m256 x = fp8_to_fp32_avx2(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + j)),
+            shift_v,
+            exponent_offset_v,
+            min_normal_v,
+            subnormal_scale_v);
+        _mm256_storeu_ps(
+            buf.data() + j,
+            _mm256_fmadd_ps(w_v, x, _mm256_loadu_ps(buf.data() + j)));
+      }
+      if (rem) {
+        // Don't read past the end of the row, which may be the end of input
+        std::int64_t tail = 0;
+        std::memcpy(&tail, row + j, rem);
+        const __m256 x = fp8_to_fp32_avx2(
+            _mm_cvtsi64_si128(tail),
+            shift_v,
+            exponent_offset_v,
+            min_normal_v,
+            subnormal_scale_v);
+        _mm256_maskstore_ps(
+            buf.data() + j,
+            mask_v,
+            _mm256_fmadd_ps(
+                w_v, x, _mm256_maskload_ps(buf.data() + j, mask_v)));
+      }
+    }
+    const float scale = normalize_by_lengths && len ? 1.f / len : 1.f;
+    store_fp8_output_avx2(out, buf.data(), block_size, scale, is_bf16_out);
+    out += output_stride;
+  }
+  return current == index_size;
+}
+
+#define INSTANTIATE_SPMDM_FP8_BASE(INDEX_TYPE, OFFSET_TYPE, OUT_TYPE) \
+  template bool EmbeddingSpMDMFP8_avx2(                               \
+      const std::int64_t block_size,                                  \
+      const std::int64_t output_size,                                 \
+      const std::int64_t index_size,                                  \
+      const std::int64_t data_size,                                   \
+      const std::uint8_t* input,                                      \
+      const INDEX_TYPE* indices,                                      \
+      const OFFSET_TYPE* offsets_or_lengths,                          \
+      const float* weights,                                           \
+      bool normalize_by_lengths,                                      \
+      OUT_TYPE* out,                                                  \
+      bool is_weight_positional,                                      \
+      bool use_offsets,                                               \
+      std::int64_t output_stride,                                     \
+      std::int64_t input_stride,                                      \
+      int exponent_bits,                                              \
+      int exponent_bias,                                              \
+      bool is_bf16_out,                                               \
+      int prefetch);
+
+#define INSTANTIATE_SPMDM_FP8_OUT_T(INDEX_TYPE, OFFSET_TYPE) \
+  INSTANTIATE_SPMDM_FP8_BASE(INDEX_TYPE, OFFSET_TYPE, float) \
+  INSTANTIATE_SPMDM_FP8_BASE(INDEX_TYPE, OFFSET_TYPE, std::uint16_t)
+
+#define INSTANTIATE_SPMDM_FP8_OFFSET_T(INDEX_TYPE)      \
+  INSTANTIATE_SPMDM_FP8_OUT_T(INDEX_TYPE, std::int32_t) \
+  INSTANTIATE_SPMDM_FP8_OUT_T(INDEX_TYPE, std::int64_t)
+
+INSTANTIATE_SPMDM_FP8_OFFSET_T(std::int32_t)
+INSTANTIATE_SPMDM_FP8_OFFSET_T(std::int64_t)
+
+#undef INSTANTIATE_SPMDM_FP8_OFFSET_T
+#undef INSTANTIATE_SPMDM_FP8_OUT_T
+#undef INSTANTIATE_SPMDM_FP8_BASE
+
+namespace {
+
+// Keys hashed and prefetched per group before any of them is probed, so that
+// the cache misses on their home slots overlap.
+constexpr int kPrunedHashmapGroup = 64;
+
+// Unsigned 32-bit division by d as a multiply and two shifts (Granlund and
+// Montgomery): n / d = (t + ((n - t) >> shift1)) >> shift2, t = mulhi(n, m).
+inline void divisor_magic_u32(
+    std::uint32_t d,
+    std::uint32_t& m,
+    int& shift1,
+    int& shift2) {
+  int l = 0;
+  while ((std::uint64_t(1) << l) < d) {
+    ++l;
+  }
+  m = static_cast<std::uint32_t>(
+      ((std::uint64_t(1) << 32) * ((std::uint64_t(1) << l) - d)) / d + 1);
+  shift1 = std::min(l, 1);
+  shift2 = std::max(l - 1, 0);
+}
+
+inline __m256i mulhi_epu32_avx2(__m256i a, __m256i b) {
+  const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+  const __m256i odd = _mm256_mul_epu32(
+      _mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// Home slot of 8 keys: MurmurHash3 fmix32 modulo the capacity
+inline __m256i pruned_hash_slot_avx2(
+    __m256i h,
+    __m256i capacity_v,
+    __m256i magic_v,
+    __m128i shift1_v,
+    __m128i shift2_v) {
+  h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+  h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0x85ebca6b));
+  h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+  h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0xc2b2ae35));
+  h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+  const __m256i t = mulhi_epu32_avx2(h, magic_v);
+  const __m256i q = _mm256_srl_epi32(
+      _mm256_add_epi32(t, _mm256_srl_epi32(_mm256_sub_epi32(h, t), shift1_v)),
+      shift2_v);
+  return _mm256_sub_epi32(h, _mm256_mullo_epi32(q, capacity_v));
+}
+
+// Linear probing for one key from slot, for at most max_probes slots
+inline std::int32_t pruned_hashmap_probe(
+    std::int32_t key,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int64_t slot,
+    std::int64_t max_probes) {
+  for (std::int64_t probe = 0; probe < max_probes; ++probe) {
+    const std::int32_t* entry = hash_table + 2 * slot;
+    if (entry[0] == -1) {
+      return -1;
+    }
+    if (entry[0] == key) {
+      return entry[1];
+    }
+    slot = slot + 1 == capacity ? 0 : slot + 1;
+  }
+  return -1;
+}
+
+} // namespace
+
+void pruned_hashmap_lookup_avx2(
+    const std::int32_t* indices,
+    std::int64_t num_indices,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int32_t* dense_indices) {
+  constexpr int VLEN = 8;
+  std::uint32_t magic;
+  int shift1, shift2;
+  divisor_magic_u32(capacity, magic, shift1, shift2);
+  const __m256i capacity_v = _mm256_set1_epi32(capacity);
+  const __m256i magic_v = _mm256_set1_epi32(magic);
+  const __m128i shift1_v = _mm_cvtsi32_si128(shift1);
+  const __m128i shift2_v = _mm_cvtsi32_si128(shift2);
+  const __m256i minus_one_v = _mm256_set1_epi32(-1);
+  const __m256i one_v = _mm256_set1_epi32(1);
+
+  alignas(32) std::int32_t slots[kPrunedHashmapGroup];
+  for (std::int64_t g = 0; g < num_indices; g += kPrunedHashmapGroup) {
+    const int len =
+        std::min<std::int64_t>(kPrunedHashmapGroup, num_indices - g);
+    for (int i = 0; i < len; i += VLEN) {
+      const __m256i mask_v = _mm256_load_si256(reinterpret_cast<const __m256i*>(
+          avx2_ps_or_epi32_masks[std::min(len - i, VLEN)]));
+      const __m256i keys = _mm256_maskload_epi32(indices + g + i, mask_v);
+      _mm256_store_si256(
+          reinterpret_cast<__m256i*>(slots + i),
+          pruned_hash_slot_avx2(
+              keys, capacity_v, magic_v, shift1_v, shift2_v));
+    }
+    for (int i = 0; i < len; ++i) {
+      _mm_prefetch(
+          reinterpret_cast<const char*>(hash_table + 2 * slots[i]),
+          _MM_HINT_T0);
+    }
+
+    for (int i = 0; i < len; i += VLEN) {
+      const __m256i mask_v = _mm256_load_si256(reinterpret_cast<const __m256i*>(
+          avx2_ps_or_epi32_masks[std::min(len - i, VLEN)]));
+      const __m256i keys = _mm256_maskload_epi32(indices + g + i, mask_v);
+      __m256i slot_v =
+          _mm256_load_si256(reinterpret_cast<const __m256i*>(slots + i));
+      __m256i result = minus_one_v;
+      __m256i active = mask_v;
+      // Every unresolved lane moves one slot further per round. Lanes resolve
+      // at different rounds, so once only a few are left (long probe chains,
+      // mostly misses in a full table) they are finished one at a time.
+      std::int64_t probe = 0;
+      for (; probe < capacity &&
+           _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(active))) >=
+               VLEN / 2;
+           ++probe) {
+        const __m256i found = _mm256_mask_i32gather_epi32(
+            minus_one_v, hash_table, slot_v, active, 8);
+        const __m256i empty =
+            _mm256_and_si256(active, _mm256_cmpeq_epi32(found, minus_one_v));
+        const __m256i hit = _mm256_andnot_si256(
+            empty, _mm256_and_si256(active, _mm256_cmpeq_epi32(found, keys)));
+        result = _mm256_mask_i32gather_epi32(
+            result, hash_table + 1, slot_v, hit, 8);
+        active = _mm256_andnot_si256(_mm256_or_si256(hit, empty), active);
+        slot_v = _mm256_add_epi32(slot_v, one_v);
+        slot_v = _mm256_andnot_si256(
+            _mm256_cmpeq_epi32(slot_v, capacity_v), slot_v);
+      }
+      alignas(32) std::int32_t lane_slots[VLEN];
+      alignas(32) std::int32_t lane_results[VLEN];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lane_slots), slot_v);
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lane_results), result);
+      for (unsigned lanes = _mm256_movemask_ps(_mm256_castsi256_ps(active));
+           lanes;
+           lanes &= lanes - 1) {
+        const int lane = std::countr_zero(lanes);
+        lane_results[lane] = pruned_hashmap_probe(
+            indices[g + i + lane],
+            hash_table,
+            capacity,
+            lane_slots[lane],
+            capacity - probe);
+      }
+      _mm256_maskstore_epi32(
+          dense_indices + g + i,
+          mask_v,
+          _mm256_load_si256(reinterpret_cast<const __m256i*>(lane_results)));
+    }
+  }
+}
+
+// Indices whose cache sets are computed and prefetched before any of them
+// is compared, so that the cache misses on the set states overlap.
+constexpr int kLxuCacheGroup = 16;
+
+template <typename IndexType>
+std::int64_t lxu_cache_lookup_avx2(
+    const IndexType* linear_cache_indices,
+    std::int64_t num_indices,
+    const std::int64_t* cache_state,
+    std::int32_t num_sets,
+    int ways,
+    std::int64_t invalid_index,
+    std::int32_t* cache_locations) {
+  constexpr int VLEN = 4;
+  std::int64_t num_misses = 0;
+  std::int64_t sets[kLxuCacheGroup];
+  for (std::int64_t g = 0; g < num_indices; g += kLxuCacheGroup) {
+    const int len = std::min<std::int64_t>(kLxuCacheGroup, num_indices - g);
+    for (int i = 0; i < len; ++i) {
+      sets[i] = lxu_cache_slot(linear_cache_indices[g + i], num_sets);
+      const char* set_state =
+          reinterpret_cast<const char*>(cache_state + sets[i] * ways);
+      for (std::size_t b = 0; b < ways * sizeof(std::int64_t); b += 64) {
+        _mm_prefetch(set_state + b, _MM_HINT_T0);
+      }
+    }
+
+    for (int i = 0; i < len; ++i) {
+      const std::int64_t idx = linear_cache_indices[g + i];
+      std::int32_t location = -1;
+      if (idx != invalid_index) {
+        const std::int64_t* set_state = cache_state + sets[i] * ways;
+        const __m256i idx_v = _mm256_set1_epi64x(idx);
+        // Compare all the ways, up to 64 at a time, and take the first hit
+        // without a data dependent branch per vector
+        for (int base = 0; base < ways && location == -1; base += 64) {
+          const int end = std::min(ways, base + 64);
+          std::uint64_t bits = 0;
+          for (int way = base; way < end; way += VLEN) {
+            const __m256i ways_v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(set_state + way));
+            const int hits = _mm256_movemask_pd(
+                _mm256_castsi256_pd(_mm256_cmpeq_epi64(ways_v, idx_v)));
+            bits |= static_cast<std::uint64_t>(hits) << (way - base);
+          }
+          if (bits) {
+            location = sets[i] * ways + base + std::countr_zero(bits);
+          }
+        }
+        num_misses += location == -1;
+      }
+      cache_locations[g + i] = location;
+    }
+  }
+  return num_misses;
+}
+
+#define INSTANTIATE_LXU_CACHE_BASE(INDEX_TYPE) \
+  template std::int64_t lxu_cache_lookup_avx2( \
+      const INDEX_TYPE* linear_cache_indices,  \
+      std::int64_t num_indices,                \
+      const std::int64_t* cache_state,         \
+      std::int32_t num_sets,                   \
+      int ways,                                \
+      std::int64_t invalid_index,              \
+      std::int32_t* cache_locations);
+
+INSTANTIATE_LXU_CACHE_BASE(std::int32_t)
+INSTANTIATE_LXU_CACHE_BASE(std::int64_t)
+
+#undef INSTANTIATE_LXU_CACHE_BASE
+
 } // namespace internal
 } // namespace fbgemm
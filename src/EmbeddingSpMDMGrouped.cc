@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "fbgemm/FbgemmEmbedding.h"
+#include "fbgemm/Types.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#define omp_get_num_threads() 1
+#define omp_get_thread_num() 0
+#endif
+
+namespace fbgemm {
+
+namespace {
+
+// Chunks per thread to aim for. More chunks balance better, fewer chunks have
+// less per call overhead.
+constexpr std::int64_t kChunksPerThread = 8;
+// Don't split below this many bytes so that the kernel call overhead stays
+// small relative to the work.
+constexpr std::int64_t kMinChunkBytes = 32 * 1024;
+
+struct Chunk {
+  int table;
+  std::int64_t bag_begin;
+  std::int64_t bag_end;
+};
+
+// Next chunk to run in a thread's range. Padded to a cache line so that the
+// owner's fetch_add doesn't contend with the counters of other threads.
+struct alignas(64) ChunkRange {
+  std::atomic<std::int64_t> next{0};
+  std::int64_t end{0};
+};
+
+} // namespace
+
+template <
+    typename InType,
+    typename IndexType,
+    typename OffsetType,
+    typename OutType>
+bool EmbeddingSpMDMGrouped(
+    const EmbeddingSpMDMTableArgs<InType, IndexType, OffsetType, OutType>*
+        tables,
+    int num_tables,
+    bool normalize_by_lengths,
+    int prefetch,
+    int num_threads) {
+  using Kernel = typename EmbeddingSpMDMKernelSignature<
+      InType,
+      IndexType,
+      OffsetType,
+      OutType>::Type;
+  if (num_tables <= 0) {
+    return true;
+  }
+  const int nthreads = num_threads > 0 ? num_threads : omp_get_max_threads();
+
+  // Tables usually share a handful of shapes, so look each kernel up once.
+  std::map<std::tuple<std::int64_t, bool, std::int64_t, std::int64_t, bool>,
+           Kernel>
+      generated;
+  std::vector<const Kernel*> kernels(num_tables);
+  // Bytes read per index and written per bag, used to estimate the cost of a
+  // range of bags as rowBytes * indices + bagBytes * bags.
+  std::vector<std::int64_t> rowBytes(num_tables);
+  std::vector<std::int64_t> bagBytes(num_tables);
+  std::int64_t totalBytes = 0;
+  for (int t = 0; t < num_tables; ++t) {
+    const auto& table = tables[t];
+    const auto key = std::make_tuple(
+        table.block_size,
+        table.weights != nullptr,
+        table.output_stride,
+        table.input_stride,
+        table.scale_bias_last);
+    auto it = generated.find(key);
+    if (it == generated.end()) {
+      it = generated
+               .emplace(
+                   key,
+                   GenerateEmbeddingSpMDMWithStrides<
+                       InType,
+                       IndexType,
+                       OffsetType,
+                       OutType>(
+                       table.block_size,
+                       table.weights != nullptr,
+                       normalize_by_lengths,
+                       prefetch,
+                       /*is_weight_positional=*/false,
+                       /*use_offsets=*/true,
+                       table.output_stride,
+                       table.input_stride,
+                       table.scale_bias_last))
+               .first;
+    }
+    kernels[t] = &it->second;
+
+    std::int64_t rowSize = table.input_stride == -1
+        ? table.block_size * static_cast<std::int64_t>(sizeof(InType))
+        : table.input_stride * static_cast<std::int64_t>(sizeof(InType));
+    if (std::is_same<InType, std::uint8_t>::value && table.input_stride == -1) {
+      // Per row scale and bias
+      rowSize += table.scale_bias_last ? 2 * sizeof(float)
+                                       : 2 * sizeof(float16);
+    }
+    rowBytes[t] = rowSize + sizeof(IndexType) +
+        (table.weights != nullptr ? sizeof(float) : 0);
+    bagBytes[t] = table.block_size * sizeof(OutType) + sizeof(OffsetType);
+    if (table.output_size > 0) {
+      totalBytes += rowBytes[t] *
+              (table.offsets[table.output_size] - table.offsets[0]) +
+          bagBytes[t] * table.output_size;
+    }
+  }
+
+  // Split every table into bag ranges of about targetBytes each.
+  const std::int64_t targetBytes =
+      std::max(kMinChunkBytes, totalBytes / (nthreads * kChunksPerThread));
+  std::vector<Chunk> chunks;
+  std::vector<std::int64_t> chunkBytes;
+  for (int t = 0; t < num_tables; ++t) {
+    const auto& table = tables[t];
+    const auto cost = [&](std::int64_t bag) {
+      return rowBytes[t] * (table.offsets[bag] - table.offsets[0]) +
+          bagBytes[t] * bag;
+    };
+    std::int64_t begin = 0;
+    while (begin < table.output_size) {
+      // The cost is monotonic in the bag index, so binary search for the
+      // first bag that reaches the target.
+      const std::int64_t beginCost = cost(begin);
+      std::int64_t lo = begin + 1, hi = table.output_size;
+      while (lo < hi) {
+        const std::int64_t mid = lo + (hi - lo) / 2;
+        if (cost(mid) - beginCost >= targetBytes) {
+          hi = mid;
+        } else {
+          lo = mid + 1;
+        }
+      }
+      chunks.push_back({t, begin, lo});
+      chunkBytes.push_back(cost(lo) - beginCost);
+      begin = lo;
+    }
+  }
+  const std::int64_t numChunks = chunks.size();
+  if (numChunks == 0) {
+    return true;
+  }
+
+  // Give every thread a contiguous range of chunks of about the same cost.
+  // Consecutive chunks of a thread are mostly from the same table, so its
+  // rows and the kernel's code stay in cache.
+  const int numRanges =
+      static_cast<int>(std::min<std::int64_t>(nthreads, numChunks));
+  std::vector<ChunkRange> ranges(numRanges);
+  {
+    std::int64_t accBytes = 0;
+    int r = 0;
+    for (std::int64_t c = 0; c < numChunks; ++c) {
+      accBytes += chunkBytes[c];
+      while (r + 1 < numRanges &&
+             accBytes * numRanges > totalBytes * (r + 1)) {
+        ranges[++r].next.store(c + 1, std::memory_order_relaxed);
+      }
+    }
+    for (r = 0; r < numRanges; ++r) {
+      ranges[r].end = r + 1 < numRanges
+          ? ranges[r + 1].next.load(std::memory_order_relaxed)
+          : numChunks;
+    }
+  }
+
+  std::atomic<bool> success{true};
+#pragma omp parallel num_threads(numRanges)
+  {
+    // Drain the own range first, then steal from the others in round robin
+    // order. Thieves take one chunk at a time from the same counter as the
+    // owner, so no chunk is run twice.
+    const int tid = omp_get_thread_num();
+    for (int i = 0; i < numRanges; ++i) {
+      ChunkRange& range = ranges[(tid + i) % numRanges];
+      while (true) {
+        const std::int64_t c =
+            range.next.fetch_add(1, std::memory_order_relaxed);
+        if (c >= range.end) {
+          break;
+        }
+        const Chunk& chunk = chunks[c];
+        const auto& table = tables[chunk.table];
+        const OffsetType* offsets = table.offsets + chunk.bag_begin;
+        const std::int64_t outputStride = table.output_stride == -1
+            ? table.block_size
+            : table.output_stride;
+        const bool ok = (*kernels[chunk.table])(
+            chunk.bag_end - chunk.bag_begin,
+            table.offsets[chunk.bag_end] - offsets[0],
+            table.data_size,
+            table.input,
+            table.indices + offsets[0],
+            offsets,
+            table.weights != nullptr ? table.weights + offsets[0] : nullptr,
+            table.out + chunk.bag_begin * outputStride);
+        if (!ok) {
+          success.store(false, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+  return success.load();
+}
+
+#define INSTANTIATE_SPMDM_GROUPED(IN_TYPE, INDEX_TYPE, OFFSET_TYPE) \
+  template FBGEMM_API bool                                          \
+  EmbeddingSpMDMGrouped<IN_TYPE, INDEX_TYPE, OFFSET_TYPE, float>(   \
+      const EmbeddingSpMDMTableArgs<                                \
+          IN_TYPE,                                                  \
+          INDEX_TYPE,                                               \
+          OFFSET_TYPE,                                              \
+          float>* tables,                                           \
+      int num_tables,                                               \
+      bool normalize_by_lengths,                                    \
+      int prefetch,                                                 \
+      int num_threads);
+
+#define INSTANTIATE_SPMDM_GROUPED_OFFSET_T(IN_TYPE, INDEX_TYPE) \
+  INSTANTIATE_SPMDM_GROUPED(IN_TYPE, INDEX_TYPE, std::int32_t)  \
+  INSTANTIATE_SPMDM_GROUPED(IN_TYPE, INDEX_TYPE, std::int64_t)
+
+#define INSTANTIATE_SPMDM_GROUPED_INDEX_T(IN_TYPE)          \
+  INSTANTIATE_SPMDM_GROUPED_OFFSET_T(IN_TYPE, std::int32_t) \
+  INSTANTIATE_SPMDM_GROUPED_OFFSET_T(IN_TYPE, std::int64_t)
+
+INSTANTIATE_SPMDM_GROUPED_INDEX_T(float)
+INSTANTIATE_SPMDM_GROUPED_INDEX_T(float16)
+INSTANTIATE_SPMDM_GROUPED_INDEX_T(std::uint8_t)
+
+#undef INSTANTIATE_SPMDM_GROUPED_INDEX_T
+#undef INSTANTIATE_SPMDM_GROUPED_OFFSET_T
+#undef INSTANTIATE_SPMDM_GROUPED
+
+} // namespace fbgemm
@@ -104,7 +104,8 @@ class GenEmbeddingSpMDMNBitLookup {
       int output_stride,
       int input_stride,
       bool scale_bias_last,
-      bool is_bf16_out);
+      bool is_bf16_out,
+      int prefetch_group);
 
  private:
   static asmjit::JitRuntime& runtime() {
@@ -119,9 +120,10 @@ class GenEmbeddingSpMDMNBitLookup {
 
   // The hash depends on bit_rate, embedding dimension (block size), weighted
   // sls, positional weights, normalize by lenths, prefetch distance,
-  // use_offsets, output_stride, input_stride, and scale_bias_last
+  // use_offsets, output_stride, input_stride, scale_bias_last, is_bf16_out,
+  // and prefetch group size
   static CodeCache<
-      tuple<int, int, bool, bool, bool, int, bool, int, int, bool, bool>,
+      tuple<int, int, bool, bool, bool, int, bool, int, int, bool, bool, int>,
       typename ReturnFunctionSignature<
           indxType,
           offsetType,
@@ -154,7 +156,7 @@ template <
     bool ROWWISE_SPARSE,
     bool THREAD_LOCAL>
 CodeCache<
-    tuple<int, int, bool, bool, bool, int, bool, int, int, bool, bool>,
+    tuple<int, int, bool, bool, bool, int, bool, int, int, bool, bool, int>,
     typename ReturnFunctionSignature<
         indxType,
         offsetType,
@@ -167,7 +169,13 @@ CodeCache<
         outType,
         instSet,
         ROWWISE_SPARSE,
-        THREAD_LOCAL>::codeCache_;
+        THREAD_LOCAL>::codeCache_(codeCacheName<GenEmbeddingSpMDMNBitLookup<
+                                      indxType,
+                                      offsetType,
+                                      outType,
+                                      instSet,
+                                      ROWWISE_SPARSE,
+                                      THREAD_LOCAL>>());
 
 template <
     typename indxType,
@@ -199,7 +207,8 @@ GenEmbeddingSpMDMNBitLookup<
         int output_stride,
         int input_stride,
         bool scale_bias_last,
-        bool is_bf16_out) {
+        bool is_bf16_out,
+        int prefetch_group) {
   auto kernelSig = make_tuple(
       bit_rate,
       block_size,
@@ -211,7 +220,8 @@ GenEmbeddingSpMDMNBitLookup<
       output_stride,
       input_stride,
       scale_bias_last,
-      is_bf16_out);
+      is_bf16_out,
+      prefetch_group);
 
   return codeCache_.getOrCreate(
       kernelSig,
@@ -222,6 +232,12 @@ GenEmbeddingSpMDMNBitLookup<
                 ROWWISE_SPARSE>::jit_embedding_kernel {
         // TODO: Make this tunable
         int pref_dist = prefetch;
+        // In pipelined mode whole groups of rows are prefetched at the top of
+        // the index loop instead of one row interleaved with the compute.
+        const bool pipelined =
+            pref_dist > 0 && prefetch_group > 1 && !ROWWISE_SPARSE;
+        const int row_pref_dist = pipelined ? 0 : pref_dist;
+        constexpr unsigned int CACHE_LINE_LEN = 64;
         bool areIndices64b = is_same<indxType, int64_t>::value;
 
         asmjit::CodeHolder code;
@@ -236,6 +252,9 @@ GenEmbeddingSpMDMNBitLookup<
         if (prefetch) {
           filename += "_prefetch";
         }
+        if (pipelined) {
+          filename += "_group" + to_string(prefetch_group);
+        }
         if (has_weight) {
           filename += "_hasweight";
         }
@@ -600,6 +619,49 @@ GenEmbeddingSpMDMNBitLookup<
           a->dec(lengths_R_);
           a->jl(LoopDataIndexEnd);
 
+          if (pipelined && vec_idx == 0) {
+            // Every prefetch_group indices (tracked with the address of the
+            // current index), prefetch all the cache lines of the next
+            // group of rows, including the trailing scale and bias. Only the
+            // first pass over the rows of a bag needs this.
+            asmjit::Label group_pref_end = a->newLabel();
+            a->test(
+                indices.r32(),
+                static_cast<asmjit::Imm>(
+                    prefetch_group * sizeof(indxType) - 1));
+            a->jnz(group_pref_end);
+            for (int g = 0; g < prefetch_group; ++g) {
+              asmjit::Label skip_row = a->newLabel();
+              const int pref_offset = (pref_dist + g) * sizeof(indxType);
+              a->lea(scratchReg2_, x86::ptr(indices, pref_offset));
+              a->cmp(scratchReg2_, index_size);
+              a->jge(group_pref_end);
+              if (areIndices64b) {
+                a->mov(scratchReg2_, x86::qword_ptr(indices, pref_offset));
+              } else {
+                a->mov(
+                    scratchReg2_.r32(), x86::dword_ptr(indices, pref_offset));
+              }
+              // Skip invalid and pruned (-1) indices
+              a->cmp(scratchReg2_, data_size);
+              a->jae(skip_row);
+              a->imul(
+                  scratchReg2_, static_cast<asmjit::Imm>(input_stride));
+              for (int line = 0; line < input_stride;
+                   line += CACHE_LINE_LEN) {
+                a->prefetcht0(x86::dword_ptr(input, scratchReg2_, 0, line));
+              }
+              // Rows are not cache line aligned, so the last bytes may be on
+              // one more cache line.
+              if (input_stride % CACHE_LINE_LEN != 1) {
+                a->prefetcht0(
+                    x86::dword_ptr(input, scratchReg2_, 0, input_stride - 1));
+              }
+              a->bind(skip_row);
+            }
+            a->bind(group_pref_end);
+          }
+
           // Array out of bound check
           if (areIndices64b) {
             a->mov(scratchReg1_, x86::qword_ptr(indices));
@@ -639,7 +701,7 @@ GenEmbeddingSpMDMNBitLookup<
 
           int num_elem_per_byte = 8 / bit_rate;
           int fused_block_size = input_stride;
-          if (pref_dist) {
+          if (row_pref_dist) {
             asmjit::Label pref_dist_reset_start = a->newLabel();
             asmjit::Label pref_dist_reset_end = a->newLabel();
             // out of bound handling for prefetch
@@ -721,8 +783,7 @@ GenEmbeddingSpMDMNBitLookup<
           a->vpbroadcastw(bias_vreg.half(), bias_src);
           a->vcvtph2ps(scale_vreg, scale_vreg.half());
           a->vcvtph2ps(bias_vreg, bias_vreg.half());
-          constexpr unsigned int CACHE_LINE_LEN = 64;
-          if (pref_dist && fused_block_size % CACHE_LINE_LEN > 0 &&
+          if (row_pref_dist && fused_block_size % CACHE_LINE_LEN > 0 &&
               fused_block_size % CACHE_LINE_LEN <= 2 * sizeof(uint16_t)) {
             a->prefetcht0(x86::dword_ptr(
                 input,
@@ -847,7 +908,7 @@ GenEmbeddingSpMDMNBitLookup<
 
             int vload_per_cache_line = CACHE_LINE_LEN / bytes_per_vload;
             int v_aligned = ceil_div(vec_idx + v, 4) * 4;
-            if (pref_dist && v_aligned % vload_per_cache_line == 0) {
+            if (row_pref_dist && v_aligned % vload_per_cache_line == 0) {
               a->prefetcht0(x86::dword_ptr(
                   input, scratchReg2_, 0, v_aligned * bytes_per_vload));
             }
@@ -994,11 +1055,7 @@ GenEmbeddingSpMDMNBitLookup<
             offsetType,
             outType,
             ROWWISE_SPARSE>::jit_embedding_kernel fn;
-        asmjit::Error err;
-        {
-          unique_lock<mutex> lock(rtMutex_);
-          err = runtime().add(&fn, &code);
-        }
+        asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
         if (err) {
           cout << "Error: in fn add" << endl;
           return nullptr;
@@ -1032,7 +1089,8 @@ typename EmbeddingSpMDMKernelSignature<uint8_t, indxType, offsetType, outType>::
         int64_t output_stride /*=-1*/,
         int64_t input_stride /*=-1*/,
         bool scale_bias_last /*=true*/,
-        bool is_bf16_out) {
+        bool is_bf16_out,
+        int prefetch_group) {
   assert((bit_rate == 2 || bit_rate == 4) && "bit_rate must be 2 or 4");
 
   if (!cpuinfo_initialize()) {
@@ -1046,6 +1104,13 @@ typename EmbeddingSpMDMKernelSignature<uint8_t, indxType, offsetType, outType>::
     input_stride =
         ceil_div(block_size, num_elem_per_byte) + 2 * sizeof(uint16_t);
   }
+  // Group prefetching is unrolled in the generated code, so keep the number
+  // of variants and the code size small.
+  constexpr int kMaxPrefetchGroup = 32;
+  prefetch_group = std::min(std::max(prefetch_group, 1), kMaxPrefetchGroup);
+  while (prefetch_group & (prefetch_group - 1)) {
+    prefetch_group &= prefetch_group - 1;
+  }
   if (fbgemmHasAvx512Support() && !is_asmjit_disabled()) {
     static GenEmbeddingSpMDMNBitLookup<
         indxType,
@@ -1066,7 +1131,8 @@ typename EmbeddingSpMDMKernelSignature<uint8_t, indxType, offsetType, outType>::
         output_stride,
         input_stride,
         scale_bias_last,
-        is_bf16_out);
+        is_bf16_out,
+        prefetch_group);
     return [=](int64_t output_size,
                int64_t index_size,
                int64_t data_size,
@@ -1106,7 +1172,8 @@ typename EmbeddingSpMDMKernelSignature<uint8_t, indxType, offsetType, outType>::
         output_stride,
         input_stride,
         scale_bias_last,
-        is_bf16_out);
+        is_bf16_out,
+        prefetch_group);
     return [=](int64_t output_size,
                int64_t index_size,
                int64_t data_size,
@@ -1155,7 +1222,8 @@ typename EmbeddingSpMDMKernelSignature<uint8_t, indxType, offsetType, outType>::
           output_stride,
           input_stride,
           scale_bias_last,
-          is_bf16_out);
+          is_bf16_out,
+          prefetch_group);
     };
 #endif // #ifdef __linux__
   } else {
@@ -1256,7 +1324,8 @@ GenerateEmbeddingSpMDMNBitRowWiseSparse(
         /*output_stride=*/block_size,
         input_stride,
         /*scale_bias_last=*/true,
-        /*is_bf16_out=*/false);
+        /*is_bf16_out=*/false,
+        /*prefetch_group=*/1);
     return [=](int64_t output_size,
                int64_t index_size,
                int64_t uncompressed_data_size,
@@ -1297,7 +1366,8 @@ GenerateEmbeddingSpMDMNBitRowWiseSparse(
         /*output_stride=*/block_size,
         input_stride,
         /*scale_bias_last=*/true,
-        /*is_bf16_out=*/false);
+        /*is_bf16_out=*/false,
+        /*prefetch_group=*/1);
     return [=](int64_t output_size,
                int64_t index_size,
                int64_t uncompressed_data_size,
@@ -1374,7 +1444,8 @@ GenerateEmbeddingSpMDMNBitRowWiseSparse(
       int64_t output_stride,                                  \
       int64_t input_stride,                                   \
       bool scale_bias_last,                                   \
-      bool is_bf16_out);
+      bool is_bf16_out,                                       \
+      int prefetch_group);
 
 #define INSTANTIATE_SPMDM_THREAD_LOCAL(INDEX_TYPE, OFFSET_TYPE, OUT_TYPE) \
   INSTANTIATE_SPMDM_BASE(INDEX_TYPE, OFFSET_TYPE, OUT_TYPE, false)        \
@@ -113,6 +113,45 @@ void ExecuteKernel<
   // packedA_.printPackedMatrix("packedA from kernel");
   // packedB_.printPackedMatrix("packedB from kernel");
 
+  int32_t bColBlocks = packedB_.blockCols();
+  int NDim = packedB_.numCols();
+
+  // Columns [n_begin, n_end) of C computed by this thread. Skinny GEMMs split
+  // them in register blocks instead of column blocks: there may be fewer
+  // column blocks than threads since fbgemmPacked doesn't split m for them.
+  int64_t n_begin, n_end;
+  if (th_info_.n_num_threads > 1 && fbgemmIsSkinnyGemm(packedA_.numRows())) {
+    fbgemmPartition1D(
+        th_info_.n_thread_id,
+        th_info_.n_num_threads,
+        (NDim + nrMinSize_ - 1) / nrMinSize_,
+        n_begin,
+        n_end);
+    n_begin *= nrMinSize_;
+    n_end = std::min<int64_t>(n_end * nrMinSize_, NDim);
+  } else {
+    fbgemmPartition1D(
+        th_info_.n_thread_id,
+        th_info_.n_num_threads,
+        bColBlocks,
+        n_begin,
+        n_end);
+    n_begin *= nbSize_;
+    n_end = std::min<int64_t>(n_end * nbSize_, NDim);
+  }
+  execute(kBlock, n_begin, n_end);
+}
+
+template <typename packingAMatrix, typename cT, typename processOutputType>
+void ExecuteKernel<
+    packingAMatrix,
+    PackBMatrix<int8_t, typename packingAMatrix::accType>,
+    cT,
+    processOutputType>::execute(int kBlock, int64_t n_begin, int64_t n_end) {
+  if (n_end <= n_begin) {
+    return;
+  }
+
   int32_t bColBlocks = packedB_.blockCols();
 
   int8_t* bBuf;
@@ -128,86 +167,76 @@ void ExecuteKernel<
   bool lastKBlock = packedB_.isThisLastKBlock(kBlock % packedB_.blockRows());
   bool accum = (kBlock % packedB_.blockRows()) > 0;
 
-  int64_t jb_begin, jb_end;
-  fbgemmPartition1D(
-      th_info_.n_thread_id,
-      th_info_.n_num_threads,
-      bColBlocks,
-      jb_begin,
-      jb_end);
-  if (jb_end == jb_begin) {
-    return;
-  }
+  const inst_set_t isa = fbgemmInstructionSet();
+  // Kernel computing nc columns of a block of B, nc a multiple of nrMinSize_
+  auto getKernel = [&](int nc) -> typename BaseType::jit_micro_kernel_fp {
+    switch (isa) {
+      case inst_set_t::avx512_vnni:
+        if (std::is_same<typename packingAMatrix::accType, std::int16_t>::
+                value) {
+          // For AVX512VNNI, we redirect int16_t to int32_t accumulation.
+          CodeGenBase<uint8_t, int8_t, int32_t, int32_t> codeObj;
+          return codeObj.getOrCreate<inst_set_t::avx512_vnni>(
+              accum, packed_rows_A, nc, packedA_.numPackedCols());
+        }
+        return BaseType::template getOrCreate<inst_set_t::avx512_vnni>(
+            accum, packed_rows_A, nc, packedA_.numPackedCols());
 
-  typename BaseType::jit_micro_kernel_fp fn;
+      case inst_set_t::avx512_vnni_ymm:
+        if (std::is_same<typename packingAMatrix::accType, std::int16_t>::
+                value) {
+          // For AVX512VNNI, we redirect int16_t to int32_t accumulation.
+          CodeGenBase<uint8_t, int8_t, int32_t, int32_t> codeObj;
+          return codeObj.getOrCreate<inst_set_t::avx512_vnni_ymm>(
+              accum, packed_rows_A, nc, packedA_.numPackedCols());
+        }
+        return BaseType::template getOrCreate<inst_set_t::avx512_vnni_ymm>(
+            accum, packed_rows_A, nc, packedA_.numPackedCols());
 
-  const inst_set_t isa = fbgemmInstructionSet();
-  switch (isa) {
-    case inst_set_t::avx512_vnni:
-      if (std::is_same<typename packingAMatrix::accType, std::int16_t>::value) {
-        // For AVX512VNNI, we redirect int16_t to int32_t accumulation.
-        CodeGenBase<uint8_t, int8_t, int32_t, int32_t> codeObj;
-        fn = codeObj.getOrCreate<inst_set_t::avx512_vnni>(
-            accum,
-            packed_rows_A,
-            packedB_.blockColSize(),
-            packedA_.numPackedCols());
-      } else {
-        fn = BaseType::template getOrCreate<inst_set_t::avx512_vnni>(
-            accum,
-            packed_rows_A,
-            packedB_.blockColSize(),
-            packedA_.numPackedCols());
-      }
-      break;
-
-    case inst_set_t::avx512_vnni_ymm:
-      if (std::is_same<typename packingAMatrix::accType, std::int16_t>::value) {
-        // For AVX512VNNI, we redirect int16_t to int32_t accumulation.
-        CodeGenBase<uint8_t, int8_t, int32_t, int32_t> codeObj;
-        fn = codeObj.getOrCreate<inst_set_t::avx512_vnni_ymm>(
-            accum,
-            packed_rows_A,
-            packedB_.blockColSize(),
-            packedA_.numPackedCols());
-      } else {
-        fn = BaseType::template getOrCreate<inst_set_t::avx512_vnni_ymm>(
-            accum,
-            packed_rows_A,
-            packedB_.blockColSize(),
-            packedA_.numPackedCols());
-      }
-      break;
-
-    case inst_set_t::avx512:
-      fn = BaseType::template getOrCreate<inst_set_t::avx512>(
-          accum,
-          packed_rows_A,
-          packedB_.blockColSize(),
-          packedA_.numPackedCols());
-      break;
-
-    case inst_set_t::avx512_ymm:
-      fn = BaseType::template getOrCreate<inst_set_t::avx512_ymm>(
-          accum,
-          packed_rows_A,
-          packedB_.blockColSize(),
-          packedA_.numPackedCols());
-      break;
-
-    case inst_set_t::avx2:
-      fn = BaseType::template getOrCreate<inst_set_t::avx2>(
-          accum,
-          packed_rows_A,
-          packedB_.blockColSize(),
-          packedA_.numPackedCols());
-      break;
-
-    default:
-      // TODO: Have default slower path
-      assert(0 && "unsupported architecture");
-      throw std::runtime_error("unsupported architecure");
-  }
+      case inst_set_t::avx512:
+        return BaseType::template getOrCreate<inst_set_t::avx512>(
+            accum, packed_rows_A, nc, packedA_.numPackedCols());
+
+      case inst_set_t::avx512_ymm:
+        return BaseType::template getOrCreate<inst_set_t::avx512_ymm>(
+            accum, packed_rows_A, nc, packedA_.numPackedCols());
+
+      case inst_set_t::avx2:
+        return BaseType::template getOrCreate<inst_set_t::avx2>(
+            accum, packed_rows_A, nc, packedA_.numPackedCols());
+
+      default:
+        // TODO: Have default slower path
+        assert(0 && "unsupported architecture");
+        throw std::runtime_error("unsupported architecure");
+    }
+  };
+
+  typename BaseType::jit_micro_kernel_fp fn = nullptr;
+  int fn_nc = 0;
+
+  const auto& packedB =
+      static_cast<const PackBMatrix<int8_t, typename packingAMatrix::accType>&>(
+          packedB_);
+
+  // If the accumulation buffer C_buffer_ is the same as matC_ (inplace output
+  // processing), then each thread use the different parts of output buffer
+  // matC_;
+  // Otherwise, each thread uses different portions of the accumulation
+  // buffer C_buffer_. If m is large enough (m >= m_nthreads * MC), then we
+  // only need to use (m_nthreads * MC) x n portion of C_buffer_, each thread
+  // access the C_buffer_row_start as tid * MC * ldc_; else when m is very
+  // small, we juse use the whole m x n C_buffer_: each thread use the
+  // different portion.
+  int32_t* C_buffer_row_start = C_buffer_ +
+      ((C_buffer_ == reinterpret_cast<int32_t*>(matC_) ||
+        th_info_.m_num_threads * mbSize_ > packedA_.numRows())
+           ? row_start_A * ldc_ + NDim * group
+           : th_info_.m_thread_id * mbSize_ * ldc_ + NDim * group);
+
+  static thread_local std::vector<int32_t> C_tile_;
+  // Columns [n_tile, n_end) are accumulated in C_tile_
+  int64_t n_tile = n_end;
 
 #ifdef FBGEMM_MEASURE_TIME_BREAKDOWN
   std::chrono::time_point<std::chrono::high_resolution_clock> t_start, t_end;
@@ -215,88 +244,29 @@ void ExecuteKernel<
   t_start = std::chrono::high_resolution_clock::now();
 #endif
 
-  for (int jb = jb_begin; jb < jb_end; ++jb) {
-    if (jb == bColBlocks - 1) {
-      int nc = ((packedB_.lastBcol() - 1) / nrMinSize_ + 1) * nrMinSize_;
-      if (nc != nbSize_) {
-        switch (isa) {
-          case inst_set_t::avx512_vnni:
-            if (std::is_same<typename packingAMatrix::accType, std::int16_t>::
-                    value) {
-              // For AVX512VNNI, we redirect int16_t to int32_t accumulation.
-              CodeGenBase<uint8_t, int8_t, int32_t, int32_t> codeObj;
-              fn = codeObj.getOrCreate<inst_set_t::avx512_vnni>(
-                  accum, packed_rows_A, nc, packedA_.numPackedCols());
-            } else {
-              fn = BaseType::template getOrCreate<inst_set_t::avx512_vnni>(
-                  accum, packed_rows_A, nc, packedA_.numPackedCols());
-            }
-            break;
-
-          case inst_set_t::avx512_vnni_ymm:
-            if (std::is_same<typename packingAMatrix::accType, std::int16_t>::
-                    value) {
-              // For AVX512VNNI, we redirect int16_t to int32_t accumulation.
-              CodeGenBase<uint8_t, int8_t, int32_t, int32_t> codeObj;
-              fn = codeObj.getOrCreate<inst_set_t::avx512_vnni_ymm>(
-                  accum, packed_rows_A, nc, packedA_.numPackedCols());
-            } else {
-              fn = BaseType::template getOrCreate<inst_set_t::avx512_vnni_ymm>(
-                  accum, packed_rows_A, nc, packedA_.numPackedCols());
-            }
-            break;
-
-          case inst_set_t::avx512:
-            fn = BaseType::template getOrCreate<inst_set_t::avx512>(
-                accum, packed_rows_A, nc, packedA_.numPackedCols());
-            break;
-
-          case inst_set_t::avx512_ymm:
-            fn = BaseType::template getOrCreate<inst_set_t::avx512_ymm>(
-                accum, packed_rows_A, nc, packedA_.numPackedCols());
-            break;
-
-          case inst_set_t::avx2:
-            fn = BaseType::template getOrCreate<inst_set_t::avx2>(
-                accum, packed_rows_A, nc, packedA_.numPackedCols());
-            break;
-
-          default:
-            // TODO: Have default slower path
-            assert(0 && "unsupported architecture");
-            throw std::runtime_error("unsupported architecure");
-        }
-      }
+  for (int64_t col = n_begin; col < n_end;) {
+    const int jb = col / nbSize_;
+    const int64_t col_end = std::min<int64_t>((jb + 1) * nbSize_, n_end);
+    const int nc = ((col_end - col - 1) / nrMinSize_ + 1) * nrMinSize_;
+    if (nc != fn_nc) {
+      fn = getKernel(nc);
+      fn_nc = nc;
     }
 
-    bBuf = packedB_.getBuf(jb, kBlock);
+    bBuf = packedB_.getBuf(jb, kBlock) +
+        (packedB.addr(0, col) - packedB.addr(0, jb * nbSize_));
     // prefetch addr of the next packed block of B matrix
     bBuf_pf = packedB_.getBuf(jb == bColBlocks - 1 ? jb : jb + 1, kBlock);
 
-    // If the accumulation buffer C_buffer_ is the same as matC_ (inplace output
-    // processing), then each thread use the different parts of output buffer
-    // matC_;
-    // Otherwise, each thread uses different portions of the accumulation
-    // buffer C_buffer_. If m is large enough (m >= m_nthreads * MC), then we
-    // only need to use (m_nthreads * MC) x n portion of C_buffer_, each thread
-    // access the C_buffer_row_start as tid * MC * ldc_; else when m is very
-    // small, we juse use the whole m x n C_buffer_: each thread use the
-    // different portion.
-    int32_t* C_buffer_row_start = C_buffer_ +
-        ((C_buffer_ == reinterpret_cast<int32_t*>(matC_) ||
-          th_info_.m_num_threads * mbSize_ > packedA_.numRows())
-             ? row_start_A * ldc_ + NDim * group
-             : th_info_.m_thread_id * mbSize_ * ldc_ + NDim * group);
-
-    int32_t* C_buffer_start = C_buffer_row_start + jb * nbSize_;
+    int32_t* C_buffer_start = C_buffer_row_start + col;
     int32_t leadingDim = ldc_;
-    static thread_local std::vector<int32_t> C_tile_;
     if (packedB_.isThereColRemainder() && (jb == bColBlocks - 1)) {
       // In case we will access memory past C_buffer_, we use C_tile_ scratchpad
       // instead.
       C_tile_.resize(mbSize_ * nbSize_);
       C_buffer_start = C_tile_.data();
       leadingDim = nbSize_;
+      n_tile = col;
     }
 
     fn(aBuf,
@@ -306,74 +276,59 @@ void ExecuteKernel<
        packedA_.numPackedCols(),
        leadingDim);
 
+    col = col_end;
+  } // for each column segment
+
 #ifdef FBGEMM_MEASURE_TIME_BREAKDOWN
-    t_end = std::chrono::high_resolution_clock::now();
-    dt = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start)
-             .count();
-    kernel_time += (dt);
-    t_start = std::chrono::high_resolution_clock::now();
+  t_end = std::chrono::high_resolution_clock::now();
+  dt = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start)
+           .count();
+  kernel_time += (dt);
+  t_start = std::chrono::high_resolution_clock::now();
 #endif
 
-    // Output processing is done only once per rowblock to amortize overhead
-    // and for better spatial locality.
-    if (lastKBlock && jb == jb_end - 1) {
-      // When C_tile_ is used for the last column block, we need a separate
-      // handling for the last column block.
-      int32_t nSize =
-          (C_buffer_start == C_tile_.data() ? (jb - jb_begin) * nbSize_
-                                            : (jb_end - jb_begin) * nbSize_);
-      if (nSize) {
-        if (fbgemmHasAvx2Support()) {
-          // TODO: avx512 path
-          // Currently use avx2 code
-          outputProcess_.template f<inst_set_t::avx2>(
-              matC_,
-              C_buffer_row_start + jb_begin * nbSize_,
-              {row_start_A,
-               packed_rows_A,
-               static_cast<int>(NDim * group + jb_begin * nbSize_),
-               nSize},
-              ldc_,
-              ldc_);
-        } else {
-          // TODO: Have default slower path
-          assert(0 && "unsupported architecure");
-          throw std::runtime_error("unsupported architecure");
-        }
-      }
-
-      if (C_buffer_start == C_tile_.data()) {
-        // When C_tile_ scratchpad was used to avoid accessing memory past
-        // C_buffer_ .
-        if (fbgemmHasAvx2Support()) {
-          // TODO: avx512 path
-          // Currently use avx2 code
-          outputProcess_.template f<inst_set_t::avx2>(
-              matC_,
-              C_tile_.data(),
-              {row_start_A,
-               packed_rows_A,
-               NDim * group + jb * nbSize_,
-               packedB_.lastBcol()},
-              ldc_,
-              leadingDim);
-        } else {
-          // TODO: Have default slower path
-          assert(0 && "unsupported architecure");
-          throw std::runtime_error("unsupported architecure");
-        }
-      }
-    } // output processing
+  // Output processing is done only once per rowblock to amortize overhead
+  // and for better spatial locality.
+  if (lastKBlock) {
+    if (!fbgemmHasAvx2Support()) {
+      // TODO: Have default slower path
+      assert(0 && "unsupported architecure");
+      throw std::runtime_error("unsupported architecure");
+    }
+    // TODO: avx512 path
+    // Currently use avx2 code
+    if (n_tile > n_begin) {
+      outputProcess_.template f<inst_set_t::avx2>(
+          matC_,
+          C_buffer_row_start + n_begin,
+          {row_start_A,
+           packed_rows_A,
+           static_cast<int>(NDim * group + n_begin),
+           static_cast<int>(n_tile - n_begin)},
+          ldc_,
+          ldc_);
+    }
+    // When C_tile_ scratchpad was used to avoid accessing memory past
+    // C_buffer_, the last columns need a separate handling.
+    if (n_end > n_tile) {
+      outputProcess_.template f<inst_set_t::avx2>(
+          matC_,
+          C_tile_.data(),
+          {row_start_A,
+           packed_rows_A,
+           static_cast<int>(NDim * group + n_tile),
+           static_cast<int>(n_end - n_tile)},
+          ldc_,
+          nbSize_);
+    }
+  } // output processing
 
 #ifdef FBGEMM_MEASURE_TIME_BREAKDOWN
-    t_end = std::chrono::high_resolution_clock::now();
-    dt = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start)
-             .count();
-    postprocessing_time += (dt);
-    t_start = std::chrono::high_resolution_clock::now();
+  t_end = std::chrono::high_resolution_clock::now();
+  dt = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start)
+           .count();
+  postprocessing_time += (dt);
 #endif
-
-  } // for each j block
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -475,6 +430,7 @@ INSTANTIATE_IM2COL_REQUANT_RELU(int16_t);
 
 INSTANTIATE_REQUANT_FLOAT_RELU(PackAWithRowOffset);
 INSTANTIATE_REQUANT_FLOAT_RELU(PackAWithQuantRowOffset);
+INSTANTIATE_REQUANT_FLOAT_RELU(PackAWithRowwiseQuantRowOffset);
 
 #undef INSTANTIATE_REQUANT_FLOAT_RELU
 #undef INSTANTIATE_REQUANT_FLOAT_Q_GRANS
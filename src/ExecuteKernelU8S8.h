@@ -49,6 +49,13 @@ class ExecuteKernel<
       const BlockingFactors* params = nullptr);
   void execute(int kBlock);
 
+  /**
+   * @brief Computes the columns [n_begin, n_end) of C for the k block kBlock
+   * instead of the columns of this thread. n_begin must be a multiple of the
+   * minimum register block size.
+   */
+  void execute(int kBlock, int64_t n_begin, int64_t n_end);
+
  private:
   PackMatrix<packingAMatrix, uint8_t, typename packingAMatrix::accType>&
       packedA_; ///< Packed uint8 block of matrix A.
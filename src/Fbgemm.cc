@@ -12,6 +12,7 @@
 #include <functional>
 #include <stdexcept>
 #include "./ExecuteKernel.h"
+#include "./TunedBlockingFactors.h"
 
 #ifdef FBGEMM_MEASURE_TIME_BREAKDOWN
 double packing_time = 0.0;
@@ -21,47 +22,44 @@ double run_time = 0.0;
 
 namespace fbgemm {
 
-template <
-    typename packingAMatrix,
-    typename packingBMatrix,
-    typename cT,
-    typename processOutputType>
-void fbgemmPacked(
+namespace {
+
+/**
+ * Resolves the blocking factors of a GEMM: without blocking_params, the tuned
+ * ones B was packed with, if any, are returned in tunedParams.
+ * MCB, KCB and MR are set from the result or the packing traits of the ISA,
+ * and A is set to pack blocks of KCB columns.
+ */
+template <typename packingAMatrix, typename packingBMatrix>
+const BlockingFactors* getCacheBlockParams(
     PackMatrix<
         packingAMatrix,
         typename packingAMatrix::inpType,
         typename packingAMatrix::accType>& packA,
-    PackMatrix<
+    const PackMatrix<
         packingBMatrix,
         typename packingBMatrix::inpType,
         typename packingBMatrix::accType>& packB,
-    cT* C,
-    int32_t* C_buffer,
-    uint32_t ldc,
-    const processOutputType& outProcess,
-    int thread_id,
-    int num_threads,
-    const BlockingFactors* blocking_params) {
-  static_assert(
-      std::is_same<
-          typename packingAMatrix::accType,
-          typename packingBMatrix::accType>::value,
-      "Accumulation type of both matrices should be the same");
-
-  // Run time CPU detection
-  if (!cpuinfo_initialize()) {
-    throw std::runtime_error("Failed to initialize cpuinfo!");
-  }
-  if ((!fbgemmHasAvx512VnniSupport() && !fbgemmHasAvx512Support() &&
-       !fbgemmHasAvx2Support())) {
-    assert(0 && "unknown architecure");
-    throw std::runtime_error("unknown architecure");
+    const BlockingFactors* blocking_params,
+    BlockingFactors& tunedParams,
+    int64_t& MCB,
+    int& KCB,
+    int& MR) {
+  // Without blocking factors, run with the tuned ones B was packed with, if
+  // any
+  if (!blocking_params && packA.numGroups() > 0) {
+    blocking_params = fbgemmSelectTunedBlockingFactors<
+        typename packingAMatrix::accType>(
+        packA.numRows(),
+        packB.numCols(),
+        packB.numRows() / packA.numGroups(),
+        packA.blockRowSize(),
+        packB.blockRowSize(),
+        packB.blockColSize(),
+        packB.tunedBlockingFactors(),
+        &tunedParams);
   }
 
-  int64_t MCB;
-  int KCB;
-  int MR;
-
   if (blocking_params) {
     MCB = blocking_params->MCB;
     KCB = blocking_params->KCB;
@@ -110,6 +108,67 @@ void fbgemmPacked(
     }
   }
 
+  // A is packed block by block while running, so it can follow B, e.g. when
+  // B was packed with tuned factors and A with the defaults
+  if (packA.blockColSize() != KCB) {
+    if (KCB > packA.blockColCapacity()) {
+      throw std::runtime_error(
+          "KCB = " + std::to_string(KCB) + " of the GEMM exceeds the KCB = " +
+          std::to_string(packA.blockColCapacity()) +
+          " A's packing buffer was sized for");
+    }
+    packA.setBlockColSize(KCB);
+  }
+
+  return blocking_params;
+}
+
+} // namespace
+
+template <
+    typename packingAMatrix,
+    typename packingBMatrix,
+    typename cT,
+    typename processOutputType>
+void fbgemmPacked(
+    PackMatrix<
+        packingAMatrix,
+        typename packingAMatrix::inpType,
+        typename packingAMatrix::accType>& packA,
+    PackMatrix<
+        packingBMatrix,
+        typename packingBMatrix::inpType,
+        typename packingBMatrix::accType>& packB,
+    cT* C,
+    int32_t* C_buffer,
+    uint32_t ldc,
+    const processOutputType& outProcess,
+    int thread_id,
+    int num_threads,
+    const BlockingFactors* blocking_params) {
+  static_assert(
+      std::is_same<
+          typename packingAMatrix::accType,
+          typename packingBMatrix::accType>::value,
+      "Accumulation type of both matrices should be the same");
+
+  // Run time CPU detection
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+  if ((!fbgemmHasAvx512VnniSupport() && !fbgemmHasAvx512Support() &&
+       !fbgemmHasAvx2Support())) {
+    assert(0 && "unknown architecure");
+    throw std::runtime_error("unknown architecure");
+  }
+
+  BlockingFactors tunedParams;
+  int64_t MCB;
+  int KCB;
+  int MR;
+  blocking_params = getCacheBlockParams(
+      packA, packB, blocking_params, tunedParams, MCB, KCB, MR);
+
   if (!packB.isPrePacked()) {
     throw std::runtime_error("B matrix must be prepacked");
   }
@@ -141,8 +200,14 @@ void fbgemmPacked(
   t_very_start = std::chrono::high_resolution_clock::now();
 #endif
 
-  thread_type_t th_info =
-      fbgemmGetThreadPartition(G, MDim, NDim, thread_id, num_threads);
+  // Splitting a skinny GEMM along m would make every m thread stream all of
+  // B, so its threads only split g and n (see ExecuteKernel for the latter).
+  thread_type_t th_info = fbgemmGetThreadPartition(
+      G,
+      fbgemmIsSkinnyGemm(MDim) ? 1 : MDim,
+      NDim,
+      thread_id,
+      num_threads);
   // if (thread_id == 0)
   //   std::cout << ", " << th_info.toString();
 
@@ -207,6 +272,135 @@ void fbgemmPacked(
 #endif
 }
 
+template <
+    typename packingAMatrix,
+    typename packingBMatrix,
+    typename cT,
+    typename processOutputType>
+void fbgemmGroupedPacked(
+    const GroupedGemmArgs<
+        packingAMatrix,
+        packingBMatrix,
+        cT,
+        processOutputType>* gemms,
+    int num_gemms,
+    int thread_id,
+    int num_threads,
+    const BlockingFactors* blocking_params) {
+  static_assert(
+      std::is_same<
+          typename packingAMatrix::accType,
+          typename packingBMatrix::accType>::value,
+      "Accumulation type of both matrices should be the same");
+
+  // Run time CPU detection
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+  if ((!fbgemmHasAvx512VnniSupport() && !fbgemmHasAvx512Support() &&
+       !fbgemmHasAvx2Support())) {
+    assert(0 && "unknown architecure");
+    throw std::runtime_error("unknown architecure");
+  }
+
+  // The cost of a tile is its number of multiply-adds. Thread t owns the
+  // tiles whose midpoint in the cost of all tiles, in the order of the loops
+  // below, falls in [t, t + 1) * total_cost / num_threads.
+  int64_t total_cost = 0;
+  for (int e = 0; e < num_gemms; ++e) {
+    total_cost += static_cast<int64_t>(gemms[e].packA->numRows()) *
+        gemms[e].packB->numCols() * gemms[e].packB->numRows();
+  }
+  if (total_cost == 0) {
+    return;
+  }
+  auto owner = [&](int64_t cost_begin, int64_t cost) {
+    return static_cast<int>(
+        (2 * cost_begin + cost) * num_threads / (2 * total_cost));
+  };
+
+  // Each thread uses its own MCB rows of a C_buffer that is not C, like the
+  // m threads of fbgemmPacked do.
+  const thread_type_t th_info{1, num_threads, 1, 0, thread_id, 0};
+
+  int64_t cost_begin = 0;
+  for (int e = 0; e < num_gemms; ++e) {
+    auto& packA = *gemms[e].packA;
+    auto& packB = *gemms[e].packB;
+    const int MDim = packA.numRows();
+    const int NDim = packB.numCols();
+    const int64_t gemm_cost_begin = cost_begin;
+    cost_begin += static_cast<int64_t>(MDim) * NDim * packB.numRows();
+    if (gemm_cost_begin * num_threads / total_cost > thread_id ||
+        cost_begin * num_threads / total_cost < thread_id) {
+      continue;
+    }
+
+    BlockingFactors tunedParams;
+    int64_t MCB;
+    int KCB;
+    int MR;
+    const BlockingFactors* params = getCacheBlockParams(
+        packA, packB, blocking_params, tunedParams, MCB, KCB, MR);
+
+    if (!packB.isPrePacked()) {
+      throw std::runtime_error("B matrix must be prepacked");
+    }
+    int G = packA.numGroups();
+    if (G != packB.numGroups()) {
+      throw std::runtime_error(
+          "A.groups = " + std::to_string(G) + " and B.groups = " +
+          std::to_string(packB.numGroups()) + " are not the same");
+    }
+
+    int KDimPerGroup = packB.numRows() / G;
+    int kBlocks = (KDimPerGroup + KCB - 1) / KCB;
+    int _kc = KDimPerGroup % KCB;
+    const int NCB = packB.blockColSize();
+
+    ExecuteKernel<packingAMatrix, packingBMatrix, cT, processOutputType>
+        exeKernelObj(
+            packA,
+            packB,
+            gemms[e].C,
+            gemms[e].C_buffer,
+            gemms[e].ldc,
+            *gemms[e].outProcess,
+            th_info,
+            params);
+
+    int64_t tile_cost_begin = gemm_cost_begin;
+    for (int g = 0; g < G; ++g) {
+      for (int i = 0; i < MDim; i += MCB) {
+        const int mc = std::min<int64_t>(MDim - i, MCB);
+        // Column blocks [jb_begin, jb_end) of this row block owned by thread_id
+        int jb_begin = -1, jb_end = -1;
+        for (int jb = 0; jb < packB.blockCols(); ++jb) {
+          const int64_t cost = static_cast<int64_t>(mc) *
+              std::min(NCB, NDim - jb * NCB) * KDimPerGroup;
+          if (owner(tile_cost_begin, cost) == thread_id) {
+            jb_begin = jb_begin < 0 ? jb : jb_begin;
+            jb_end = jb + 1;
+          }
+          tile_cost_begin += cost;
+        }
+        if (jb_begin < 0) {
+          continue;
+        }
+
+        for (int kb = 0; kb < kBlocks; ++kb) {
+          const int kc = (kb != kBlocks - 1 || _kc == 0) ? KCB : _kc;
+          packA.pack({i, mc, g * KDimPerGroup + kb * KCB, kc});
+          exeKernelObj.execute(
+              g * kBlocks + kb,
+              static_cast<int64_t>(jb_begin) * NCB,
+              std::min<int64_t>(static_cast<int64_t>(jb_end) * NCB, NDim));
+        }
+      }
+    }
+  } // for each GEMM
+}
+
 template <int SPATIAL_DIM>
 bool fbgemmOptimizedGConv(const conv_param_t<SPATIAL_DIM>& conv_p) {
   if (SPATIAL_DIM == 1)
@@ -437,6 +631,7 @@ INSTANTIATE_RELU(int16_t)
 
 INSTANTIATE_RELU(PackAWithRowOffset)
 INSTANTIATE_RELU(PackAWithQuantRowOffset);
+INSTANTIATE_RELU(PackAWithRowwiseQuantRowOffset);
 
 #undef INSTANTIATE_RELU
 #undef INSTANTIATE_Q_GRANS
@@ -635,4 +830,66 @@ template FBGEMM_API void fbgemmPacked(
     int num_threads,
     const BlockingFactors* blocking_params);
 
+////////////////////////////////////////////////////////////////////////////////
+// fbgemmGroupedPacked
+// The output processing type, which may contain commas, comes last
+#define INSTANTIATE_GROUPED(PACK_A, ACC_T, C_T, ...) \
+  template FBGEMM_API void fbgemmGroupedPacked(      \
+      const GroupedGemmArgs<                         \
+          PACK_A<uint8_t, ACC_T>,                    \
+          PackBMatrix<int8_t, ACC_T>,                \
+          C_T,                                       \
+          __VA_ARGS__>* gemms,                       \
+      int num_gemms,                                 \
+      int thread_id,                                 \
+      int num_threads,                               \
+      const BlockingFactors* blocking_params);
+
+#define INSTANTIATE_BASE(PACK_A, ACC_T, RELU, Q_GRAN, BIAS_TYPE) \
+  INSTANTIATE_GROUPED(                                           \
+      PACK_A, ACC_T, uint8_t, ReQuantizeOutput<RELU, Q_GRAN, BIAS_TYPE>)
+
+#define INSTANTIATE_BIAS_T(PACK_A, ACC_T, RELU, Q_GRAN) \
+  INSTANTIATE_BASE(PACK_A, ACC_T, RELU, Q_GRAN, float)  \
+  INSTANTIATE_BASE(PACK_A, ACC_T, RELU, Q_GRAN, int32_t)
+
+#define INSTANTIATE_Q_GRANS(PACK_A, ACC_T, RELU)                           \
+  INSTANTIATE_BIAS_T(PACK_A, ACC_T, RELU, QuantizationGranularity::TENSOR) \
+  INSTANTIATE_BIAS_T(PACK_A, ACC_T, RELU, QuantizationGranularity::GROUP)  \
+  INSTANTIATE_BIAS_T(PACK_A, ACC_T, RELU, QuantizationGranularity::OUT_CHANNEL)
+
+#define INSTANTIATE_RELU(PACK_A, ACC_T)     \
+  INSTANTIATE_Q_GRANS(PACK_A, ACC_T, false) \
+  INSTANTIATE_Q_GRANS(PACK_A, ACC_T, true)
+
+#define INSTANTIATE_ACC_T(PACK_A)                          \
+  INSTANTIATE_RELU(PACK_A, int32_t)                        \
+  INSTANTIATE_RELU(PACK_A, int16_t)                        \
+  INSTANTIATE_GROUPED(PACK_A, int32_t, int32_t, memCopy<>) \
+  INSTANTIATE_GROUPED(PACK_A, int16_t, int32_t, memCopy<>)
+
+INSTANTIATE_ACC_T(PackAMatrix)
+INSTANTIATE_ACC_T(PackAWithRowOffset)
+
+#define INSTANTIATE_FLOAT_BASE(RELU, Q_GRAN) \
+  INSTANTIATE_GROUPED(                       \
+      PackAWithRowOffset, int32_t, float, ReQuantizeForFloat<RELU, Q_GRAN>)
+
+#define INSTANTIATE_FLOAT_Q_GRANS(RELU)                          \
+  INSTANTIATE_FLOAT_BASE(RELU, QuantizationGranularity::TENSOR) \
+  INSTANTIATE_FLOAT_BASE(RELU, QuantizationGranularity::GROUP)  \
+  INSTANTIATE_FLOAT_BASE(RELU, QuantizationGranularity::OUT_CHANNEL)
+
+INSTANTIATE_FLOAT_Q_GRANS(false)
+INSTANTIATE_FLOAT_Q_GRANS(true)
+
+#undef INSTANTIATE_FLOAT_Q_GRANS
+#undef INSTANTIATE_FLOAT_BASE
+#undef INSTANTIATE_ACC_T
+#undef INSTANTIATE_RELU
+#undef INSTANTIATE_Q_GRANS
+#undef INSTANTIATE_BIAS_T
+#undef INSTANTIATE_BASE
+#undef INSTANTIATE_GROUPED
+
 } // namespace fbgemm
@@ -0,0 +1,797 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmAutotune.h"
+
+#include <cpuinfo.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_num_threads() 1
+#define omp_get_thread_num() 0
+#endif
+
+#include "./RefImplementations.h"
+#include "./TunedBlockingFactors.h"
+#include "fbgemm/Fbgemm.h"
+
+namespace fbgemm {
+
+namespace {
+
+constexpr char kFileHeader[] = "# FBGEMM blocking factors v1";
+
+template <typename accT>
+constexpr int accBits() {
+  return 8 * sizeof(accT);
+}
+
+template <typename accT, inst_set_t ISA>
+BlockingFactors traitsBlockingFactors() {
+  using Traits = PackingTraits<std::uint8_t, accT, ISA>;
+  BlockingFactors params;
+  params.MR = Traits::MR;
+  params.NR = Traits::NR;
+  params.NR_MIN = Traits::NR_MIN;
+  params.ROW_INTERLEAVE = Traits::ROW_INTERLEAVE;
+  params.MCB = Traits::MCB;
+  params.KCB = Traits::KCB;
+  params.NCB = Traits::NCB;
+  return params;
+}
+
+template <typename accT>
+BlockingFactors defaultBlockingFactors(inst_set_t isa) {
+  switch (isa) {
+    case inst_set_t::avx512_vnni:
+      return traitsBlockingFactors<accT, inst_set_t::avx512_vnni>();
+    case inst_set_t::avx512_vnni_ymm:
+      return traitsBlockingFactors<accT, inst_set_t::avx512_vnni_ymm>();
+    case inst_set_t::avx512:
+      return traitsBlockingFactors<accT, inst_set_t::avx512>();
+    case inst_set_t::avx512_ymm:
+      return traitsBlockingFactors<accT, inst_set_t::avx512_ymm>();
+    case inst_set_t::avx2:
+      return traitsBlockingFactors<accT, inst_set_t::avx2>();
+    default:
+      throw std::runtime_error("unknown architecure");
+  }
+}
+
+// 16-bit accumulation on VNNI runs 32-bit accumulation kernels generated
+// with the default blocking factors, whatever B was packed with.
+template <typename accT>
+bool isTunable(inst_set_t isa) {
+  if (isa == inst_set_t::anyarch) {
+    return false;
+  }
+  return std::is_same<accT, std::int32_t>::value ||
+      (isa != inst_set_t::avx512_vnni && isa != inst_set_t::avx512_vnni_ymm);
+}
+
+// Whether params can be used in place of the defaults on this machine. See
+// fbgemm/FbgemmAutotune.h for why MCB and KCB are bounded.
+template <typename accT>
+bool isValidTunedFactors(inst_set_t isa, const BlockingFactors& params) {
+  if (!isTunable<accT>(isa)) {
+    return false;
+  }
+  const BlockingFactors def = defaultBlockingFactors<accT>(isa);
+  if (params.MR <= 0 || params.NR <= 0 || params.MCB <= 0 ||
+      params.KCB <= 0 || params.NCB <= 0) {
+    return false;
+  }
+  if (params.NR_MIN != def.NR_MIN ||
+      params.ROW_INTERLEAVE != def.ROW_INTERLEAVE) {
+    return false;
+  }
+  if (params.MCB > def.MCB || params.KCB > def.KCB ||
+      params.KCB % params.ROW_INTERLEAVE != 0) {
+    return false;
+  }
+  return isValidBlockingFactor<accT>(&params);
+}
+
+bool sameFactors(const BlockingFactors& a, const BlockingFactors& b) {
+  return a.MR == b.MR && a.NR == b.NR && a.NR_MIN == b.NR_MIN &&
+      a.ROW_INTERLEAVE == b.ROW_INTERLEAVE && a.MCB == b.MCB &&
+      a.KCB == b.KCB && a.NCB == b.NCB;
+}
+
+const char* isaName(inst_set_t isa) {
+  switch (isa) {
+    case inst_set_t::avx2:
+      return "avx2";
+    case inst_set_t::avx512:
+      return "avx512";
+    case inst_set_t::avx512_ymm:
+      return "avx512_ymm";
+    case inst_set_t::avx512_vnni:
+      return "avx512_vnni";
+    case inst_set_t::avx512_vnni_ymm:
+      return "avx512_vnni_ymm";
+    default:
+      return "anyarch";
+  }
+}
+
+bool parseIsa(const std::string& name, inst_set_t* isa) {
+  for (inst_set_t candidate :
+       {inst_set_t::avx2,
+        inst_set_t::avx512,
+        inst_set_t::avx512_ymm,
+        inst_set_t::avx512_vnni,
+        inst_set_t::avx512_vnni_ymm}) {
+    if (name == isaName(candidate)) {
+      *isa = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Process wide tuning table. Keys are ordered so that the entries sharing a
+ * K, or an (N, K), of an instruction set and accumulation type are adjacent.
+ *
+ * GEMMs look the table up on every call, so it is published as an immutable
+ * snapshot that is read without locking. Updates, which only come from
+ * tuning and loading, copy the snapshot under a mutex and swap it in.
+ */
+class TunedBlockingFactorsTable {
+ public:
+  // (isa, accumulation bits, K, N, M)
+  using Key = std::tuple<int, int, int, int, int>;
+  using Entries = std::map<Key, BlockingFactors>;
+
+  static TunedBlockingFactorsTable& instance() {
+    static TunedBlockingFactorsTable table;
+    return table;
+  }
+
+  ~TunedBlockingFactorsTable() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!envPath_.empty() && dirty_) {
+      saveLocked(envPath_);
+    }
+  }
+
+  /**
+   * @brief Cheap, called by every packing without BlockingFactors.
+   */
+  bool empty() const {
+    return size_.load(std::memory_order_acquire) == 0;
+  }
+
+  std::size_t size() const {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  bool add(const Key& key, const BlockingFactors& params) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entries = snapshot();
+    if (conflicts(*entries, key, params)) {
+      return false;
+    }
+    auto updated = std::make_shared<Entries>(*entries);
+    (*updated)[key] = params;
+    publishLocked(std::move(updated));
+    dirty_ = true;
+    return true;
+  }
+
+  bool get(const Key& key, BlockingFactors* params) const {
+    auto entries = snapshot();
+    auto it = entries->find(key);
+    if (it == entries->end()) {
+      return false;
+    }
+    *params = it->second;
+    return true;
+  }
+
+  /**
+   * @brief KCB and NCB other entries impose on key, 0 if unconstrained.
+   */
+  void fixedBlocks(const Key& key, int* kcb, int* ncb) const {
+    fixedBlocks(*snapshot(), key, kcb, ncb);
+  }
+
+  /**
+   * @brief The KCB of the entries with K.
+   */
+  bool findKcb(int isa, int acc, int K, int* kcb) const {
+    auto entries = snapshot();
+    auto it = entries->lower_bound(Key(isa, acc, K, 0, 0));
+    if (it == entries->end() || std::get<0>(it->first) != isa ||
+        std::get<1>(it->first) != acc || std::get<2>(it->first) != K) {
+      return false;
+    }
+    *kcb = it->second.KCB;
+    return true;
+  }
+
+  /**
+   * @brief The entry of (N, K) with the largest M.
+   */
+  bool findLargestM(int isa, int acc, int N, int K, BlockingFactors* params)
+      const {
+    auto entries = snapshot();
+    auto it = entries->upper_bound(
+        Key(isa, acc, K, N, std::numeric_limits<int>::max()));
+    if (it == entries->begin()) {
+      return false;
+    }
+    --it;
+    if (std::get<0>(it->first) != isa || std::get<1>(it->first) != acc ||
+        std::get<2>(it->first) != K || std::get<3>(it->first) != N) {
+      return false;
+    }
+    *params = it->second;
+    return true;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dirty_ = dirty_ || !snapshot()->empty();
+    publishLocked(std::make_shared<const Entries>());
+  }
+
+  std::int64_t load(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return loadLocked(path);
+  }
+
+  bool save(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return saveLocked(path);
+  }
+
+ private:
+  TunedBlockingFactorsTable() {
+    const char* env = std::getenv("FBGEMM_BLOCKING_FACTORS_DB");
+    if (env != nullptr && env[0] != '\0') {
+      envPath_ = env;
+      std::lock_guard<std::mutex> lock(mutex_);
+      loadLocked(envPath_);
+    }
+  }
+
+  std::shared_ptr<const Entries> snapshot() const {
+    return entries_.load(std::memory_order_acquire);
+  }
+
+  // Must be called with mutex_ held.
+  void publishLocked(std::shared_ptr<const Entries> entries) {
+    const std::size_t size = entries->size();
+    entries_.store(std::move(entries), std::memory_order_release);
+    size_.store(size, std::memory_order_release);
+  }
+
+  static void
+  fixedBlocks(const Entries& entries, const Key& key, int* kcb, int* ncb) {
+    *kcb = 0;
+    *ncb = 0;
+    const auto [isa, acc, K, N, M] = key;
+    (void)M;
+    for (auto it = entries.lower_bound(Key(isa, acc, K, 0, 0));
+         it != entries.end() && std::get<0>(it->first) == isa &&
+         std::get<1>(it->first) == acc && std::get<2>(it->first) == K;
+         ++it) {
+      if (it->first == key) {
+        continue;
+      }
+      *kcb = it->second.KCB;
+      if (std::get<3>(it->first) == N) {
+        *ncb = it->second.NCB;
+      }
+    }
+  }
+
+  static bool conflicts(
+      const Entries& entries,
+      const Key& key,
+      const BlockingFactors& params) {
+    int kcb, ncb;
+    fixedBlocks(entries, key, &kcb, &ncb);
+    return (kcb != 0 && kcb != params.KCB) || (ncb != 0 && ncb != params.NCB);
+  }
+
+  // Must be called with mutex_ held.
+  std::int64_t loadLocked(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+      return -1;
+    }
+    std::string line;
+    if (!std::getline(in, line) || line != kFileHeader) {
+      return -1;
+    }
+
+    const inst_set_t currentIsa = fbgemmInstructionSet();
+    std::vector<std::pair<Key, BlockingFactors>> parsed;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::istringstream iss(line);
+      std::string isaStr;
+      int acc, M, N, K;
+      BlockingFactors params;
+      inst_set_t isa;
+      if (!(iss >> isaStr >> acc >> M >> N >> K >> params.MCB >> params.NCB >>
+            params.KCB >> params.MR >> params.NR >> params.NR_MIN >>
+            params.ROW_INTERLEAVE) ||
+          !parseIsa(isaStr, &isa) || (acc != 16 && acc != 32) || M <= 0 ||
+          N <= 0 || K <= 0) {
+        return -1;
+      }
+      // Entries of other instruction sets are only carried along.
+      if (isa == currentIsa &&
+          !(acc == 32 ? isValidTunedFactors<std::int32_t>(isa, params)
+                      : isValidTunedFactors<std::int16_t>(isa, params))) {
+        continue;
+      }
+      parsed.emplace_back(Key(static_cast<int>(isa), acc, K, N, M), params);
+    }
+
+    auto entries = std::make_shared<Entries>(*snapshot());
+    std::int64_t loaded = 0;
+    for (const auto& entry : parsed) {
+      if (!entries->count(entry.first) &&
+          !conflicts(*entries, entry.first, entry.second)) {
+        entries->emplace(entry.first, entry.second);
+        ++loaded;
+      }
+    }
+    publishLocked(std::move(entries));
+    return loaded;
+  }
+
+  // Must be called with mutex_ held.
+  bool saveLocked(const std::string& path) {
+#ifdef _WIN32
+    const std::string tmpPath = path + ".tmp" + std::to_string(_getpid());
+#else
+    const std::string tmpPath = path + ".tmp" + std::to_string(getpid());
+#endif
+    {
+      std::ofstream os(tmpPath, std::ios::trunc);
+      if (!os) {
+        return false;
+      }
+      os << kFileHeader << '\n'
+         << "# isa acc M N K MCB NCB KCB MR NR NR_MIN ROW_INTERLEAVE\n";
+      for (const auto& entry : *snapshot()) {
+        auto [isa, acc, K, N, M] = entry.first;
+        const BlockingFactors& p = entry.second;
+        os << isaName(static_cast<inst_set_t>(isa)) << ' ' << acc << ' ' << M
+           << ' ' << N << ' ' << K << ' ' << p.MCB << ' ' << p.NCB << ' '
+           << p.KCB << ' ' << p.MR << ' ' << p.NR << ' ' << p.NR_MIN << ' '
+           << p.ROW_INTERLEAVE << '\n';
+      }
+      if (!os) {
+        std::remove(tmpPath.c_str());
+        return false;
+      }
+    }
+#ifdef _WIN32
+    // rename does not replace an existing file on Windows.
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+    dirty_ = false;
+    return true;
+  }
+
+  std::mutex mutex_; ///< serializes updates
+  // The following are guarded by mutex_.
+  bool dirty_{false}; ///< entries changed since the last load/save
+  std::string envPath_; ///< FBGEMM_BLOCKING_FACTORS_DB, saved at exit
+
+  std::atomic<std::shared_ptr<const Entries>> entries_{
+      std::make_shared<const Entries>()};
+  std::atomic<std::size_t> size_{0}; ///< size of entries_
+};
+
+template <typename accT>
+TunedBlockingFactorsTable::Key
+tableKey(inst_set_t isa, int M, int N, int K) {
+  return TunedBlockingFactorsTable::Key(
+      static_cast<int>(isa), accBits<accT>(), K, N, M);
+}
+
+/**
+ * Runs fbgemmPacked on fixed random data of one shape. Values are small
+ * enough that 16-bit accumulation never saturates, so every candidate must
+ * match the reference exactly.
+ */
+template <typename accT>
+class TuningRun {
+ public:
+  TuningRun(int M, int N, int K, const AutotuneOptions& options)
+      : M_(M),
+        N_(N),
+        K_(K),
+        options_(options),
+        A_(static_cast<std::size_t>(M) * K),
+        B_(static_cast<std::size_t>(K) * N),
+        Cref_(static_cast<std::size_t>(M) * N),
+        C_(Cref_.size()) {
+    std::mt19937 gen(5489u);
+    std::uniform_int_distribution<int> aDist(0, 3);
+    std::uniform_int_distribution<int> bDist(-2, 2);
+    for (auto& a : A_) {
+      a = aDist(gen);
+    }
+    for (auto& b : B_) {
+      b = bDist(gen);
+    }
+    matmul_u8i8acc32_ref(
+        M, N, K, K, N, N, A_.data(), B_.data(), Cref_.data());
+  }
+
+  /**
+   * @return seconds taken by the fastest run with params, infinity if the
+   * result is wrong.
+   */
+  double time(const BlockingFactors& params) {
+    PackBMatrix<std::int8_t, accT> packedB(
+        matrix_op_t::NoTranspose,
+        K_,
+        N_,
+        B_.data(),
+        N_,
+        nullptr,
+        1,
+        &params);
+
+    double best = std::numeric_limits<double>::infinity();
+    const int warmup = std::max(options_.warmupIterations, 0);
+    const int numRuns = warmup + std::max(options_.iterations, 1);
+    for (int run = 0; run < numRuns; ++run) {
+      std::fill(C_.begin(), C_.end(), 0);
+      const auto start = std::chrono::high_resolution_clock::now();
+#ifdef _OPENMP
+#pragma omp parallel num_threads(std::max(options_.numThreads, 1))
+#endif
+      {
+        PackAMatrix<std::uint8_t, accT> packA(
+            matrix_op_t::NoTranspose,
+            M_,
+            K_,
+            A_.data(),
+            K_,
+            nullptr,
+            1,
+            &params);
+        DoNothing<std::int32_t, std::int32_t> doNothingObj{};
+        memCopy<> outputProcObj(doNothingObj);
+        fbgemmPacked(
+            packA,
+            packedB,
+            C_.data(),
+            C_.data(),
+            N_,
+            outputProcObj,
+            omp_get_thread_num(),
+            omp_get_num_threads(),
+            &params);
+      }
+      const auto end = std::chrono::high_resolution_clock::now();
+      if (run >= warmup) {
+        best = std::min(
+            best, std::chrono::duration<double>(end - start).count());
+      }
+    }
+    return C_ == Cref_ ? best : std::numeric_limits<double>::infinity();
+  }
+
+ private:
+  int M_, N_, K_;
+  AutotuneOptions options_;
+  std::vector<std::uint8_t> A_;
+  std::vector<std::int8_t> B_;
+  std::vector<std::int32_t> Cref_;
+  std::vector<std::int32_t> C_;
+};
+
+int roundUp(int a, int b) {
+  return (a + b - 1) / b * b;
+}
+
+} // namespace
+
+template <typename accT>
+BlockingFactors fbgemmAutotuneBlockingFactors(
+    int M,
+    int N,
+    int K,
+    const AutotuneOptions& options) {
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+  if (M <= 0 || N <= 0 || K <= 0) {
+    throw std::runtime_error(
+        "invalid GEMM shape M = " + std::to_string(M) +
+        ", N = " + std::to_string(N) + ", K = " + std::to_string(K));
+  }
+  const inst_set_t isa = fbgemmInstructionSet();
+  const BlockingFactors def = defaultBlockingFactors<accT>(isa);
+  if (!isTunable<accT>(isa)) {
+    return def;
+  }
+
+  auto& table = TunedBlockingFactorsTable::instance();
+  const auto key = tableKey<accT>(isa, M, N, K);
+  int fixedKcb = 0;
+  int fixedNcb = 0;
+  table.fixedBlocks(key, &fixedKcb, &fixedNcb);
+
+  // Start from the defaults, within the limits set by the table
+  BlockingFactors best = def;
+  if (fixedKcb) {
+    best.KCB = fixedKcb;
+  }
+  if (fixedNcb) {
+    best.NCB = fixedNcb;
+    if (fixedNcb % best.NR) {
+      best.NR = best.NR_MIN;
+    }
+  }
+
+  TuningRun<accT> tuningRun(M, N, K, options);
+  double bestTime = tuningRun.time(best);
+  if (bestTime == std::numeric_limits<double>::infinity()) {
+    return best;
+  }
+  int timed = 1;
+  auto tryCandidate = [&](const BlockingFactors& candidate) {
+    if (timed >= options.maxCandidates ||
+        !isValidTunedFactors<accT>(isa, candidate) ||
+        sameFactors(candidate, best)) {
+      return;
+    }
+    const double t = tuningRun.time(candidate);
+    ++timed;
+    if (t < bestTime) {
+      best = candidate;
+      bestTime = t;
+    }
+  };
+
+  // Register blocking: the valid (MR, NR) using the most accumulator
+  // registers are the usual winners.
+  std::vector<std::pair<int, int>> registerBlocks;
+  for (int nr = best.NR_MIN; nr <= 4 * best.NR_MIN; nr += best.NR_MIN) {
+    for (int mr = 1; mr <= 28; ++mr) {
+      BlockingFactors candidate = best;
+      candidate.MR = mr;
+      candidate.NR = nr;
+      candidate.MCB = std::max(mr, def.MCB / mr * mr);
+      candidate.NCB = fixedNcb ? fixedNcb : roundUp(best.NCB, nr);
+      if (isValidTunedFactors<accT>(isa, candidate)) {
+        registerBlocks.emplace_back(mr, nr);
+      }
+    }
+  }
+  std::stable_sort(
+      registerBlocks.begin(),
+      registerBlocks.end(),
+      [&](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first * a.second > b.first * b.second;
+      });
+  registerBlocks.resize(std::min<std::size_t>(registerBlocks.size(), 8));
+  const BlockingFactors start = best;
+  for (const auto& block : registerBlocks) {
+    BlockingFactors candidate = start;
+    candidate.MR = block.first;
+    candidate.NR = block.second;
+    candidate.MCB = std::max(block.first, def.MCB / block.first * block.first);
+    candidate.NCB = fixedNcb ? fixedNcb : roundUp(start.NCB, block.second);
+    tryCandidate(candidate);
+  }
+
+  // NCB, up to one block covering N
+  if (!fixedNcb) {
+    const BlockingFactors base = best;
+    const int maxNcb = roundUp(N, base.NR);
+    for (int f = 1; f <= 16; f *= 2) {
+      BlockingFactors candidate = base;
+      candidate.NCB = std::min(f * base.NR, maxNcb);
+      tryCandidate(candidate);
+      if (candidate.NCB == maxNcb) {
+        break;
+      }
+    }
+  }
+
+  // KCB, up to one block covering K
+  if (!fixedKcb) {
+    const BlockingFactors base = best;
+    const int maxKcb = roundUp(K, base.ROW_INTERLEAVE);
+    for (int kcb = 64; kcb <= def.KCB; kcb += 64) {
+      BlockingFactors candidate = base;
+      candidate.KCB = std::min(kcb, maxKcb);
+      tryCandidate(candidate);
+      if (candidate.KCB == maxKcb) {
+        break;
+      }
+    }
+  }
+
+  // MCB, up to one block covering M
+  {
+    const BlockingFactors base = best;
+    const int maxMcb =
+        std::min(roundUp(M, base.MR), def.MCB / base.MR * base.MR);
+    for (int f = 1; f * base.MR <= def.MCB; f *= 2) {
+      BlockingFactors candidate = base;
+      candidate.MCB = std::min(f * base.MR, maxMcb);
+      tryCandidate(candidate);
+      if (candidate.MCB == maxMcb) {
+        break;
+      }
+    }
+  }
+
+  if (options.addToTable) {
+    table.add(key, best);
+  }
+  return best;
+}
+
+template <typename accT>
+bool fbgemmAddTunedBlockingFactors(
+    int M,
+    int N,
+    int K,
+    const BlockingFactors& params) {
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+  const inst_set_t isa = fbgemmInstructionSet();
+  if (M <= 0 || N <= 0 || K <= 0 || !isValidTunedFactors<accT>(isa, params)) {
+    return false;
+  }
+  return TunedBlockingFactorsTable::instance().add(
+      tableKey<accT>(isa, M, N, K), params);
+}
+
+template <typename accT>
+bool fbgemmGetTunedBlockingFactors(
+    int M,
+    int N,
+    int K,
+    BlockingFactors* params) {
+  auto& table = TunedBlockingFactorsTable::instance();
+  if (table.empty()) {
+    return false;
+  }
+  const inst_set_t isa = fbgemmInstructionSet();
+  return isTunable<accT>(isa) &&
+      table.get(tableKey<accT>(isa, M, N, K), params);
+}
+
+std::int64_t fbgemmLoadTunedBlockingFactors(const std::string& path) {
+  return TunedBlockingFactorsTable::instance().load(path);
+}
+
+bool fbgemmSaveTunedBlockingFactors(const std::string& path) {
+  return TunedBlockingFactorsTable::instance().save(path);
+}
+
+void fbgemmClearTunedBlockingFactors() {
+  TunedBlockingFactorsTable::instance().clear();
+}
+
+std::size_t fbgemmNumTunedBlockingFactors() {
+  return TunedBlockingFactorsTable::instance().size();
+}
+
+template <typename accT>
+bool fbgemmGetTunedPackBParams(int N, int K, BlockingFactors* params) {
+  auto& table = TunedBlockingFactorsTable::instance();
+  if (table.empty()) {
+    return false;
+  }
+  const inst_set_t isa = fbgemmInstructionSet();
+  if (!isTunable<accT>(isa)) {
+    return false;
+  }
+  if (table.findLargestM(
+          static_cast<int>(isa), accBits<accT>(), N, K, params)) {
+    return true;
+  }
+  // Without an entry for (N, K), the KCB tuned for K with another N is still
+  // a better guess than the default
+  int kcb;
+  if (!table.findKcb(static_cast<int>(isa), accBits<accT>(), K, &kcb)) {
+    return false;
+  }
+  *params = defaultBlockingFactors<accT>(isa);
+  params->KCB = kcb;
+  return true;
+}
+
+template <typename accT>
+const BlockingFactors* fbgemmSelectTunedBlockingFactors(
+    int M,
+    int N,
+    int K,
+    int aBlockRows,
+    int bBlockRows,
+    int bBlockCols,
+    const BlockingFactors* bTuned,
+    BlockingFactors* storage) {
+  auto& table = TunedBlockingFactorsTable::instance();
+  if (table.empty() && bTuned == nullptr) {
+    return nullptr;
+  }
+  // B is prepacked, so only an entry blocking k and n like B can be used
+  if (fbgemmGetTunedBlockingFactors<accT>(M, N, K, storage) &&
+      storage->KCB == bBlockRows && storage->NCB == bBlockCols &&
+      storage->MCB <= aBlockRows) {
+    return storage;
+  }
+  return bTuned;
+}
+
+#define INSTANTIATE_ACC_T(ACC_T)                                           \
+  template FBGEMM_API BlockingFactors fbgemmAutotuneBlockingFactors<ACC_T>( \
+      int M, int N, int K, const AutotuneOptions& options);                \
+  template FBGEMM_API bool fbgemmAddTunedBlockingFactors<ACC_T>(           \
+      int M, int N, int K, const BlockingFactors& params);                 \
+  template FBGEMM_API bool fbgemmGetTunedBlockingFactors<ACC_T>(           \
+      int M, int N, int K, BlockingFactors* params);                       \
+  template FBGEMM_API bool fbgemmGetTunedPackBParams<ACC_T>(               \
+      int N, int K, BlockingFactors* params);                              \
+  template FBGEMM_API const BlockingFactors*                               \
+  fbgemmSelectTunedBlockingFactors<ACC_T>(                                 \
+      int M,                                                               \
+      int N,                                                               \
+      int K,                                                               \
+      int aBlockRows,                                                      \
+      int bBlockRows,                                                      \
+      int bBlockCols,                                                      \
+      const BlockingFactors* bTuned,                                       \
+      BlockingFactors* storage);
+
+INSTANTIATE_ACC_T(std::int32_t)
+INSTANTIATE_ACC_T(std::int16_t)
+
+#undef INSTANTIATE_ACC_T
+
+} // namespace fbgemm
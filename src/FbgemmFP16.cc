@@ -147,4 +147,16 @@ template FBGEMM_API void cblas_gemm_compute(
     int thread_id,
     int num_threads);
 
+template FBGEMM_API void cblas_gemm_compute_k_range(
+    const matrix_op_t transa,
+    const int m,
+    const float* A,
+    const PackedGemmMatrixB<float16>& Bp,
+    const float beta,
+    float* C,
+    int k_begin,
+    int k_end,
+    int thread_id,
+    int num_threads);
+
 } // namespace fbgemm
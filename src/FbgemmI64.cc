@@ -377,11 +377,7 @@ CodeGenBase<int64_t, int64_t, int64_t, int64_t>::getOrCreate(
     a->emitEpilog(frame);
 
     jit_micro_kernel_fp fn;
-    asmjit::Error err;
-    {
-      unique_lock<mutex> lock(rtMutex_);
-      err = runtime().add(&fn, &code);
-    }
+    asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
     if (err) {
       cout << "Error: in fn add" << endl;
       return nullptr;
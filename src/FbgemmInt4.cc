@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmInt4.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace fbgemm {
+
+PackedInt4GemmMatrixB::PackedInt4GemmMatrixB(
+    matrix_op_t trans,
+    int nrow,
+    int ncol,
+    const float* smat,
+    int groupSize)
+    : nrow_(nrow), ncol_(ncol), groupSize_(groupSize) {
+  initialize();
+  const int ld_k = trans == matrix_op_t::Transpose ? 1 : ncol;
+  const int ld_n = trans == matrix_op_t::Transpose ? nrow : 1;
+
+  vector<uint8_t> qmat(static_cast<size_t>(nrow) * ncol);
+  for (int g = 0; g < numGroups(); ++g) {
+    for (int n = 0; n < ncol; ++n) {
+      const float* src = smat + static_cast<size_t>(g) * groupSize * ld_k +
+          static_cast<size_t>(n) * ld_n;
+      // Keep zero exactly representable, e.g. for padding in K
+      float min_val = 0.0f, max_val = 0.0f;
+      for (int k = 0; k < groupSize; ++k) {
+        min_val = std::min(min_val, src[k * ld_k]);
+        max_val = std::max(max_val, src[k * ld_k]);
+      }
+      float scale = (max_val - min_val) / 15.0f;
+      if (scale == 0.0f) {
+        scale = 1.0f;
+      }
+      const int32_t zero_point = std::max(
+          0,
+          std::min(
+              15, static_cast<int32_t>(std::nearbyint(-min_val / scale))));
+      scales_[g * paddedCols() + n] = scale;
+      zero_points_[g * paddedCols() + n] = zero_point;
+      for (int k = 0; k < groupSize; ++k) {
+        const int32_t q =
+            static_cast<int32_t>(std::nearbyint(src[k * ld_k] / scale)) +
+            zero_point;
+        qmat[(static_cast<size_t>(g) * groupSize + k) * ncol + n] =
+            static_cast<uint8_t>(std::max(0, std::min(15, q)));
+      }
+    }
+  }
+  pack(qmat.data(), ncol, 1);
+  computeColSums();
+}
+
+PackedInt4GemmMatrixB::PackedInt4GemmMatrixB(
+    int nrow,
+    int ncol,
+    int groupSize,
+    const uint8_t* qmat,
+    const float* scales,
+    const int32_t* zero_points)
+    : nrow_(nrow), ncol_(ncol), groupSize_(groupSize) {
+  initialize();
+  for (int g = 0; g < numGroups(); ++g) {
+    for (int n = 0; n < ncol; ++n) {
+      scales_[g * paddedCols() + n] = scales[g * ncol + n];
+      zero_points_[g * paddedCols() + n] = zero_points[g * ncol + n];
+    }
+  }
+  pack(qmat, ncol, 1);
+  computeColSums();
+}
+
+void PackedInt4GemmMatrixB::initialize() {
+  if (nrow_ <= 0 || ncol_ <= 0 || groupSize_ <= 0 ||
+      groupSize_ % ROW_BLOCK != 0 || nrow_ % groupSize_ != 0) {
+    throw std::runtime_error(
+        "PackedInt4GemmMatrixB: group size " + std::to_string(groupSize_) +
+        " must be a multiple of " + std::to_string(ROW_BLOCK) +
+        " and divide the number of rows " + std::to_string(nrow_));
+  }
+  pmat_.assign(static_cast<size_t>(numColBlocks()) * nrow_ * COL_BLOCK / 2, 0);
+  scales_.assign(static_cast<size_t>(numGroups()) * paddedCols(), 0.0f);
+  zero_points_.assign(scales_.size(), 0);
+  col_sums_.assign(scales_.size(), 0);
+}
+
+void PackedInt4GemmMatrixB::pack(const uint8_t* qmat, int ld_k, int ld_n) {
+  for (int jb = 0; jb < numColBlocks(); ++jb) {
+    uint8_t* dst =
+        pmat_.data() + static_cast<size_t>(jb) * nrow_ * COL_BLOCK / 2;
+    for (int k = 0; k < nrow_; ++k) {
+      for (int c = 0; c < COL_BLOCK && jb * COL_BLOCK + c < ncol_; ++c) {
+        const int n = jb * COL_BLOCK + c;
+        const uint8_t q = qmat[static_cast<size_t>(k) * ld_k +
+                               static_cast<size_t>(n) * ld_n] &
+            0x0F;
+        uint8_t& byte = dst[(k / ROW_BLOCK) * COL_BLOCK * ROW_BLOCK / 2 +
+                            (c % 8) * ROW_BLOCK + k % ROW_BLOCK];
+        byte |= c < 8 ? q : q << 4;
+      }
+    }
+  }
+}
+
+void PackedInt4GemmMatrixB::computeColSums() {
+  for (int g = 0; g < numGroups(); ++g) {
+    for (int n = 0; n < ncol_; ++n) {
+      int32_t sum = 0;
+      for (int k = g * groupSize_; k < (g + 1) * groupSize_; ++k) {
+        sum += quantizedValue(k, n);
+      }
+      col_sums_[g * paddedCols() + n] = sum;
+    }
+  }
+}
+
+uint8_t PackedInt4GemmMatrixB::quantizedValue(int k, int n) const {
+  const int c = n % COL_BLOCK;
+  const uint8_t byte = blockAddr(n / COL_BLOCK)
+      [(k / ROW_BLOCK) * COL_BLOCK * ROW_BLOCK / 2 + (c % 8) * ROW_BLOCK +
+       k % ROW_BLOCK];
+  return c < 8 ? byte & 0x0F : byte >> 4;
+}
+
+void PackedInt4GemmMatrixB::unpack(float* dst) const {
+  for (int k = 0; k < nrow_; ++k) {
+    const int g = k / groupSize_;
+    for (int n = 0; n < ncol_; ++n) {
+      dst[static_cast<size_t>(k) * ncol_ + n] = scales_[g * paddedCols() + n] *
+          (quantizedValue(k, n) - zero_points_[g * paddedCols() + n]);
+    }
+  }
+}
+
+size_t PackedInt4GemmMatrixB::packedBytes() const {
+  return pmat_.size() * sizeof(uint8_t) + scales_.size() * sizeof(float) +
+      zero_points_.size() * sizeof(int32_t);
+}
+
+namespace {
+
+template <typename inType, typename accType>
+void int4GemmRef(
+    int m,
+    const inType* A,
+    int lda,
+    float A_scale,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const accType* A_group_sums) {
+  const int n_begin = jb_begin * PackedInt4GemmMatrixB::COL_BLOCK;
+  const int n_end =
+      std::min(jb_end * PackedInt4GemmMatrixB::COL_BLOCK, Bp.numCols());
+  const int ld = Bp.paddedCols();
+  for (int i = 0; i < m; ++i) {
+    for (int n = n_begin; n < n_end; ++n) {
+      float sum = 0.0f;
+      for (int g = 0; g < Bp.numGroups(); ++g) {
+        accType acc = 0;
+        for (int k = g * Bp.groupSize(); k < (g + 1) * Bp.groupSize(); ++k) {
+          acc += A[i * lda + k] * static_cast<accType>(Bp.quantizedValue(k, n));
+        }
+        // Folds in both zero points; A_group_sums already has
+        // groupSize * A_zero_point subtracted.
+        acc -= A_zero_point * Bp.groupColSums()[g * ld + n] +
+            Bp.zeroPoints()[g * ld + n] * A_group_sums[i * Bp.numGroups() + g];
+        sum += Bp.scales()[g * ld + n] * acc;
+      }
+      float& c = C[i * ldc + n];
+      c = A_scale * sum + (beta == 0.0f ? 0.0f : beta * c);
+    }
+  }
+}
+
+} // namespace
+
+void fbgemmInt4Gemm(
+    int m,
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int thread_id,
+    int num_threads) {
+  int64_t jb_begin, jb_end;
+  fbgemmPartition1D(
+      thread_id, num_threads, Bp.numColBlocks(), jb_begin, jb_end);
+  if (m <= 0 || jb_begin >= jb_end) {
+    return;
+  }
+
+  const int num_groups = Bp.numGroups();
+  // Reused across calls; every element is written below
+  static thread_local vector<float> A_group_sums;
+  A_group_sums.resize(static_cast<size_t>(m) * num_groups);
+  for (int i = 0; i < m; ++i) {
+    for (int g = 0; g < num_groups; ++g) {
+      const float* a = A + static_cast<size_t>(i) * lda + g * Bp.groupSize();
+      float sum = 0.0f;
+      for (int k = 0; k < Bp.groupSize(); ++k) {
+        sum += a[k];
+      }
+      A_group_sums[i * num_groups + g] = sum;
+    }
+  }
+
+  static const auto iset = fbgemmInstructionSet();
+  // Run time CPU detection
+  if (isZmm(iset)) {
+    internal::Int4GemmFP32Avx512(
+        m, A, lda, Bp, beta, C, ldc, jb_begin, jb_end, A_group_sums.data());
+  } else if (isYmm(iset)) {
+    internal::Int4GemmFP32Avx2(
+        m, A, lda, Bp, beta, C, ldc, jb_begin, jb_end, A_group_sums.data());
+  } else {
+    int4GemmRef<float, float>(
+        m,
+        A,
+        lda,
+        1.0f,
+        0,
+        Bp,
+        beta,
+        C,
+        ldc,
+        jb_begin,
+        jb_end,
+        A_group_sums.data());
+  }
+}
+
+void fbgemmInt4Gemm(
+    int m,
+    const uint8_t* A,
+    int lda,
+    float A_scale,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int thread_id,
+    int num_threads) {
+  int64_t jb_begin, jb_end;
+  fbgemmPartition1D(
+      thread_id, num_threads, Bp.numColBlocks(), jb_begin, jb_end);
+  if (m <= 0 || jb_begin >= jb_end) {
+    return;
+  }
+
+  const int num_groups = Bp.numGroups();
+  // Reused across calls; every element is written below
+  static thread_local vector<int32_t> A_group_sums;
+  A_group_sums.resize(static_cast<size_t>(m) * num_groups);
+  for (int i = 0; i < m; ++i) {
+    for (int g = 0; g < num_groups; ++g) {
+      const uint8_t* a = A + static_cast<size_t>(i) * lda + g * Bp.groupSize();
+      int32_t sum = -A_zero_point * Bp.groupSize();
+      for (int k = 0; k < Bp.groupSize(); ++k) {
+        sum += a[k];
+      }
+      A_group_sums[i * num_groups + g] = sum;
+    }
+  }
+
+  static const auto iset = fbgemmInstructionSet();
+  // Run time CPU detection
+  if (isZmm(iset)) {
+    internal::Int4GemmU8Avx512(
+        m,
+        A,
+        lda,
+        A_scale,
+        A_zero_point,
+        Bp,
+        beta,
+        C,
+        ldc,
+        jb_begin,
+        jb_end,
+        A_group_sums.data());
+  } else if (isYmm(iset)) {
+    internal::Int4GemmU8Avx2(
+        m,
+        A,
+        lda,
+        A_scale,
+        A_zero_point,
+        Bp,
+        beta,
+        C,
+        ldc,
+        jb_begin,
+        jb_end,
+        A_group_sums.data());
+  } else {
+    int4GemmRef<uint8_t, int32_t>(
+        m,
+        A,
+        lda,
+        A_scale,
+        A_zero_point,
+        Bp,
+        beta,
+        C,
+        ldc,
+        jb_begin,
+        jb_end,
+        A_group_sums.data());
+  }
+}
+
+} // namespace fbgemm
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmInt4.h"
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cstring>
+
+namespace fbgemm {
+namespace internal {
+
+namespace {
+
+constexpr int COL_BLOCK = PackedInt4GemmMatrixB::COL_BLOCK;
+constexpr int ROW_BLOCK = PackedInt4GemmMatrixB::ROW_BLOCK;
+// Bytes of a (column block, row quad) tile
+constexpr int TILE_BYTES = COL_BLOCK * ROW_BLOCK / 2;
+// Rows of A sharing the unpacked B registers; 2 ymm accumulators per row
+constexpr int MR = 4;
+
+// c[MR][COL_BLOCK] += sum over groups of scale * (A * q - zp * A_group_sum)
+template <int ROWS>
+void fp32Block(
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const float* A_group_sums,
+    float* c) {
+  const int group_size = Bp.groupSize();
+  const int num_groups = Bp.numGroups();
+  const __m256i nibble_mask = _mm256_set1_epi32(0x0F);
+  const uint8_t* b = Bp.blockAddr(jb);
+  for (int g = 0; g < num_groups; ++g) {
+    __m256 acc[ROWS][2];
+    for (int r = 0; r < ROWS; ++r) {
+      acc[r][0] = _mm256_setzero_ps();
+      acc[r][1] = _mm256_setzero_ps();
+    }
+    const float* a = A + g * group_size;
+    for (int k = 0; k < group_size; k += ROW_BLOCK, b += TILE_BYTES) {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+      for (int kk = 0; kk < ROW_BLOCK; ++kk) {
+        const __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(x, nibble_mask));
+        const __m256 hi = _mm256_cvtepi32_ps(
+            _mm256_and_si256(_mm256_srli_epi32(x, 4), nibble_mask));
+        x = _mm256_srli_epi32(x, 8);
+        for (int r = 0; r < ROWS; ++r) {
+          const __m256 a_v = _mm256_broadcast_ss(a + r * lda + k + kk);
+          acc[r][0] = _mm256_fmadd_ps(a_v, lo, acc[r][0]);
+          acc[r][1] = _mm256_fmadd_ps(a_v, hi, acc[r][1]);
+        }
+      }
+    }
+
+    const int offset = g * Bp.paddedCols() + jb * COL_BLOCK;
+    for (int h = 0; h < 2; ++h) {
+      const __m256 scale = _mm256_loadu_ps(Bp.scales() + offset + h * 8);
+      const __m256 zp = _mm256_cvtepi32_ps(_mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(
+              Bp.zeroPoints() + offset + h * 8)));
+      for (int r = 0; r < ROWS; ++r) {
+        const __m256 sum = _mm256_fnmadd_ps(
+            zp, _mm256_set1_ps(A_group_sums[r * num_groups + g]), acc[r][h]);
+        float* c_r = c + r * COL_BLOCK + h * 8;
+        _mm256_storeu_ps(
+            c_r, _mm256_fmadd_ps(scale, sum, _mm256_loadu_ps(c_r)));
+      }
+    }
+  }
+}
+
+template <int ROWS>
+void u8Block(
+    const uint8_t* A,
+    int lda,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const int32_t* A_group_sums,
+    float* c) {
+  const int group_size = Bp.groupSize();
+  const int num_groups = Bp.numGroups();
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+  const __m256i ones = _mm256_set1_epi16(1);
+  const uint8_t* b = Bp.blockAddr(jb);
+  for (int g = 0; g < num_groups; ++g) {
+    __m256i acc[ROWS][2];
+    for (int r = 0; r < ROWS; ++r) {
+      acc[r][0] = _mm256_setzero_si256();
+      acc[r][1] = _mm256_setzero_si256();
+    }
+    const uint8_t* a = A + g * group_size;
+    for (int k = 0; k < group_size; k += ROW_BLOCK, b += TILE_BYTES) {
+      // 4 k bytes per 32-bit lane for columns 0-7 (lo) and 8-15 (hi)
+      const __m256i x =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+      const __m256i lo = _mm256_and_si256(x, nibble_mask);
+      const __m256i hi =
+          _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble_mask);
+      for (int r = 0; r < ROWS; ++r) {
+        int32_t a_quad;
+        std::memcpy(&a_quad, a + r * lda + k, sizeof(a_quad));
+        const __m256i a_v = _mm256_set1_epi32(a_quad);
+        // Pairwise u8 * s8 sums stay below 2 * 255 * 15 so don't saturate
+        acc[r][0] = _mm256_add_epi32(
+            acc[r][0],
+            _mm256_madd_epi16(_mm256_maddubs_epi16(a_v, lo), ones));
+        acc[r][1] = _mm256_add_epi32(
+            acc[r][1],
+            _mm256_madd_epi16(_mm256_maddubs_epi16(a_v, hi), ones));
+      }
+    }
+
+    const int offset = g * Bp.paddedCols() + jb * COL_BLOCK;
+    for (int h = 0; h < 2; ++h) {
+      const __m256 scale = _mm256_loadu_ps(Bp.scales() + offset + h * 8);
+      const __m256i zp = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(Bp.zeroPoints() + offset + h * 8));
+      const __m256i a_zp_correction = _mm256_mullo_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+              Bp.groupColSums() + offset + h * 8)),
+          _mm256_set1_epi32(A_zero_point));
+      for (int r = 0; r < ROWS; ++r) {
+        const __m256i sum = _mm256_sub_epi32(
+            _mm256_sub_epi32(acc[r][h], a_zp_correction),
+            _mm256_mullo_epi32(
+                zp, _mm256_set1_epi32(A_group_sums[r * num_groups + g])));
+        float* c_r = c + r * COL_BLOCK + h * 8;
+        _mm256_storeu_ps(
+            c_r,
+            _mm256_fmadd_ps(
+                scale, _mm256_cvtepi32_ps(sum), _mm256_loadu_ps(c_r)));
+      }
+    }
+  }
+}
+
+// C = alpha * c + beta * C for rows x cols of a column block
+void storeBlock(
+    int rows,
+    int cols,
+    const float* c,
+    float alpha,
+    float beta,
+    float* C,
+    int ldc) {
+  const __m256 alpha_v = _mm256_set1_ps(alpha);
+  const __m256 beta_v = _mm256_set1_ps(beta);
+  for (int r = 0; r < rows; ++r) {
+    float* C_r = C + r * ldc;
+    const float* c_r = c + r * COL_BLOCK;
+    int j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      __m256 out = _mm256_mul_ps(alpha_v, _mm256_loadu_ps(c_r + j));
+      if (beta != 0.0f) {
+        out = _mm256_fmadd_ps(beta_v, _mm256_loadu_ps(C_r + j), out);
+      }
+      _mm256_storeu_ps(C_r + j, out);
+    }
+    for (; j < cols; ++j) {
+      C_r[j] = alpha * c_r[j] + (beta == 0.0f ? 0.0f : beta * C_r[j]);
+    }
+  }
+}
+
+template <int ROWS>
+void fp32Rows(
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const float* A_group_sums,
+    float* c,
+    int rows) {
+  if (rows == ROWS) {
+    fp32Block<ROWS>(A, lda, Bp, jb, A_group_sums, c);
+  } else if constexpr (ROWS > 1) {
+    fp32Rows<ROWS - 1>(A, lda, Bp, jb, A_group_sums, c, rows);
+  }
+}
+
+template <int ROWS>
+void u8Rows(
+    const uint8_t* A,
+    int lda,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const int32_t* A_group_sums,
+    float* c,
+    int rows) {
+  if (rows == ROWS) {
+    u8Block<ROWS>(A, lda, A_zero_point, Bp, jb, A_group_sums, c);
+  } else if constexpr (ROWS > 1) {
+    u8Rows<ROWS - 1>(A, lda, A_zero_point, Bp, jb, A_group_sums, c, rows);
+  }
+}
+
+} // namespace
+
+void Int4GemmFP32Avx2(
+    int m,
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const float* A_group_sums) {
+  const int num_groups = Bp.numGroups();
+  for (int jb = jb_begin; jb < jb_end; ++jb) {
+    const int n0 = jb * COL_BLOCK;
+    const int cols = std::min(COL_BLOCK, Bp.numCols() - n0);
+    for (int i = 0; i < m; i += MR) {
+      const int rows = std::min(MR, m - i);
+      alignas(32) float c[MR * COL_BLOCK] = {};
+      fp32Rows<MR>(
+          A + static_cast<size_t>(i) * lda,
+          lda,
+          Bp,
+          jb,
+          A_group_sums + i * num_groups,
+          c,
+          rows);
+      storeBlock(
+          rows,
+          cols,
+          c,
+          1.0f,
+          beta,
+          C + static_cast<size_t>(i) * ldc + n0,
+          ldc);
+    }
+  }
+}
+
+void Int4GemmU8Avx2(
+    int m,
+    const uint8_t* A,
+    int lda,
+    float A_scale,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const int32_t* A_group_sums) {
+  const int num_groups = Bp.numGroups();
+  for (int jb = jb_begin; jb < jb_end; ++jb) {
+    const int n0 = jb * COL_BLOCK;
+    const int cols = std::min(COL_BLOCK, Bp.numCols() - n0);
+    for (int i = 0; i < m; i += MR) {
+      const int rows = std::min(MR, m - i);
+      alignas(32) float c[MR * COL_BLOCK] = {};
+      u8Rows<MR>(
+          A + static_cast<size_t>(i) * lda,
+          lda,
+          A_zero_point,
+          Bp,
+          jb,
+          A_group_sums + i * num_groups,
+          c,
+          rows);
+      storeBlock(
+          rows,
+          cols,
+          c,
+          A_scale,
+          beta,
+          C + static_cast<size_t>(i) * ldc + n0,
+          ldc);
+    }
+  }
+}
+
+} // namespace internal
+} // namespace fbgemm
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmInt4.h"
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cstring>
+
+namespace fbgemm {
+namespace internal {
+
+namespace {
+
+constexpr int COL_BLOCK = PackedInt4GemmMatrixB::COL_BLOCK;
+constexpr int ROW_BLOCK = PackedInt4GemmMatrixB::ROW_BLOCK;
+// Bytes of a (column block, row quad) tile
+constexpr int TILE_BYTES = COL_BLOCK * ROW_BLOCK / 2;
+// Rows of A sharing the unpacked B register; 1 zmm accumulator per row
+constexpr int MR = 8;
+
+// Widens a tile so that lane c holds the 4 k bytes of column c, with
+// columns 8-15 still in the high nibbles.
+inline __m512i loadTile(const uint8_t* b) {
+  const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+  return _mm512_inserti64x4(
+      _mm512_castsi256_si512(x), _mm256_srli_epi32(x, 4), 1);
+}
+
+template <int ROWS>
+void fp32Block(
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const float* A_group_sums,
+    float* c) {
+  const int group_size = Bp.groupSize();
+  const int num_groups = Bp.numGroups();
+  const __m512i nibble_mask = _mm512_set1_epi32(0x0F);
+  const uint8_t* b = Bp.blockAddr(jb);
+  for (int g = 0; g < num_groups; ++g) {
+    __m512 acc[ROWS];
+    for (int r = 0; r < ROWS; ++r) {
+      acc[r] = _mm512_setzero_ps();
+    }
+    const float* a = A + g * group_size;
+    for (int k = 0; k < group_size; k += ROW_BLOCK, b += TILE_BYTES) {
+      __m512i x = loadTile(b);
+      for (int kk = 0; kk < ROW_BLOCK; ++kk) {
+        const __m512 q =
+            _mm512_cvtepi32_ps(_mm512_and_si512(x, nibble_mask));
+        x = _mm512_srli_epi32(x, 8);
+        for (int r = 0; r < ROWS; ++r) {
+          acc[r] =
+              _mm512_fmadd_ps(_mm512_set1_ps(a[r * lda + k + kk]), q, acc[r]);
+        }
+      }
+    }
+
+    const int offset = g * Bp.paddedCols() + jb * COL_BLOCK;
+    const __m512 scale = _mm512_loadu_ps(Bp.scales() + offset);
+    const __m512 zp =
+        _mm512_cvtepi32_ps(_mm512_loadu_si512(Bp.zeroPoints() + offset));
+    for (int r = 0; r < ROWS; ++r) {
+      const __m512 sum = _mm512_fnmadd_ps(
+          zp, _mm512_set1_ps(A_group_sums[r * num_groups + g]), acc[r]);
+      float* c_r = c + r * COL_BLOCK;
+      _mm512_storeu_ps(c_r, _mm512_fmadd_ps(scale, sum, _mm512_loadu_ps(c_r)));
+    }
+  }
+}
+
+template <int ROWS>
+void u8Block(
+    const uint8_t* A,
+    int lda,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const int32_t* A_group_sums,
+    float* c) {
+  const int group_size = Bp.groupSize();
+  const int num_groups = Bp.numGroups();
+  const __m512i nibble_mask = _mm512_set1_epi8(0x0F);
+  const __m512i ones = _mm512_set1_epi16(1);
+  const uint8_t* b = Bp.blockAddr(jb);
+  for (int g = 0; g < num_groups; ++g) {
+    __m512i acc[ROWS];
+    for (int r = 0; r < ROWS; ++r) {
+      acc[r] = _mm512_setzero_si512();
+    }
+    const uint8_t* a = A + g * group_size;
+    for (int k = 0; k < group_size; k += ROW_BLOCK, b += TILE_BYTES) {
+      const __m512i q = _mm512_and_si512(loadTile(b), nibble_mask);
+      for (int r = 0; r < ROWS; ++r) {
+        int32_t a_quad;
+        std::memcpy(&a_quad, a + r * lda + k, sizeof(a_quad));
+        // Pairwise u8 * s8 sums stay below 2 * 255 * 15 so don't saturate
+        acc[r] = _mm512_add_epi32(
+            acc[r],
+            _mm512_madd_epi16(
+                _mm512_maddubs_epi16(_mm512_set1_epi32(a_quad), q), ones));
+      }
+    }
+
+    const int offset = g * Bp.paddedCols() + jb * COL_BLOCK;
+    const __m512 scale = _mm512_loadu_ps(Bp.scales() + offset);
+    const __m512i zp = _mm512_loadu_si512(Bp.zeroPoints() + offset);
+    const __m512i a_zp_correction = _mm512_mullo_epi32(
+        _mm512_loadu_si512(Bp.groupColSums() + offset),
+        _mm512_set1_epi32(A_zero_point));
+    for (int r = 0; r < ROWS; ++r) {
+      const __m512i sum = _mm512_sub_epi32(
+          _mm512_sub_epi32(acc[r], a_zp_correction),
+          _mm512_mullo_epi32(
+              zp, _mm512_set1_epi32(A_group_sums[r * num_groups + g])));
+      float* c_r = c + r * COL_BLOCK;
+      _mm512_storeu_ps(
+          c_r,
+          _mm512_fmadd_ps(
+              scale, _mm512_cvtepi32_ps(sum), _mm512_loadu_ps(c_r)));
+    }
+  }
+}
+
+// C = alpha * c + beta * C for rows x cols of a column block
+void storeBlock(
+    int rows,
+    int cols,
+    const float* c,
+    float alpha,
+    float beta,
+    float* C,
+    int ldc) {
+  const __mmask16 mask = static_cast<__mmask16>((1U << cols) - 1);
+  const __m512 alpha_v = _mm512_set1_ps(alpha);
+  for (int r = 0; r < rows; ++r) {
+    __m512 out = _mm512_mul_ps(alpha_v, _mm512_loadu_ps(c + r * COL_BLOCK));
+    if (beta != 0.0f) {
+      out = _mm512_fmadd_ps(
+          _mm512_set1_ps(beta),
+          _mm512_maskz_loadu_ps(mask, C + r * ldc),
+          out);
+    }
+    _mm512_mask_storeu_ps(C + r * ldc, mask, out);
+  }
+}
+
+template <int ROWS>
+void fp32Rows(
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const float* A_group_sums,
+    float* c,
+    int rows) {
+  if (rows == ROWS) {
+    fp32Block<ROWS>(A, lda, Bp, jb, A_group_sums, c);
+  } else if constexpr (ROWS > 1) {
+    fp32Rows<ROWS - 1>(A, lda, Bp, jb, A_group_sums, c, rows);
+  }
+}
+
+template <int ROWS>
+void u8Rows(
+    const uint8_t* A,
+    int lda,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    int jb,
+    const int32_t* A_group_sums,
+    float* c,
+    int rows) {
+  if (rows == ROWS) {
+    u8Block<ROWS>(A, lda, A_zero_point, Bp, jb, A_group_sums, c);
+  } else if constexpr (ROWS > 1) {
+    u8Rows<ROWS - 1>(A, lda, A_zero_point, Bp, jb, A_group_sums, c, rows);
+  }
+}
+
+} // namespace
+
+void Int4GemmFP32Avx512(
+    int m,
+    const float* A,
+    int lda,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const float* A_group_sums) {
+  const int num_groups = Bp.numGroups();
+  for (int jb = jb_begin; jb < jb_end; ++jb) {
+    const int n0 = jb * COL_BLOCK;
+    const int cols = std::min(COL_BLOCK, Bp.numCols() - n0);
+    for (int i = 0; i < m; i += MR) {
+      const int rows = std::min(MR, m - i);
+      alignas(64) float c[MR * COL_BLOCK] = {};
+      fp32Rows<MR>(
+          A + static_cast<size_t>(i) * lda,
+          lda,
+          Bp,
+          jb,
+          A_group_sums + i * num_groups,
+          c,
+          rows);
+      storeBlock(
+          rows,
+          cols,
+          c,
+          1.0f,
+          beta,
+          C + static_cast<size_t>(i) * ldc + n0,
+          ldc);
+    }
+  }
+}
+
+void Int4GemmU8Avx512(
+    int m,
+    const uint8_t* A,
+    int lda,
+    float A_scale,
+    int32_t A_zero_point,
+    const PackedInt4GemmMatrixB& Bp,
+    float beta,
+    float* C,
+    int ldc,
+    int jb_begin,
+    int jb_end,
+    const int32_t* A_group_sums) {
+  const int num_groups = Bp.numGroups();
+  for (int jb = jb_begin; jb < jb_end; ++jb) {
+    const int n0 = jb * COL_BLOCK;
+    const int cols = std::min(COL_BLOCK, Bp.numCols() - n0);
+    for (int i = 0; i < m; i += MR) {
+      const int rows = std::min(MR, m - i);
+      alignas(64) float c[MR * COL_BLOCK] = {};
+      u8Rows<MR>(
+          A + static_cast<size_t>(i) * lda,
+          lda,
+          A_zero_point,
+          Bp,
+          jb,
+          A_group_sums + i * num_groups,
+          c,
+          rows);
+      storeBlock(
+          rows,
+          cols,
+          c,
+          A_scale,
+          beta,
+          C + static_cast<size_t>(i) * ldc + n0,
+          ldc);
+    }
+  }
+}
+
+} // namespace internal
+} // namespace fbgemm
@@ -0,0 +1,998 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmPackSerialize.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "fbgemm/Fbgemm.h"
+#include "fbgemm/FbgemmBF16.h"
+#include "fbgemm/FbgemmFP16.h"
+#include "fbgemm/FbgemmSparse.h"
+
+namespace fbgemm {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'B', 'G', 'E', 'M', 'M', 'P', 'W'};
+// Packed buffers start at multiples of this in the file, so that mapped
+// buffers are as aligned as the ones from fbgemmAlignedAlloc.
+constexpr std::uint64_t kBlobAlignment = 64;
+
+// File layout: the header, the packed buffers of all objects, and the index
+// of the objects at indexOffset.
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t isa;
+  std::uint64_t indexOffset;
+  std::uint64_t indexSize;
+};
+
+enum class PackedKind : std::uint32_t {
+  PACK_B_MATRIX = 1,
+  GCONV = 2,
+  DEPTHWISE = 3,
+  CONV = 4,
+  GEMM_FP16 = 5,
+  GEMM_BF16 = 6,
+  BCSR = 7,
+};
+
+// Which packed matrix of PackWeightsForConv is set
+enum class ConvPath : std::int64_t {
+  NONE = 0,
+  IM2COL = 1,
+  DEPTHWISE = 2,
+  DIRECTCONV = 3,
+  GROUPWISE = 4,
+  POINTWISE = 5,
+};
+
+template <typename PackedT>
+struct PackedKindOf;
+
+template <typename T, typename accT>
+struct PackedKindOf<PackBMatrix<T, accT>> {
+  static constexpr PackedKind value = PackedKind::PACK_B_MATRIX;
+};
+
+template <typename T, typename accT, int SPATIAL_DIM>
+struct PackedKindOf<PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>> {
+  static constexpr PackedKind value = PackedKind::GCONV;
+};
+
+template <>
+struct PackedKindOf<PackedDepthWiseConvMatrix> {
+  static constexpr PackedKind value = PackedKind::DEPTHWISE;
+};
+
+template <int SPATIAL_DIM, typename T, typename accT>
+struct PackedKindOf<PackWeightsForConv<SPATIAL_DIM, T, accT>> {
+  static constexpr PackedKind value = PackedKind::CONV;
+};
+
+template <>
+struct PackedKindOf<PackedGemmMatrixFP16> {
+  static constexpr PackedKind value = PackedKind::GEMM_FP16;
+};
+
+template <>
+struct PackedKindOf<PackedGemmMatrixBF16> {
+  static constexpr PackedKind value = PackedKind::GEMM_BF16;
+};
+
+template <typename T, int RB, int CB>
+struct PackedKindOf<BCSRMatrix<T, RB, CB>> {
+  static constexpr PackedKind value = PackedKind::BCSR;
+};
+
+template <typename PackedT>
+struct Tag {};
+
+const char* isaName(std::uint32_t isa) {
+  switch (static_cast<inst_set_t>(isa)) {
+    case inst_set_t::anyarch:
+      return "anyarch";
+    case inst_set_t::avx2:
+      return "avx2";
+    case inst_set_t::avx512:
+      return "avx512";
+    case inst_set_t::avx512_ymm:
+      return "avx512_ymm";
+    case inst_set_t::avx512_vnni:
+      return "avx512_vnni";
+    case inst_set_t::avx512_vnni_ymm:
+      return "avx512_vnni_ymm";
+  }
+  return "unknown";
+}
+
+} // namespace
+
+// A packed buffer in the file
+struct PackedBlob {
+  std::uint64_t offset;
+  std::uint64_t size;
+};
+
+// An object in the index of the file
+struct PackedEntry {
+  std::string name;
+  PackedKind kind;
+  std::vector<std::int64_t> params;
+  std::vector<PackedBlob> blobs;
+  bool hasBlocking{false};
+  BlockingFactors blocking{};
+};
+
+// An object being saved: its layout parameters and the buffers to write.
+struct PackedSaveRecord {
+  std::vector<std::int64_t> params;
+  std::vector<std::pair<const void*, std::uint64_t>> blobs;
+  const BlockingFactors* blocking{nullptr};
+};
+
+// Where the packed buffers of loaded objects come from.
+class PackedBlobSource {
+ public:
+  virtual ~PackedBlobSource() = default;
+  // Returns the buffer and whether the caller owns it.
+  virtual std::pair<void*, bool> acquire(const PackedBlob& blob) const = 0;
+  virtual void read(const PackedBlob& blob, void* dst) const = 0;
+};
+
+// Reads back the parameters and buffers of an object in the order they were
+// saved.
+class PackedLoadRecord {
+ public:
+  PackedLoadRecord(const PackedEntry& entry, const PackedBlobSource& source)
+      : entry_(entry), source_(source) {}
+
+  std::int64_t next() {
+    if (param_ >= entry_.params.size()) {
+      fail("truncated layout parameters");
+    }
+    return entry_.params[param_++];
+  }
+
+  int nextInt() {
+    const std::int64_t val = next();
+    if (val < std::numeric_limits<int>::min() ||
+        val > std::numeric_limits<int>::max()) {
+      fail("layout parameter out of range");
+    }
+    return static_cast<int>(val);
+  }
+
+  void expect(std::int64_t val, const char* what) {
+    if (next() != val) {
+      fail(std::string("mismatching ") + what);
+    }
+  }
+
+  // Returns the next buffer, which has to hold size bytes, and whether the
+  // caller owns it.
+  std::pair<void*, bool> blob(std::uint64_t size) {
+    return source_.acquire(nextBlob(size));
+  }
+
+  // Copies the next buffer into v, which is resized to size elements once
+  // the buffer is known to hold them.
+  template <typename T>
+  void readVector(std::vector<T>& v, std::int64_t size) {
+    if (size < 0 ||
+        static_cast<std::uint64_t>(size) >
+            std::numeric_limits<std::uint64_t>::max() / sizeof(T)) {
+      fail("invalid vector size");
+    }
+    const PackedBlob& b = nextBlob(size * sizeof(T));
+    v.resize(size);
+    if (size > 0) {
+      source_.read(b, v.data());
+    }
+  }
+
+  // Fails unless all parameters and buffers were read.
+  void finish() const {
+    if (param_ != entry_.params.size() || blob_ != entry_.blobs.size()) {
+      fail("unexpected layout parameters");
+    }
+  }
+
+  const BlockingFactors* blocking() const {
+    return entry_.hasBlocking ? &entry_.blocking : nullptr;
+  }
+
+  [[noreturn]] void fail(const std::string& msg) const {
+    throw std::runtime_error("packed weights " + entry_.name + ": " + msg);
+  }
+
+ private:
+  const PackedBlob& nextBlob(std::uint64_t size) {
+    if (blob_ >= entry_.blobs.size() || entry_.blobs[blob_].size != size) {
+      fail("mismatching packed buffer size");
+    }
+    return entry_.blobs[blob_++];
+  }
+
+  const PackedEntry& entry_;
+  const PackedBlobSource& source_;
+  std::size_t param_{0};
+  std::size_t blob_{0};
+};
+
+// Saves and loads the layout and buffers of each packed type. Friend of the
+// packed classes.
+class PackedWeightSerializer {
+ public:
+  template <typename T, typename accT>
+  static void save(const PackBMatrix<T, accT>& m, PackedSaveRecord& rec) {
+    rec.params.insert(
+        rec.params.end(),
+        {static_cast<std::int64_t>(sizeof(accT)),
+         static_cast<std::int64_t>(m.trans_),
+         m.numRows(),
+         m.numCols(),
+         m.numGroups(),
+         m.blockRowSize(),
+         m.blockColSize(),
+         m.row_interleave_});
+    rec.blobs.emplace_back(m.buf_, packedSize(m));
+    rec.blocking = m.blocking_params;
+  }
+
+  template <typename T, typename accT>
+  static std::unique_ptr<PackBMatrix<T, accT>> load(
+      PackedLoadRecord& rec,
+      Tag<PackBMatrix<T, accT>>) {
+    rec.expect(sizeof(accT), "accumulation type");
+    const auto trans = static_cast<matrix_op_t>(rec.next());
+    const int nRow = rec.nextInt();
+    const int nCol = rec.nextInt();
+    const int groups = rec.nextInt();
+    const int brow = rec.nextInt();
+    const int bcol = rec.nextInt();
+    const int rowInterleave = rec.nextInt();
+    if (nRow < 0 || nCol < 0 || groups <= 0 || brow <= 0 || bcol <= 0 ||
+        rowInterleave <= 0) {
+      rec.fail("invalid PackBMatrix layout");
+    }
+    std::unique_ptr<PackBMatrix<T, accT>> m(new PackBMatrix<T, accT>(
+        trans,
+        nRow,
+        nCol,
+        nullptr,
+        groups,
+        rec.blocking(),
+        brow,
+        bcol,
+        rowInterleave));
+    const auto buf = rec.blob(packedSize(*m));
+    m->buf_ = static_cast<T*>(buf.first);
+    m->bufAllocatedHere_ = buf.second;
+    return m;
+  }
+
+  template <typename T, typename accT, int SPATIAL_DIM>
+  static void save(
+      const PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>& m,
+      PackedSaveRecord& rec) {
+    rec.params.push_back(sizeof(accT));
+    saveConvParam(m.conv_param_, rec);
+    rec.params.push_back(static_cast<std::int64_t>(m.trans_));
+    rec.params.push_back(m.GTogether_);
+    rec.blobs.emplace_back(
+        m.pdata_, packedSize(m.conv_param_, m.GTogether_) * sizeof(T));
+  }
+
+  template <typename T, typename accT, int SPATIAL_DIM>
+  static std::unique_ptr<PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>> load(
+      PackedLoadRecord& rec,
+      Tag<PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>>) {
+    using PackedT = PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>;
+    rec.expect(sizeof(accT), "accumulation type");
+    const auto conv_p = loadConvParam<SPATIAL_DIM>(rec);
+    const auto trans = static_cast<matrix_op_t>(rec.next());
+    const int GTogether = rec.nextInt();
+    if (GTogether != PackedT::numOfGroupsTogether(conv_p)) {
+      rec.fail("groupwise weights packed for another instruction set");
+    }
+    std::unique_ptr<PackedT> m(
+        new PackedT(trans, conv_p, nullptr, GTogether));
+    const auto buf = rec.blob(packedSize(conv_p, GTogether) * sizeof(T));
+    m->pdata_ = static_cast<T*>(buf.first);
+    m->bufAllocatedHere_ = buf.second;
+    return m;
+  }
+
+  static void save(const PackedDepthWiseConvMatrix& m, PackedSaveRecord& rec) {
+    rec.params.insert(rec.params.end(), {m.OC_, m.kernel_prod_});
+    rec.blobs.emplace_back(m.pmat_, packedSize(m.OC_, m.kernel_prod_));
+  }
+
+  static std::unique_ptr<PackedDepthWiseConvMatrix> load(
+      PackedLoadRecord& rec,
+      Tag<PackedDepthWiseConvMatrix>) {
+    const int OC = rec.nextInt();
+    const int kernel_prod = rec.nextInt();
+    if (OC < 0 || kernel_prod <= 0) {
+      rec.fail("invalid depthwise layout");
+    }
+    std::unique_ptr<PackedDepthWiseConvMatrix> m(
+        new PackedDepthWiseConvMatrix(OC, kernel_prod, nullptr, false));
+    const auto buf = rec.blob(packedSize(OC, kernel_prod));
+    m->pmat_ = static_cast<std::int8_t*>(buf.first);
+    m->bufAllocatedHere_ = buf.second;
+    return m;
+  }
+
+  template <int SPATIAL_DIM, typename T, typename accT>
+  static void save(
+      const PackWeightsForConv<SPATIAL_DIM, T, accT>& w,
+      PackedSaveRecord& rec) {
+    saveConvParam(w.conv_param_, rec);
+    if (w.W_im2col_packed_) {
+      rec.params.push_back(static_cast<std::int64_t>(ConvPath::IM2COL));
+      save(*w.W_im2col_packed_, rec);
+    } else if (w.W_dw_packed_) {
+      rec.params.push_back(static_cast<std::int64_t>(ConvPath::DEPTHWISE));
+      save(*w.W_dw_packed_, rec);
+    } else if (w.W_dc_packed_) {
+      rec.params.push_back(static_cast<std::int64_t>(ConvPath::DIRECTCONV));
+      rec.blobs.emplace_back(
+          w.W_dc_packed_->pmat_, directConvPackedSize(w.conv_param_));
+    } else if (w.W_gconv_packed_) {
+      rec.params.push_back(static_cast<std::int64_t>(ConvPath::GROUPWISE));
+      save(*w.W_gconv_packed_, rec);
+    } else if (w.W_pointwise_packed_) {
+      rec.params.push_back(static_cast<std::int64_t>(ConvPath::POINTWISE));
+      save(*w.W_pointwise_packed_, rec);
+    } else {
+      rec.params.push_back(static_cast<std::int64_t>(ConvPath::NONE));
+    }
+  }
+
+  template <int SPATIAL_DIM, typename T, typename accT>
+  static std::unique_ptr<PackWeightsForConv<SPATIAL_DIM, T, accT>> load(
+      PackedLoadRecord& rec,
+      Tag<PackWeightsForConv<SPATIAL_DIM, T, accT>>) {
+    using PackedT = PackWeightsForConv<SPATIAL_DIM, T, accT>;
+    const auto conv_p = loadConvParam<SPATIAL_DIM>(rec);
+    std::unique_ptr<PackedT> w(new PackedT(conv_p));
+    switch (static_cast<ConvPath>(rec.next())) {
+      case ConvPath::IM2COL:
+        w->W_im2col_packed_ = load(rec, Tag<PackBMatrix<T, accT>>());
+        break;
+      case ConvPath::DEPTHWISE:
+        w->W_dw_packed_ = load(rec, Tag<PackedDepthWiseConvMatrix>());
+        break;
+      case ConvPath::DIRECTCONV: {
+        w->W_dc_packed_.reset(new PackedDirectConvMatrix(nullptr, false));
+        const auto buf = rec.blob(directConvPackedSize(conv_p));
+        w->W_dc_packed_->pmat_ = static_cast<std::int8_t*>(buf.first);
+        w->W_dc_packed_->bufAllocatedHere_ = buf.second;
+        break;
+      }
+      case ConvPath::GROUPWISE:
+        w->W_gconv_packed_ =
+            load(rec, Tag<PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>>());
+        break;
+      case ConvPath::POINTWISE:
+        w->W_pointwise_packed_ = load(rec, Tag<PackBMatrix<T, accT>>());
+        break;
+      case ConvPath::NONE:
+        break;
+      default:
+        rec.fail("unknown convolution path");
+    }
+    return w;
+  }
+
+  template <typename T>
+  static void save(const PackedGemmMatrixB<T>& m, PackedSaveRecord& rec) {
+    rec.params.insert(
+        rec.params.end(),
+        {m.numRows(),
+         m.numCols(),
+         m.blockRowSize(),
+         m.lastBrow(),
+         m.blockColSize(),
+         m.numBrow(),
+         m.numBcol(),
+         m.matSize(),
+         m.kernelNumColBlocks()});
+    rec.blobs.emplace_back(
+        m.pmat(), static_cast<std::uint64_t>(m.matSize()) * sizeof(T));
+  }
+
+  template <typename T>
+  static std::unique_ptr<PackedGemmMatrixB<T>> load(
+      PackedLoadRecord& rec,
+      Tag<PackedGemmMatrixB<T>>) {
+    std::array<int, 9> p;
+    for (int& v : p) {
+      v = rec.nextInt();
+    }
+    if (*std::min_element(p.begin(), p.end()) < 0) {
+      rec.fail("invalid PackedGemmMatrixB layout");
+    }
+    const auto buf = rec.blob(static_cast<std::uint64_t>(p[7]) * sizeof(T));
+    return std::make_unique<PackedGemmMatrixB<T>>(
+        p[0],
+        p[1],
+        p[2],
+        p[3],
+        p[4],
+        p[5],
+        p[6],
+        p[7],
+        p[8],
+        static_cast<T*>(buf.first),
+        buf.second);
+  }
+
+  template <typename T, int RB, int CB>
+  static void save(const BCSRMatrix<T, RB, CB>& m, PackedSaveRecord& rec) {
+    rec.params.insert(
+        rec.params.end(),
+        {m.R,
+         m.C,
+         RB,
+         CB,
+         static_cast<std::int64_t>(m.rowBPtr.size()),
+         static_cast<std::int64_t>(m.colBIdx.size()),
+         static_cast<std::int64_t>(m.values.size()),
+         static_cast<std::int64_t>(m.row_offsets.size())});
+    saveVector(m.rowBPtr, rec);
+    saveVector(m.colBIdx, rec);
+    saveVector(m.values, rec);
+    saveVector(m.row_offsets, rec);
+  }
+
+  template <typename T, int RB, int CB>
+  static std::unique_ptr<BCSRMatrix<T, RB, CB>> load(
+      PackedLoadRecord& rec,
+      Tag<BCSRMatrix<T, RB, CB>>) {
+    const int R = rec.nextInt();
+    const int C = rec.nextInt();
+    rec.expect(RB, "row block size");
+    rec.expect(CB, "column block size");
+    if (R < 0 || C < 0) {
+      rec.fail("invalid BCSRMatrix shape");
+    }
+    auto m = std::make_unique<BCSRMatrix<T, RB, CB>>(R, C);
+    const std::int64_t rowBPtrSize = rec.next();
+    const std::int64_t colBIdxSize = rec.next();
+    const std::int64_t valuesSize = rec.next();
+    const std::int64_t rowOffsetsSize = rec.next();
+    rec.readVector(m->rowBPtr, rowBPtrSize);
+    rec.readVector(m->colBIdx, colBIdxSize);
+    rec.readVector(m->values, valuesSize);
+    rec.readVector(m->row_offsets, rowOffsetsSize);
+    return m;
+  }
+
+ private:
+  template <typename T, typename accT>
+  static std::uint64_t packedSize(const PackBMatrix<T, accT>& m) {
+    return static_cast<std::uint64_t>(m.numGroups()) * m.blockRows() *
+        m.blockRowSize() * m.blockCols() * m.blockColSize() * sizeof(T);
+  }
+
+  // Elements of a PackWeightMatrixForGConv buffer
+  template <int SPATIAL_DIM>
+  static std::uint64_t packedSize(
+      const conv_param_t<SPATIAL_DIM>& conv_p,
+      int GTogether) {
+    const int kernel_prod = std::accumulate(
+        conv_p.K.begin(), conv_p.K.end(), 1, std::multiplies<int>());
+    const int paddedICPerG = ((conv_p.IC / conv_p.G) + 3) / 4 * 4;
+    return static_cast<std::uint64_t>(
+               (conv_p.G + GTogether - 1) / GTogether * GTogether) *
+        kernel_prod * (conv_p.OC / conv_p.G) * paddedICPerG;
+  }
+
+  // Bytes of a PackedDepthWiseConvMatrix buffer
+  static std::uint64_t packedSize(int OC, int kernel_prod) {
+    const int kernel_prod_aligned = (kernel_prod + 1) / 2 * 2;
+    return static_cast<std::uint64_t>((OC + 31) / 32) * kernel_prod_aligned *
+        32;
+  }
+
+  // Bytes of the PackedDirectConvMatrix buffer of PackWeightsForConv
+  template <int SPATIAL_DIM>
+  static std::uint64_t directConvPackedSize(
+      const conv_param_t<SPATIAL_DIM>& conv_p) {
+    const int kernel_h = SPATIAL_DIM == 1 ? 1 : conv_p.K[SPATIAL_DIM - 2];
+    const int kernel_w = conv_p.K[SPATIAL_DIM - 1];
+    const int kernel_prod_aligned = (kernel_h * kernel_w + 1) / 2 * 2;
+    return static_cast<std::uint64_t>((conv_p.OC + 31) / 32 * 32) *
+        kernel_prod_aligned * conv_p.IC;
+  }
+
+  template <int SPATIAL_DIM>
+  static void saveConvParam(
+      const conv_param_t<SPATIAL_DIM>& conv_p,
+      PackedSaveRecord& rec) {
+    auto& p = rec.params;
+    p.insert(p.end(), {SPATIAL_DIM, conv_p.MB, conv_p.IC, conv_p.OC, conv_p.G});
+    p.insert(p.end(), conv_p.IN_DIM.begin(), conv_p.IN_DIM.end());
+    p.insert(p.end(), conv_p.K.begin(), conv_p.K.end());
+    p.insert(p.end(), conv_p.stride.begin(), conv_p.stride.end());
+    p.insert(p.end(), conv_p.pad.begin(), conv_p.pad.end());
+    p.insert(p.end(), conv_p.dilation.begin(), conv_p.dilation.end());
+    p.insert(p.end(), conv_p.output_pad.begin(), conv_p.output_pad.end());
+    p.push_back(conv_p.transposed);
+  }
+
+  template <int SPATIAL_DIM>
+  static conv_param_t<SPATIAL_DIM> loadConvParam(PackedLoadRecord& rec) {
+    rec.expect(SPATIAL_DIM, "spatial dimensions");
+    const int MB = rec.nextInt();
+    const int IC = rec.nextInt();
+    const int OC = rec.nextInt();
+    const int G = rec.nextInt();
+    if (MB <= 0 || IC <= 0 || OC <= 0 || G <= 0) {
+      rec.fail("invalid convolution parameters");
+    }
+    std::array<int, SPATIAL_DIM> in_dim, k, stride, dilation, output_pad;
+    std::array<int, SPATIAL_DIM * 2> pad;
+    for (auto* dims : {&in_dim, &k, &stride}) {
+      for (int& v : *dims) {
+        v = rec.nextInt();
+      }
+    }
+    for (int& v : pad) {
+      v = rec.nextInt();
+    }
+    for (auto* dims : {&dilation, &output_pad}) {
+      for (int& v : *dims) {
+        v = rec.nextInt();
+      }
+    }
+    const bool transposed = rec.next() != 0;
+    return conv_param_t<SPATIAL_DIM>(
+        MB,
+        IC,
+        OC,
+        in_dim,
+        G,
+        k,
+        stride,
+        pad,
+        dilation,
+        output_pad,
+        transposed);
+  }
+
+  template <typename T>
+  static void saveVector(const std::vector<T>& v, PackedSaveRecord& rec) {
+    rec.blobs.emplace_back(v.data(), v.size() * sizeof(T));
+  }
+};
+
+namespace {
+
+template <typename T>
+void appendPod(std::string& out, const T& val) {
+  out.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+// Reads the index of a file, failing on truncation.
+class IndexParser {
+ public:
+  IndexParser(const std::string& path, const std::string& data)
+      : path_(path), data_(data) {}
+
+  template <typename T>
+  T read() {
+    T val;
+    std::memcpy(&val, take(sizeof(T)), sizeof(T));
+    return val;
+  }
+
+  std::string readString(std::uint64_t size) {
+    const char* p = take(size);
+    return std::string(p, size);
+  }
+
+  // Number of elements of elemSize bytes that follow, checked against the
+  // remaining index size.
+  std::uint64_t readCount(std::uint64_t elemSize) {
+    const auto count = read<std::uint64_t>();
+    if (count > (data_.size() - pos_) / elemSize) {
+      truncated();
+    }
+    return count;
+  }
+
+ private:
+  const char* take(std::uint64_t size) {
+    if (size > data_.size() - pos_) {
+      truncated();
+    }
+    const char* p = data_.data() + pos_;
+    pos_ += size;
+    return p;
+  }
+
+  [[noreturn]] void truncated() const {
+    throw std::runtime_error(path_ + ": truncated packed weight index");
+  }
+
+  const std::string& path_;
+  const std::string& data_;
+  std::uint64_t pos_{0};
+};
+
+} // namespace
+
+struct PackedWeightWriter::Impl {
+  std::string path;
+  std::ofstream out;
+  std::uint64_t offset{sizeof(FileHeader)};
+  std::vector<PackedEntry> entries;
+  std::unordered_map<std::string, std::size_t> index;
+  bool closed{false};
+
+  [[noreturn]] void fail(const std::string& msg) const {
+    throw std::runtime_error(path + ": " + msg);
+  }
+
+  void write(const void* data, std::uint64_t size) {
+    out.write(static_cast<const char*>(data), size);
+    if (!out) {
+      fail("failed to write packed weights");
+    }
+    offset += size;
+  }
+
+  void add(
+      const std::string& name,
+      PackedKind kind,
+      const PackedSaveRecord& rec) {
+    if (closed) {
+      fail("add() after close()");
+    }
+    if (index.count(name)) {
+      fail("duplicate packed weights " + name);
+    }
+    PackedEntry entry;
+    entry.name = name;
+    entry.kind = kind;
+    entry.params = rec.params;
+    if (rec.blocking) {
+      entry.hasBlocking = true;
+      entry.blocking = *rec.blocking;
+    }
+    static const char padding[kBlobAlignment] = {};
+    for (const auto& blob : rec.blobs) {
+      write(padding, (kBlobAlignment - offset % kBlobAlignment) %
+                kBlobAlignment);
+      entry.blobs.push_back({offset, blob.second});
+      write(blob.first, blob.second);
+    }
+    index.emplace(name, entries.size());
+    entries.push_back(std::move(entry));
+  }
+
+  void close() {
+    if (closed) {
+      return;
+    }
+    closed = true;
+    std::string data;
+    appendPod<std::uint64_t>(data, entries.size());
+    for (const PackedEntry& e : entries) {
+      appendPod<std::uint64_t>(data, e.name.size());
+      data.append(e.name);
+      appendPod(data, static_cast<std::uint32_t>(e.kind));
+      appendPod<std::uint32_t>(data, e.hasBlocking);
+      const BlockingFactors& b = e.blocking;
+      for (int v :
+           {b.MR, b.NR, b.NR_MIN, b.ROW_INTERLEAVE, b.MCB, b.KCB, b.NCB}) {
+        appendPod<std::int32_t>(data, v);
+      }
+      appendPod<std::uint64_t>(data, e.params.size());
+      for (std::int64_t p : e.params) {
+        appendPod(data, p);
+      }
+      appendPod<std::uint64_t>(data, e.blobs.size());
+      for (const PackedBlob& blob : e.blobs) {
+        appendPod(data, blob.offset);
+        appendPod(data, blob.size);
+      }
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kPackedWeightFormatVersion;
+    header.isa = static_cast<std::uint32_t>(fbgemmInstructionSet());
+    header.indexOffset = offset;
+    header.indexSize = data.size();
+    write(data.data(), data.size());
+    out.seekp(0);
+    write(&header, sizeof(header));
+    out.close();
+    if (!out) {
+      fail("failed to close packed weight file");
+    }
+  }
+};
+
+PackedWeightWriter::PackedWeightWriter(const std::string& path)
+    : impl_(new Impl) {
+  impl_->path = path;
+  impl_->out.open(path, std::ios::binary | std::ios::trunc);
+  if (!impl_->out) {
+    impl_->fail("failed to open for writing");
+  }
+  // The header is written by close() once the index offset is known.
+  FileHeader header{};
+  impl_->write(&header, sizeof(header));
+  impl_->offset = sizeof(header);
+}
+
+PackedWeightWriter::~PackedWeightWriter() {
+  try {
+    impl_->close();
+  } catch (const std::exception&) {
+  }
+}
+
+void PackedWeightWriter::close() {
+  impl_->close();
+}
+
+template <typename PackedT>
+void PackedWeightWriter::add(const std::string& name, const PackedT& packed) {
+  PackedSaveRecord rec;
+  PackedWeightSerializer::save(packed, rec);
+  impl_->add(name, PackedKindOf<PackedT>::value, rec);
+}
+
+struct PackedWeightReader::Impl : public PackedBlobSource {
+  std::string path;
+  std::uint64_t fileSize{0};
+  void* mapped{nullptr};
+  // Used to copy packed buffers if the file is not mapped
+  mutable std::ifstream in;
+  mutable std::mutex inMutex;
+  std::vector<PackedEntry> entries;
+  std::unordered_map<std::string, std::size_t> index;
+
+  ~Impl() override {
+#ifndef _WIN32
+    if (mapped) {
+      munmap(mapped, fileSize);
+    }
+#endif
+  }
+
+  [[noreturn]] void fail(const std::string& msg) const {
+    throw std::runtime_error(path + ": " + msg);
+  }
+
+  void readAt(std::uint64_t offset, void* dst, std::uint64_t size) const {
+    std::lock_guard<std::mutex> lock(inMutex);
+    in.seekg(offset);
+    in.read(static_cast<char*>(dst), size);
+    if (!in) {
+      in.clear();
+      fail("failed to read packed weights");
+    }
+  }
+
+  std::pair<void*, bool> acquire(const PackedBlob& blob) const override {
+    if (mapped) {
+      return {static_cast<char*>(mapped) + blob.offset, false};
+    }
+    void* buf = fbgemmPackedWeightAlloc(
+        kBlobAlignment, std::max<std::uint64_t>(blob.size, kBlobAlignment));
+    try {
+      read(blob, buf);
+    } catch (...) {
+      fbgemmAlignedFree(buf);
+      throw;
+    }
+    return {buf, true};
+  }
+
+  void read(const PackedBlob& blob, void* dst) const override {
+    if (mapped) {
+      std::memcpy(dst, static_cast<char*>(mapped) + blob.offset, blob.size);
+    } else {
+      readAt(blob.offset, dst, blob.size);
+    }
+  }
+
+  void readIndex() {
+    FileHeader header;
+    if (fileSize < sizeof(header)) {
+      fail("not a packed weight file");
+    }
+    readAt(0, &header, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+      fail("not a packed weight file");
+    }
+    if (header.version != kPackedWeightFormatVersion) {
+      fail(
+          "packed weight format version " + std::to_string(header.version) +
+          " is not supported, expected " +
+          std::to_string(kPackedWeightFormatVersion));
+    }
+    const auto isa = static_cast<std::uint32_t>(fbgemmInstructionSet());
+    if (header.isa != isa) {
+      fail(
+          std::string("weights were packed for ") + isaName(header.isa) +
+          " but this machine uses " + isaName(isa));
+    }
+    if (header.indexOffset > fileSize ||
+        header.indexSize > fileSize - header.indexOffset) {
+      fail("truncated packed weight file");
+    }
+
+    std::string data(header.indexSize, '\0');
+    readAt(header.indexOffset, &data[0], data.size());
+    IndexParser parser(path, data);
+    const std::uint64_t count = parser.readCount(1);
+    for (std::uint64_t i = 0; i < count; ++i) {
+      PackedEntry e;
+      e.name = parser.readString(parser.read<std::uint64_t>());
+      e.kind = static_cast<PackedKind>(parser.read<std::uint32_t>());
+      e.hasBlocking = parser.read<std::uint32_t>() != 0;
+      BlockingFactors& b = e.blocking;
+      for (int* v :
+           {&b.MR,
+            &b.NR,
+            &b.NR_MIN,
+            &b.ROW_INTERLEAVE,
+            &b.MCB,
+            &b.KCB,
+            &b.NCB}) {
+        *v = parser.read<std::int32_t>();
+      }
+      e.params.resize(parser.readCount(sizeof(std::int64_t)));
+      for (std::int64_t& p : e.params) {
+        p = parser.read<std::int64_t>();
+      }
+      e.blobs.resize(parser.readCount(2 * sizeof(std::uint64_t)));
+      for (PackedBlob& blob : e.blobs) {
+        blob.offset = parser.read<std::uint64_t>();
+        blob.size = parser.read<std::uint64_t>();
+        if (blob.offset % kBlobAlignment != 0 ||
+            blob.offset > header.indexOffset ||
+            blob.size > header.indexOffset - blob.offset) {
+          fail("packed weights " + e.name + " are out of bounds");
+        }
+      }
+      if (!index.emplace(e.name, entries.size()).second) {
+        fail("duplicate packed weights " + e.name);
+      }
+      entries.push_back(std::move(e));
+    }
+  }
+
+  const PackedEntry& find(const std::string& name) const {
+    auto it = index.find(name);
+    if (it == index.end()) {
+      fail("no packed weights named " + name);
+    }
+    return entries[it->second];
+  }
+};
+
+PackedWeightReader::PackedWeightReader(const std::string& path, bool useMmap)
+    : impl_(new Impl) {
+  impl_->path = path;
+  impl_->in.open(path, std::ios::binary | std::ios::ate);
+  if (!impl_->in) {
+    impl_->fail("failed to open for reading");
+  }
+  impl_->fileSize = static_cast<std::uint64_t>(impl_->in.tellg());
+  impl_->readIndex();
+#ifndef _WIN32
+  if (useMmap && impl_->fileSize > 0) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      void* p =
+          mmap(nullptr, impl_->fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      // Falls back to copying if the file can't be mapped.
+      if (p != MAP_FAILED) {
+        impl_->mapped = p;
+      }
+    }
+  }
+#else
+  (void)useMmap;
+#endif
+}
+
+PackedWeightReader::~PackedWeightReader() = default;
+
+std::vector<std::string> PackedWeightReader::names() const {
+  std::vector<std::string> result;
+  result.reserve(impl_->entries.size());
+  for (const PackedEntry& e : impl_->entries) {
+    result.push_back(e.name);
+  }
+  return result;
+}
+
+bool PackedWeightReader::contains(const std::string& name) const {
+  return impl_->index.count(name) > 0;
+}
+
+const BlockingFactors* PackedWeightReader::blockingFactors(
+    const std::string& name) const {
+  const PackedEntry& e = impl_->find(name);
+  return e.hasBlocking ? &e.blocking : nullptr;
+}
+
+template <typename PackedT>
+std::unique_ptr<PackedT> PackedWeightReader::load(
+    const std::string& name) const {
+  const PackedEntry& e = impl_->find(name);
+  PackedLoadRecord rec(e, *impl_);
+  if (e.kind != PackedKindOf<PackedT>::value) {
+    rec.fail("saved as another packed type");
+  }
+  auto packed = PackedWeightSerializer::load(rec, Tag<PackedT>());
+  rec.finish();
+  return packed;
+}
+
+#define INSTANTIATE_PACKED_TYPE(...)                                      \
+  template void PackedWeightWriter::add<__VA_ARGS__>(                     \
+      const std::string& name, const __VA_ARGS__& packed);                \
+  template std::unique_ptr<__VA_ARGS__> PackedWeightReader::load<         \
+      __VA_ARGS__>(const std::string& name) const;
+
+INSTANTIATE_PACKED_TYPE(PackBMatrix<std::int8_t, std::int32_t>)
+INSTANTIATE_PACKED_TYPE(PackBMatrix<std::int8_t, std::int16_t>)
+INSTANTIATE_PACKED_TYPE(PackWeightsForConv<1>)
+INSTANTIATE_PACKED_TYPE(PackWeightsForConv<2>)
+INSTANTIATE_PACKED_TYPE(PackWeightsForConv<3>)
+INSTANTIATE_PACKED_TYPE(
+    PackWeightMatrixForGConv<std::int8_t, std::int32_t, 1>)
+INSTANTIATE_PACKED_TYPE(
+    PackWeightMatrixForGConv<std::int8_t, std::int32_t, 2>)
+INSTANTIATE_PACKED_TYPE(
+    PackWeightMatrixForGConv<std::int8_t, std::int32_t, 3>)
+INSTANTIATE_PACKED_TYPE(
+    PackWeightMatrixForGConv<std::int8_t, std::int16_t, 1>)
+INSTANTIATE_PACKED_TYPE(
+    PackWeightMatrixForGConv<std::int8_t, std::int16_t, 2>)
+INSTANTIATE_PACKED_TYPE(
+    PackWeightMatrixForGConv<std::int8_t, std::int16_t, 3>)
+INSTANTIATE_PACKED_TYPE(PackedDepthWiseConvMatrix)
+INSTANTIATE_PACKED_TYPE(PackedGemmMatrixFP16)
+INSTANTIATE_PACKED_TYPE(PackedGemmMatrixBF16)
+INSTANTIATE_PACKED_TYPE(BCSRMatrix<std::int8_t, 1, 4>)
+
+#undef INSTANTIATE_PACKED_TYPE
+
+} // namespace fbgemm
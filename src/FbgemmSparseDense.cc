@@ -16,6 +16,8 @@
 #include <cstring>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "fbgemm/Utils.h"
@@ -198,6 +200,176 @@ fbgemmDenseToBCSR(int R, int C, const int8_t* inp);
 template FBGEMM_API std::unique_ptr<BCSRMatrix<int8_t, 1, 4>>
 fbgemmDenseToBCSR(int R, int C, const int8_t* inp, int ld);
 
+namespace internal {
+
+// Index of the pattern with positions p0 < p1, in the order of
+// nmSparsePairPatterns
+template <int NNZ, int GROUP>
+static inline int nmSparsePairPatternIndex(int p0, int p1) {
+  if (NNZ == 2) {
+    return p0 * (2 * GROUP - p0 - 1) / 2 + p1 - p0 - 1;
+  } else {
+    return p0 * GROUP + p1 - GROUP;
+  }
+}
+
+template <int NNZ, int GROUP>
+int nmSparsePairPatterns(int pattern_pos[][2]) {
+  static_assert(
+      (NNZ == 1 || NNZ == 2) && GROUP <= 4,
+      "pairs are only supported for 1:GROUP and 2:GROUP with GROUP <= 4");
+  int n = 0;
+  for (int p0 = 0; p0 < GROUP; ++p0) {
+    int p1_begin = NNZ == 2 ? p0 + 1 : GROUP;
+    int p1_end = NNZ == 2 ? GROUP : 2 * GROUP;
+    for (int p1 = p1_begin; p1 < p1_end; ++p1) {
+      assert((nmSparsePairPatternIndex<NNZ, GROUP>(p0, p1) == n));
+      pattern_pos[n][0] = p0;
+      pattern_pos[n][1] = p1;
+      ++n;
+    }
+  }
+  return n;
+}
+
+// Pattern of a pair given the bitmask of its columns (the 2 bitmasks of its
+// groups for 1:GROUP)
+template <int NNZ, int GROUP>
+static inline std::uint8_t nmSparseMaskToPattern(unsigned mask) {
+  static const std::array<std::uint8_t, 256> mask_to_pattern = []() {
+    std::array<std::uint8_t, 256> table{};
+    int pattern_pos[16][2];
+    int num_patterns = nmSparsePairPatterns<NNZ, GROUP>(pattern_pos);
+    for (int t = 0; t < num_patterns; ++t) {
+      table[(1 << pattern_pos[t][0]) | (1 << pattern_pos[t][1])] = t;
+    }
+    return table;
+  }();
+  return mask_to_pattern[mask];
+}
+
+} // namespace internal
+
+template <typename T, int NNZ, int GROUP>
+void NMSparseMatrix<T, NNZ, GROUP>::pack(const DTYPE* src, size_t ld) {
+  const int G = numGroups();
+  const int stride = valuesStride();
+  values.assign(static_cast<size_t>(R) * stride, 0);
+  meta.assign(static_cast<size_t>(R) * G, 0);
+  pair_patterns.assign(static_cast<size_t>(R) * stride / 2, 0);
+  for (int i = 0; i < R; ++i) {
+    int32_t rowSum = 0;
+    int n = 0;
+    for (int g = 0; g < G; ++g) {
+      unsigned mask = 0;
+      int nnz = 0;
+      for (int p = 0; p < GROUP && g * GROUP + p < C; ++p) {
+        if (src[i * ld + g * GROUP + p] != 0) {
+          mask |= 1U << p;
+          ++nnz;
+        }
+      }
+      if (nnz > NNZ) {
+        throw std::runtime_error(
+            "row " + std::to_string(i) + " has " + std::to_string(nnz) +
+            " non-zeros in columns [" + std::to_string(g * GROUP) + ", " +
+            std::to_string(g * GROUP + GROUP) + "), more than " +
+            std::to_string(NNZ) + ":" + std::to_string(GROUP) + " sparsity");
+      }
+      // Pad with zeros at the first free positions so every group has NNZ
+      // values
+      for (int p = 0; nnz < NNZ; ++p) {
+        if (!(mask & (1U << p))) {
+          mask |= 1U << p;
+          ++nnz;
+        }
+      }
+      meta[i * G + g] = static_cast<uint8_t>(mask);
+      for (int p = 0; p < GROUP; ++p) {
+        if (mask & (1U << p)) {
+          DTYPE val = g * GROUP + p < C ? src[i * ld + g * GROUP + p] : 0;
+          values[static_cast<size_t>(i) * stride + n++] = val;
+          rowSum += static_cast<int32_t>(val);
+        }
+      }
+    }
+    row_offsets[i] = rowSum;
+
+    const uint8_t* row_meta = meta.data() + static_cast<size_t>(i) * G;
+    for (int q = 0; q < stride / 2; ++q) {
+      unsigned mask;
+      if (NNZ == 2) {
+        mask = q < G ? row_meta[q] : 0;
+      } else {
+        // A missing group takes the first position, as the padding does
+        mask = (2 * q < G ? row_meta[2 * q] : 1) |
+            (2 * q + 1 < G ? row_meta[2 * q + 1] : 1) << GROUP;
+      }
+      pair_patterns[static_cast<size_t>(i) * stride / 2 + q] =
+          internal::nmSparseMaskToPattern<NNZ, GROUP>(mask);
+    }
+  }
+}
+
+template <typename T, int NNZ, int GROUP>
+void NMSparseMatrix<T, NNZ, GROUP>::pack(const DTYPE* src) {
+  pack(src, C);
+}
+
+template <typename T, int NNZ, int GROUP>
+void NMSparseMatrix<T, NNZ, GROUP>::unpack(T* dst, size_t ld) const {
+  const int G = numGroups();
+  const int stride = valuesStride();
+  for (int i = 0; i < R; ++i) {
+    memset(dst + i * ld, 0, C * sizeof(T));
+    int n = 0;
+    for (int g = 0; g < G; ++g) {
+      for (int p = 0; p < GROUP; ++p) {
+        if (meta[i * G + g] & (1U << p)) {
+          T val = values[static_cast<size_t>(i) * stride + n++];
+          if (g * GROUP + p < C) {
+            dst[i * ld + g * GROUP + p] = val;
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T, int NNZ, int GROUP>
+void NMSparseMatrix<T, NNZ, GROUP>::unpack(T* dst) const {
+  unpack(dst, C);
+}
+
+template <int NNZ, int GROUP, typename T>
+FBGEMM_API std::unique_ptr<NMSparseMatrix<T, NNZ, GROUP>>
+fbgemmDenseToNMSparse(int R, int C, const T* inp, int ld) {
+  unique_ptr<NMSparseMatrix<T, NNZ, GROUP>> nm(
+      new NMSparseMatrix<T, NNZ, GROUP>(R, C));
+  nm->pack(inp, ld);
+  return nm;
+}
+
+template <int NNZ, int GROUP, typename T>
+FBGEMM_API std::unique_ptr<NMSparseMatrix<T, NNZ, GROUP>>
+fbgemmDenseToNMSparse(int R, int C, const T* inp) {
+  return fbgemmDenseToNMSparse<NNZ, GROUP, T>(R, C, inp, C);
+}
+
+
+#define CREATE_INSTANCE(NNZ, GROUP)                                      \
+  template struct NMSparseMatrix<int8_t, NNZ, GROUP>;                    \
+  template FBGEMM_API std::unique_ptr<NMSparseMatrix<int8_t, NNZ, GROUP>> \
+  fbgemmDenseToNMSparse<NNZ, GROUP>(int R, int C, const int8_t* inp);    \
+  template FBGEMM_API std::unique_ptr<NMSparseMatrix<int8_t, NNZ, GROUP>> \
+  fbgemmDenseToNMSparse<NNZ, GROUP>(                                     \
+      int R, int C, const int8_t* inp, int ld);                          \
+  template int internal::nmSparsePairPatterns<NNZ, GROUP>(               \
+      int pattern_pos[][2]);
+CREATE_INSTANCE(2, 4)
+CREATE_INSTANCE(1, 4)
+#undef CREATE_INSTANCE
+
 void SparseDenseMM(
     int M,
     int N,
@@ -304,4 +476,95 @@ CREATE_INSTANCE(false, QuantizationGranularity::TENSOR)
 CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL)
 #undef CREATE_INSTANCE
 
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+FBGEMM_API void fbgemmSparseDenseInt8MM(
+    int N,
+    const std::unique_ptr<NMSparseMatrix<int8_t, NNZ, GROUP>>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum,
+    int thread_id,
+    int num_threads) {
+  static const auto iset = fbgemmInstructionSet();
+  // Rows of A are independent, including their requantization
+  int64_t row_start = 0, row_end = 0;
+  fbgemmPartition1D(thread_id, num_threads, nm->R, row_start, row_end);
+  if (row_start >= row_end) {
+    return;
+  }
+
+  // Run time CPU detection
+  if (isZmm(iset)) {
+    internal::SparseDenseInt8NMAvx512<FUSE_RELU, Q_GRAN>(
+        N,
+        *nm,
+        B,
+        ldb,
+        C_i32,
+        C_u8,
+        ldc,
+        rParams,
+        accum,
+        row_start,
+        row_end);
+  } else if (isYmm(iset)) {
+    internal::SparseDenseInt8NMAvx2<FUSE_RELU, Q_GRAN>(
+        N,
+        *nm,
+        B,
+        ldb,
+        C_i32,
+        C_u8,
+        ldc,
+        rParams,
+        accum,
+        row_start,
+        row_end);
+  } else {
+    sparseDenseInt8MMRef<FUSE_RELU, Q_GRAN>(
+        N,
+        nm,
+        B,
+        ldb,
+        C_i32,
+        C_u8,
+        ldc,
+        rParams,
+        accum,
+        thread_id,
+        num_threads);
+  }
+}
+
+#define CREATE_INSTANCE(FUSE_RELU, QGRAN, NNZ, GROUP)                        \
+  template FBGEMM_API void fbgemmSparseDenseInt8MM<FUSE_RELU, QGRAN>(       \
+      int N,                                                                \
+      const std::unique_ptr<NMSparseMatrix<int8_t, NNZ, GROUP>>& nm,        \
+      const uint8_t* B,                                                     \
+      int ldb,                                                              \
+      int32_t* C_i32,                                                       \
+      uint8_t* C_u8,                                                        \
+      int ldc,                                                              \
+      trRequantizationParams_t& rParams,                                    \
+      bool accum,                                                           \
+      int thread_id,                                                        \
+      int num_threads);
+#define CREATE_INSTANCE_NM(NNZ, GROUP)                                      \
+  CREATE_INSTANCE(true, QuantizationGranularity::TENSOR, NNZ, GROUP)       \
+  CREATE_INSTANCE(true, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP)  \
+  CREATE_INSTANCE(false, QuantizationGranularity::TENSOR, NNZ, GROUP)      \
+  CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP)
+CREATE_INSTANCE_NM(2, 4)
+CREATE_INSTANCE_NM(1, 4)
+#undef CREATE_INSTANCE_NM
+#undef CREATE_INSTANCE
+
 } // namespace fbgemm
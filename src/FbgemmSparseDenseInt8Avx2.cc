@@ -257,5 +257,231 @@ CREATE_INSTANCE(false, QuantizationGranularity::TENSOR)
 CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL)
 #undef CREATE_INSTANCE
 
+// Swaps the high 128 bits of x[0] (x[1]) with the low 128 bits of x[2]
+// (x[3])
+static inline void transpose_2x2_blocks(__m256i x[]) {
+  for (int idx = 0; idx < 2; ++idx) {
+    __m256i lo = _mm256_permute2x128_si256(x[idx], x[idx + 2], 0x20);
+    __m256i hi = _mm256_permute2x128_si256(x[idx], x[idx + 2], 0x31);
+    x[idx] = lo;
+    x[idx + 2] = hi;
+  }
+}
+
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+void SparseDenseInt8NMAvx2(
+    int N,
+    const NMSparseMatrix<int8_t, NNZ, GROUP>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum,
+    int row_start,
+    int row_end) {
+  // Calcualtes accum ? C += A * B : C = A * B
+  // A pair of values of a row of A multiplies 2 rows of B chosen by one of a
+  // few patterns (see nmSparsePairPatterns). For a tile of pairs, the 2 rows
+  // of B of every pattern are interleaved byte by byte once for all rows of
+  // A. A quad of values then needs 2 of these buffers interleaved 16 bits at
+  // a time, half of the work of dense 4x1 BCSR blocks for 2:4 sparsity.
+  constexpr int VLEN_INT8 = 32;
+  constexpr int VLEN_INT32 = 8;
+  constexpr int PAIR_TILE = 128; // pairs per tile, must be even
+  constexpr int MAX_PATTERNS = 16;
+  constexpr int SPAN = 2 * GROUP / NNZ; // rows of B of a pair
+
+  int pattern_pos[MAX_PATTERNS][2];
+  const int num_patterns = nmSparsePairPatterns<NNZ, GROUP>(pattern_pos);
+  const int K = nm.C;
+  const int stride = nm.valuesStride();
+  const int pairs = stride / 2;
+  const int pTiles = (pairs + PAIR_TILE - 1) / PAIR_TILE;
+
+  constexpr int buffer_size = PAIR_TILE * MAX_PATTERNS * 2 * VLEN_INT8;
+  static thread_local uint8_t* pair_buffer_ = nullptr;
+
+  if (pair_buffer_ == nullptr) {
+    pair_buffer_ = static_cast<uint8_t*>(fbgemmAlignedAlloc(64, buffer_size));
+  }
+
+  const __m256i one_16bit_v = _mm256_set1_epi16(1);
+  for (int j = 0; j < N; j += VLEN_INT8) {
+    const int cols = std::min(VLEN_INT8, N - j);
+
+    for (int pt = 0; pt < pTiles; ++pt) {
+      const int p_begin = pt * PAIR_TILE;
+      const int p_end = std::min(pairs, p_begin + PAIR_TILE);
+      for (int q = p_begin; q < p_end; ++q) {
+        __m256i br_v[SPAN];
+        for (int p = 0; p < SPAN; ++p) {
+          const int k = q * SPAN + p;
+          if (k < K && cols == VLEN_INT8) {
+            br_v[p] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(B + k * ldb + j));
+          } else {
+            uint8_t tmpDest[VLEN_INT8] = {};
+            if (k < K) {
+              std::memcpy(tmpDest, B + k * ldb + j, cols);
+            }
+            br_v[p] =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tmpDest));
+          }
+        }
+        uint8_t* dst =
+            pair_buffer_ + (q - p_begin) * num_patterns * 2 * VLEN_INT8;
+        for (int t = 0; t < num_patterns; ++t) {
+          const __m256i r0_v = br_v[pattern_pos[t][0]];
+          const __m256i r1_v = br_v[pattern_pos[t][1]];
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dst + 2 * t * VLEN_INT8),
+              _mm256_unpacklo_epi8(r0_v, r1_v));
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dst + (2 * t + 1) * VLEN_INT8),
+              _mm256_unpackhi_epi8(r0_v, r1_v));
+        }
+      }
+
+      for (int i = row_start; i < row_end; ++i) {
+        const uint8_t* row_pattern =
+            nm.pair_patterns.data() + static_cast<size_t>(i) * pairs;
+        const int32_t* values =
+            reinterpret_cast<const int32_t*>(nm.values.data() + i * stride);
+        int32_t* C_row = C_i32 + i * ldc + j;
+
+        // Accumulators hold the columns of 128-bit block b of c_v[idx] at
+        // 16 * b + 8 * (idx % 2) + 4 * (idx / 2), see transpose_2x2_blocks.
+        __m256i c_v[4];
+        if (accum || pt > 0) {
+          int32_t tmpC[VLEN_INT8] = {};
+          const int32_t* src = C_row;
+          if (cols < VLEN_INT8) {
+            std::memcpy(tmpC, C_row, cols * sizeof(int32_t));
+            src = tmpC;
+          }
+          for (int idx = 0; idx < 4; ++idx) {
+            c_v[idx] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(src + idx * VLEN_INT32));
+          }
+          transpose_2x2_blocks(c_v);
+        } else {
+          for (int idx = 0; idx < 4; ++idx) {
+            c_v[idx] = _mm256_setzero_si256();
+          }
+        }
+
+        // Buffers of the first pair of the quad
+        const uint8_t* quad_buffer = pair_buffer_;
+        for (int q = p_begin; q < p_end; q += 2) {
+          const __m256i a_v = _mm256_set1_epi32(values[q / 2]);
+          const uint8_t* x = quad_buffer + row_pattern[q] * 2 * VLEN_INT8;
+          const uint8_t* y = quad_buffer +
+              (num_patterns + row_pattern[q + 1]) * 2 * VLEN_INT8;
+          quad_buffer += 2 * num_patterns * 2 * VLEN_INT8;
+          const __m256i xlo_v =
+              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+          const __m256i xhi_v = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(x + VLEN_INT8));
+          const __m256i ylo_v =
+              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y));
+          const __m256i yhi_v = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(y + VLEN_INT8));
+          __m256i br_v[4] = {
+              _mm256_unpacklo_epi16(xlo_v, ylo_v),
+              _mm256_unpacklo_epi16(xhi_v, yhi_v),
+              _mm256_unpackhi_epi16(xlo_v, ylo_v),
+              _mm256_unpackhi_epi16(xhi_v, yhi_v)};
+          for (int idx = 0; idx < 4; ++idx) {
+            __m256i c_i16_v = _mm256_maddubs_epi16(br_v[idx], a_v);
+            __m256i c_i32_v = _mm256_madd_epi16(one_16bit_v, c_i16_v);
+            c_v[idx] = _mm256_add_epi32(c_v[idx], c_i32_v);
+          }
+        }
+
+        transpose_2x2_blocks(c_v);
+        if (cols == VLEN_INT8) {
+          for (int idx = 0; idx < 4; ++idx) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(C_row + idx * VLEN_INT32),
+                c_v[idx]);
+          }
+        } else {
+          int32_t tmpC[VLEN_INT8];
+          for (int idx = 0; idx < 4; ++idx) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(tmpC + idx * VLEN_INT32), c_v[idx]);
+          }
+          std::memcpy(C_row, tmpC, cols * sizeof(int32_t));
+        }
+      }
+    }
+  }
+
+  block_type_t block{row_start, row_end - row_start, 0, N};
+  const int32_t* C_i32_block = C_i32 + row_start * ldc;
+  if (rParams.bias == nullptr) {
+    if (rParams.act_zero_point) {
+      trRequantizeOpt<
+          FUSE_RELU,
+          /*ACT_SYMMETRIC*/ false,
+          /*WEIGHT_SYMMETRIC*/ true,
+          /*HAS_BIAS*/ false,
+          Q_GRAN>(C_u8, C_i32_block, block, ldc, ldc, rParams);
+    } else {
+      trRequantizeOpt<
+          FUSE_RELU,
+          /*ACT_SYMMETRIC*/ true,
+          /*WEIGHT_SYMMETRIC*/ true,
+          /*HAS_BIAS*/ false,
+          Q_GRAN>(C_u8, C_i32_block, block, ldc, ldc, rParams);
+    }
+  } else {
+    if (rParams.act_zero_point) {
+      trRequantizeOpt<
+          FUSE_RELU,
+          /*ACT_SYMMETRIC*/ false,
+          /*WEIGHT_SYMMETRIC*/ true,
+          /*HAS_BIAS*/ true,
+          Q_GRAN>(C_u8, C_i32_block, block, ldc, ldc, rParams);
+    } else {
+      trRequantizeOpt<
+          FUSE_RELU,
+          /*ACT_SYMMETRIC*/ true,
+          /*WEIGHT_SYMMETRIC*/ true,
+          /*HAS_BIAS*/ true,
+          Q_GRAN>(C_u8, C_i32_block, block, ldc, ldc, rParams);
+    }
+  }
+}
+
+#define CREATE_INSTANCE(FUSE_RELU, QGRAN, NNZ, GROUP)         \
+  template void SparseDenseInt8NMAvx2<FUSE_RELU, QGRAN>(     \
+      int N,                                                 \
+      const NMSparseMatrix<int8_t, NNZ, GROUP>& nm,          \
+      const uint8_t* B,                                      \
+      int ldb,                                               \
+      int32_t* C_i32,                                        \
+      uint8_t* C_u8,                                         \
+      int ldc,                                               \
+      trRequantizationParams_t& rParams,                     \
+      bool accum,                                            \
+      int row_start,                                         \
+      int row_end);
+#define CREATE_INSTANCE_NM(NNZ, GROUP)                                     \
+  CREATE_INSTANCE(true, QuantizationGranularity::TENSOR, NNZ, GROUP)      \
+  CREATE_INSTANCE(true, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP) \
+  CREATE_INSTANCE(false, QuantizationGranularity::TENSOR, NNZ, GROUP)     \
+  CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP)
+CREATE_INSTANCE_NM(2, 4)
+CREATE_INSTANCE_NM(1, 4)
+#undef CREATE_INSTANCE_NM
+#undef CREATE_INSTANCE
+
 } // namespace internal
 } // namespace fbgemm
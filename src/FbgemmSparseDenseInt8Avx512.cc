@@ -581,5 +581,287 @@ CREATE_INSTANCE(false, QuantizationGranularity::TENSOR)
 CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL)
 #undef CREATE_INSTANCE
 
+// Maps the columns of the accumulators of SparseDenseInt8NMColsAvx512 to
+// consecutive columns and back.
+// COLBLOCKS = 4: the 4 x 4 128-bit blocks of x are transposed.
+// COLBLOCKS = 2: the blocks of x[0] and x[1] hold columns 0, 16, 8, 24 and
+// 4, 20, 12, 28 (+ 0-3).
+template <int COLBLOCKS>
+static inline void permuteNMColumns(__m512i x[]) {
+  if constexpr (COLBLOCKS == 4) {
+    __m512i t0 = _mm512_shuffle_i64x2(x[0], x[1], 0x44);
+    __m512i t1 = _mm512_shuffle_i64x2(x[0], x[1], 0xEE);
+    __m512i t2 = _mm512_shuffle_i64x2(x[2], x[3], 0x44);
+    __m512i t3 = _mm512_shuffle_i64x2(x[2], x[3], 0xEE);
+    x[0] = _mm512_shuffle_i64x2(t0, t2, 0x88);
+    x[1] = _mm512_shuffle_i64x2(t0, t2, 0xDD);
+    x[2] = _mm512_shuffle_i64x2(t1, t3, 0x88);
+    x[3] = _mm512_shuffle_i64x2(t1, t3, 0xDD);
+  } else {
+    __m512i t0 = _mm512_permutex2var_epi64(
+        x[0], _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0), x[1]);
+    __m512i t1 = _mm512_permutex2var_epi64(
+        x[0], _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2), x[1]);
+    x[0] = t0;
+    x[1] = t1;
+  }
+}
+
+// Rows [row_start, row_end) and up to COLBLOCKS * 16 columns from col_start
+// of the N:M sparse int8 GEMM. pair_buffer must hold PAIR_TILE *
+// MAX_PATTERNS * COLBLOCKS * 32 bytes.
+template <
+    int COLBLOCKS,
+    int PAIR_TILE,
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+static inline void SparseDenseInt8NMColsAvx512(
+    int N,
+    const NMSparseMatrix<int8_t, NNZ, GROUP>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum,
+    int row_start,
+    int row_end,
+    int col_start,
+    uint8_t* pair_buffer) {
+  constexpr int VLEN_INT8 = 64;
+  constexpr int VLEN_INT32 = 16;
+  constexpr int MAX_PATTERNS = 16;
+  constexpr int SPAN = 2 * GROUP / NNZ; // rows of B of a pair
+  // bytes of the 2 interleaved rows of B of a pattern
+  constexpr int PATTERN_BYTES = COLBLOCKS * 2 * VLEN_INT32;
+
+  int pattern_pos[MAX_PATTERNS][2];
+  const int num_patterns = nmSparsePairPatterns<NNZ, GROUP>(pattern_pos);
+  const int K = nm.C;
+  const int stride = nm.valuesStride();
+  const int pairs = stride / 2;
+  const int pTiles = (pairs + PAIR_TILE - 1) / PAIR_TILE;
+
+  const int cols = std::min(COLBLOCKS * VLEN_INT32, N - col_start);
+  const __mmask64 mask_int8_v =
+      cols == VLEN_INT8 ? ~0ULL : (1ULL << cols) - 1;
+  __mmask16 mask_int32_v[4] = {};
+  for (int idx = 0; idx < COLBLOCKS; ++idx) {
+    const int n = std::max(0, std::min(VLEN_INT32, cols - idx * VLEN_INT32));
+    mask_int32_v[idx] = static_cast<__mmask16>((1U << n) - 1);
+  }
+  const __m512i one_16bit_v = _mm512_set1_epi16(1);
+
+  for (int pt = 0; pt < pTiles; ++pt) {
+    const int p_begin = pt * PAIR_TILE;
+    const int p_end = std::min(pairs, p_begin + PAIR_TILE);
+    // Interleave the 2 rows of B of every pattern of every pair of the tile
+    for (int q = p_begin; q < p_end; ++q) {
+      uint8_t* dst = pair_buffer + (q - p_begin) * num_patterns * PATTERN_BYTES;
+      if constexpr (COLBLOCKS == 4) {
+        __m512i br_v[SPAN];
+        for (int p = 0; p < SPAN; ++p) {
+          const int k = q * SPAN + p;
+          br_v[p] = k < K
+              ? _mm512_maskz_loadu_epi8(mask_int8_v, B + k * ldb + col_start)
+              : _mm512_setzero_si512();
+        }
+        for (int t = 0; t < num_patterns; ++t) {
+          const __m512i r0_v = br_v[pattern_pos[t][0]];
+          const __m512i r1_v = br_v[pattern_pos[t][1]];
+          _mm512_storeu_si512(
+              dst + t * PATTERN_BYTES, _mm512_unpacklo_epi8(r0_v, r1_v));
+          _mm512_storeu_si512(
+              dst + t * PATTERN_BYTES + VLEN_INT8,
+              _mm512_unpackhi_epi8(r0_v, r1_v));
+        }
+      } else {
+        __m256i br_v[SPAN];
+        for (int p = 0; p < SPAN; ++p) {
+          const int k = q * SPAN + p;
+          br_v[p] = k < K ? _mm256_maskz_loadu_epi8(
+                                static_cast<__mmask32>(mask_int8_v),
+                                B + k * ldb + col_start)
+                          : _mm256_setzero_si256();
+        }
+        for (int t = 0; t < num_patterns; ++t) {
+          const __m256i r0_v = br_v[pattern_pos[t][0]];
+          const __m256i r1_v = br_v[pattern_pos[t][1]];
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dst + t * PATTERN_BYTES),
+              _mm256_unpacklo_epi8(r0_v, r1_v));
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dst + t * PATTERN_BYTES + 32),
+              _mm256_unpackhi_epi8(r0_v, r1_v));
+        }
+      }
+    }
+
+    for (int i = row_start; i < row_end; ++i) {
+      const uint8_t* row_pattern =
+          nm.pair_patterns.data() + static_cast<size_t>(i) * pairs;
+      const int32_t* values =
+          reinterpret_cast<const int32_t*>(nm.values.data() + i * stride);
+      int32_t* C_row = C_i32 + i * ldc + col_start;
+
+      __m512i c_v[4] = {};
+      if (accum || pt > 0) {
+        for (int idx = 0; idx < COLBLOCKS; ++idx) {
+          c_v[idx] = _mm512_maskz_loadu_epi32(
+              mask_int32_v[idx], C_row + idx * VLEN_INT32);
+        }
+        permuteNMColumns<COLBLOCKS>(c_v);
+      }
+
+      // Buffers of the first pair of the quad
+      const uint8_t* quad_buffer = pair_buffer;
+      for (int q = p_begin; q < p_end; q += 2) {
+        const __m512i a_v = _mm512_set1_epi32(values[q / 2]);
+        const uint8_t* x = quad_buffer + row_pattern[q] * PATTERN_BYTES;
+        const uint8_t* y =
+            quad_buffer + (num_patterns + row_pattern[q + 1]) * PATTERN_BYTES;
+        quad_buffer += 2 * num_patterns * PATTERN_BYTES;
+        // 4 bytes of each column: the 2 rows of B of the 2 pairs
+        __m512i br_v[COLBLOCKS];
+        for (int idx = 0; idx < COLBLOCKS / 2; ++idx) {
+          const __m512i x_v = _mm512_loadu_si512(x + idx * VLEN_INT8);
+          const __m512i y_v = _mm512_loadu_si512(y + idx * VLEN_INT8);
+          br_v[2 * idx] = _mm512_unpacklo_epi16(x_v, y_v);
+          br_v[2 * idx + 1] = _mm512_unpackhi_epi16(x_v, y_v);
+        }
+        for (int idx = 0; idx < COLBLOCKS; ++idx) {
+          __m512i c_i16_v = _mm512_maddubs_epi16(br_v[idx], a_v);
+          __m512i c_i32_v = _mm512_madd_epi16(one_16bit_v, c_i16_v);
+          c_v[idx] = _mm512_add_epi32(c_v[idx], c_i32_v);
+        }
+      }
+
+      permuteNMColumns<COLBLOCKS>(c_v);
+      for (int idx = 0; idx < COLBLOCKS; ++idx) {
+        _mm512_mask_storeu_epi32(
+            C_row + idx * VLEN_INT32, mask_int32_v[idx], c_v[idx]);
+      }
+      if (pt == pTiles - 1) {
+        // Requantize after last tile
+        __m512i res;
+        if (rParams.bias == nullptr) {
+          if (rParams.act_zero_point) {
+            res = requantizeForMM<FUSE_RELU, false, false, Q_GRAN>(
+                c_v, i, rParams);
+          } else {
+            res = requantizeForMM<FUSE_RELU, true, false, Q_GRAN>(
+                c_v, i, rParams);
+          }
+        } else {
+          if (rParams.act_zero_point) {
+            res = requantizeForMM<FUSE_RELU, false, true, Q_GRAN>(
+                c_v, i, rParams);
+          } else {
+            res = requantizeForMM<FUSE_RELU, true, true, Q_GRAN>(
+                c_v, i, rParams);
+          }
+        }
+        _mm512_mask_storeu_epi8(C_u8 + i * ldc + col_start, mask_int8_v, res);
+      }
+    }
+  }
+}
+
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+void SparseDenseInt8NMAvx512(
+    int N,
+    const NMSparseMatrix<int8_t, NNZ, GROUP>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum,
+    int row_start,
+    int row_end) {
+  // Calcualtes accum ? C += A * B : C = A * B
+  // A pair of values of a row of A multiplies 2 rows of B chosen by one of a
+  // few patterns (see nmSparsePairPatterns). For a tile of pairs, the 2 rows
+  // of B of every pattern are interleaved byte by byte once for all rows of
+  // A. A quad of values then needs 2 of these buffers interleaved 16 bits at
+  // a time, half of the work of dense 4x1 BCSR blocks for 2:4 sparsity.
+  constexpr int VLEN_INT8 = 64;
+  constexpr int PAIR_TILE = 128; // pairs per tile, must be even
+  constexpr int MAX_PATTERNS = 16;
+
+  constexpr int buffer_size = PAIR_TILE * MAX_PATTERNS * 2 * VLEN_INT8;
+  static thread_local uint8_t* pair_buffer_ = nullptr;
+
+  if (pair_buffer_ == nullptr) {
+    pair_buffer_ = static_cast<uint8_t*>(fbgemmAlignedAlloc(64, buffer_size));
+  }
+
+  for (int j = 0; j < N; j += VLEN_INT8) {
+    // Only 2 column blocks for the last 32 columns or less
+    if (N - j > VLEN_INT8 / 2) {
+      SparseDenseInt8NMColsAvx512<4, PAIR_TILE, FUSE_RELU, Q_GRAN>(
+          N,
+          nm,
+          B,
+          ldb,
+          C_i32,
+          C_u8,
+          ldc,
+          rParams,
+          accum,
+          row_start,
+          row_end,
+          j,
+          pair_buffer_);
+    } else {
+      SparseDenseInt8NMColsAvx512<2, PAIR_TILE, FUSE_RELU, Q_GRAN>(
+          N,
+          nm,
+          B,
+          ldb,
+          C_i32,
+          C_u8,
+          ldc,
+          rParams,
+          accum,
+          row_start,
+          row_end,
+          j,
+          pair_buffer_);
+    }
+  }
+}
+
+#define CREATE_INSTANCE(FUSE_RELU, QGRAN, NNZ, GROUP)     \
+  template void SparseDenseInt8NMAvx512<FUSE_RELU, QGRAN>( \
+      int N,                                             \
+      const NMSparseMatrix<int8_t, NNZ, GROUP>& nm,      \
+      const uint8_t* B,                                  \
+      int ldb,                                           \
+      int32_t* C_i32,                                    \
+      uint8_t* C_u8,                                     \
+      int ldc,                                           \
+      trRequantizationParams_t& rParams,                 \
+      bool accum,                                        \
+      int row_start,                                     \
+      int row_end);
+#define CREATE_INSTANCE_NM(NNZ, GROUP)                                     \
+  CREATE_INSTANCE(true, QuantizationGranularity::TENSOR, NNZ, GROUP)      \
+  CREATE_INSTANCE(true, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP) \
+  CREATE_INSTANCE(false, QuantizationGranularity::TENSOR, NNZ, GROUP)     \
+  CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP)
+CREATE_INSTANCE_NM(2, 4)
+CREATE_INSTANCE_NM(1, 4)
+#undef CREATE_INSTANCE_NM
+#undef CREATE_INSTANCE
+
 } // namespace internal
 } // namespace fbgemm
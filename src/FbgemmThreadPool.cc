@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace fbgemm {
+
+namespace {
+
+// Depth of the pool tasks running on this thread.
+thread_local int poolTaskDepth = 0;
+
+struct PoolTaskScope {
+  PoolTaskScope() {
+    ++poolTaskDepth;
+  }
+  ~PoolTaskScope() {
+    --poolTaskDepth;
+  }
+};
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// CPUs the process may run on.
+std::vector<int> allowedCpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    const int n = std::max(1u, std::thread::hardware_concurrency());
+    for (int cpu = 0; cpu < n; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+void pinCurrentThread(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  // Best effort: the thread just stays unpinned if this fails.
+  sched_setaffinity(0, sizeof(set), &set);
+#else
+  (void)cpu;
+#endif
+}
+
+bool inOpenMPParallel() {
+#ifdef _OPENMP
+  return omp_in_parallel();
+#else
+  return false;
+#endif
+}
+
+} // namespace
+
+struct FbgemmThreadPool::Impl {
+  int spinIterations{0};
+  std::vector<std::thread> workers;
+
+  // Serializes jobs. Submitters that find it taken run the job themselves.
+  std::mutex submitMutex;
+
+  // The current job, published by bumping generation.
+  const std::function<void(int, int)>* job{nullptr};
+  int jobThreads{0};
+  std::atomic<std::uint64_t> generation{0};
+  // Workers that have not finished with the current generation yet.
+  std::atomic<int> pending{0};
+  bool stop{false};
+
+  // Guards parking, i.e. the condition variables and stop.
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+
+  std::mutex errorMutex;
+  std::exception_ptr error;
+
+  // Held by the owner of a Scratch.
+  std::mutex scratchMutex;
+  std::vector<float> scratch;
+
+  void runTask(int thread_id, int num_threads) {
+    PoolTaskScope scope;
+    try {
+      (*job)(thread_id, num_threads);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  void workerLoop(int thread_id, int cpu) {
+    if (cpu >= 0) {
+      pinCurrentThread(cpu);
+    }
+    std::uint64_t seen = 0;
+    while (true) {
+      std::uint64_t gen = generation.load(std::memory_order_acquire);
+      for (int i = 0; gen == seen && i < spinIterations; ++i) {
+        cpuRelax();
+        gen = generation.load(std::memory_order_acquire);
+      }
+      if (gen == seen) {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [&] {
+          return stop || generation.load(std::memory_order_acquire) != seen;
+        });
+        if (stop) {
+          return;
+        }
+        gen = generation.load(std::memory_order_acquire);
+      }
+      seen = gen;
+
+      // Every worker acknowledges every generation, also the ones not taking
+      // part in a job with fewer threads, so that none of them can read the
+      // job of the next generation while still handling this one.
+      if (thread_id < jobThreads) {
+        runTask(thread_id, jobThreads);
+      }
+      if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.notify_one();
+      }
+    }
+  }
+};
+
+FbgemmThreadPool::FbgemmThreadPool(const ThreadPoolOptions& options)
+    : impl_(new Impl()) {
+  const std::vector<int> cpus = allowedCpus();
+  const int numThreads = options.numThreads > 0
+      ? options.numThreads
+      : static_cast<int>(cpus.size());
+  impl_->spinIterations = std::max(0, options.spinIterations);
+  impl_->workers.reserve(numThreads - 1);
+  for (int thread_id = 1; thread_id < numThreads; ++thread_id) {
+    const int cpu = options.pinThreads ? cpus[thread_id % cpus.size()] : -1;
+    impl_->workers.emplace_back([impl = impl_.get(), thread_id, cpu] {
+      impl->workerLoop(thread_id, cpu);
+    });
+  }
+}
+
+FbgemmThreadPool::~FbgemmThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->stop = true;
+  }
+  impl_->wake.notify_all();
+  for (auto& worker : impl_->workers) {
+    worker.join();
+  }
+}
+
+int FbgemmThreadPool::numThreads() const {
+  return static_cast<int>(impl_->workers.size()) + 1;
+}
+
+void FbgemmThreadPool::run(
+    const std::function<void(int thread_id, int num_threads)>& fn) {
+  run(numThreads(), fn);
+}
+
+void FbgemmThreadPool::run(
+    int num_threads,
+    const std::function<void(int thread_id, int num_threads)>& fn) {
+  num_threads = std::min(num_threads, numThreads());
+
+  std::unique_lock<std::mutex> submitLock(impl_->submitMutex, std::defer_lock);
+  if (num_threads <= 1 || poolTaskDepth > 0 || inOpenMPParallel() ||
+      !submitLock.try_lock()) {
+    PoolTaskScope scope;
+    fn(0, 1);
+    return;
+  }
+
+  impl_->job = &fn;
+  impl_->jobThreads = num_threads;
+  impl_->error = nullptr;
+  impl_->pending.store(
+      static_cast<int>(impl_->workers.size()), std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->generation.fetch_add(1, std::memory_order_release);
+  }
+  impl_->wake.notify_all();
+
+  impl_->runTask(0, num_threads);
+
+  for (int i = 0; impl_->pending.load(std::memory_order_acquire) != 0 &&
+       i < impl_->spinIterations;
+       ++i) {
+    cpuRelax();
+  }
+  if (impl_->pending.load(std::memory_order_acquire) != 0) {
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    impl_->done.wait(lock, [&] {
+      return impl_->pending.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+  impl_->job = nullptr;
+  std::exception_ptr error = impl_->error;
+  impl_->error = nullptr;
+  submitLock.unlock();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void FbgemmThreadPool::parallelFor(
+    std::int64_t total_work,
+    const std::function<void(std::int64_t start, std::int64_t end)>& fn) {
+  const int num_threads = static_cast<int>(std::min<std::int64_t>(
+      numThreads(), std::max<std::int64_t>(total_work, 1)));
+  run(num_threads, [&](int thread_id, int nthreads) {
+    std::int64_t start, end;
+    fbgemmPartition1D(thread_id, nthreads, total_work, start, end);
+    if (start < end) {
+      fn(start, end);
+    }
+  });
+}
+
+FbgemmThreadPool::Scratch::Scratch(FbgemmThreadPool& pool, std::size_t size)
+    : pool_(pool) {
+  std::unique_lock<std::mutex> lock(
+      pool_.impl_->scratchMutex, std::try_to_lock);
+  if (lock.owns_lock()) {
+    // At least one element so that data_ tells whether the lock is held
+    pool_.impl_->scratch.resize(std::max<std::size_t>(size, 1));
+    data_ = pool_.impl_->scratch.data();
+    lock.release();
+  }
+}
+
+FbgemmThreadPool::Scratch::~Scratch() {
+  if (data_ != nullptr) {
+    pool_.impl_->scratchMutex.unlock();
+  }
+}
+
+FbgemmThreadPool& fbgemmGetDefaultThreadPool() {
+  // Never destroyed, so that no task can outlive the pool during exit.
+  static FbgemmThreadPool* pool = [] {
+    ThreadPoolOptions options;
+    const char* env = std::getenv("FBGEMM_NUM_THREADS");
+    if (env != nullptr) {
+      options.numThreads = std::max(0, std::atoi(env));
+    }
+    return new FbgemmThreadPool(options);
+  }();
+  return *pool;
+}
+
+bool fbgemmInThreadPool() {
+  return poolTaskDepth > 0;
+}
+
+namespace internal {
+
+// Declared in Utils.cc, which does not include FbgemmThreadPool.h.
+int defaultThreadPoolSize() {
+  return fbgemmGetDefaultThreadPool().numThreads();
+}
+
+void runOnDefaultThreadPool(
+    int num_threads,
+    const std::function<void(int thread_id, int num_threads)>& fn) {
+  fbgemmGetDefaultThreadPool().run(num_threads, fn);
+}
+
+} // namespace internal
+
+} // namespace fbgemm
@@ -38,7 +38,7 @@ CodeCache<
     std::
         tuple<int, int, int, int, int, bool, int, int, int, int, int, int, int>,
     GenI8Depthwise::jit_kernel_signature>
-    codeCache_;
+    codeCache_(codeCacheName<GenI8Depthwise>());
 } // namespace
 
 namespace x86 = asmjit::x86;
@@ -558,11 +558,7 @@ GenI8Depthwise::jit_kernel_signature GenI8Depthwise::getOrCreate(
     e->emitEpilog(frame);
 
     jit_kernel_signature fn;
-    asmjit::Error err;
-    {
-      std::unique_lock<std::mutex> lock(rtMutex_);
-      err = runtime().add(&fn, &code);
-    }
+    asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
     if (err) {
       std::cout << "Error: in fn add" << std::endl;
       return nullptr;
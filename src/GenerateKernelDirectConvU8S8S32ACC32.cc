@@ -403,11 +403,7 @@ DirectConvCodeGenBase<uint8_t, int8_t, int32_t, int32_t>::getOrCreateDirectConv(
     a->emitEpilog(frame);
 
     jit_micro_kernel_fp fn;
-    asmjit::Error err;
-    {
-      std::unique_lock<std::mutex> lock(rtMutex_);
-      err = runtime().add(&fn, &code);
-    }
+    asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
     if (err) {
       std::cout << "Error: in fn add" << std::endl;
       return nullptr;
@@ -773,11 +769,7 @@ DirectConvCodeGenBase<uint8_t, int8_t, int32_t, int32_t>::
     a->emitEpilog(frame);
 
     jit_micro_kernel_fp_convT fn;
-    asmjit::Error err;
-    {
-      std::unique_lock<std::mutex> lock(rtMutex_);
-      err = runtime().add(&fn, &code);
-    }
+    asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
     if (err) {
       std::cout << "Error: in fn add" << std::endl;
       return nullptr;
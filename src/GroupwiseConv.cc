@@ -301,11 +301,8 @@ jit_conv_kernel_fp GenConvKernel<SPATIAL_DIM, INST_SET>::getOrCreate() {
   a->emitEpilog(frame_);
 
   jit_conv_kernel_fp fn;
-  asmjit::Error err;
-  {
-    unique_lock<mutex> lock(this->rtMutex_);
-    err = this->runtime().add(&fn, &code);
-  }
+  asmjit::Error err =
+      addToJitRuntime(this->runtime(), this->rtMutex_, &fn, &code);
 
   if (err) {
     cout << "Error: in fn add" << endl;
@@ -327,6 +327,7 @@ std::mutex GenConvKernelBase<SPATIAL_DIM, INST_SET>::rtMutex_;
 
 template <int SPATIAL_DIM, inst_set_t INST_SET>
 CodeCache<kernel_sig_t, jit_conv_kernel_fp>
-    GenConvKernelBase<SPATIAL_DIM, INST_SET>::codeCache_;
+    GenConvKernelBase<SPATIAL_DIM, INST_SET>::codeCache_(
+        codeCacheName<GenConvKernelBase<SPATIAL_DIM, INST_SET>>());
 
 } // namespace fbgemm
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include <cpuinfo.h>
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include "fbgemm/Fbgemm.h"
+#include "fbgemm/QuantUtils.h"
+#include "fbgemm/QuantUtilsAvx2.h"
+
+namespace fbgemm {
+
+template <typename T, typename accT>
+PackAWithRowwiseQuantRowOffset<T, accT>::PackAWithRowwiseQuantRowOffset(
+    matrix_op_t trans,
+    int32_t nRow,
+    int32_t nCol,
+    const float* smat,
+    int32_t ld,
+    inpType* pmat,
+    int groups,
+    int32_t* row_offset,
+    float* row_scale,
+    int32_t* row_zero_point,
+    const BlockingFactors* params)
+    : PackMatrix<PackAWithRowwiseQuantRowOffset<T, accT>, T, accT>(
+          nRow,
+          nCol,
+          pmat,
+          groups,
+          params),
+      trans_(trans),
+      smat_(smat),
+      ld_(ld),
+      row_offset_(row_offset),
+      row_scale_(row_scale),
+      row_zero_point_(row_zero_point) {
+  if (!cpuinfo_initialize()) {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+  if ((!fbgemmHasAvx512VnniSupport() && !fbgemmHasAvx512Support() &&
+       !fbgemmHasAvx2Support())) {
+    assert(0 && "unknown architecure");
+  }
+
+  if (params) {
+    BaseType::brow_ = params->MCB;
+    BaseType::bcol_ = params->KCB;
+    row_interleave_B_ = params->ROW_INTERLEAVE;
+  } else {
+    const inst_set_t isa = fbgemmInstructionSet();
+    switch (isa) {
+      case inst_set_t::avx512_vnni:
+        std::tie(BaseType::brow_, BaseType::bcol_, row_interleave_B_) =
+            PackingTraits<T, accT, inst_set_t::avx512_vnni>::
+                getMatrixPackAParams();
+        break;
+
+      case inst_set_t::avx512_vnni_ymm:
+        std::tie(BaseType::brow_, BaseType::bcol_, row_interleave_B_) =
+            PackingTraits<T, accT, inst_set_t::avx512_vnni_ymm>::
+                getMatrixPackAParams();
+        break;
+
+      case inst_set_t::avx512:
+        std::tie(BaseType::brow_, BaseType::bcol_, row_interleave_B_) =
+            PackingTraits<T, accT, inst_set_t::avx512>::getMatrixPackAParams();
+        break;
+
+      case inst_set_t::avx512_ymm:
+        std::tie(BaseType::brow_, BaseType::bcol_, row_interleave_B_) =
+            PackingTraits<T, accT, inst_set_t::avx512_ymm>::
+                getMatrixPackAParams();
+        break;
+
+      case inst_set_t::avx2:
+        std::tie(BaseType::brow_, BaseType::bcol_, row_interleave_B_) =
+            PackingTraits<T, accT, inst_set_t::avx2>::getMatrixPackAParams();
+        break;
+
+      default:
+        assert(0 && "unknown architecure");
+        throw std::runtime_error("unknown architecure");
+    }
+  }
+
+  if (BaseType::numCols() % groups != 0) {
+    throw std::runtime_error(
+        "groups = " + std::to_string(groups) +
+        " does not divide numCols = " + std::to_string(BaseType::numCols()));
+  }
+  if (pmat) {
+    BaseType::buf_ = pmat;
+  } else {
+    BaseType::bufAllocatedHere_ = true;
+    BaseType::buf_ = static_cast<T*>(
+        fbgemmAlignedAlloc(64, BaseType::brow_ * BaseType::bcol_ * sizeof(T)));
+  }
+  if (!row_offset_) {
+    rowOffsetAllocatedHere = true;
+    row_offset_ = static_cast<int32_t*>(
+        fbgemmAlignedAlloc(64, BaseType::brow_ * sizeof(accT)));
+  }
+  if (!row_scale_) {
+    rowScaleAllocatedHere = true;
+    row_scale_ = static_cast<float*>(
+        fbgemmAlignedAlloc(64, BaseType::brow_ * sizeof(float)));
+  }
+  if (!row_zero_point_) {
+    rowZeroPointAllocatedHere = true;
+    row_zero_point_ = static_cast<int32_t*>(
+        fbgemmAlignedAlloc(64, BaseType::brow_ * sizeof(int32_t)));
+  }
+  if (groups > 1) {
+    rowQParams_.resize(BaseType::numRows());
+    rowQParamsReady_.resize(BaseType::numRows(), false);
+  }
+}
+
+template <typename T, typename accT>
+TensorQuantizationParams
+PackAWithRowwiseQuantRowOffset<T, accT>::rowQuantParams(int32_t row) const {
+  float min_val, max_val;
+  if (trans_ == matrix_op_t::Transpose) {
+    const float* col = smat_ + row;
+    min_val = max_val = col[0];
+    for (int j = 1; j < BaseType::numCols(); ++j) {
+      min_val = std::min(min_val, col[j * ld_]);
+      max_val = std::max(max_val, col[j * ld_]);
+    }
+  } else {
+    FindMinMax(smat_ + row * ld_, &min_val, &max_val, BaseType::numCols());
+  }
+  return ChooseQuantizationParams(min_val, max_val, 0, 255);
+}
+
+template <typename T, typename accT>
+void PackAWithRowwiseQuantRowOffset<T, accT>::pack(const block_type_t& block) {
+  assert(block.row_size <= BaseType::blockRowSize());
+  assert(block.col_size <= BaseType::blockColSize());
+
+  block_type_t block_p = {
+      block.row_start,
+      block.row_size,
+      block.col_start,
+      (block.col_size + row_interleave_B_ - 1) / row_interleave_B_ *
+          row_interleave_B_};
+  assert(block_p.col_size <= BaseType::blockColSize());
+  BaseType::packedBlock(block_p);
+
+  T* out = BaseType::getBuf();
+  bool tr = (trans_ == matrix_op_t::Transpose);
+  // The first column block of a group starts the row offsets. It also sets
+  // the quantization parameters of the rows, which span all groups, so they
+  // don't depend on which groups a thread packs. Groups after the first one
+  // packing a row reuse its parameters.
+  bool row_offset_acc =
+      (block.col_start % (this->numCols() / this->numGroups())) != 0;
+  int32_t* row_offset_buf = getRowOffsetBuffer();
+
+  float* smat_transposed = nullptr;
+  if (tr) {
+    smat_transposed = static_cast<float*>(fbgemmAlignedAlloc(
+        64, block.row_size * block.col_size * sizeof(float)));
+    transpose_simd(
+        block.col_size,
+        block.row_size,
+        smat_ + block.col_start * ld_ + block.row_start,
+        ld_,
+        smat_transposed,
+        block.col_size);
+  }
+  const float* smat_temp =
+      tr ? smat_transposed : smat_ + block.row_start * ld_ + block.col_start;
+  int32_t ld_temp = tr ? block.col_size : ld_;
+
+  static_assert(
+      std::is_same<T, uint8_t>::value,
+      "PackAWithRowwiseQuantRowOffset<T, accT>::pack only works for "
+      "T == uint8_t");
+
+  for (int i = 0; i < block.row_size; ++i) {
+    if (!row_offset_acc) {
+      const int32_t row = block.row_start + i;
+      TensorQuantizationParams row_qparams;
+      if (rowQParams_.empty()) {
+        row_qparams = rowQuantParams(row);
+      } else {
+        if (!rowQParamsReady_[row]) {
+          rowQParams_[row] = rowQuantParams(row);
+          rowQParamsReady_[row] = true;
+        }
+        row_qparams = rowQParams_[row];
+      }
+      row_scale_[i] = row_qparams.scale;
+      row_zero_point_[i] = row_qparams.zero_point;
+    }
+
+    // Only scale and zero points are used in QuantizeAndReduceAvx2
+    TensorQuantizationParams qparams;
+    qparams.scale = row_scale_[i];
+    qparams.zero_point = row_zero_point_[i];
+
+    int32_t row_sum = row_offset_acc ? row_offset_buf[i] : 0;
+    row_sum += QuantizeAndReduceAvx2(
+        smat_temp + i * ld_temp,
+        out + i * BaseType::blockColSize(),
+        block.col_size,
+        qparams);
+    row_offset_buf[i] = row_sum;
+
+    // zero fill
+    // Please see the comment in PackAMatrix.cc on zero vs zero_pt fill.
+    for (int j = block.col_size; j < block_p.col_size; ++j) {
+      out[i * BaseType::blockColSize() + j] = 0;
+    }
+  }
+  if (smat_transposed) {
+    fbgemmAlignedFree(smat_transposed);
+  }
+}
+
+template <typename T, typename accT>
+int32_t PackAWithRowwiseQuantRowOffset<T, accT>::addr(int32_t r, int32_t c)
+    const {
+  int32_t block_row_id = r / BaseType::blockRowSize();
+  int32_t brow_offset = (block_row_id * BaseType::blockCols()) *
+      (BaseType::blockRowSize() * BaseType::blockColSize());
+
+  int32_t block_col_id = c / BaseType::blockColSize();
+  int32_t bcol_offset =
+      block_col_id * BaseType::blockRowSize() * BaseType::blockColSize();
+  int32_t block_offset = brow_offset + bcol_offset;
+  int32_t inblock_offset =
+      (r % BaseType::blockRowSize()) * BaseType::blockColSize() +
+      (c % BaseType::blockColSize());
+
+  int32_t index = block_offset + inblock_offset;
+
+  return index;
+}
+
+template <typename T, typename accT>
+void PackAWithRowwiseQuantRowOffset<T, accT>::printPackedMatrix(
+    std::string name) {
+  std::cout << name << ":" << "[" << BaseType::numPackedRows() << ", "
+            << BaseType::numPackedCols() << "]" << std::endl;
+
+  T* out = BaseType::getBuf();
+  for (auto r = 0; r < BaseType::numPackedRows(); ++r) {
+    for (auto c = 0; c < BaseType::numPackedCols(); ++c) {
+      T val = out[addr(r, c)];
+      // cast to int64 because cout doesn't print int8_t type directly
+      std::cout << std::setw(5) << static_cast<int64_t>(val) << " ";
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+template <typename T, typename accT>
+int PackAWithRowwiseQuantRowOffset<T, accT>::rowOffsetBufferSize(
+    const BlockingFactors* params) {
+  if (cpuinfo_initialize()) {
+    if (params) {
+      return params->MCB;
+    } else {
+      if (fbgemmHasAvx512VnniSupport()) {
+        return PackingTraits<T, accT, inst_set_t::avx512_vnni>::MCB;
+      } else if (fbgemmHasAvx512Support()) {
+        return PackingTraits<T, accT, inst_set_t::avx512>::MCB;
+      } else if (fbgemmHasAvx2Support()) {
+        return PackingTraits<T, accT, inst_set_t::avx2>::MCB;
+      } else {
+        assert(0 && "unsupported architecture");
+        return -1;
+      }
+    }
+  } else {
+    throw std::runtime_error("Failed to initialize cpuinfo!");
+  }
+}
+
+template class PackAWithRowwiseQuantRowOffset<uint8_t, int32_t>;
+
+} // namespace fbgemm
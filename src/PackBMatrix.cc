@@ -11,6 +11,7 @@
 #include <cassert>
 #include <iomanip>
 #include <iostream>
+#include "./TunedBlockingFactors.h"
 #include "fbgemm/Fbgemm.h"
 
 /*
@@ -191,6 +192,13 @@ PackBMatrix<T, accT>::PackBMatrix(
   if (!cpuinfo_initialize()) {
     throw std::runtime_error("Failed to initialize cpuinfo!");
   }
+  if (!params && groups > 0 && nRow % groups == 0 &&
+      fbgemmGetTunedPackBParams<accT>(
+          nCol, nRow / groups, &this->tunedParams_)) {
+    BaseType::hasTunedParams_ = true;
+    params = &this->tunedParams_;
+    BaseType::blocking_params = params;
+  }
   if (params) {
     BaseType::brow_ = params->KCB;
     BaseType::bcol_ = params->NCB;
@@ -244,7 +252,7 @@ PackBMatrix<T, accT>::PackBMatrix(
   BaseType::packedBlock(block);
   if (!pmat) {
     BaseType::bufAllocatedHere_ = true;
-    BaseType::buf_ = static_cast<T*>(fbgemmAlignedAlloc(
+    BaseType::buf_ = static_cast<T*>(fbgemmPackedWeightAlloc(
         64,
         BaseType::numGroups() * BaseType::blockRows() * BaseType::brow_ *
             BaseType::blockCols() * BaseType::bcol_ * sizeof(T)));
@@ -252,6 +260,40 @@ PackBMatrix<T, accT>::PackBMatrix(
   pack(block, params);
 }
 
+template <typename T, typename accT>
+PackBMatrix<T, accT>::PackBMatrix(
+    matrix_op_t trans,
+    int32_t nRow,
+    int32_t nCol,
+    T* pmat,
+    int groups,
+    const BlockingFactors* params,
+    int32_t brow,
+    int32_t bcol,
+    int32_t row_interleave)
+    : PackMatrix<PackBMatrix<T, accT>, T, accT>(
+          nRow,
+          nCol,
+          pmat,
+          groups,
+          params),
+      trans_(trans),
+      smat_(nullptr),
+      row_interleave_(row_interleave) {
+  BaseType::brow_ = brow;
+  BaseType::bcol_ = bcol;
+  if (groups <= 0 || BaseType::numRows() % groups != 0) {
+    throw std::runtime_error(
+        "groups = " + std::to_string(groups) +
+        " does not divide numRows = " + std::to_string(BaseType::numRows()));
+  }
+  // unpack() writes a dense matrix
+  ld_ = trans == matrix_op_t::Transpose ? nRow / groups : nCol;
+  block_type_t block{
+      0, BaseType::numRows() / BaseType::numGroups(), 0, BaseType::numCols()};
+  BaseType::packedBlock(block);
+}
+
 template <typename T, typename accT>
 void PackBMatrix<T, accT>::pack_unpack_(
     const block_type_t& block,
@@ -276,6 +318,9 @@ void PackBMatrix<T, accT>::pack_unpack_(
   const auto blockColSize = block.col_size;
 
   BaseType::packedBlock(block);
+  if (!params) {
+    params = BaseType::tunedBlockingFactors();
+  }
   bool tr = (trans_ == matrix_op_t::Transpose);
   for (int g = 0; g < BaseType::numGroups(); ++g) {
     T* pack_buf_cur = pack_buf +
@@ -394,6 +439,9 @@ void PackBMatrix<T, accT>::printPackedMatrix(
             << BaseType::numPackedCols() << "]" << std::endl;
   std::cout << "block size:" << "[" << BaseType::blockRowSize() << ", "
             << BaseType::blockColSize() << "]" << std::endl;
+  if (!params) {
+    params = BaseType::tunedBlockingFactors();
+  }
 
   for (int g = 0; g < BaseType::numGroups(); ++g) {
     T* out = BaseType::getBuf() +
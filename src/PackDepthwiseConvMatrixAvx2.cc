@@ -36,7 +36,7 @@ PackedDepthWiseConvMatrix::PackedDepthWiseConvMatrix(
 
   // Allocate packed arrays
   int kernel_prod_aligned = (kernel_prod + 1) / 2 * 2;
-  pmat_ = static_cast<int8_t*>(fbgemmAlignedAlloc(
+  pmat_ = static_cast<int8_t*>(fbgemmPackedWeightAlloc(
       64, ((OC + 31) / 32) * kernel_prod_aligned * 32 * sizeof(int8_t)));
 
   // Pack input matrix
@@ -196,8 +196,20 @@ void PackedDepthWiseConvMatrix::unpack(int8_t* unpacked_data) {
   }
 }
 
+PackedDepthWiseConvMatrix::PackedDepthWiseConvMatrix(
+    int OC,
+    int kernel_prod,
+    int8_t* pmat,
+    bool bufAllocatedHere)
+    : OC_(OC),
+      kernel_prod_(kernel_prod),
+      pmat_(pmat),
+      bufAllocatedHere_(bufAllocatedHere) {}
+
 PackedDepthWiseConvMatrix::~PackedDepthWiseConvMatrix() {
-  fbgemmAlignedFree(pmat_);
+  if (bufAllocatedHere_) {
+    fbgemmAlignedFree(pmat_);
+  }
 }
 
 } // namespace fbgemm
@@ -123,6 +123,11 @@ template class PackMatrix<
     uint8_t,
     int32_t>;
 
+template class PackMatrix<
+    PackAWithRowwiseQuantRowOffset<uint8_t, int32_t>,
+    uint8_t,
+    int32_t>;
+
 template class PackMatrix<PackBMatrix<int8_t, int32_t>, int8_t, int32_t>;
 
 // int16 accumulation
@@ -37,7 +37,7 @@ PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>::PackWeightMatrixForGConv(
         conv_param.K.begin(), conv_param.K.end(), 1, std::multiplies<int>());
     // we make it a multiple of 4
     int paddedICPerG = ((conv_param_.IC / conv_param_.G) + 3) / 4 * 4;
-    pdata_ = static_cast<T*>(fbgemmAlignedAlloc(
+    pdata_ = static_cast<T*>(fbgemmPackedWeightAlloc(
         64,
         (conv_param_.G + GTogether_ - 1) / GTogether_ * GTogether_ *
             kernel_prod * (conv_param_.OC / conv_param_.G) * paddedICPerG *
@@ -50,6 +50,18 @@ PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>::PackWeightMatrixForGConv(
   pack();
 }
 
+template <typename T, typename accT, int SPATIAL_DIM>
+PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>::PackWeightMatrixForGConv(
+    matrix_op_t trans,
+    const conv_param_t<SPATIAL_DIM>& conv_param,
+    T* pdata,
+    int GTogether)
+    : trans_(trans),
+      conv_param_(conv_param),
+      sdata_(nullptr),
+      pdata_(pdata),
+      GTogether_(GTogether) {}
+
 template <typename T, typename accT, int SPATIAL_DIM>
 int PackWeightMatrixForGConv<T, accT, SPATIAL_DIM>::numOfGroupsTogether(
     const conv_param_t<SPATIAL_DIM>& conv_param) {
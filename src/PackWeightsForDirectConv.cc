@@ -37,7 +37,7 @@ PackedDirectConvMatrix::PackedDirectConvMatrix(
     const int8_t* smat) {
   // Allocate packed arrays
   int kernel_prod_aligned = (filter_prod + 1) / 2 * 2;
-  pmat_ = static_cast<int8_t*>(fbgemmAlignedAlloc(
+  pmat_ = static_cast<int8_t*>(fbgemmPackedWeightAlloc(
       64,
       ((OC_per_G + 31) / 32 * 32) * kernel_prod_aligned * IC_per_G *
           sizeof(int8_t)));
@@ -67,7 +67,9 @@ PackedDirectConvMatrix::PackedDirectConvMatrix(
 }
 
 PackedDirectConvMatrix::~PackedDirectConvMatrix() {
-  fbgemmAlignedFree(pmat_);
+  if (bufAllocatedHere_) {
+    fbgemmAlignedFree(pmat_);
+  }
 }
 
 template <int kSpatialDim>
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "./PersistentCodeCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "./CodeCacheRegistry.h"
+#include "fbgemm/FbgemmKernelCache.h"
+#include "fbgemm/Utils.h"
+
+// Kernels are only reused by the exact build that generated them, since the
+// generators may emit different code for the same key across versions. The
+// build system passes the build hash, see CMakeLists.txt.
+#ifndef FBGEMM_KERNEL_CACHE_BUILD_ID
+#error "FBGEMM_KERNEL_CACHE_BUILD_ID must be defined by the build"
+#endif
+
+namespace fbgemm {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'B', 'G', 'E', 'M', 'M', 'K', 'C'};
+constexpr std::uint32_t kFormatVersion = 1;
+
+std::string entryKey(const std::string& cacheName, const std::string& key) {
+  return cacheName + '\n' + key;
+}
+
+template <typename T>
+bool readPod(const char*& cur, const char* end, T& val) {
+  if (static_cast<std::size_t>(end - cur) < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&val, cur, sizeof(T));
+  cur += sizeof(T);
+  return true;
+}
+
+template <typename T>
+void writePod(std::ostream& os, T val) {
+  os.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+} // namespace
+
+/**
+ * Read-only view of a cache file. mmap'd where available so that only the
+ * kernels actually used are paged in.
+ */
+struct PersistentCodeCache::MappedFile {
+  const char* data{nullptr};
+  std::size_t size{0};
+
+  ~MappedFile() {
+#ifndef _WIN32
+    if (data != nullptr && size > 0) {
+      munmap(const_cast<char*>(data), size);
+    }
+#endif
+  }
+
+  bool open(const std::string& path) {
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      return false;
+    }
+    buffer_.assign(
+        std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data = buffer_.data();
+    size = buffer_.size();
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      close(fd);
+      return false;
+    }
+    void* addr =
+        mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, /*offset=*/0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    data = static_cast<const char*>(addr);
+    size = st.st_size;
+    return true;
+#endif
+  }
+
+#ifdef _WIN32
+ private:
+  std::string buffer_;
+#endif
+};
+
+PersistentCodeCache& PersistentCodeCache::instance() {
+  static PersistentCodeCache store;
+  return store;
+}
+
+PersistentCodeCache::PersistentCodeCache() {
+  const char* env = std::getenv("FBGEMM_KERNEL_CACHE_PATH");
+  if (env != nullptr && env[0] != '\0') {
+    envPath_ = env;
+    load(envPath_);
+  }
+}
+
+PersistentCodeCache::~PersistentCodeCache() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!envPath_.empty() && dirty_) {
+    saveLocked(envPath_);
+  }
+}
+
+std::string PersistentCodeCache::fileTag() {
+  std::ostringstream oss;
+  oss << FBGEMM_KERNEL_CACHE_BUILD_ID << ";ptr" << sizeof(void*) << ";isa"
+      << static_cast<int>(fbgemmInstructionSet());
+  return oss.str();
+}
+
+void* PersistentCodeCache::find(
+    const std::string& cacheName,
+    const std::string& key) {
+  const std::string fullKey = entryKey(cacheName, key);
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto installed = installed_.find(fullKey);
+  if (installed != installed_.end()) {
+    return installed->second;
+  }
+  auto it = entries_.find(fullKey);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+
+  asmjit::CodeHolder code;
+  code.init(runtime_.environment());
+  asmjit::x86::Assembler assembler(&code);
+  void* fn = nullptr;
+  if (assembler.embed(it->second.first, it->second.second) ||
+      runtime_.add(&fn, &code)) {
+    return nullptr;
+  }
+  CodeCacheRegistry::instance().addRuntime(&runtime_);
+  installed_[fullKey] = fn;
+  return fn;
+}
+
+void PersistentCodeCache::record(
+    const std::string& cacheName,
+    const std::string& key,
+    std::string code) {
+  const std::string fullKey = entryKey(cacheName, key);
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (entries_.count(fullKey)) {
+    return;
+  }
+  generated_.push_back(std::move(code));
+  entries_[fullKey] = {generated_.back().data(), generated_.back().size()};
+  dirty_ = true;
+}
+
+std::int64_t PersistentCodeCache::load(const std::string& path) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  enabled_.store(true, std::memory_order_release);
+  return loadLocked(path);
+}
+
+std::int64_t PersistentCodeCache::loadLocked(const std::string& path) {
+  auto file = std::make_unique<MappedFile>();
+  if (!file->open(path)) {
+    return 0;
+  }
+
+  const char* cur = file->data;
+  const char* end = file->data + file->size;
+  std::uint32_t version = 0;
+  std::uint32_t tagLen = 0;
+  if (file->size < sizeof(kMagic) ||
+      std::memcmp(cur, kMagic, sizeof(kMagic)) != 0) {
+    return -1;
+  }
+  cur += sizeof(kMagic);
+  if (!readPod(cur, end, version) || !readPod(cur, end, tagLen) ||
+      static_cast<std::size_t>(end - cur) < tagLen) {
+    return -1;
+  }
+  // Written by another build or for another ISA: fall back to JIT.
+  if (version != kFormatVersion || std::string(cur, tagLen) != fileTag()) {
+    return 0;
+  }
+  cur += tagLen;
+
+  std::uint64_t numEntries = 0;
+  if (!readPod(cur, end, numEntries)) {
+    return -1;
+  }
+  std::vector<std::pair<std::string, std::pair<const char*, std::size_t>>>
+      parsed;
+  for (std::uint64_t i = 0; i < numEntries; ++i) {
+    std::uint32_t keyLen = 0;
+    std::uint64_t codeLen = 0;
+    if (!readPod(cur, end, keyLen) ||
+        static_cast<std::size_t>(end - cur) < keyLen) {
+      return -1;
+    }
+    std::string key(cur, keyLen);
+    cur += keyLen;
+    if (!readPod(cur, end, codeLen) ||
+        static_cast<std::uint64_t>(end - cur) < codeLen) {
+      return -1;
+    }
+    parsed.emplace_back(
+        std::move(key), std::make_pair(cur, static_cast<std::size_t>(codeLen)));
+    cur += codeLen;
+  }
+
+  std::int64_t loaded = 0;
+  for (auto& entry : parsed) {
+    if (entries_.emplace(std::move(entry.first), entry.second).second) {
+      ++loaded;
+    }
+  }
+  files_.push_back(std::move(file));
+  return loaded;
+}
+
+bool PersistentCodeCache::save(const std::string& path) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return saveLocked(path);
+}
+
+bool PersistentCodeCache::saveLocked(const std::string& path) {
+#ifdef _WIN32
+  const std::string tmpPath = path + ".tmp" + std::to_string(_getpid());
+#else
+  const std::string tmpPath = path + ".tmp" + std::to_string(getpid());
+#endif
+  {
+    std::ofstream os(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!os) {
+      return false;
+    }
+    const std::string tag = fileTag();
+    os.write(kMagic, sizeof(kMagic));
+    writePod<std::uint32_t>(os, kFormatVersion);
+    writePod<std::uint32_t>(os, tag.size());
+    os.write(tag.data(), tag.size());
+    writePod<std::uint64_t>(os, entries_.size());
+    for (const auto& entry : entries_) {
+      writePod<std::uint32_t>(os, entry.first.size());
+      os.write(entry.first.data(), entry.first.size());
+      writePod<std::uint64_t>(os, entry.second.second);
+      os.write(entry.second.first, entry.second.second);
+    }
+    if (!os) {
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+#ifdef _WIN32
+  // rename does not replace an existing file on Windows.
+  std::remove(path.c_str());
+#endif
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  dirty_ = false;
+  return true;
+}
+
+bool PersistentCodeCache::saveManifest(const std::string& path) {
+  std::ofstream os(path, std::ios::trunc);
+  if (!os) {
+    return false;
+  }
+  for (const auto& cache : CodeCacheRegistry::instance().caches()) {
+    for (const auto& key : cache.second->serializedKeys()) {
+      os << cache.first << '\t' << key << '\n';
+    }
+  }
+  return static_cast<bool>(os);
+}
+
+std::int64_t PersistentCodeCache::prewarm(const std::string& manifestPath) {
+  std::ifstream in(manifestPath);
+  if (!in) {
+    return -1;
+  }
+  const auto registered = CodeCacheRegistry::instance().caches();
+  const std::map<std::string, RegisteredCodeCache*> caches(
+      registered.begin(), registered.end());
+  std::int64_t warmed = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::size_t sep = line.find('\t');
+    if (sep == std::string::npos) {
+      continue;
+    }
+    auto it = caches.find(line.substr(0, sep));
+    if (it != caches.end()) {
+      warmed += it->second->prewarm(line.substr(sep + 1));
+    }
+  }
+  return warmed;
+}
+
+std::int64_t fbgemmLoadKernelCache(const std::string& path) {
+  return PersistentCodeCache::instance().load(path);
+}
+
+bool fbgemmSaveKernelCache(const std::string& path) {
+  return PersistentCodeCache::instance().save(path);
+}
+
+bool fbgemmSaveKernelManifest(const std::string& path) {
+  return PersistentCodeCache::instance().saveManifest(path);
+}
+
+std::int64_t fbgemmPrewarmKernelCache(const std::string& manifestPath) {
+  return PersistentCodeCache::instance().prewarm(manifestPath);
+}
+
+} // namespace fbgemm
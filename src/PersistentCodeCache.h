@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <asmjit/asmjit.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "./CodeCacheRegistry.h"
+
+namespace fbgemm {
+
+/**
+ * @brief Text encoding of code cache keys. Only tuples of integral and enum
+ * values are persistable; keys holding pointers are process specific.
+ */
+template <typename KEY>
+struct CodeCacheKeyCodec {
+  static constexpr bool persistable = false;
+
+  static std::string describe(const KEY&) {
+    return "?";
+  }
+};
+
+template <typename... Ts>
+struct CodeCacheKeyCodec<std::tuple<Ts...>> {
+  static constexpr bool persistable =
+      ((std::is_integral<Ts>::value || std::is_enum<Ts>::value) && ...);
+
+  /**
+   * @brief Human readable form of any key, pointers included.
+   */
+  static std::string describe(const std::tuple<Ts...>& key) {
+    std::ostringstream oss;
+    bool first = true;
+    std::apply(
+        [&](const Ts&... v) {
+          ((oss << (first ? "" : ","), first = false, describeField(oss, v)),
+           ...);
+        },
+        key);
+    return oss.str();
+  }
+
+  static std::string serialize(const std::tuple<Ts...>& key) {
+    std::string out;
+    std::apply(
+        [&out](const Ts&... v) {
+          ((out += (out.empty() ? "" : ","),
+            out += std::to_string(static_cast<long long>(v))),
+           ...);
+        },
+        key);
+    return out;
+  }
+
+  static bool deserialize(const std::string& str, std::tuple<Ts...>& key) {
+    std::size_t pos = 0;
+    bool ok = true;
+    std::apply(
+        [&](Ts&... v) { ((ok = ok && parseField(str, pos, v)), ...); }, key);
+    return ok && pos == str.size() + 1;
+  }
+
+ private:
+  template <typename T>
+  static void describeField(std::ostream& os, const T& v) {
+    if constexpr (std::is_pointer<T>::value) {
+      os << static_cast<const void*>(v);
+    } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+      os << static_cast<long long>(v);
+    } else {
+      os << '?';
+    }
+  }
+
+  template <typename T>
+  static bool parseField(const std::string& str, std::size_t& pos, T& v) {
+    if (pos > str.size()) {
+      return false;
+    }
+    std::size_t end = str.find(',', pos);
+    if (end == std::string::npos) {
+      end = str.size();
+    }
+    const std::string field = str.substr(pos, end - pos);
+    char* fieldEnd = nullptr;
+    long long val = std::strtoll(field.c_str(), &fieldEnd, 10);
+    if (field.empty() || *fieldEnd != '\0') {
+      return false;
+    }
+    v = static_cast<T>(val);
+    pos = end + 1;
+    return true;
+  }
+};
+
+/**
+ * @brief Name under which a code cache is persisted, unique per owner class
+ * (kernel generator instantiation) and member.
+ */
+template <typename OWNER>
+std::string codeCacheName(const char* member = "codeCache_") {
+  return std::string(typeid(OWNER).name()) + "::" + member;
+}
+
+/**
+ * @brief Collects where the kernel JIT'd on the current thread while it is
+ * alive was placed and, if requested, its machine code. CodeCache opens one
+ * around the generator function on a miss so that the kernel can be released
+ * on eviction and persisted.
+ */
+class JitCodeCapture {
+ public:
+  JitCodeCapture() : prev_(current()) {
+    current() = this;
+  }
+  ~JitCodeCapture() {
+    current() = prev_;
+  }
+  JitCodeCapture(const JitCodeCapture&) = delete;
+  JitCodeCapture& operator=(const JitCodeCapture&) = delete;
+
+  static JitCodeCapture*& current() {
+    static thread_local JitCodeCapture* capture = nullptr;
+    return capture;
+  }
+
+  asmjit::JitRuntime* runtime = nullptr; ///< runtime holding the kernel
+  std::mutex* runtimeMutex = nullptr; ///< guards runtime
+  std::size_t codeSize = 0; ///< size of the kernel's machine code
+  bool copyCode = false; ///< whether to copy the kernel's machine code
+  std::string code; ///< copy of the kernel's machine code
+  bool captured = false; ///< true if code holds a relocatable kernel
+
+ private:
+  JitCodeCapture* prev_;
+};
+
+/**
+ * @brief Add the generated code to the JIT runtime under the runtime's mutex
+ * and report the result to the active JitCodeCapture, if any. Code that
+ * references absolute addresses can't be relocated and is never copied.
+ */
+template <typename FN>
+asmjit::Error addToJitRuntime(
+    asmjit::JitRuntime& rt,
+    std::mutex& rtMutex,
+    FN* fn,
+    asmjit::CodeHolder* code) {
+  asmjit::Error err;
+  {
+    std::unique_lock<std::mutex> lock(rtMutex);
+    err = rt.add(fn, code);
+  }
+  JitCodeCapture* capture = JitCodeCapture::current();
+  if (err || capture == nullptr) {
+    return err;
+  }
+  CodeCacheRegistry::instance().addRuntime(&rt);
+  capture->runtime = &rt;
+  capture->runtimeMutex = &rtMutex;
+  capture->codeSize = code->codeSize();
+  if (capture->copyCode && code->relocEntries().empty() &&
+      !code->hasAddressTable()) {
+    capture->code.assign(
+        reinterpret_cast<const char*>(*fn), code->codeSize());
+    capture->captured = true;
+  }
+  return err;
+}
+
+/**
+ * @brief Process wide store of persisted JIT kernels, see
+ * fbgemm/FbgemmKernelCache.h for the user facing API.
+ *
+ * Cache files are mapped read-only; kernels are copied into executable
+ * memory owned by the store the first time they are requested. Entries are
+ * keyed by "<code cache name>\n<serialized key>".
+ */
+class PersistentCodeCache {
+ public:
+  static PersistentCodeCache& instance();
+
+  /**
+   * @brief Whether kernels are looked up in and recorded to the store. Cheap,
+   * called on every code cache miss.
+   */
+  bool enabled() const {
+    return enabled_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Executable copy of a persisted kernel or nullptr.
+   */
+  void* find(const std::string& cacheName, const std::string& key);
+
+  /**
+   * @brief Remember a newly JIT'd kernel so that it gets saved.
+   */
+  void record(
+      const std::string& cacheName,
+      const std::string& key,
+      std::string code);
+
+  std::int64_t load(const std::string& path);
+  bool save(const std::string& path);
+  bool saveManifest(const std::string& path);
+  std::int64_t prewarm(const std::string& manifestPath);
+
+  ~PersistentCodeCache();
+
+ private:
+  PersistentCodeCache();
+
+  struct MappedFile;
+
+  /// Identifies the build and ISA a cache file was written for.
+  static std::string fileTag();
+
+  std::int64_t loadLocked(const std::string& path);
+  bool saveLocked(const std::string& path);
+
+  std::atomic<bool> enabled_{false};
+  bool dirty_{false}; ///< kernels recorded since the last load/save
+  std::string envPath_; ///< FBGEMM_KERNEL_CACHE_PATH, saved at exit
+
+  std::mutex mutex_;
+  /// Mappings stay alive until exit since entries_ may point into them.
+  std::vector<std::unique_ptr<MappedFile>> files_;
+  /// Code of each entry; points into files_ or into generated_.
+  std::unordered_map<std::string, std::pair<const char*, std::size_t>>
+      entries_;
+  std::deque<std::string> generated_; ///< code recorded in this process
+  std::unordered_map<std::string, void*> installed_;
+
+  asmjit::JitRuntime runtime_; ///< owns executable copies of loaded kernels
+};
+
+} // namespace fbgemm
@@ -319,6 +319,72 @@ void FindMinMax(const float* a, float* min, float* max, int64_t len) {
   *max = temp_max;
 }
 
+int32_t QuantizeAndReduceAvx2(
+    const float* src,
+    uint8_t* dst,
+    int64_t len,
+    const TensorQuantizationParams& qparams) {
+  int64_t i = 0;
+  int32_t sum = 0;
+  const float inverse_scale = 1.f / qparams.scale;
+  // This is the largest int32 value less than int32_max
+  // that is exactly representable in float
+  constexpr int32_t int32_float_max_val =
+      std::numeric_limits<int32_t>::max() - 127;
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+  constexpr int VLEN = 8;
+  const __m256 inverse_scale_v = _mm256_set1_ps(inverse_scale);
+  const __m256 zero_point_v = _mm256_set1_ps(qparams.zero_point);
+  // clang-format off
+  const __m256i shuffle_mask_v = _mm256_set_epi8(
+      0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff,
+      0x0c, 0x08, 0x04, 0x00,
+      0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff,
+      0x0c, 0x08, 0x04, 0x00);
+  // clang-format on
+  const __m256i permute_mask_v =
+      _mm256_set_epi32(0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00);
+  __m256i sum_v = _mm256_setzero_si256();
+  for (; i < len / VLEN * VLEN; i += VLEN) {
+    __m256 transformed_v = _mm256_fmadd_ps(
+        _mm256_loadu_ps(src + i), inverse_scale_v, zero_point_v);
+    transformed_v =
+        _mm256_min_ps(transformed_v, _mm256_set1_ps(int32_float_max_val));
+    __m256i clipped_v = _mm256_min_epi32(
+        _mm256_max_epi32(
+            _mm256_cvtps_epi32(transformed_v), _mm256_setzero_si256()),
+        _mm256_set1_epi32(255));
+    // Row offsets are accumulated from the same registers that are stored
+    sum_v = _mm256_add_epi32(sum_v, clipped_v);
+
+    clipped_v = _mm256_shuffle_epi8(clipped_v, shuffle_mask_v);
+    clipped_v = _mm256_permutevar8x32_epi32(clipped_v, permute_mask_v);
+    _mm_storel_epi64(
+        reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(clipped_v));
+  }
+  alignas(32) int32_t sum_buf[VLEN];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sum_buf), sum_v);
+  for (int j = 0; j < VLEN; ++j) {
+    sum += sum_buf[j];
+  }
+#endif
+  // Same rounding as the vector loop: fma then round to nearest even
+  for (; i < len; ++i) {
+    const float transformed = std::min(
+        std::fma(src[i], inverse_scale, static_cast<float>(qparams.zero_point)),
+        static_cast<float>(int32_float_max_val));
+    const int32_t clipped = std::min(
+        std::max(static_cast<int32_t>(std::nearbyint(transformed)), 0), 255);
+    dst[i] = static_cast<uint8_t>(clipped);
+    sum += clipped;
+  }
+  return sum;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Requantization (with floats)
 
@@ -1014,10 +1080,11 @@ void requantizeForFloatAvx2(
     int g = block.col_start / ncol_per_group;
     quant_param_idx = g;
   }
-  __m256 multiplier_v = _mm256_set1_ps(r.A_scale * r.B_scale[quant_param_idx]);
+  float A_scale = r.A_scale;
+  __m256 multiplier_v = _mm256_set1_ps(A_scale * r.B_scale[quant_param_idx]);
 
   assert(
-      (A_SYMMETRIC == (r.A_zero_point == 0)) &&
+      (r.A_scales ? !A_SYMMETRIC : A_SYMMETRIC == (r.A_zero_point == 0)) &&
       "A_SYMMETRIC == true if and only if A_zero_point == 0");
   assert(
       (B_SYMMETRIC ==
@@ -1033,6 +1100,13 @@ void requantizeForFloatAvx2(
 
   constexpr int VLEN = 8;
   for (int64_t i = block.row_start; i < block.row_start + block.row_size; ++i) {
+    // Per-row (dynamically quantized) A overrides the tensor parameters
+    if (r.A_scales) {
+      A_scale = r.A_scales[i - block.row_start];
+      A_zero_point_v = _mm256_set1_epi32(r.A_zero_points[i - block.row_start]);
+      multiplier_v = _mm256_set1_ps(A_scale * r.B_scale[quant_param_idx]);
+    }
+
     // Scale row_offset with Bq_zero_point
     int32_t row_offset = 0;
     if (B_SYMMETRIC) {
@@ -1077,7 +1151,7 @@ void requantizeForFloatAvx2(
         x_scaled_v = _mm256_mul_ps(
             _mm256_cvtepi32_ps(x_v),
             _mm256_mul_ps(
-                _mm256_set1_ps(r.A_scale), _mm256_loadu_ps(r.B_scale + j)));
+                _mm256_set1_ps(A_scale), _mm256_loadu_ps(r.B_scale + j)));
       } else {
         x_scaled_v = _mm256_mul_ps(_mm256_cvtepi32_ps(x_v), multiplier_v);
       }
@@ -1120,7 +1194,7 @@ void requantizeForFloatAvx2(
         x_scaled_v = _mm256_mul_ps(
             _mm256_cvtepi32_ps(x_v),
             _mm256_mul_ps(
-                _mm256_set1_ps(r.A_scale),
+                _mm256_set1_ps(A_scale),
                 _mm256_maskload_ps(r.B_scale + j, mask_v)));
       } else {
         x_scaled_v = _mm256_mul_ps(_mm256_cvtepi32_ps(x_v), multiplier_v);
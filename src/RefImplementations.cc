@@ -11,6 +11,7 @@
 
 #include "fbgemm/FbgemmBuild.h"
 #include "fbgemm/FbgemmConvert.h"
+#include "fbgemm/FbgemmEmbedding.h"
 
 #include <algorithm>
 #include <cassert>
@@ -2261,6 +2262,164 @@ INSTANTIATE_SPMDM_INDEX_T(float16)
 #undef INSTANTIATE_SPMDM_OFFSET_T
 #undef INSTANTIATE_SPMDM_BASE
 
+template <typename DataType>
+void sparse_adam_row_ref(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    int64_t iter,
+    bool rowwise) {
+  const float bias_correction1 = 1.0f - powf(beta1, iter);
+  const float bias_correction2 = 1.0f - powf(beta2, iter);
+  float v_hat = 0.0f;
+  if (rowwise) {
+    float g_sum_square = 0.0f;
+    for (int j = 0; j < block_size; ++j) {
+      g_sum_square += g[j] * g[j];
+    }
+    v[0] = v[0] * beta2 + g_sum_square / block_size * (1.0f - beta2);
+    v_hat = v[0] / bias_correction2;
+  }
+  for (int j = 0; j < block_size; ++j) {
+    float wj = convert_to_float_ref(w[j]);
+    m[j] = beta1 * m[j] + (1.0f - beta1) * g[j];
+    if (!rowwise) {
+      v[j] = beta2 * v[j] + (1.0f - beta2) * g[j] * g[j];
+      v_hat = v[j] / bias_correction2;
+    }
+    wj -= lr *
+        (m[j] / bias_correction1 / (std::sqrt(v_hat) + epsilon) +
+         weight_decay * wj);
+    w[j] = convert_from_float_ref<DataType>(wj);
+  }
+}
+
+template <typename DataType>
+void sparse_lamb_row_ref(
+    int block_size,
+    DataType* w,
+    float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    int64_t iter,
+    bool rowwise) {
+  const float bias_correction1 = 1.0f - powf(beta1, iter);
+  const float bias_correction2 = 1.0f - powf(beta2, iter);
+  float v_hat = 0.0f;
+  if (rowwise) {
+    float g_sum_square = 0.0f;
+    for (int j = 0; j < block_size; ++j) {
+      g_sum_square += g[j] * g[j];
+    }
+    v[0] = beta2 * v[0] + (1.0f - beta2) * g_sum_square / block_size;
+    v_hat = v[0] / bias_correction2;
+  }
+  float weight_sum_square = 0.0f;
+  float rtw_sum_square = 0.0f;
+  for (int j = 0; j < block_size; ++j) {
+    float wj = convert_to_float_ref(w[j]);
+    m[j] = beta1 * m[j] + (1.0f - beta1) * g[j];
+    if (!rowwise) {
+      v[j] = beta2 * v[j] + (1.0f - beta2) * g[j] * g[j];
+      v_hat = v[j] / bias_correction2;
+    }
+    // g is not needed anymore, reuse it for r_t + weight_decay * w
+    g[j] = m[j] / bias_correction1 / (std::sqrt(v_hat) + epsilon) +
+        weight_decay * wj;
+    weight_sum_square += wj * wj;
+    rtw_sum_square += g[j] * g[j];
+  }
+  const float true_ratio =
+      std::sqrt(weight_sum_square) / std::sqrt(rtw_sum_square);
+  for (int j = 0; j < block_size; ++j) {
+    float wj = convert_to_float_ref(w[j]);
+    wj -= lr * true_ratio * g[j];
+    w[j] = convert_from_float_ref<DataType>(wj);
+  }
+}
+
+template <typename DataType>
+void sparse_lars_sgd_row_ref(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float lr,
+    float eta,
+    float momentum,
+    float weight_decay) {
+  float weight_sum_square = 0.0f;
+  float grad_sum_square = 0.0f;
+  for (int j = 0; j < block_size; ++j) {
+    float wj = convert_to_float_ref(w[j]);
+    weight_sum_square += wj * wj;
+    grad_sum_square += g[j] * g[j];
+  }
+  const float weight_norm = std::sqrt(weight_sum_square);
+  const float grad_norm = std::sqrt(grad_sum_square);
+  const float adjusted_lr =
+      lr * eta * weight_norm / (grad_norm + weight_decay * weight_norm);
+  for (int j = 0; j < block_size; ++j) {
+    float wj = convert_to_float_ref(w[j]);
+    m[j] = momentum * m[j] + adjusted_lr * (g[j] + weight_decay * wj);
+    w[j] = convert_from_float_ref<DataType>(wj - m[j]);
+  }
+}
+
+#define INSTANTIATE_SPARSE_OPTIMIZERS_BASE(DATA_TYPE) \
+  template FBGEMM_API void sparse_adam_row_ref(      \
+      int block_size,                                 \
+      DATA_TYPE* w,                                   \
+      const float* g,                                 \
+      float* m,                                       \
+      float* v,                                       \
+      float lr,                                       \
+      float epsilon,                                  \
+      float beta1,                                    \
+      float beta2,                                    \
+      float weight_decay,                             \
+      int64_t iter,                                   \
+      bool rowwise);                                  \
+  template FBGEMM_API void sparse_lamb_row_ref(      \
+      int block_size,                                 \
+      DATA_TYPE* w,                                   \
+      float* g,                                       \
+      float* m,                                       \
+      float* v,                                       \
+      float lr,                                       \
+      float epsilon,                                  \
+      float beta1,                                    \
+      float beta2,                                    \
+      float weight_decay,                             \
+      int64_t iter,                                   \
+      bool rowwise);                                  \
+  template FBGEMM_API void sparse_lars_sgd_row_ref(  \
+      int block_size,                                 \
+      DATA_TYPE* w,                                   \
+      const float* g,                                 \
+      float* m,                                       \
+      float lr,                                       \
+      float eta,                                      \
+      float momentum,                                 \
+      float weight_decay);
+
+INSTANTIATE_SPARSE_OPTIMIZERS_BASE(float)
+INSTANTIATE_SPARSE_OPTIMIZERS_BASE(float16)
+
+#undef INSTANTIATE_SPARSE_OPTIMIZERS_BASE
+
 template <typename IndexType>
 FBGEMM_API void compressed_indices_remap_ref(
     std::int32_t offsets_numel,
@@ -2304,4 +2463,107 @@ INSTANTIATE_REMAP_BASE(int64_t)
 
 #undef INSTANTIATE_REMAP_BASE
 
+// MurmurHash3 32-bit finalizer, the hash of the pruned embedding hash maps
+static inline std::uint32_t pruned_hash_ref(std::uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+void pruned_hashmap_insert_ref(
+    const std::int32_t* indices,
+    const std::int32_t* dense_indices,
+    std::int64_t num_indices,
+    std::int32_t* hash_table,
+    std::int64_t capacity) {
+  for (std::int64_t i = 0; i < num_indices; ++i) {
+    if (dense_indices[i] == -1) {
+      continue;
+    }
+    std::int64_t slot =
+        pruned_hash_ref(static_cast<std::uint32_t>(indices[i])) % capacity;
+    for (std::int64_t probe = 0; probe < capacity; ++probe) {
+      std::int32_t* entry = hash_table + 2 * slot;
+      if (entry[0] == -1 || entry[0] == indices[i]) {
+        entry[0] = indices[i];
+        entry[1] = dense_indices[i];
+        break;
+      }
+      slot = slot + 1 == capacity ? 0 : slot + 1;
+    }
+  }
+}
+
+void pruned_hashmap_lookup_ref(
+    const std::int32_t* indices,
+    std::int64_t num_indices,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int32_t* dense_indices) {
+  for (std::int64_t i = 0; i < num_indices; ++i) {
+    dense_indices[i] = -1;
+    std::int64_t slot =
+        pruned_hash_ref(static_cast<std::uint32_t>(indices[i])) % capacity;
+    // Bounded so that a full table without the id cannot loop forever
+    for (std::int64_t probe = 0; probe < capacity; ++probe) {
+      const std::int32_t* entry = hash_table + 2 * slot;
+      if (entry[0] == -1) {
+        break;
+      }
+      if (entry[0] == indices[i]) {
+        dense_indices[i] = entry[1];
+        break;
+      }
+      slot = slot + 1 == capacity ? 0 : slot + 1;
+    }
+  }
+}
+
+template <typename IndexType>
+std::int64_t lxu_cache_lookup_ref(
+    const IndexType* linear_cache_indices,
+    std::int64_t num_indices,
+    const std::int64_t* cache_state,
+    std::int32_t num_sets,
+    int ways,
+    std::int64_t invalid_index,
+    std::int32_t* cache_locations) {
+  std::int64_t num_misses = 0;
+  for (std::int64_t i = 0; i < num_indices; ++i) {
+    const std::int64_t idx = linear_cache_indices[i];
+    cache_locations[i] = -1;
+    if (idx == invalid_index) {
+      continue;
+    }
+    const std::int64_t cache_set = lxu_cache_slot(idx, num_sets);
+    const std::int64_t* set_state = cache_state + cache_set * ways;
+    for (int way = 0; way < ways; ++way) {
+      if (set_state[way] == idx) {
+        cache_locations[i] = cache_set * ways + way;
+        break;
+      }
+    }
+    num_misses += cache_locations[i] == -1;
+  }
+  return num_misses;
+}
+
+#define INSTANTIATE_LXU_CACHE_BASE(INDEX_TYPE)           \
+  template FBGEMM_API std::int64_t lxu_cache_lookup_ref( \
+      const INDEX_TYPE* linear_cache_indices,            \
+      std::int64_t num_indices,                          \
+      const std::int64_t* cache_state,                   \
+      std::int32_t num_sets,                             \
+      int ways,                                          \
+      std::int64_t invalid_index,                        \
+      std::int32_t* cache_locations);
+
+INSTANTIATE_LXU_CACHE_BASE(std::int32_t)
+INSTANTIATE_LXU_CACHE_BASE(std::int64_t)
+
+#undef INSTANTIATE_LXU_CACHE_BASE
+
 } // namespace fbgemm
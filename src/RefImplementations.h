@@ -401,6 +401,51 @@ FBGEMM_API int rowwise_sparse_adagrad_fused_ref(
     int emu_vector_size = 8,
     std::int64_t grad_stride = -1);
 
+/**
+ * Reference row updates of SparseAdamRowUpdate, SparseLambRowUpdate and
+ * SparseLarsSgdRowUpdate in fbgemm/FbgemmEmbedding.h.
+ */
+template <typename DataType>
+FBGEMM_API void sparse_adam_row_ref(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise = false);
+
+template <typename DataType>
+FBGEMM_API void sparse_lamb_row_ref(
+    int block_size,
+    DataType* w,
+    float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise = false);
+
+template <typename DataType>
+FBGEMM_API void sparse_lars_sgd_row_ref(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float lr,
+    float eta,
+    float momentum,
+    float weight_decay);
+
 template <typename IndexType>
 FBGEMM_API void compressed_indices_remap_ref(
     std::int32_t offsets_len,
@@ -412,6 +457,35 @@ FBGEMM_API void compressed_indices_remap_ref(
     IndexType* out_offsets,
     float* out_weights);
 
+/**
+ * Inserts (sparse id, dense id) pairs into a pruned embedding hash map with
+ * the layout read by pruned_hashmap_lookup. Pairs with dense id -1 (pruned
+ * rows) are skipped; an id that is already present has its dense id updated.
+ */
+FBGEMM_API void pruned_hashmap_insert_ref(
+    const std::int32_t* indices,
+    const std::int32_t* dense_indices,
+    std::int64_t num_indices,
+    std::int32_t* hash_table,
+    std::int64_t capacity);
+
+FBGEMM_API void pruned_hashmap_lookup_ref(
+    const std::int32_t* indices,
+    std::int64_t num_indices,
+    const std::int32_t* hash_table,
+    std::int64_t capacity,
+    std::int32_t* dense_indices);
+
+template <typename IndexType>
+FBGEMM_API std::int64_t lxu_cache_lookup_ref(
+    const IndexType* linear_cache_indices,
+    std::int64_t num_indices,
+    const std::int64_t* cache_state,
+    std::int32_t num_sets,
+    int ways,
+    std::int64_t invalid_index,
+    std::int32_t* cache_locations);
+
 template <typename T>
 float convert_to_float_ref(T src, bool is_bf16 = false) {
   float f_value;
@@ -98,7 +98,11 @@ CodeCache<
     typename ReturnFunctionSignature<indxType, offsetType, dataType>::
         jit_sparse_adagrad_kernel>
     GenRowWiseSparseAdagradFused<indxType, offsetType, dataType, instSet>::
-        codeCache_;
+        codeCache_(codeCacheName<GenRowWiseSparseAdagradFused<
+                       indxType,
+                       offsetType,
+                       dataType,
+                       instSet>>());
 
 template <
     typename indxType,
@@ -754,11 +758,7 @@ typename ReturnFunctionSignature<indxType, offsetType, dataType>::
         // jit_fused8bitembedding_kernel fn;
         typename ReturnFunctionSignature<indxType, offsetType, dataType>::
             jit_sparse_adagrad_kernel fn;
-        asmjit::Error err;
-        {
-          unique_lock<mutex> lock(rtMutex_);
-          err = runtime().add(&fn, &code);
-        }
+        asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
         if (err) {
           cout << "Error: in fn add" << endl;
           return nullptr;
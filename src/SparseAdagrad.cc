@@ -120,7 +120,8 @@ template <typename indxType, inst_set_t instSet>
 CodeCache<
     std::tuple<int, int, bool, bool>,
     typename ReturnFunctionSignature<indxType>::jit_sparse_adagrad_kernel>
-    GenSparseAdagrad<indxType, instSet>::codeCache_;
+    GenSparseAdagrad<indxType, instSet>::codeCache_(
+        codeCacheName<GenSparseAdagrad<indxType, instSet>>());
 
 template <typename indxType, inst_set_t instSet>
 void GenSparseAdagrad<indxType, instSet>::genSparseAdagrad(
@@ -770,11 +771,7 @@ GenSparseAdagrad<indxType, instSet>::getOrCreate(
 
         typename ReturnFunctionSignature<indxType>::jit_sparse_adagrad_kernel
             fn;
-        asmjit::Error err;
-        {
-          std::unique_lock<std::mutex> lock(rtMutex_);
-          err = runtime().add(&fn, &code);
-        }
+        asmjit::Error err = addToJitRuntime(runtime(), rtMutex_, &fn, &code);
         if (err) {
           std::cout << "Error: in fn add" << std::endl;
           return nullptr;
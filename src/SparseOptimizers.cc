@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmEmbedding.h"
+
+#include "./RefImplementations.h"
+#include "fbgemm/Types.h"
+#include "fbgemm/Utils.h"
+
+namespace fbgemm {
+
+// The row updates are bounded by memory bandwidth, so like SparseAdagrad they
+// run the AVX2 kernels on AVX512 machines too.
+
+template <typename DataType>
+void SparseAdamRowUpdate(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise) {
+  static const auto iset = fbgemmInstructionSet();
+  if (isZmm(iset) || isYmm(iset)) {
+    internal::SparseAdamRowUpdateAvx2(
+        block_size,
+        w,
+        g,
+        m,
+        v,
+        lr,
+        epsilon,
+        beta1,
+        beta2,
+        weight_decay,
+        iter,
+        rowwise);
+  } else {
+    sparse_adam_row_ref(
+        block_size,
+        w,
+        g,
+        m,
+        v,
+        lr,
+        epsilon,
+        beta1,
+        beta2,
+        weight_decay,
+        iter,
+        rowwise);
+  }
+}
+
+template <typename DataType>
+void SparseLambRowUpdate(
+    int block_size,
+    DataType* w,
+    float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise) {
+  static const auto iset = fbgemmInstructionSet();
+  if (isZmm(iset) || isYmm(iset)) {
+    internal::SparseLambRowUpdateAvx2(
+        block_size,
+        w,
+        g,
+        m,
+        v,
+        lr,
+        epsilon,
+        beta1,
+        beta2,
+        weight_decay,
+        iter,
+        rowwise);
+  } else {
+    sparse_lamb_row_ref(
+        block_size,
+        w,
+        g,
+        m,
+        v,
+        lr,
+        epsilon,
+        beta1,
+        beta2,
+        weight_decay,
+        iter,
+        rowwise);
+  }
+}
+
+template <typename DataType>
+void SparseLarsSgdRowUpdate(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float lr,
+    float eta,
+    float momentum,
+    float weight_decay) {
+  static const auto iset = fbgemmInstructionSet();
+  if (isZmm(iset) || isYmm(iset)) {
+    internal::SparseLarsSgdRowUpdateAvx2(
+        block_size, w, g, m, lr, eta, momentum, weight_decay);
+  } else {
+    sparse_lars_sgd_row_ref(
+        block_size, w, g, m, lr, eta, momentum, weight_decay);
+  }
+}
+
+#define INSTANTIATE_SPARSE_OPTIMIZERS(DATA_TYPE)  \
+  template FBGEMM_API void SparseAdamRowUpdate(   \
+      int block_size,                             \
+      DATA_TYPE* w,                               \
+      const float* g,                             \
+      float* m,                                   \
+      float* v,                                   \
+      float lr,                                   \
+      float epsilon,                              \
+      float beta1,                                \
+      float beta2,                                \
+      float weight_decay,                         \
+      std::int64_t iter,                          \
+      bool rowwise);                              \
+  template FBGEMM_API void SparseLambRowUpdate(   \
+      int block_size,                             \
+      DATA_TYPE* w,                               \
+      float* g,                                   \
+      float* m,                                   \
+      float* v,                                   \
+      float lr,                                   \
+      float epsilon,                              \
+      float beta1,                                \
+      float beta2,                                \
+      float weight_decay,                         \
+      std::int64_t iter,                          \
+      bool rowwise);                              \
+  template FBGEMM_API void SparseLarsSgdRowUpdate( \
+      int block_size,                             \
+      DATA_TYPE* w,                               \
+      const float* g,                             \
+      float* m,                                   \
+      float lr,                                   \
+      float eta,                                  \
+      float momentum,                             \
+      float weight_decay);
+
+INSTANTIATE_SPARSE_OPTIMIZERS(float)
+INSTANTIATE_SPARSE_OPTIMIZERS(float16)
+
+#undef INSTANTIATE_SPARSE_OPTIMIZERS
+
+} // namespace fbgemm
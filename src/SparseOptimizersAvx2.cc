@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define FBGEMM_EXPORTS
+#include "fbgemm/FbgemmEmbedding.h"
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "./MaskAvx2.h"
+#include "fbgemm/Types.h"
+
+namespace fbgemm {
+namespace internal {
+
+namespace {
+
+constexpr int VLEN = 8;
+
+// Loads and stores of len <= VLEN floats. Lanes past len are loaded as 0.
+inline __m256i tailMask(int len) {
+  return _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(avx2_ps_or_epi32_masks[len]));
+}
+
+inline __m256 loadFloat(const float* src, int len) {
+  return len == VLEN ? _mm256_loadu_ps(src)
+                     : _mm256_maskload_ps(src, tailMask(len));
+}
+
+inline __m256 loadFloat(const float16* src, int len) {
+  if (len == VLEN) {
+    return _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+  }
+  alignas(16) float16 buf[VLEN] = {};
+  std::memcpy(buf, src, len * sizeof(float16));
+  return _mm256_cvtph_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(buf)));
+}
+
+inline void storeFloat(float* dst, __m256 val, int len) {
+  if (len == VLEN) {
+    _mm256_storeu_ps(dst, val);
+  } else {
+    _mm256_maskstore_ps(dst, tailMask(len), val);
+  }
+}
+
+inline void storeFloat(float16* dst, __m256 val, int len) {
+  __m128i half = _mm256_cvtps_ph(val, _MM_FROUND_TO_NEAREST_INT);
+  if (len == VLEN) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), half);
+  } else {
+    alignas(16) float16 buf[VLEN];
+    _mm_store_si128(reinterpret_cast<__m128i*>(buf), half);
+    std::memcpy(dst, buf, len * sizeof(float16));
+  }
+}
+
+inline float horizontalSum(__m256 val) {
+  __m128 sum = _mm_add_ps(
+      _mm256_castps256_ps128(val), _mm256_extractf128_ps(val, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+  return _mm_cvtss_f32(sum);
+}
+
+inline float sumOfSquares(const float* src, int n) {
+  __m256 acc = _mm256_setzero_ps();
+  for (int j = 0; j < n; j += VLEN) {
+    __m256 x = loadFloat(src + j, std::min(VLEN, n - j));
+    acc = _mm256_fmadd_ps(x, x, acc);
+  }
+  return horizontalSum(acc);
+}
+
+} // namespace
+
+template <typename DataType>
+void SparseAdamRowUpdateAvx2(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise) {
+  const float bias_correction1 = 1.0f - std::pow(beta1, float(iter));
+  const float bias_correction2 = 1.0f - std::pow(beta2, float(iter));
+  const __m256 beta1_v = _mm256_set1_ps(beta1);
+  const __m256 one_minus_beta1_v = _mm256_set1_ps(1.0f - beta1);
+  const __m256 beta2_v = _mm256_set1_ps(beta2);
+  const __m256 one_minus_beta2_v = _mm256_set1_ps(1.0f - beta2);
+  const __m256 bias_correction1_v = _mm256_set1_ps(bias_correction1);
+  const __m256 bias_correction2_v = _mm256_set1_ps(bias_correction2);
+  const __m256 epsilon_v = _mm256_set1_ps(epsilon);
+  const __m256 lr_v = _mm256_set1_ps(lr);
+  const __m256 weight_decay_v = _mm256_set1_ps(weight_decay);
+
+  // bias_correction1 * (sqrt(v_hat) + epsilon)
+  __m256 denom = _mm256_setzero_ps();
+  if (rowwise) {
+    const float g_avg_square = sumOfSquares(g, block_size) / block_size;
+    v[0] = v[0] * beta2 + g_avg_square * (1.0f - beta2);
+    denom = _mm256_set1_ps(
+        bias_correction1 *
+        (std::sqrt(v[0] / bias_correction2) + epsilon));
+  }
+
+  for (int j = 0; j < block_size; j += VLEN) {
+    const int len = std::min(VLEN, block_size - j);
+    const __m256 g_v = loadFloat(g + j, len);
+    __m256 w_v = loadFloat(w + j, len);
+
+    __m256 m_v = loadFloat(m + j, len);
+    m_v = _mm256_fmadd_ps(beta1_v, m_v, _mm256_mul_ps(one_minus_beta1_v, g_v));
+    storeFloat(m + j, m_v, len);
+
+    if (!rowwise) {
+      __m256 v_v = loadFloat(v + j, len);
+      v_v = _mm256_fmadd_ps(
+          beta2_v,
+          v_v,
+          _mm256_mul_ps(one_minus_beta2_v, _mm256_mul_ps(g_v, g_v)));
+      storeFloat(v + j, v_v, len);
+      denom = _mm256_mul_ps(
+          bias_correction1_v,
+          _mm256_add_ps(
+              _mm256_sqrt_ps(_mm256_div_ps(v_v, bias_correction2_v)),
+              epsilon_v));
+    }
+
+    const __m256 step =
+        _mm256_fmadd_ps(weight_decay_v, w_v, _mm256_div_ps(m_v, denom));
+    w_v = _mm256_fnmadd_ps(lr_v, step, w_v);
+    storeFloat(w + j, w_v, len);
+  }
+}
+
+template <typename DataType>
+void SparseLambRowUpdateAvx2(
+    int block_size,
+    DataType* w,
+    float* g,
+    float* m,
+    float* v,
+    float lr,
+    float epsilon,
+    float beta1,
+    float beta2,
+    float weight_decay,
+    std::int64_t iter,
+    bool rowwise) {
+  const float bias_correction1 = 1.0f - std::pow(beta1, float(iter));
+  const float bias_correction2 = 1.0f - std::pow(beta2, float(iter));
+  const __m256 beta1_v = _mm256_set1_ps(beta1);
+  const __m256 one_minus_beta1_v = _mm256_set1_ps(1.0f - beta1);
+  const __m256 beta2_v = _mm256_set1_ps(beta2);
+  const __m256 one_minus_beta2_v = _mm256_set1_ps(1.0f - beta2);
+  const __m256 bias_correction1_v = _mm256_set1_ps(bias_correction1);
+  const __m256 bias_correction2_v = _mm256_set1_ps(bias_correction2);
+  const __m256 epsilon_v = _mm256_set1_ps(epsilon);
+  const __m256 weight_decay_v = _mm256_set1_ps(weight_decay);
+
+  __m256 denom = _mm256_setzero_ps();
+  if (rowwise) {
+    const float g_avg_square = sumOfSquares(g, block_size) / block_size;
+    v[0] = beta2 * v[0] + (1.0f - beta2) * g_avg_square;
+    denom = _mm256_set1_ps(
+        bias_correction1 *
+        (std::sqrt(v[0] / bias_correction2) + epsilon));
+  }
+
+  __m256 weight_sum_square = _mm256_setzero_ps();
+  __m256 rtw_sum_square = _mm256_setzero_ps();
+  for (int j = 0; j < block_size; j += VLEN) {
+    const int len = std::min(VLEN, block_size - j);
+    const __m256 g_v = loadFloat(g + j, len);
+    const __m256 w_v = loadFloat(w + j, len);
+
+    __m256 m_v = loadFloat(m + j, len);
+    m_v = _mm256_fmadd_ps(beta1_v, m_v, _mm256_mul_ps(one_minus_beta1_v, g_v));
+    storeFloat(m + j, m_v, len);
+
+    if (!rowwise) {
+      __m256 v_v = loadFloat(v + j, len);
+      v_v = _mm256_fmadd_ps(
+          beta2_v,
+          v_v,
+          _mm256_mul_ps(one_minus_beta2_v, _mm256_mul_ps(g_v, g_v)));
+      storeFloat(v + j, v_v, len);
+      denom = _mm256_mul_ps(
+          bias_correction1_v,
+          _mm256_add_ps(
+              _mm256_sqrt_ps(_mm256_div_ps(v_v, bias_correction2_v)),
+              epsilon_v));
+    }
+
+    // g is not needed anymore, reuse it for r_t + weight_decay * w. Lanes
+    // past len may be NaN when epsilon is 0, keep them out of the norm.
+    __m256 rtw =
+        _mm256_fmadd_ps(weight_decay_v, w_v, _mm256_div_ps(m_v, denom));
+    if (len < VLEN) {
+      rtw = _mm256_and_ps(rtw, _mm256_castsi256_ps(tailMask(len)));
+    }
+    storeFloat(g + j, rtw, len);
+    weight_sum_square = _mm256_fmadd_ps(w_v, w_v, weight_sum_square);
+    rtw_sum_square = _mm256_fmadd_ps(rtw, rtw, rtw_sum_square);
+  }
+
+  const float true_ratio = std::sqrt(horizontalSum(weight_sum_square)) /
+      std::sqrt(horizontalSum(rtw_sum_square));
+  const __m256 step_v = _mm256_set1_ps(lr * true_ratio);
+  for (int j = 0; j < block_size; j += VLEN) {
+    const int len = std::min(VLEN, block_size - j);
+    __m256 w_v = loadFloat(w + j, len);
+    w_v = _mm256_fnmadd_ps(step_v, loadFloat(g + j, len), w_v);
+    storeFloat(w + j, w_v, len);
+  }
+}
+
+template <typename DataType>
+void SparseLarsSgdRowUpdateAvx2(
+    int block_size,
+    DataType* w,
+    const float* g,
+    float* m,
+    float lr,
+    float eta,
+    float momentum,
+    float weight_decay) {
+  __m256 weight_sum_square = _mm256_setzero_ps();
+  __m256 grad_sum_square = _mm256_setzero_ps();
+  for (int j = 0; j < block_size; j += VLEN) {
+    const int len = std::min(VLEN, block_size - j);
+    const __m256 w_v = loadFloat(w + j, len);
+    const __m256 g_v = loadFloat(g + j, len);
+    weight_sum_square = _mm256_fmadd_ps(w_v, w_v, weight_sum_square);
+    grad_sum_square = _mm256_fmadd_ps(g_v, g_v, grad_sum_square);
+  }
+  const float weight_norm = std::sqrt(horizontalSum(weight_sum_square));
+  const float grad_norm = std::sqrt(horizontalSum(grad_sum_square));
+  const float adjusted_lr =
+      lr * eta * weight_norm / (grad_norm + weight_decay * weight_norm);
+
+  const __m256 momentum_v = _mm256_set1_ps(momentum);
+  const __m256 adjusted_lr_v = _mm256_set1_ps(adjusted_lr);
+  const __m256 weight_decay_v = _mm256_set1_ps(weight_decay);
+  for (int j = 0; j < block_size; j += VLEN) {
+    const int len = std::min(VLEN, block_size - j);
+    __m256 w_v = loadFloat(w + j, len);
+    const __m256 g_v = loadFloat(g + j, len);
+    __m256 m_v = loadFloat(m + j, len);
+    m_v = _mm256_fmadd_ps(
+        momentum_v,
+        m_v,
+        _mm256_mul_ps(
+            adjusted_lr_v, _mm256_fmadd_ps(weight_decay_v, w_v, g_v)));
+    storeFloat(m + j, m_v, len);
+    w_v = _mm256_sub_ps(w_v, m_v);
+    storeFloat(w + j, w_v, len);
+  }
+}
+
+#define INSTANTIATE_SPARSE_OPTIMIZERS_AVX2(DATA_TYPE) \
+  template void SparseAdamRowUpdateAvx2(             \
+      int block_size,                                 \
+      DATA_TYPE* w,                                   \
+      const float* g,                                 \
+      float* m,                                       \
+      float* v,                                       \
+      float lr,                                       \
+      float epsilon,                                  \
+      float beta1,                                    \
+      float beta2,                                    \
+      float weight_decay,                             \
+      std::int64_t iter,                              \
+      bool rowwise);                                  \
+  template void SparseLambRowUpdateAvx2(             \
+      int block_size,                                 \
+      DATA_TYPE* w,                                   \
+      float* g,                                       \
+      float* m,                                       \
+      float* v,                                       \
+      float lr,                                       \
+      float epsilon,                                  \
+      float beta1,                                    \
+      float beta2,                                    \
+      float weight_decay,                             \
+      std::int64_t iter,                              \
+      bool rowwise);                                  \
+  template void SparseLarsSgdRowUpdateAvx2(          \
+      int block_size,                                 \
+      DATA_TYPE* w,                                   \
+      const float* g,                                 \
+      float* m,                                       \
+      float lr,                                       \
+      float eta,                                      \
+      float momentum,                                 \
+      float weight_decay);
+
+INSTANTIATE_SPARSE_OPTIMIZERS_AVX2(float)
+INSTANTIATE_SPARSE_OPTIMIZERS_AVX2(float16)
+
+#undef INSTANTIATE_SPARSE_OPTIMIZERS_AVX2
+
+} // namespace internal
+} // namespace fbgemm
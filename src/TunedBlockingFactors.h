@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbgemm/FbgemmBuild.h"
+#include "fbgemm/Utils.h"
+
+// Lookups in the tuning table of fbgemm/FbgemmAutotune.h done by PackBMatrix
+// and fbgemmPacked when they are not given BlockingFactors. All of them are
+// cheap when the table is empty.
+
+namespace fbgemm {
+
+/**
+ * @brief Blocking factors to pack B of K rows per group and N columns with:
+ *        those of the entry of (N, K) with the largest M. Without an entry
+ *        for (N, K), the defaults with KCB replaced by the tuned KCB of K.
+ * @return false if there is no entry with this K, params is left untouched.
+ */
+template <typename accT>
+FBGEMM_API bool
+fbgemmGetTunedPackBParams(int N, int K, BlockingFactors* params);
+
+/**
+ * @brief Picks the blocking factors fbgemmPacked runs with when it is not
+ *        given any, from the shape and the blocks A and B were packed with.
+ *        A is packed with the KCB of the result whatever it was constructed
+ *        with, so only B constrains it.
+ * @param bTuned the tuned factors B was packed with, nullptr if it was packed
+ *        with the defaults.
+ * @param storage holds the returned factors when they are copied from the
+ *        table.
+ * @return the exact entry of (M, N, K) if B was packed with its KCB and NCB
+ *         and A's blocks hold its MCB rows, else bTuned, else nullptr for
+ *         the defaults.
+ */
+template <typename accT>
+FBGEMM_API const BlockingFactors* fbgemmSelectTunedBlockingFactors(
+    int M,
+    int N,
+    int K,
+    int aBlockRows,
+    int bBlockRows,
+    int bBlockCols,
+    const BlockingFactors* bTuned,
+    BlockingFactors* storage);
+
+} // namespace fbgemm
@@ -11,19 +11,33 @@
 #define FBGEMM_EXPORTS
 #include "fbgemm/Utils.h"
 #include <cpuinfo.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cinttypes>
 #include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <new>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -35,6 +49,19 @@
 
 namespace fbgemm {
 
+// From FbgemmThreadPool.h, which would pull in all of Fbgemm.h.
+FBGEMM_API bool fbgemmInThreadPool();
+
+namespace internal {
+
+// The size of fbgemmGetDefaultThreadPool() and its run(num_threads, fn).
+int defaultThreadPoolSize();
+void runOnDefaultThreadPool(
+    int num_threads,
+    const std::function<void(int thread_id, int num_threads)>& fn);
+
+} // namespace internal
+
 /**
  * @brief Compare the reference and test result matrix to check the correctness.
  * @param ref The buffer for the reference result matrix.
@@ -445,7 +472,198 @@ void* fbgemmAlignedAlloc(
   return aligned_mem;
 }
 
+namespace {
+
+#ifdef __linux__
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+constexpr size_t kHugePage2MB = size_t(1) << 21;
+constexpr size_t kHugePage1GB = size_t(1) << 30;
+// NUMA policies from linux/mempolicy.h
+constexpr int kMpolBind = 2;
+constexpr int kMpolInterleave = 3;
+constexpr int kMaxNumaNodes = 1024;
+
+struct MappedRegion {
+  void* base;
+  size_t length;
+};
+
+// Regions returned by fbgemmAlignedAllocWithPolicy, keyed by the pointer
+// handed out, so that fbgemmAlignedFree can tell them from malloc'ed memory.
+std::mutex& mappedRegionsMutex() {
+  static std::mutex m;
+  return m;
+}
+
+std::unordered_map<void*, MappedRegion>& mappedRegions() {
+  static std::unordered_map<void*, MappedRegion> regions;
+  return regions;
+}
+
+// Number of live mapped regions. fbgemmAlignedFree skips the lookup while
+// nothing is mapped, which is the case unless a policy is in use.
+std::atomic<std::int64_t> numMappedRegions{0};
+
+size_t roundUp(size_t n, size_t multiple) {
+  return (n + multiple - 1) / multiple * multiple;
+}
+
+void* mapAnonymous(size_t length, int extraFlags) {
+  void* p = mmap(
+      nullptr,
+      length,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | extraFlags,
+      -1,
+      0);
+  return p == MAP_FAILED ? nullptr : p;
+}
+
+// Sets the NUMA policy of a range before its pages are first touched.
+void applyNumaPolicy(void* p, size_t length, const AllocPolicy& policy) {
+  if (policy.numa == NumaMode::DEFAULT) {
+    return;
+  }
+  constexpr int kBitsPerWord = 8 * sizeof(unsigned long);
+  unsigned long nodeMask[kMaxNumaNodes / kBitsPerWord] = {};
+  int mode;
+  if (policy.numa == NumaMode::BIND) {
+    if (policy.numaNode < 0 || policy.numaNode >= kMaxNumaNodes) {
+      return;
+    }
+    nodeMask[policy.numaNode / kBitsPerWord] = 1UL
+        << (policy.numaNode % kBitsPerWord);
+    mode = kMpolBind;
+  } else {
+    // The kernel restricts the mask to the nodes the process may use.
+    memset(nodeMask, 0xff, sizeof(nodeMask));
+    mode = kMpolInterleave;
+  }
+  // Best effort: on failure the range keeps the default policy.
+  syscall(SYS_mbind, p, length, mode, nodeMask, kMaxNumaNodes + 1, 0);
+}
+
+void* mapWithPolicy(size_t align, size_t size, const AllocPolicy& policy) {
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  // Room to align the returned pointer past what the mapping guarantees.
+  const size_t padded = size + (align > pageSize ? align : 0);
+  void* base = nullptr;
+  size_t length = 0;
+  size_t regionAlign = pageSize;
+
+  if (policy.hugePages == HugePageMode::EXPLICIT_1GB ||
+      policy.hugePages == HugePageMode::EXPLICIT_2MB) {
+    const bool is1GB = policy.hugePages == HugePageMode::EXPLICIT_1GB;
+    regionAlign = is1GB ? kHugePage1GB : kHugePage2MB;
+    length = roundUp(padded, regionAlign);
+    // Huge page sizes are encoded as log2 in the upper flag bits.
+    base = mapAnonymous(
+        length, MAP_HUGETLB | ((is1GB ? 30 : 21) << MAP_HUGE_SHIFT));
+  }
+  if (base == nullptr && policy.hugePages != HugePageMode::NONE) {
+    // Transparent huge pages need a 2MB aligned range, so over allocate and
+    // align inside of it.
+    regionAlign = kHugePage2MB;
+    length = roundUp(padded, kHugePage2MB) + kHugePage2MB;
+    base = mapAnonymous(length, 0);
+#ifdef MADV_HUGEPAGE
+    if (base != nullptr) {
+      madvise(base, length, MADV_HUGEPAGE);
+    }
+#endif
+  }
+  if (base == nullptr) {
+    regionAlign = pageSize;
+    length = roundUp(padded, pageSize);
+    base = mapAnonymous(length, 0);
+    if (base == nullptr) {
+      throw std::bad_alloc();
+    }
+  }
+  applyNumaPolicy(base, length, policy);
+
+  const size_t a = std::max(align, regionAlign);
+  void* p = reinterpret_cast<void*>(
+      roundUp(reinterpret_cast<std::uintptr_t>(base), a));
+  {
+    std::lock_guard<std::mutex> lock(mappedRegionsMutex());
+    mappedRegions()[p] = {base, length};
+  }
+  numMappedRegions.fetch_add(1, std::memory_order_relaxed);
+  return p;
+}
+
+bool unmapIfMapped(void* p) {
+  if (numMappedRegions.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  MappedRegion region;
+  {
+    std::lock_guard<std::mutex> lock(mappedRegionsMutex());
+    auto it = mappedRegions().find(p);
+    if (it == mappedRegions().end()) {
+      return false;
+    }
+    region = it->second;
+    mappedRegions().erase(it);
+  }
+  numMappedRegions.fetch_sub(1, std::memory_order_relaxed);
+  munmap(region.base, region.length);
+  return true;
+}
+#endif // __linux__
+
+AllocPolicy policyFromEnv() {
+  AllocPolicy policy;
+  const char* hugePages = std::getenv("FBGEMM_HUGE_PAGES");
+  if (hugePages != nullptr) {
+    const std::string val(hugePages);
+    if (val == "thp" || val == "transparent") {
+      policy.hugePages = HugePageMode::TRANSPARENT;
+    } else if (val == "2mb") {
+      policy.hugePages = HugePageMode::EXPLICIT_2MB;
+    } else if (val == "1gb") {
+      policy.hugePages = HugePageMode::EXPLICIT_1GB;
+    }
+  }
+  const char* numa = std::getenv("FBGEMM_NUMA");
+  if (numa != nullptr) {
+    const std::string val(numa);
+    if (val == "interleave") {
+      policy.numa = NumaMode::INTERLEAVE;
+    } else if (!val.empty() && val.find_first_not_of("0123456789") ==
+                   std::string::npos) {
+      policy.numa = NumaMode::BIND;
+      policy.numaNode = std::atoi(val.c_str());
+    }
+  }
+  return policy;
+}
+
+std::mutex& packedWeightPolicyMutex() {
+  static std::mutex m;
+  return m;
+}
+
+AllocPolicy& packedWeightPolicy() {
+  static AllocPolicy policy = policyFromEnv();
+  return policy;
+}
+
+// Set by PackedWeightAllocPolicyScope.
+thread_local const AllocPolicy* packedWeightPolicyOverride = nullptr;
+
+} // namespace
+
 void fbgemmAlignedFree(void* p) {
+#ifdef __linux__
+  if (p != nullptr && unmapIfMapped(p)) {
+    return;
+  }
+#endif
 #ifdef _MSC_VER
   _aligned_free(p);
 #else
@@ -453,6 +671,75 @@ void fbgemmAlignedFree(void* p) {
 #endif
 }
 
+std::string AllocPolicy::toString() const {
+  std::string out;
+  switch (hugePages) {
+    case HugePageMode::NONE:
+      out = "4KB pages";
+      break;
+    case HugePageMode::TRANSPARENT:
+      out = "transparent huge pages";
+      break;
+    case HugePageMode::EXPLICIT_2MB:
+      out = "2MB huge pages";
+      break;
+    case HugePageMode::EXPLICIT_1GB:
+      out = "1GB huge pages";
+      break;
+  }
+  switch (numa) {
+    case NumaMode::DEFAULT:
+      break;
+    case NumaMode::BIND:
+      out += ", bound to node " + std::to_string(numaNode);
+      break;
+    case NumaMode::INTERLEAVE:
+      out += ", interleaved";
+      break;
+  }
+  return out;
+}
+
+void* fbgemmAlignedAllocWithPolicy(
+    size_t align,
+    size_t size,
+    const AllocPolicy& policy) {
+#ifdef __linux__
+  if (!policy.isDefault() && size >= policy.minSize && size > 0) {
+    return mapWithPolicy(align, size, policy);
+  }
+#endif
+  return fbgemmAlignedAlloc(align, size);
+}
+
+void fbgemmSetPackedWeightAllocPolicy(const AllocPolicy& policy) {
+  std::lock_guard<std::mutex> lock(packedWeightPolicyMutex());
+  packedWeightPolicy() = policy;
+}
+
+AllocPolicy fbgemmGetPackedWeightAllocPolicy() {
+  if (packedWeightPolicyOverride != nullptr) {
+    return *packedWeightPolicyOverride;
+  }
+  std::lock_guard<std::mutex> lock(packedWeightPolicyMutex());
+  return packedWeightPolicy();
+}
+
+PackedWeightAllocPolicyScope::PackedWeightAllocPolicyScope(
+    const AllocPolicy& policy)
+    : saved_(packedWeightPolicyOverride), policy_(policy) {
+  packedWeightPolicyOverride = &policy_;
+}
+
+PackedWeightAllocPolicyScope::~PackedWeightAllocPolicyScope() {
+  packedWeightPolicyOverride = saved_;
+}
+
+void* fbgemmPackedWeightAlloc(size_t align, size_t size) {
+  return fbgemmAlignedAllocWithPolicy(
+      align, size, fbgemmGetPackedWeightAllocPolicy());
+}
+
 int fbgemmGet2DPartition(
     int m,
     int n,
@@ -582,6 +869,28 @@ thread_type_t fbgemmGetThreadPartition(
 
 namespace {
 
+std::atomic<bool>& skinnyGemmPartition() {
+  static std::atomic<bool> enabled([]() {
+    const char* env_val = std::getenv("FBGEMM_SKINNY_GEMM_PARTITION");
+    return env_val == nullptr || std::atoi(env_val) != 0;
+  }());
+  return enabled;
+}
+
+} // namespace
+
+bool fbgemmIsSkinnyGemm(int m) {
+  constexpr int kSkinnyGemmMaxRows = 64;
+  return m <= kSkinnyGemmMaxRows &&
+      skinnyGemmPartition().load(std::memory_order_relaxed);
+}
+
+void fbgemmSetSkinnyGemmPartition(bool enable) {
+  skinnyGemmPartition().store(enable, std::memory_order_relaxed);
+}
+
+namespace {
+
 // implementation taken from pytorch/c10/util/llvmMathExtras.h
 template <typename T>
 size_t count_leading_zeros(T val) {
@@ -600,151 +909,63 @@ size_t count_leading_zeros(T val) {
   return zero_bits;
 }
 
-// histogram size per thread
-constexpr int RDX_HIST_SIZE = 256;
-
-void update_prefsum_and_offset_in_range(
-    int64_t& offset,
-    const int bins_beg,
-    const int bins_end,
-    const int nthreads,
-    const int64_t* const histogram,
-    int64_t* const histogram_ps) {
-  for (int bins = bins_beg; bins < bins_end; ++bins) {
-    for (int t = 0; t < nthreads; ++t) {
-      histogram_ps[t * RDX_HIST_SIZE + bins] = offset;
-      offset += histogram[t * RDX_HIST_SIZE + bins];
-    }
+// A chunk should amortize the histograms and the thread wakeups of a pass.
+constexpr int64_t RDX_MIN_CHUNK_SIZE = 1 << 14;
+
+// Calls fn(chunk) for every chunk in [0, num_chunks), in parallel on an
+// OpenMP team if fbgemm is built with OpenMP and on the library thread pool
+// otherwise. Either may run fewer threads than there are chunks, so the work
+// of a chunk must not depend on the thread running it.
+template <typename Fn>
+void parallel_for_each_chunk(const int num_chunks, const Fn& fn) {
+  if (num_chunks == 1) {
+    fn(0);
+    return;
   }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_chunks) schedule(static, 1)
+  for (int c = 0; c < num_chunks; ++c) {
+    fn(c);
+  }
+#else
+  internal::runOnDefaultThreadPool(
+      num_chunks, [&](int thread_id, int num_threads) {
+        for (int c = thread_id; c < num_chunks; c += num_threads) {
+          fn(c);
+        }
+      });
+#endif
 }
 
-void combine_prefix_sum(
-    const int nthreads,
-    const int64_t elements_count,
-    const int64_t* const histogram,
-    int64_t* const histogram_ps) {
-  int64_t offset = 0;
-  update_prefsum_and_offset_in_range(
-      offset, 0, RDX_HIST_SIZE, nthreads, histogram, histogram_ps);
-  // TODO(DamianSzwichtenberg): Is assert sufficient? In most cases, it will
-  // work only in debug build.
-  assert(offset == elements_count);
-  // Suppress unused variable warning
-  (void)elements_count;
-}
-
-void combine_prefix_sum_for_msb(
-    const int nthreads,
-    const int64_t elements_count,
-    const int64_t* const histogram,
-    int64_t* const histogram_ps) {
-  int64_t offset = 0;
-  update_prefsum_and_offset_in_range(
-      offset, 128, RDX_HIST_SIZE, nthreads, histogram, histogram_ps);
-  update_prefsum_and_offset_in_range(
-      offset, 0, 128, nthreads, histogram, histogram_ps);
-  // TODO(DamianSzwichtenberg): Is assert sufficient? In most cases, it will
-  // work only in debug build.
-  assert(offset == elements_count);
-  // Suppress unused variable warning
-  (void)elements_count;
-}
-
-template <typename K, typename V>
-void radix_sort_kernel(
-    const K* const input_keys,
-    const V* const input_values,
-    K* const output_keys,
-    V* const output_values,
-    const int64_t elements_count,
-    int64_t* const histogram,
-    int64_t* const histogram_ps,
-    const int pass,
-    const bool pass_with_sign_bit = false) {
-  const auto tid = omp_get_thread_num();
-  const auto nthreads = omp_get_num_threads();
-  const auto elements_count_4 = elements_count / 4 * 4;
-
-  auto* const local_histogram = &histogram[RDX_HIST_SIZE * tid];
-  auto* const local_histogram_ps = &histogram_ps[RDX_HIST_SIZE * tid];
-
-  // Step 1: compute histogram
-  for (int i = 0; i < RDX_HIST_SIZE; i++) {
-    local_histogram[i] = 0;
-  }
-
-#pragma omp for schedule(static)
-  for (int64_t i = 0; i < elements_count_4; i += 4) {
-    const auto key_1 = input_keys[i];
-    const auto key_2 = input_keys[i + 1];
-    const auto key_3 = input_keys[i + 2];
-    const auto key_4 = input_keys[i + 3];
-
-    local_histogram[(key_1 >> (pass * 8)) & 0xFF]++;
-    local_histogram[(key_2 >> (pass * 8)) & 0xFF]++;
-    local_histogram[(key_3 >> (pass * 8)) & 0xFF]++;
-    local_histogram[(key_4 >> (pass * 8)) & 0xFF]++;
-  }
-  if (tid == (nthreads - 1)) {
-    for (int64_t i = elements_count_4; i < elements_count; ++i) {
-      const auto key = input_keys[i];
-      local_histogram[(key >> (pass * 8)) & 0xFF]++;
-    }
+int parallel_max_threads() {
+  // Inside a pool task the other threads of the pool are busy already, so
+  // starting more threads would oversubscribe the machine.
+  if (fbgemmInThreadPool()) {
+    return 1;
   }
-#pragma omp barrier
-  // Step 2: prefix sum
-  if (tid == 0) {
-    if (pass_with_sign_bit) {
-      combine_prefix_sum_for_msb(
-          nthreads, elements_count, histogram, histogram_ps);
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return internal::defaultThreadPoolSize();
+#endif
+}
 
-    } else {
-      combine_prefix_sum(nthreads, elements_count, histogram, histogram_ps);
-    }
-  }
-#pragma omp barrier
-
-  // Step 3: scatter
-#pragma omp for schedule(static)
-  for (int64_t i = 0; i < elements_count_4; i += 4) {
-    const auto key_1 = input_keys[i];
-    const auto key_2 = input_keys[i + 1];
-    const auto key_3 = input_keys[i + 2];
-    const auto key_4 = input_keys[i + 3];
-
-    const int bin_1 = (key_1 >> (pass * 8)) & 0xFF;
-    const int bin_2 = (key_2 >> (pass * 8)) & 0xFF;
-    const int bin_3 = (key_3 >> (pass * 8)) & 0xFF;
-    const int bin_4 = (key_4 >> (pass * 8)) & 0xFF;
-
-    const auto pos_1 = local_histogram_ps[bin_1]++;
-    const auto pos_2 = local_histogram_ps[bin_2]++;
-    const auto pos_3 = local_histogram_ps[bin_3]++;
-    const auto pos_4 = local_histogram_ps[bin_4]++;
-
-    output_keys[pos_1] = key_1;
-    output_values[pos_1] = input_values[i];
-    output_keys[pos_2] = key_2;
-    output_values[pos_2] = input_values[i + 1];
-    output_keys[pos_3] = key_3;
-    output_values[pos_3] = input_values[i + 2];
-    output_keys[pos_4] = key_4;
-    output_values[pos_4] = input_values[i + 3];
-  }
-  if (tid == (nthreads - 1)) {
-    for (int64_t i = elements_count_4; i < elements_count; ++i) {
-      const auto key = input_keys[i];
-      const auto pos = local_histogram_ps[(key >> (pass * 8)) & 0xFF]++;
-      output_keys[pos] = key;
-      output_values[pos] = input_values[i];
+// Widest digit for num_chunks chunks of chunk_size elements. Wider digits
+// save passes over the data as long as the histograms, which are cleared by
+// every chunk and summed up serially, stay small next to the chunks.
+int radix_sort_max_digit_bits(const int64_t chunk_size, const int num_chunks) {
+  for (const int bits : {16, 11}) {
+    if ((int64_t(num_chunks) << bits) * 8 <= chunk_size) {
+      return bits;
     }
   }
+  return 8;
 }
 
-} // namespace
-
+// Least significant digit radix sort, stable. Values are moved along with
+// the keys unless V is void.
 template <typename K, typename V>
-std::pair<K*, V*> radix_sort_parallel(
+std::pair<K*, V*> radix_sort_impl(
     K* const inp_key_buf,
     V* const inp_value_buf,
     K* const tmp_key_buf,
@@ -752,64 +973,158 @@ std::pair<K*, V*> radix_sort_parallel(
     const int64_t elements_count,
     const int64_t max_value,
     const bool maybe_with_neg_vals) {
-  if (max_value == 0) {
+  using UK = typename std::make_unsigned<K>::type;
+  if (max_value == 0 || elements_count <= 1) {
     return {inp_key_buf, inp_value_buf};
   }
 
-  const auto maxthreads = omp_get_max_threads();
-#ifdef _MSC_VER
-  const size_t array_size = (size_t)RDX_HIST_SIZE * maxthreads;
-  // fixes MSVC error C2131
-  auto* const histogram = static_cast<int64_t*>(
-      fbgemm::fbgemmAlignedAlloc(64, array_size * sizeof(int64_t)));
-  auto* const histogram_ps = static_cast<int64_t*>(
-      fbgemm::fbgemmAlignedAlloc(64, array_size * sizeof(int64_t)));
-
-#else
-  alignas(64) int64_t histogram[RDX_HIST_SIZE * maxthreads];
-  alignas(64) int64_t histogram_ps[RDX_HIST_SIZE * maxthreads];
-#endif
   // If negative values are present, we want to perform all passes
   // up to a sign bit
   int num_bits = sizeof(K) * 8;
-  if (!maybe_with_neg_vals)
+  if (!maybe_with_neg_vals) {
     // __builtin_clz is not portable, std::countl_zero is available in C++20
-    num_bits -= count_leading_zeros(
-        static_cast<typename std::make_unsigned<K>::type>(max_value));
-
-  const unsigned int num_passes = (num_bits + 7) / 8;
+    num_bits -= count_leading_zeros(static_cast<UK>(max_value));
+  }
 
-#pragma omp parallel
-  {
-    K* input_keys = inp_key_buf;
-    V* input_values = inp_value_buf;
-    K* output_keys = tmp_key_buf;
-    V* output_values = tmp_value_buf;
-
-    for (unsigned int pass = 0; pass < num_passes; pass++) {
-      radix_sort_kernel(
-          input_keys,
-          input_values,
-          output_keys,
-          output_values,
-          elements_count,
-          histogram,
-          histogram_ps,
-          pass,
-          maybe_with_neg_vals && pass == num_passes - 1);
-
-      std::swap(input_keys, output_keys);
-      std::swap(input_values, output_values);
-#pragma omp barrier
+  const int num_chunks = static_cast<int>(std::min<int64_t>(
+      parallel_max_threads(),
+      std::max<int64_t>(1, elements_count / RDX_MIN_CHUNK_SIZE)));
+  const int max_digit_bits =
+      radix_sort_max_digit_bits(elements_count / num_chunks, num_chunks);
+  const int num_passes = (num_bits + max_digit_bits - 1) / max_digit_bits;
+  // Spread the bits evenly over the passes, e.g. 2 x 12 instead of 16 + 8
+  const int digit_bits = (num_bits + num_passes - 1) / num_passes;
+  const int num_bins = 1 << digit_bits;
+
+  // histogram[c * num_bins + bin] counts the keys of chunk c in bin, and is
+  // then turned into the position of the next such key in the output
+  auto* const histogram = static_cast<int64_t*>(fbgemmAlignedAlloc(
+      64, static_cast<size_t>(num_chunks) * num_bins * sizeof(int64_t)));
+
+  K* input_keys = inp_key_buf;
+  V* input_values = inp_value_buf;
+  K* output_keys = tmp_key_buf;
+  V* output_values = tmp_value_buf;
+
+  for (int pass = 0; pass < num_passes; ++pass) {
+    const int shift = pass * digit_bits;
+    const int pass_bits = std::min(digit_bits, num_bits - shift);
+    const UK mask = static_cast<UK>((UK(1) << (pass_bits - 1)) * 2 - 1);
+    // Negative keys have the sign bit set, flipping it orders them first
+    const UK flip = maybe_with_neg_vals && pass == num_passes - 1
+        ? static_cast<UK>(UK(1) << (pass_bits - 1))
+        : UK(0);
+    const auto digit = [&](const K key) {
+      return static_cast<int>(
+          ((static_cast<UK>(key) >> shift) & mask) ^ flip);
+    };
+
+    // Step 1: compute histogram
+    parallel_for_each_chunk(num_chunks, [&](const int c) {
+      int64_t begin, end;
+      fbgemmPartition1D(c, num_chunks, elements_count, begin, end);
+      int64_t* const local_histogram = histogram + c * num_bins;
+      std::fill(local_histogram, local_histogram + num_bins, 0);
+      int64_t i = begin;
+      for (; i + 4 <= end; i += 4) {
+        local_histogram[digit(input_keys[i])]++;
+        local_histogram[digit(input_keys[i + 1])]++;
+        local_histogram[digit(input_keys[i + 2])]++;
+        local_histogram[digit(input_keys[i + 3])]++;
+      }
+      for (; i < end; ++i) {
+        local_histogram[digit(input_keys[i])]++;
+      }
+    });
+
+    // Step 2: prefix sum, bins major so that the sort is stable. A pass
+    // whose keys all fall into a single bin would not move anything.
+    bool single_bin = false;
+    int64_t offset = 0;
+    for (int bin = 0; bin < num_bins && !single_bin; ++bin) {
+      const int64_t bin_begin = offset;
+      for (int c = 0; c < num_chunks; ++c) {
+        const int64_t count = histogram[c * num_bins + bin];
+        histogram[c * num_bins + bin] = offset;
+        offset += count;
+      }
+      single_bin = offset - bin_begin == elements_count;
+    }
+    if (single_bin) {
+      continue;
     }
+
+    // Step 3: scatter
+    parallel_for_each_chunk(num_chunks, [&](const int c) {
+      int64_t begin, end;
+      fbgemmPartition1D(c, num_chunks, elements_count, begin, end);
+      int64_t* const local_histogram_ps = histogram + c * num_bins;
+      const auto scatter = [&](const int64_t i) {
+        const K key = input_keys[i];
+        const int64_t pos = local_histogram_ps[digit(key)]++;
+        output_keys[pos] = key;
+        if constexpr (!std::is_void<V>::value) {
+          output_values[pos] = input_values[i];
+        }
+      };
+      // Unrolled so that the loads of the next keys overlap the scatter
+      int64_t i = begin;
+      for (; i + 4 <= end; i += 4) {
+        scatter(i);
+        scatter(i + 1);
+        scatter(i + 2);
+        scatter(i + 3);
+      }
+      for (; i < end; ++i) {
+        scatter(i);
+      }
+    });
+
+    std::swap(input_keys, output_keys);
+    std::swap(input_values, output_values);
   }
-#ifdef _MSC_VER
-  fbgemm::fbgemmAlignedFree(histogram);
-  fbgemm::fbgemmAlignedFree(histogram_ps);
-#endif
-  return (
-      num_passes % 2 == 0 ? std::make_pair(inp_key_buf, inp_value_buf)
-                          : std::make_pair(tmp_key_buf, tmp_value_buf));
+
+  fbgemmAlignedFree(histogram);
+  return {input_keys, input_values};
+}
+
+} // namespace
+
+template <typename K, typename V>
+std::pair<K*, V*> radix_sort_parallel(
+    K* const inp_key_buf,
+    V* const inp_value_buf,
+    K* const tmp_key_buf,
+    V* const tmp_value_buf,
+    const int64_t elements_count,
+    const int64_t max_value,
+    const bool maybe_with_neg_vals) {
+  return radix_sort_impl(
+      inp_key_buf,
+      inp_value_buf,
+      tmp_key_buf,
+      tmp_value_buf,
+      elements_count,
+      max_value,
+      maybe_with_neg_vals);
+}
+
+template <typename K>
+K* radix_sort_parallel(
+    K* const inp_key_buf,
+    K* const tmp_key_buf,
+    const int64_t elements_count,
+    const int64_t max_value,
+    const bool maybe_with_neg_vals) {
+  return radix_sort_impl<K, void>(
+             inp_key_buf,
+             nullptr,
+             tmp_key_buf,
+             nullptr,
+             elements_count,
+             max_value,
+             maybe_with_neg_vals)
+      .first;
 }
 
 #define FORALL_INT_TYPES_AND_KEY(key_t, _) \
@@ -840,6 +1155,162 @@ using pair_int_float = std::pair<int, float>;
 INSTANTIATE(int, pair_int_double);
 INSTANTIATE(int, pair_int_float);
 
+#define INSTANTIATE_KEYS_ONLY(key_t)                      \
+  template FBGEMM_API key_t* radix_sort_parallel<key_t>( \
+      key_t* const inp_key_buf,                           \
+      key_t* const tmp_key_buf,                           \
+      const int64_t elements_count,                       \
+      const int64_t max_value,                            \
+      const bool maybe_with_neg_vals)
+
+INSTANTIATE_KEYS_ONLY(uint8_t);
+INSTANTIATE_KEYS_ONLY(int8_t);
+INSTANTIATE_KEYS_ONLY(int16_t);
+INSTANTIATE_KEYS_ONLY(int);
+INSTANTIATE_KEYS_ONLY(int64_t);
+
+#undef INSTANTIATE_KEYS_ONLY
+
+template <typename K, typename I>
+int64_t unique_parallel(
+    const K* const keys,
+    const int64_t elements_count,
+    const int64_t max_value,
+    K* const unique_keys,
+    I* const inverse,
+    I* const counts,
+    I* const sorted_positions,
+    const bool maybe_with_neg_vals) {
+  if (elements_count == 0) {
+    return 0;
+  }
+  assert(elements_count <= std::numeric_limits<I>::max());
+
+  // Without inverse and positions only the keys need sorting
+  const bool with_positions = inverse || sorted_positions;
+  const int num_chunks = static_cast<int>(std::min<int64_t>(
+      parallel_max_threads(),
+      std::max<int64_t>(1, elements_count / RDX_MIN_CHUNK_SIZE)));
+
+  auto* const key_buf = static_cast<K*>(
+      fbgemmAlignedAlloc(64, 2 * elements_count * sizeof(K)));
+  // Positions need two buffers for sorting; after sorting, one of them is
+  // free again to hold where every run of equal keys starts.
+  auto* const pos_buf = static_cast<I*>(fbgemmAlignedAlloc(
+      64, (with_positions ? 2 : 1) * elements_count * sizeof(I)));
+
+  parallel_for_each_chunk(num_chunks, [&](const int c) {
+    int64_t begin, end;
+    fbgemmPartition1D(c, num_chunks, elements_count, begin, end);
+    std::copy(keys + begin, keys + end, key_buf + begin);
+    if (with_positions) {
+      for (int64_t i = begin; i < end; ++i) {
+        pos_buf[i] = static_cast<I>(i);
+      }
+    }
+  });
+
+  K* sorted_keys = nullptr;
+  I* sorted_pos = nullptr;
+  I* run_starts = pos_buf;
+  if (with_positions) {
+    std::tie(sorted_keys, sorted_pos) = radix_sort_parallel(
+        key_buf,
+        pos_buf,
+        key_buf + elements_count,
+        pos_buf + elements_count,
+        elements_count,
+        max_value,
+        maybe_with_neg_vals);
+    run_starts = sorted_pos == pos_buf ? pos_buf + elements_count : pos_buf;
+  } else {
+    sorted_keys = radix_sort_parallel(
+        key_buf,
+        key_buf + elements_count,
+        elements_count,
+        max_value,
+        maybe_with_neg_vals);
+  }
+
+  // Step 1: count the segment boundaries in every chunk
+  std::vector<int64_t> runs_ps(num_chunks + 1, 0);
+  parallel_for_each_chunk(num_chunks, [&](const int c) {
+    int64_t begin, end;
+    fbgemmPartition1D(c, num_chunks, elements_count, begin, end);
+    int64_t runs = 0;
+    for (int64_t i = begin; i < end; ++i) {
+      runs += i == 0 || sorted_keys[i] != sorted_keys[i - 1];
+    }
+    runs_ps[c + 1] = runs;
+  });
+
+  // Step 2: prefix sum over chunks
+  for (int c = 0; c < num_chunks; ++c) {
+    runs_ps[c + 1] += runs_ps[c];
+  }
+  const int64_t num_unique = runs_ps[num_chunks];
+
+  // Step 3: number the runs. A chunk that starts in the middle of a run
+  // continues the last run of the previous chunk.
+  parallel_for_each_chunk(num_chunks, [&](const int c) {
+    int64_t begin, end;
+    fbgemmPartition1D(c, num_chunks, elements_count, begin, end);
+    int64_t u = runs_ps[c] - 1;
+    for (int64_t i = begin; i < end; ++i) {
+      if (i == 0 || sorted_keys[i] != sorted_keys[i - 1]) {
+        ++u;
+        unique_keys[u] = sorted_keys[i];
+        run_starts[u] = static_cast<I>(i);
+      }
+      if (inverse) {
+        inverse[sorted_pos[i]] = static_cast<I>(u);
+      }
+    }
+    if (sorted_positions) {
+      std::copy(sorted_pos + begin, sorted_pos + end, sorted_positions + begin);
+    }
+  });
+
+  // Step 4: counts are the distances between the run starts
+  if (counts) {
+    parallel_for_each_chunk(num_chunks, [&](const int c) {
+      int64_t begin, end;
+      fbgemmPartition1D(c, num_chunks, num_unique, begin, end);
+      for (int64_t u = begin; u < end; ++u) {
+        const int64_t next =
+            u + 1 < num_unique ? run_starts[u + 1] : elements_count;
+        counts[u] = static_cast<I>(next - run_starts[u]);
+      }
+    });
+  }
+
+  fbgemmAlignedFree(key_buf);
+  fbgemmAlignedFree(pos_buf);
+  return num_unique;
+}
+
+#define INSTANTIATE_UNIQUE(key_t, idx_t)                     \
+  template FBGEMM_API int64_t unique_parallel<key_t, idx_t>( \
+      const key_t* const keys,                               \
+      const int64_t elements_count,                          \
+      const int64_t max_value,                               \
+      key_t* const unique_keys,                              \
+      idx_t* const inverse,                                  \
+      idx_t* const counts,                                   \
+      idx_t* const sorted_positions,                         \
+      const bool maybe_with_neg_vals)
+
+INSTANTIATE_UNIQUE(int, int);
+INSTANTIATE_UNIQUE(int, int64_t);
+INSTANTIATE_UNIQUE(int64_t, int);
+INSTANTIATE_UNIQUE(int64_t, int64_t);
+
+#undef INSTANTIATE_UNIQUE
+
+bool is_radix_sort_accelerated() {
+  return parallel_max_threads() > 1;
+}
+
 bool is_radix_sort_accelerated_with_openmp() {
 #ifdef _OPENMP
   return true;
@@ -848,6 +1319,135 @@ bool is_radix_sort_accelerated_with_openmp() {
 #endif
 }
 
+namespace {
+
+// Number of NUMA nodes with online CPUs or memory, from the highest id in
+// /sys/devices/system/node/online, e.g. "0-1" or "0,2-3".
+int detectNumNumaNodes() {
+#ifdef __linux__
+  FILE* f = std::fopen("/sys/devices/system/node/online", "r");
+  if (f == nullptr) {
+    return 1;
+  }
+  char buf[256] = {};
+  const size_t len = std::fread(buf, 1, sizeof(buf) - 1, f);
+  std::fclose(f);
+  int maxNode = 0;
+  int cur = 0;
+  bool inNumber = false;
+  for (size_t i = 0; i < len; ++i) {
+    if (buf[i] >= '0' && buf[i] <= '9') {
+      cur = cur * 10 + (buf[i] - '0');
+      inNumber = true;
+    } else {
+      if (inNumber) {
+        maxNode = std::max(maxNode, cur);
+      }
+      cur = 0;
+      inNumber = false;
+    }
+  }
+  if (inNumber) {
+    maxNode = std::max(maxNode, cur);
+  }
+  return maxNode + 1;
+#else
+  return 1;
+#endif
+}
+
+// NUMA node of each CPU, from /sys/devices/system/node/node<N>/cpulist, e.g.
+// "0-15,32-47". CPUs that are not listed are on node 0.
+std::vector<int> detectCpuNumaNodes() {
+  std::vector<int> cpuNodes;
+#ifdef __linux__
+  constexpr long kMaxCpus = 1 << 16;
+  const int numNodes = detectNumNumaNodes();
+  for (int node = 0; node < numNodes; ++node) {
+    const std::string path = "/sys/devices/system/node/node" +
+        std::to_string(node) + "/cpulist";
+    FILE* f = std::fopen(path.c_str(), "r");
+    if (f == nullptr) {
+      continue;
+    }
+    char buf[4096] = {};
+    std::fread(buf, 1, sizeof(buf) - 1, f);
+    std::fclose(f);
+    const char* cur = buf;
+    while (true) {
+      char* end = nullptr;
+      const long first = std::strtol(cur, &end, 10);
+      if (end == cur || first < 0 || first >= kMaxCpus) {
+        break;
+      }
+      long last = first;
+      if (*end == '-') {
+        cur = end + 1;
+        last = std::strtol(cur, &end, 10);
+        if (end == cur || last < first || last >= kMaxCpus) {
+          break;
+        }
+      }
+      if (static_cast<size_t>(last) >= cpuNodes.size()) {
+        cpuNodes.resize(last + 1, 0);
+      }
+      std::fill(cpuNodes.begin() + first, cpuNodes.begin() + last + 1, node);
+      if (*end != ',') {
+        break;
+      }
+      cur = end + 1;
+    }
+  }
+#endif
+  return cpuNodes;
+}
+
+std::atomic<int>& emulatedNumaNodes() {
+  static std::atomic<int> numNodes([]() {
+    const char* env_val = std::getenv("FBGEMM_EMULATE_NUMA_NODES");
+    return env_val != nullptr ? std::max(0, std::atoi(env_val)) : 0;
+  }());
+  return numNodes;
+}
+
+} // namespace
+
+int fbgemmGetNumNumaNodes() {
+  const int emulated = emulatedNumaNodes().load(std::memory_order_relaxed);
+  if (emulated > 0) {
+    return emulated;
+  }
+  static const int numNodes = detectNumNumaNodes();
+  return numNodes;
+}
+
+int fbgemmGetCurrentNumaNode() {
+#ifdef __linux__
+  // sched_getcpu goes through the vDSO, unlike the getcpu system call, so
+  // this is cheap enough to call on every GEMM
+  const int cpu = sched_getcpu();
+  if (cpu < 0) {
+    return 0;
+  }
+  const int emulated = emulatedNumaNodes().load(std::memory_order_relaxed);
+  if (emulated > 0) {
+    return cpu % emulated;
+  }
+  static const std::vector<int> cpuNodes = detectCpuNumaNodes();
+  return static_cast<size_t>(cpu) < cpuNodes.size() ? cpuNodes[cpu] : 0;
+#else
+  return 0;
+#endif
+}
+
+void fbgemmSetEmulatedNumaNodes(int num_nodes) {
+  emulatedNumaNodes().store(std::max(0, num_nodes), std::memory_order_relaxed);
+}
+
+bool fbgemmIsNumaEmulated() {
+  return emulatedNumaNodes().load(std::memory_order_relaxed) > 0;
+}
+
 bool is_autovec_disabled() {
   static bool res;
   static bool called_once = false;
@@ -41,9 +41,10 @@ struct ISA {
 
 enum class DataType { Float32, Float16, BFloat16 };
 
-std::array<std::pair<DataType, std::string>, 2> types_to_gen = {
+std::array<std::pair<DataType, std::string>, 3> types_to_gen = {
     std::make_pair(DataType::Float32, "FP32"),
-    std::make_pair(DataType::Float16, "FP16")};
+    std::make_pair(DataType::Float16, "FP16"),
+    std::make_pair(DataType::BFloat16, "BF16")};
 
 constexpr int cache_line_size = 64;
 constexpr int prefetch_len_default = cache_line_size * 12;
@@ -86,8 +87,9 @@ int main(int argc, const char* argv[]) {
   bool disable = false;
   unordered_set<string> enabledDataType;
 
-  // Always generate FP16
+  // Always generate FP16 and BF16
   enabledDataType.insert("FP16");
+  enabledDataType.insert("BF16");
   if (parseArgumentBool(argc, argv, "--fp32", false)) {
     enabledDataType.insert("FP32");
   }
@@ -215,8 +217,17 @@ int main(int argc, const char* argv[]) {
           return "fp32";
         if (d_type.first == DataType::Float16)
           return "fp16";
+        if (d_type.first == DataType::BFloat16)
+          return "bf16";
         throw std::runtime_error("Unknow DataType");
       }();
+      string const B_ctype = [&]() {
+        if (d_type.first == DataType::Float32)
+          return "float";
+        if (d_type.first == DataType::Float16)
+          return "float16";
+        return "BFloat16";
+      }();
 
       string isa_file_name = "Fbgemm" + d_type.second + "UKernels" + s.name;
 
@@ -241,8 +252,8 @@ int main(int argc, const char* argv[]) {
       hdrfile << "#include \"fbgemm/FbgemmBuild.h\"\n";
       hdrfile << "#include \"fbgemm/FbgemmFPCommon.h\"\n\n";
       hdrfile << "namespace fbgemm {\n\n";
-      hdrfile << "using GemmParams" << d_type.second << " = GemmParams<float"
-              << (isFp16 ? "16" : "") << ">;\n\n";
+      hdrfile << "using GemmParams" << d_type.second << " = GemmParams<"
+              << B_ctype << ">;\n\n";
 
       unsigned labelId = 0;
 
@@ -337,6 +348,15 @@ int main(int argc, const char* argv[]) {
                     (s.iset == ISA::isaType::avx512 ? "YMM" : "XMM") +
                     "WORD PTR [r10 + " + to_string(vec_len_in_bytes / 2 * c) +
                     "]");
+          } else if (d_type.first == DataType::BFloat16) {
+            // bf16 is the upper half of fp32: zero-extend and shift into place
+            addi(
+                srcfile,
+                "vpmovzxwd " + vBcol + "," +
+                    (s.iset == ISA::isaType::avx512 ? "YMM" : "XMM") +
+                    "WORD PTR [r10 + " + to_string(vec_len_in_bytes / 2 * c) +
+                    "]");
+            addi(srcfile, "vpslld " + vBcol + "," + vBcol + ",16");
           }
           if (prefetch_len && ((vec_len_in_bytes * c) % cache_line_size == 0)) {
             addi(
@@ -11,6 +11,7 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include "fbgemm/Utils.h"
 
 using namespace std;
 
@@ -326,4 +327,81 @@ CREATE_INSTANCE(false, QuantizationGranularity::TENSOR)
 CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL)
 #undef CREATE_INSTANCE
 
+template <
+    bool FUSE_RELU,
+    QuantizationGranularity Q_GRAN,
+    int NNZ,
+    int GROUP>
+void sparseDenseInt8MMRef(
+    int N,
+    const std::unique_ptr<NMSparseMatrix<int8_t, NNZ, GROUP>>& nm,
+    const uint8_t* B,
+    int ldb,
+    int32_t* C_i32,
+    uint8_t* C_u8,
+    int ldc,
+    trRequantizationParams_t& rParams,
+    bool accum,
+    int thread_id,
+    int num_threads) {
+  // Calcualtes accum ? C += A * B : C = A * B
+  int64_t row_start = 0, row_end = 0;
+  fbgemmPartition1D(thread_id, num_threads, nm->R, row_start, row_end);
+  if (row_start >= row_end) {
+    return;
+  }
+  const int numGroups = nm->numGroups();
+  const int stride = nm->valuesStride();
+  for (int i = row_start; i < row_end; ++i) {
+    if (!accum) {
+      for (int j = 0; j < N; ++j) {
+        C_i32[i * ldc + j] = 0;
+      }
+    }
+    const int8_t* rowValues = nm->values.data() + i * stride;
+    for (int g = 0; g < numGroups; ++g) {
+      for (int p = 0; p < GROUP; ++p) {
+        if (!(nm->meta[i * numGroups + g] & (1U << p))) {
+          continue;
+        }
+        int32_t a = *rowValues++;
+        int k = g * GROUP + p;
+        if (k >= nm->C) {
+          continue;
+        }
+        for (int j = 0; j < N; ++j) {
+          C_i32[i * ldc + j] += a * static_cast<int32_t>(B[k * ldb + j]);
+        }
+      }
+    }
+  }
+  block_type_t block{
+      static_cast<int>(row_start), static_cast<int>(row_end - row_start), 0, N};
+  trRequantizeRef<FUSE_RELU, Q_GRAN>(
+      C_u8, C_i32 + row_start * ldc, block, ldc, ldc, rParams);
+}
+
+#define CREATE_INSTANCE(FUSE_RELU, QGRAN, NNZ, GROUP)                 \
+  template void sparseDenseInt8MMRef<FUSE_RELU, QGRAN>(              \
+      int N,                                                         \
+      const std::unique_ptr<NMSparseMatrix<int8_t, NNZ, GROUP>>& nm, \
+      const uint8_t* B,                                              \
+      int ldb,                                                       \
+      int32_t* C_i32,                                                \
+      uint8_t* C_u8,                                                 \
+      int ldc,                                                       \
+      trRequantizationParams_t& rParams,                             \
+      bool accum,                                                    \
+      int thread_id,                                                 \
+      int num_threads);
+#define CREATE_INSTANCE_NM(NNZ, GROUP)                                     \
+  CREATE_INSTANCE(true, QuantizationGranularity::TENSOR, NNZ, GROUP)      \
+  CREATE_INSTANCE(true, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP) \
+  CREATE_INSTANCE(false, QuantizationGranularity::TENSOR, NNZ, GROUP)     \
+  CREATE_INSTANCE(false, QuantizationGranularity::OUT_CHANNEL, NNZ, GROUP)
+CREATE_INSTANCE_NM(2, 4)
+CREATE_INSTANCE_NM(1, 4)
+#undef CREATE_INSTANCE_NM
+#undef CREATE_INSTANCE
+
 } // namespace fbgemm
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "./TestUtils.h"
+#include "bench/BenchUtils.h"
+#include "fbgemm/Fbgemm.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+vector<AllocPolicy> GetPolicies_() {
+  vector<AllocPolicy> policies;
+  for (auto hugePages :
+       {HugePageMode::NONE,
+        HugePageMode::TRANSPARENT,
+        HugePageMode::EXPLICIT_2MB,
+        HugePageMode::EXPLICIT_1GB}) {
+    for (auto numa :
+         {NumaMode::DEFAULT, NumaMode::BIND, NumaMode::INTERLEAVE}) {
+      AllocPolicy policy;
+      policy.hugePages = hugePages;
+      policy.numa = numa;
+      policy.minSize = 0;
+      policies.push_back(policy);
+    }
+  }
+  return policies;
+}
+
+} // namespace
+
+TEST(AllocPolicyTest, AllocFree) {
+  // Explicit huge pages are usually not reserved on test machines, which
+  // exercises the fallbacks.
+  for (const AllocPolicy& policy : GetPolicies_()) {
+    for (size_t align : {64, 4096, 1 << 22}) {
+      for (size_t size : {1, 1000, 3 << 20}) {
+        auto* p = static_cast<uint8_t*>(
+            fbgemmAlignedAllocWithPolicy(align, size, policy));
+        ASSERT_NE(p, nullptr) << policy.toString();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % align, 0u)
+            << policy.toString() << " align " << align << " size " << size;
+        memset(p, 0xab, size);
+        EXPECT_EQ(p[0], 0xab);
+        EXPECT_EQ(p[size - 1], 0xab);
+        fbgemmAlignedFree(p);
+      }
+    }
+  }
+  // Small allocations and malloc'ed memory are freed the same way.
+  AllocPolicy policy;
+  policy.hugePages = HugePageMode::TRANSPARENT;
+  void* small = fbgemmAlignedAllocWithPolicy(64, 100, policy);
+  void* mapped = fbgemmAlignedAllocWithPolicy(64, 4 << 20, policy);
+  void* plain = fbgemmAlignedAlloc(64, 100);
+  fbgemmAlignedFree(small);
+  fbgemmAlignedFree(plain);
+  fbgemmAlignedFree(mapped);
+  fbgemmAlignedFree(nullptr);
+}
+
+TEST(AllocPolicyTest, PackedWeights) {
+  const AllocPolicy saved = fbgemmGetPackedWeightAllocPolicy();
+  constexpr int k = 1024, n = 1024;
+  aligned_vector<int8_t> B(k * n);
+  randFill<int8_t>(B, -128, 127);
+  for (const AllocPolicy& policy : GetPolicies_()) {
+    fbgemmSetPackedWeightAllocPolicy(policy);
+    EXPECT_EQ(fbgemmGetPackedWeightAllocPolicy().hugePages, policy.hugePages);
+    PackBMatrix<int8_t> packedB(
+        matrix_op_t::NoTranspose, k, n, B.data(), n, nullptr, 1);
+    aligned_vector<int8_t> unpacked(k * n, 0);
+    packedB.unpack(unpacked.data());
+    EXPECT_EQ(B, unpacked) << policy.toString();
+  }
+  fbgemmSetPackedWeightAllocPolicy(saved);
+}
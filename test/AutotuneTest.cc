@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "./TestUtils.h"
+#include "bench/BenchUtils.h"
+#include "fbgemm/Fbgemm.h"
+#include "fbgemm/FbgemmAutotune.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+class AutotuneTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    fbgemmClearTunedBlockingFactors();
+    path_ = testing::TempDir() + "fbgemm_autotune_" +
+        testing::UnitTest::GetInstance()->current_test_info()->name();
+  }
+
+  void TearDown() override {
+    fbgemmClearTunedBlockingFactors();
+    remove(path_.c_str());
+  }
+
+  string path_;
+};
+
+template <typename accT, inst_set_t ISA>
+BlockingFactors GetTraitsParams_() {
+  using Traits = PackingTraits<uint8_t, accT, ISA>;
+  BlockingFactors params;
+  params.MR = Traits::MR;
+  params.NR = Traits::NR;
+  params.NR_MIN = Traits::NR_MIN;
+  params.ROW_INTERLEAVE = Traits::ROW_INTERLEAVE;
+  params.MCB = Traits::MCB;
+  params.KCB = Traits::KCB;
+  params.NCB = Traits::NCB;
+  return params;
+}
+
+// Default blocking factors of this machine
+template <typename accT>
+BlockingFactors GetDefaultParams_() {
+  switch (fbgemmInstructionSet()) {
+    case inst_set_t::avx512_vnni:
+      return GetTraitsParams_<accT, inst_set_t::avx512_vnni>();
+    case inst_set_t::avx512_vnni_ymm:
+      return GetTraitsParams_<accT, inst_set_t::avx512_vnni_ymm>();
+    case inst_set_t::avx512:
+      return GetTraitsParams_<accT, inst_set_t::avx512>();
+    case inst_set_t::avx512_ymm:
+      return GetTraitsParams_<accT, inst_set_t::avx512_ymm>();
+    default:
+      return GetTraitsParams_<accT, inst_set_t::avx2>();
+  }
+}
+
+bool SameParams_(const BlockingFactors& a, const BlockingFactors& b) {
+  return a.MR == b.MR && a.NR == b.NR && a.NR_MIN == b.NR_MIN &&
+      a.ROW_INTERLEAVE == b.ROW_INTERLEAVE && a.MCB == b.MCB &&
+      a.KCB == b.KCB && a.NCB == b.NCB;
+}
+
+// Runs fbgemmPacked without blocking factors, so that it and the packing
+// classes look the shape up in the tuning table.
+aligned_vector<int32_t> RunGemm_(
+    int m,
+    int n,
+    int k,
+    int groups,
+    const aligned_vector<uint8_t>& A,
+    PackBMatrix<int8_t>& packedB) {
+  aligned_vector<int32_t> C(m * n * groups);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    PackAMatrix<uint8_t> packA(
+        matrix_op_t::NoTranspose,
+        m,
+        k * groups,
+        A.data(),
+        k * groups,
+        nullptr,
+        groups);
+    DoNothing<int32_t, int32_t> doNothingObj{};
+    memCopy<> outputProcObj(doNothingObj);
+    fbgemmPacked(
+        packA,
+        packedB,
+        C.data(),
+        C.data(),
+        n * groups,
+        outputProcObj,
+        fbgemm_get_thread_num(),
+        fbgemm_get_num_threads());
+  }
+  return C;
+}
+
+} // namespace
+
+TEST_F(AutotuneTest, Table) {
+  const BlockingFactors def = GetDefaultParams_<int32_t>();
+  BlockingFactors params = def;
+  params.KCB = 128;
+  params.NCB = 2 * params.NR;
+  params.MCB = 4 * params.MR;
+
+  EXPECT_TRUE(fbgemmAddTunedBlockingFactors(64, 96, 300, params));
+  BlockingFactors found;
+  ASSERT_TRUE(fbgemmGetTunedBlockingFactors(64, 96, 300, &found));
+  EXPECT_TRUE(SameParams_(found, params));
+  EXPECT_FALSE(fbgemmGetTunedBlockingFactors(65, 96, 300, &found));
+  EXPECT_FALSE(fbgemmGetTunedBlockingFactors<int16_t>(64, 96, 300, &found));
+
+  // One KCB per K and one NCB per (N, K)
+  BlockingFactors other = params;
+  other.KCB = 64;
+  EXPECT_FALSE(fbgemmAddTunedBlockingFactors(32, 96, 300, other));
+  other = params;
+  other.NCB = params.NR;
+  EXPECT_FALSE(fbgemmAddTunedBlockingFactors(32, 96, 300, other));
+  EXPECT_TRUE(fbgemmAddTunedBlockingFactors(32, 48, 300, other));
+  EXPECT_TRUE(fbgemmAddTunedBlockingFactors(32, 96, 300, params));
+  // Replacing the only entry of a K is not a conflict
+  EXPECT_TRUE(fbgemmAddTunedBlockingFactors(16, 16, 64, def));
+  other = def;
+  other.KCB = 64;
+  EXPECT_TRUE(fbgemmAddTunedBlockingFactors(16, 16, 64, other));
+
+  // Blocks larger than the defaults and invalid factors are rejected
+  other = params;
+  other.MCB = def.MCB + other.MR;
+  EXPECT_FALSE(fbgemmAddTunedBlockingFactors(8, 8, 8, other));
+  other = params;
+  other.KCB = 2 * def.KCB;
+  EXPECT_FALSE(fbgemmAddTunedBlockingFactors(8, 8, 8, other));
+  other = params;
+  other.NCB = params.NR + 1;
+  EXPECT_FALSE(fbgemmAddTunedBlockingFactors(8, 8, 8, other));
+  other = params;
+  other.ROW_INTERLEAVE = 2;
+  EXPECT_FALSE(fbgemmAddTunedBlockingFactors(8, 8, 8, other));
+  EXPECT_FALSE(fbgemmAddTunedBlockingFactors(0, 8, 8, params));
+
+  // 16-bit accumulation runs with 32-bit kernels on VNNI
+  EXPECT_EQ(
+      fbgemmAddTunedBlockingFactors<int16_t>(
+          64, 96, 300, GetDefaultParams_<int16_t>()),
+      !fbgemmHasAvx512VnniSupport());
+
+  EXPECT_EQ(
+      fbgemmNumTunedBlockingFactors(),
+      fbgemmHasAvx512VnniSupport() ? 4 : 5);
+  fbgemmClearTunedBlockingFactors();
+  EXPECT_EQ(fbgemmNumTunedBlockingFactors(), 0);
+  EXPECT_FALSE(fbgemmGetTunedBlockingFactors(64, 96, 300, &found));
+}
+
+TEST_F(AutotuneTest, SaveLoad) {
+  const BlockingFactors def = GetDefaultParams_<int32_t>();
+  BlockingFactors params = def;
+  params.KCB = 128;
+  ASSERT_TRUE(fbgemmAddTunedBlockingFactors(64, 96, 300, params));
+  ASSERT_TRUE(fbgemmAddTunedBlockingFactors(1, 96, 300, params));
+  ASSERT_TRUE(fbgemmSaveTunedBlockingFactors(path_));
+
+  fbgemmClearTunedBlockingFactors();
+  EXPECT_EQ(fbgemmLoadTunedBlockingFactors(path_), 2);
+  BlockingFactors found;
+  ASSERT_TRUE(fbgemmGetTunedBlockingFactors(1, 96, 300, &found));
+  EXPECT_TRUE(SameParams_(found, params));
+  // Entries already in the table are not loaded again
+  EXPECT_EQ(fbgemmLoadTunedBlockingFactors(path_), 0);
+  EXPECT_EQ(fbgemmNumTunedBlockingFactors(), 2);
+
+  // Entries of other instruction sets are carried along
+  {
+    ofstream out(path_, ios::app);
+    out << (fbgemmInstructionSet() == inst_set_t::avx2 ? "avx512" : "avx2")
+        << " 32 64 96 300 48 16 256 1 16 16 4\n";
+  }
+  fbgemmClearTunedBlockingFactors();
+  EXPECT_EQ(fbgemmLoadTunedBlockingFactors(path_), 3);
+  EXPECT_EQ(fbgemmNumTunedBlockingFactors(), 3);
+
+  {
+    ofstream out(path_, ios::app);
+    out << "avx2 32 64 96\n";
+  }
+  EXPECT_EQ(fbgemmLoadTunedBlockingFactors(path_), -1);
+  {
+    ofstream out(path_);
+    out << "not a tuning table\n";
+  }
+  EXPECT_EQ(fbgemmLoadTunedBlockingFactors(path_), -1);
+  EXPECT_EQ(fbgemmLoadTunedBlockingFactors(path_ + ".missing"), -1);
+}
+
+TEST_F(AutotuneTest, PackWithTunedFactors) {
+  constexpr int m = 70, n = 100, k = 300, groups = 2;
+  aligned_vector<uint8_t> A(m * k * groups);
+  aligned_vector<int8_t> B(k * groups * n);
+  randFill<uint8_t>(A, 0, 255);
+  randFill<int8_t>(B, -128, 127);
+
+  PackBMatrix<int8_t> packedBDefault(
+      matrix_op_t::NoTranspose, k * groups, n, B.data(), n, nullptr, groups);
+  EXPECT_EQ(packedBDefault.tunedBlockingFactors(), nullptr);
+  const auto C_ref = RunGemm_(m, n, k, groups, A, packedBDefault);
+
+  const BlockingFactors def = GetDefaultParams_<int32_t>();
+  BlockingFactors small = def;
+  small.KCB = 64;
+  small.NCB = small.NR;
+  small.MCB = small.MR;
+  BlockingFactors large = def;
+  large.KCB = 64;
+  large.NCB = 2 * large.NR;
+  ASSERT_TRUE(fbgemmAddTunedBlockingFactors(1, n, k, small));
+  ASSERT_FALSE(fbgemmAddTunedBlockingFactors(m, n, k, large));
+  large.NCB = small.NCB;
+  ASSERT_TRUE(fbgemmAddTunedBlockingFactors(m, n, k, large));
+
+  // B is packed with the entry of the largest M
+  PackBMatrix<int8_t> packedB(
+      matrix_op_t::NoTranspose, k * groups, n, B.data(), n, nullptr, groups);
+  const BlockingFactors* tuned = packedB.tunedBlockingFactors();
+  ASSERT_NE(tuned, nullptr);
+  EXPECT_TRUE(SameParams_(*tuned, large));
+  EXPECT_EQ(packedB.blockRowSize(), large.KCB);
+  EXPECT_EQ(packedB.blockColSize(), large.NCB);
+  aligned_vector<int8_t> unpacked(B.size());
+  packedB.unpack(unpacked.data());
+  EXPECT_EQ(unpacked, B);
+
+  EXPECT_EQ(RunGemm_(m, n, k, groups, A, packedB), C_ref);
+  // Other M use their own entry if there is one, else the factors of B
+  EXPECT_EQ(
+      RunGemm_(1, n, k, groups, A, packedB),
+      aligned_vector<int32_t>(C_ref.begin(), C_ref.begin() + n * groups));
+  EXPECT_EQ(
+      RunGemm_(3, n, k, groups, A, packedB),
+      aligned_vector<int32_t>(C_ref.begin(), C_ref.begin() + 3 * n * groups));
+
+  // B prepacked before tuning keeps running with the defaults
+  EXPECT_EQ(RunGemm_(m, n, k, groups, A, packedBDefault), C_ref);
+  EXPECT_EQ(
+      RunGemm_(1, n, k, groups, A, packedBDefault),
+      aligned_vector<int32_t>(C_ref.begin(), C_ref.begin() + n * groups));
+}
+
+TEST_F(AutotuneTest, PackBWithTunedKcbOfOtherN) {
+  constexpr int m = 30, n = 100, k = 300, n_other = 52;
+  BlockingFactors tuned = GetDefaultParams_<int32_t>();
+  tuned.KCB = 64;
+  ASSERT_TRUE(fbgemmAddTunedBlockingFactors(m, n, k, tuned));
+
+  // (n_other, k) has no entry, B is packed with the tuned KCB of k
+  aligned_vector<uint8_t> A(m * k);
+  aligned_vector<int8_t> B(k * n_other);
+  randFill<uint8_t>(A, 0, 255);
+  randFill<int8_t>(B, -128, 127);
+  PackBMatrix<int8_t> packedB(
+      matrix_op_t::NoTranspose, k, n_other, B.data(), n_other, nullptr, 1);
+  ASSERT_NE(packedB.tunedBlockingFactors(), nullptr);
+  EXPECT_EQ(packedB.blockRowSize(), tuned.KCB);
+  EXPECT_EQ(packedB.blockColSize(), GetDefaultParams_<int32_t>().NCB);
+
+  aligned_vector<int32_t> C_ref(m * n_other);
+  matmul_u8i8acc32_ref(
+      m, n_other, k, k, n_other, n_other, A.data(), B.data(), C_ref.data());
+  EXPECT_EQ(RunGemm_(m, n_other, k, 1, A, packedB), C_ref);
+}
+
+TEST_F(AutotuneTest, Autotune) {
+  constexpr int m = 40, n = 72, k = 200;
+  AutotuneOptions options;
+  options.warmupIterations = 0;
+  options.iterations = 1;
+  options.maxCandidates = 6;
+  const BlockingFactors best = fbgemmAutotuneBlockingFactors(m, n, k, options);
+  BlockingFactors found;
+  ASSERT_TRUE(fbgemmGetTunedBlockingFactors(m, n, k, &found));
+  EXPECT_TRUE(SameParams_(found, best));
+  EXPECT_LE(best.MCB, GetDefaultParams_<int32_t>().MCB);
+  EXPECT_LE(best.KCB, GetDefaultParams_<int32_t>().KCB);
+
+  // Tuning another M keeps the KCB and NCB of (N, K)
+  options.addToTable = false;
+  const BlockingFactors other = fbgemmAutotuneBlockingFactors(1, n, k, options);
+  EXPECT_EQ(other.KCB, best.KCB);
+  EXPECT_EQ(other.NCB, best.NCB);
+  EXPECT_EQ(fbgemmNumTunedBlockingFactors(), 1);
+
+  aligned_vector<uint8_t> A(m * k);
+  aligned_vector<int8_t> B(k * n);
+  randFill<uint8_t>(A, 0, 255);
+  randFill<int8_t>(B, -128, 127);
+  PackBMatrix<int8_t> packedB(
+      matrix_op_t::NoTranspose, k, n, B.data(), n, nullptr, 1);
+  aligned_vector<int32_t> C_ref(m * n);
+  matmul_u8i8acc32_ref(m, n, k, k, n, n, A.data(), B.data(), C_ref.data());
+  EXPECT_EQ(RunGemm_(m, n, k, 1, A, packedB), C_ref);
+
+  EXPECT_THROW(fbgemmAutotuneBlockingFactors(0, n, k), runtime_error);
+}
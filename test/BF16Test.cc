@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "./FBGemmFPTest.h"
+#include "fbgemm/FbgemmBF16.h"
+
+using FBGemmBF16Test = fbgemm::FBGemmFPTest<fbgemm::BFloat16>;
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    FBGemmBF16Test,
+    ::testing::Values(
+      std::pair<fbgemm::matrix_op_t, fbgemm::matrix_op_t>(
+          fbgemm::matrix_op_t::NoTranspose, fbgemm::matrix_op_t::NoTranspose),
+      std::pair<fbgemm::matrix_op_t, fbgemm::matrix_op_t>(
+          fbgemm::matrix_op_t::NoTranspose, fbgemm::matrix_op_t::Transpose)/*,
+      pair<matrix_op_t, matrix_op_t>(
+          matrix_op_t::Transpose, matrix_op_t::NoTranspose),
+      pair<matrix_op_t, matrix_op_t>(
+          matrix_op_t::Transpose, matrix_op_t::Transpose)*/));
+
+TEST_P(FBGemmBF16Test, Test) {
+  TestRun();
+}
+
+TEST_P(FBGemmBF16Test, Unpack) {
+  UnpackTestRun();
+}
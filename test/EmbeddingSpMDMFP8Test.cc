@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "./EmbeddingSpMDMTestUtils.h"
+#include "fbgemm/Fbgemm.h"
+#include "fbgemm/FbgemmConvert.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+static vector<vector<int>> GetInputs_() {
+  vector<vector<int>> input_dims = {
+      // batch size, number of rows of table, emb dim , avg length
+      {1, 8, 8, 4},
+      {2, 8, 16, 4},
+      {10, 4000, 32, 100},
+      {10, 4000, 64, 100},
+      {10, 4000, 128, 100},
+      {4, 400, 256, 10},
+      {10, 4000, 48, 100},
+      {10, 4000, 40, 100},
+      {10, 4000, 2, 100},
+      {10, 4000, 7, 100},
+      {10, 40, 86, 10},
+      {10, 40, 164, 10},
+  };
+  return input_dims;
+}
+
+namespace {
+
+class EmbeddingSpMDMFP8Test : public testing::TestWithParam<tuple<
+                                  int,
+                                  int,
+                                  EmbeddingSpMDMWeightChoice,
+                                  EmbeddingSpMDMCornerCase,
+                                  EmbeddingSpMDMDtypeChoice>> {};
+
+// Runs the generated kernel and the reference and checks that both produce
+// bit-identical results, including the padding past each output row.
+template <typename IndexType, typename OffsetType, typename OutType>
+void RunAndCompare(
+    int exponent_bits,
+    int prefetch,
+    int batch_size,
+    int num_rows,
+    int embedding_dim,
+    int input_stride,
+    int output_stride,
+    int lengths_sum,
+    const vector<uint8_t>& table,
+    const vector<IndexType>& indices,
+    const vector<OffsetType>& offsets_or_lengths,
+    const float* weights,
+    bool normalize_by_lengths,
+    bool is_wt_positional,
+    bool use_offsets,
+    bool is_bf16_out,
+    bool empty_indices,
+    bool expect_failure) {
+  const int exponent_bias = (1 << (exponent_bits - 1)) - 1;
+  // Fill the outputs, including the stride padding, with the same sentry
+  vector<OutType> output_ref(batch_size * output_stride, 1);
+  vector<OutType> output(output_ref);
+
+  const bool success_ref =
+      EmbeddingSpMDMFP8_ref<IndexType, OffsetType, OutType>(
+          embedding_dim,
+          batch_size,
+          lengths_sum,
+          num_rows,
+          table.data(),
+          empty_indices ? nullptr : indices.data(),
+          offsets_or_lengths.data(),
+          weights,
+          normalize_by_lengths,
+          output_ref.data(),
+          is_wt_positional,
+          use_offsets,
+          output_stride,
+          input_stride,
+          exponent_bits,
+          exponent_bias,
+          is_bf16_out);
+
+  auto kernel =
+      GenerateEmbeddingSpMDMFP8WithStrides<IndexType, OffsetType, OutType>(
+          embedding_dim,
+          normalize_by_lengths,
+          is_wt_positional,
+          use_offsets,
+          output_stride,
+          input_stride,
+          exponent_bits,
+          exponent_bias,
+          is_bf16_out,
+          prefetch);
+  const bool success = kernel(
+      batch_size,
+      lengths_sum,
+      num_rows,
+      table.data(),
+      empty_indices ? nullptr : indices.data(),
+      offsets_or_lengths.data(),
+      weights,
+      output.data());
+
+  EXPECT_EQ(success, success_ref)
+      << "Reference and optimized impl did not both succeed";
+  if (expect_failure) {
+    EXPECT_FALSE(success);
+  }
+  if (success) {
+    for (size_t i = 0; i < output.size(); ++i) {
+      EXPECT_EQ(output[i], output_ref[i])
+          << "results differ at (" << i << ") emb dim :" << embedding_dim;
+    }
+  }
+}
+
+} // namespace
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    EmbeddingSpMDMFP8Test,
+    ::testing::Combine(
+        ::testing::Values(4, 5), // exponent_bits
+        ::testing::Values(0, 16, 1000000), // prefetch
+        ::testing::Values(UNWEIGHTED, WEIGHTED, POSITIONAL_WEIGHTED),
+        ::testing::Values(
+            NONE,
+            EMPTY_INDICES,
+            OUT_OF_BOUND_INDICES,
+            UNMATCHED_NUM_INDICES_AND_LENGTHS_SUM),
+        ::testing::Values(FLOAT, FLOAT16, BFLOAT16)));
+
+TEST_P(EmbeddingSpMDMFP8Test, basicTest) {
+  vector<vector<int>> inputs(GetInputs_());
+
+  random_device r;
+  default_random_engine generator(r());
+  uniform_int_distribution<> bool_dist(0, 1);
+
+  const bool isIndex64b = bool_dist(generator);
+  const bool isOffset64b = bool_dist(generator);
+  const bool normalize_by_lengths = bool_dist(generator);
+  const bool use_offsets = bool_dist(generator);
+  const bool padded_strides = bool_dist(generator);
+  int exponent_bits, prefetch;
+  EmbeddingSpMDMWeightChoice weight_choice;
+  EmbeddingSpMDMCornerCase corner_case;
+  EmbeddingSpMDMDtypeChoice out_type;
+  tie(exponent_bits, prefetch, weight_choice, corner_case, out_type) =
+      GetParam();
+  const bool is_wt_positional = weight_choice == POSITIONAL_WEIGHTED;
+  const bool use_weight = weight_choice != UNWEIGHTED;
+  const bool is_bf16_out = out_type == BFLOAT16;
+
+  for (auto input : inputs) {
+    const int batch_size = input[0];
+    const int num_rows = input[1];
+    const int embedding_dim = input[2];
+    const int average_len = input[3];
+    const int input_stride = embedding_dim + (padded_strides ? 5 : 0);
+    const int output_stride = embedding_dim + (padded_strides ? 3 : 0);
+
+    // Every FP8 encoding, including subnormals, zeros, and the largest values
+    uniform_int_distribution<int> byte_dist(0, 255);
+    vector<uint8_t> table(num_rows * input_stride);
+    for (auto& v : table) {
+      v = byte_dist(generator);
+    }
+
+    vector<int64_t> lengths, offsets, indices;
+    vector<int32_t> lengths_32, offsets_32, indices_32;
+    vector<float> weights;
+    const int lengths_sum = GenerateLengthsIndicesWeights(
+        lengths,
+        lengths_32,
+        offsets,
+        offsets_32,
+        indices,
+        indices_32,
+        weights,
+        batch_size,
+        num_rows,
+        average_len,
+        corner_case);
+    const float* weights_ptr = use_weight ? weights.data() : nullptr;
+    const bool empty_indices = corner_case == EMPTY_INDICES;
+    const bool expect_failure = corner_case == OUT_OF_BOUND_INDICES ||
+        corner_case == UNMATCHED_NUM_INDICES_AND_LENGTHS_SUM;
+
+    auto run = [&](auto out_tag, const auto& idx, const auto& off) {
+      using IndexType = typename decay_t<decltype(idx)>::value_type;
+      using OffsetType = typename decay_t<decltype(off)>::value_type;
+      RunAndCompare<IndexType, OffsetType, decltype(out_tag)>(
+          exponent_bits,
+          prefetch,
+          batch_size,
+          num_rows,
+          embedding_dim,
+          input_stride,
+          output_stride,
+          lengths_sum,
+          table,
+          idx,
+          off,
+          weights_ptr,
+          normalize_by_lengths,
+          is_wt_positional,
+          use_offsets,
+          is_bf16_out,
+          empty_indices,
+          expect_failure);
+    };
+    auto run_out_type = [&](const auto& idx, const auto& off) {
+      if (out_type == FLOAT) {
+        run(float(), idx, off);
+      } else {
+        run(uint16_t(), idx, off);
+      }
+    };
+    auto run_offset_type = [&](const auto& idx) {
+      if (isOffset64b) {
+        run_out_type(idx, use_offsets ? offsets : lengths);
+      } else {
+        run_out_type(idx, use_offsets ? offsets_32 : lengths_32);
+      }
+    };
+    if (isIndex64b) {
+      run_offset_type(indices);
+    } else {
+      run_offset_type(indices_32);
+    }
+  } // end for input
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fbgemm/FbgemmEmbedding.h"
+#include "fbgemm/Types.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+class EmbeddingSpMDMGroupedTest
+    : public testing::TestWithParam<tuple<bool, bool, int>> {};
+
+template <typename InType>
+void runGroupedTest(bool weighted, bool normalize, int num_threads) {
+  // Tables with skewed pooling factors and a few different dimensions. The
+  // offsets of each table start past 0 as in table batched embedding.
+  constexpr int kNumTables = 23;
+  constexpr int kBatchSize = 67;
+  constexpr int kNumRows = 100;
+  default_random_engine generator;
+  uniform_int_distribution<int> rowDist(0, kNumRows - 1);
+  uniform_real_distribution<float> valueDist(-1.0f, 1.0f);
+
+  vector<vector<InType>> inputs(kNumTables);
+  vector<vector<int64_t>> indices(kNumTables);
+  vector<vector<int64_t>> offsets(kNumTables);
+  vector<vector<float>> weights(kNumTables);
+  vector<vector<float>> outputs(kNumTables);
+  vector<EmbeddingSpMDMTableArgs<InType, int64_t, int64_t>> tables(kNumTables);
+  for (int t = 0; t < kNumTables; ++t) {
+    const int64_t block_size = 1 + (t % 4) * 24;
+    const int avgLength = t % 7 == 0 ? 200 : 3;
+    const int64_t rowSize = is_same<InType, uint8_t>::value
+        ? block_size + 2 * sizeof(float)
+        : block_size;
+    inputs[t].resize(kNumRows * rowSize);
+    for (int64_t r = 0; r < kNumRows; ++r) {
+      for (int64_t d = 0; d < rowSize; ++d) {
+        InType& val = inputs[t][r * rowSize + d];
+        if constexpr (is_same<InType, float>::value) {
+          val = valueDist(generator);
+        } else if constexpr (is_same<InType, float16>::value) {
+          val = cpu_float2half_rn(valueDist(generator));
+        } else {
+          val = rowDist(generator) % 256;
+        }
+      }
+      if constexpr (is_same<InType, uint8_t>::value) {
+        // Row wise scale and bias after the quantized values
+        const float scaleBias[2] = {valueDist(generator), valueDist(generator)};
+        memcpy(
+            &inputs[t][r * rowSize + block_size],
+            scaleBias,
+            sizeof(scaleBias));
+      }
+    }
+
+    const int64_t base = 5 * t;
+    indices[t].resize(base);
+    offsets[t].push_back(base);
+    uniform_int_distribution<int> lengthDist(0, 2 * avgLength);
+    for (int b = 0; b < kBatchSize; ++b) {
+      const int length = lengthDist(generator);
+      for (int i = 0; i < length; ++i) {
+        indices[t].push_back(rowDist(generator));
+      }
+      offsets[t].push_back(indices[t].size());
+    }
+    weights[t].resize(indices[t].size());
+    for (float& w : weights[t]) {
+      w = valueDist(generator);
+    }
+    outputs[t].assign(kBatchSize * block_size, 0.0f);
+
+    tables[t].block_size = block_size;
+    tables[t].output_size = kBatchSize;
+    tables[t].data_size = kNumRows;
+    tables[t].input = inputs[t].data();
+    tables[t].indices = indices[t].data();
+    tables[t].offsets = offsets[t].data();
+    tables[t].weights = weighted ? weights[t].data() : nullptr;
+    tables[t].out = outputs[t].data();
+  }
+
+  EXPECT_TRUE(EmbeddingSpMDMGrouped(
+      tables.data(), kNumTables, normalize, /*prefetch=*/16, num_threads));
+
+  for (int t = 0; t < kNumTables; ++t) {
+    const int64_t base = offsets[t][0];
+    vector<int64_t> refOffsets(offsets[t]);
+    for (int64_t& o : refOffsets) {
+      o -= base;
+    }
+    vector<float> expected(outputs[t].size());
+    EXPECT_TRUE(EmbeddingSpMDM_ref(
+        tables[t].block_size,
+        kBatchSize,
+        refOffsets.back(),
+        kNumRows,
+        inputs[t].data(),
+        indices[t].data() + base,
+        refOffsets.data(),
+        weighted ? weights[t].data() + base : nullptr,
+        normalize,
+        expected.data()));
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(outputs[t][i], expected[i], 1e-3 + 1e-4 * abs(expected[i]))
+          << "table " << t << " element " << i;
+    }
+  }
+
+  // An out of bound index fails the call.
+  indices[kNumTables / 2][offsets[kNumTables / 2][1]] = kNumRows;
+  EXPECT_FALSE(EmbeddingSpMDMGrouped(
+      tables.data(), kNumTables, normalize, /*prefetch=*/16, num_threads));
+}
+
+} // namespace
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    EmbeddingSpMDMGroupedTest,
+    ::testing::Combine(
+        ::testing::Bool(), // weighted
+        ::testing::Bool(), // normalize_by_lengths
+        ::testing::Values(0, 1, 3))); // num_threads
+
+TEST_P(EmbeddingSpMDMGroupedTest, basicTest) {
+  bool weighted, normalize;
+  int num_threads;
+  tie(weighted, normalize, num_threads) = GetParam();
+  runGroupedTest<float>(weighted, normalize, num_threads);
+  runGroupedTest<float16>(weighted, normalize, num_threads);
+  runGroupedTest<uint8_t>(weighted, normalize, num_threads);
+}
+
+TEST(EmbeddingSpMDMGroupedTest, emptyTables) {
+  vector<int32_t> offsets = {0};
+  EmbeddingSpMDMTableArgs<float, int32_t> table{};
+  table.block_size = 8;
+  table.offsets = offsets.data();
+  EXPECT_TRUE(EmbeddingSpMDMGrouped(&table, 1, false));
+  EXPECT_TRUE(EmbeddingSpMDMGrouped(&table, 0, false));
+}
@@ -91,6 +91,8 @@ TEST_P(FusedNBitRowwiseEmbeddingLookupTest, basicTest) {
   bool use_offsets = bool_dist(generator);
   bool scale_bias_last = bool_dist(generator);
   bool test_thread_local = bool_dist(generator);
+  // Pipelined prefetching of groups of rows
+  int prefetch_group = bool_dist(generator) ? 8 : 1;
   int bit_rate, prefetch;
   EmbeddingSpMDMWeightChoice weight_choice;
   EmbeddingSpMDMCornerCase corner_case;
@@ -243,7 +245,8 @@ TEST_P(FusedNBitRowwiseEmbeddingLookupTest, basicTest) {
       /*output_stride=*/-1,                                             \
       /*input_stride=*/-1,                                              \
       scale_bias_last,                                                  \
-      is_bf16_out);                                                     \
+      is_bf16_out,                                                      \
+      prefetch_group);                                                  \
   success = kernel(                                                     \
       batch_size,                                                       \
       lengths_sum,                                                      \
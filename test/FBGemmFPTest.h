@@ -24,6 +24,19 @@
 #endif
 
 namespace fbgemm {
+
+inline float convertToFloatRef(float16 src) {
+  return cpu_half2float(src);
+}
+
+inline float convertToFloatRef(BFloat16 src) {
+  return cpu_bf162float(src.x);
+}
+
+inline float convertToFloatRef(float src) {
+  return src;
+}
+
 /*
  * @brief Abstract of the GEMM FP test
  * The template parameter is transpose of A and B
@@ -180,10 +193,7 @@ class FBGemmFPTest : public testing::TestWithParam<
       memcpy(tmp.data(), Bp.pmat(), Bp.matSize() * sizeof(T));
       for (int i = 0; i < k; ++i) {
         for (int j = 0; j < n; ++j) {
-          EXPECT_EQ(
-              sizeof(T) == sizeof(float16) ? cpu_half2float(tmp[i * n + j])
-                                           : tmp[i * n + j],
-              B[i * n + j]);
+          EXPECT_EQ(convertToFloatRef(tmp[i * n + j]), B[i * n + j]);
         }
       }
 
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "./TestUtils.h"
+#include "bench/BenchUtils.h"
+#include "fbgemm/Fbgemm.h"
+#include "fbgemm/FbgemmThreadPool.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// One GEMM of a grouped call with its inputs and single threaded results.
+struct Problem {
+  int m, n, k, groups;
+  aligned_vector<uint8_t> A;
+  aligned_vector<int8_t> B;
+  unique_ptr<PackBMatrix<int8_t>> packedB;
+  vector<int32_t> col_offsets;
+  aligned_vector<uint8_t> C_ref;
+  aligned_vector<uint8_t> C;
+  aligned_vector<int32_t> C_buffer;
+  aligned_vector<int32_t> C_int32_ref;
+  aligned_vector<int32_t> C_int32;
+};
+
+// m, n, k, groups of small MLP layers
+const vector<array<int, 4>> kShapes = {
+    {1, 64, 128, 1},
+    {17, 200, 96, 1},
+    {64, 32, 512, 1},
+    {3, 48, 64, 2},
+    {130, 130, 300, 1},
+    {5, 16, 32, 3},
+};
+
+vector<Problem> makeProblems() {
+  vector<Problem> problems(kShapes.size());
+  for (size_t p = 0; p < kShapes.size(); ++p) {
+    auto& pr = problems[p];
+    pr.m = kShapes[p][0];
+    pr.n = kShapes[p][1];
+    pr.k = kShapes[p][2];
+    pr.groups = kShapes[p][3];
+    const int k_per_group = pr.k / pr.groups;
+    pr.A.resize(pr.m * pr.k);
+    pr.B.resize(pr.k * pr.n);
+    randFill<uint8_t>(pr.A, 0, 255);
+    randFill<int8_t>(pr.B, -128, 127);
+    pr.packedB = make_unique<PackBMatrix<int8_t>>(
+        matrix_op_t::NoTranspose,
+        pr.k,
+        pr.n,
+        pr.B.data(),
+        pr.n,
+        nullptr,
+        pr.groups);
+    pr.col_offsets.assign(pr.n * pr.groups, 0);
+    for (int g = 0; g < pr.groups; ++g) {
+      for (int j = 0; j < pr.n; ++j) {
+        for (int i = 0; i < k_per_group; ++i) {
+          pr.col_offsets[g * pr.n + j] +=
+              pr.B[(g * k_per_group + i) * pr.n + j];
+        }
+      }
+    }
+    pr.C_ref.resize(pr.m * pr.n * pr.groups);
+    pr.C.resize(pr.C_ref.size());
+    pr.C_buffer.resize(pr.C_ref.size());
+    pr.C_int32_ref.resize(pr.C_ref.size());
+    pr.C_int32.resize(pr.C_ref.size());
+  }
+  return problems;
+}
+
+ThreadPoolOptions poolOptions(int num_threads) {
+  ThreadPoolOptions options;
+  options.numThreads = num_threads;
+  options.pinThreads = false;
+  return options;
+}
+
+} // namespace
+
+TEST(GroupedGemmTest, ReQuantizeOutput) {
+  vector<Problem> problems = makeProblems();
+  vector<float> C_multiplier = {0.001f};
+  vector<int32_t> B_zero_point = {2};
+  constexpr int32_t A_zero_point = 3, C_zero_point = 5;
+  DoNothing<> doNothingObj{};
+
+  auto makeOutputProc = [&](const Problem& pr, const int32_t* row_offsets) {
+    return ReQuantizeOutput<false>(
+        doNothingObj,
+        C_multiplier.data(),
+        C_zero_point,
+        A_zero_point,
+        B_zero_point.data(),
+        row_offsets,
+        pr.col_offsets.data(),
+        nullptr, // bias
+        pr.n * pr.groups,
+        pr.groups);
+  };
+
+  for (auto& pr : problems) {
+    PackAWithRowOffset<uint8_t> packA(
+        matrix_op_t::NoTranspose,
+        pr.m,
+        pr.k,
+        pr.A.data(),
+        pr.k,
+        nullptr,
+        pr.groups);
+    auto outputProcObj = makeOutputProc(pr, packA.getRowOffsetBuffer());
+    fbgemmPacked(
+        packA,
+        *pr.packedB,
+        pr.C_ref.data(),
+        pr.C_buffer.data(),
+        pr.n * pr.groups,
+        outputProcObj,
+        0,
+        1);
+  }
+
+  using Args = GroupedGemmArgs<
+      PackAWithRowOffset<uint8_t>,
+      PackBMatrix<int8_t>,
+      uint8_t,
+      ReQuantizeOutput<false>>;
+  FbgemmThreadPool pool(poolOptions(8));
+  for (int num_threads : {1, 3, 8}) {
+    for (auto& pr : problems) {
+      pr.C.assign(pr.C.size(), 0);
+    }
+    pool.run(num_threads, [&](int thread_id, int nthreads) {
+      // Every thread packs A and reads its row offsets with its own objects
+      vector<unique_ptr<PackAWithRowOffset<uint8_t>>> packAs;
+      vector<ReQuantizeOutput<false>> outputProcs;
+      outputProcs.reserve(problems.size());
+      vector<Args> gemms;
+      for (auto& pr : problems) {
+        packAs.push_back(make_unique<PackAWithRowOffset<uint8_t>>(
+            matrix_op_t::NoTranspose,
+            pr.m,
+            pr.k,
+            pr.A.data(),
+            pr.k,
+            nullptr,
+            pr.groups));
+        outputProcs.push_back(
+            makeOutputProc(pr, packAs.back()->getRowOffsetBuffer()));
+        gemms.push_back(Args{
+            packAs.back().get(),
+            pr.packedB.get(),
+            pr.C.data(),
+            pr.C_buffer.data(),
+            static_cast<uint32_t>(pr.n * pr.groups),
+            &outputProcs.back()});
+      }
+      fbgemmGroupedPacked(
+          gemms.data(), static_cast<int>(gemms.size()), thread_id, nthreads);
+    });
+    for (size_t p = 0; p < problems.size(); ++p) {
+      EXPECT_EQ(problems[p].C, problems[p].C_ref)
+          << "GEMM " << p << " threads " << num_threads;
+    }
+  }
+}
+
+TEST(GroupedGemmTest, MemCopy) {
+  vector<Problem> problems = makeProblems();
+  DoNothing<int32_t, int32_t> doNothingObj{};
+  memCopy<> outputProcObj(doNothingObj);
+
+  for (auto& pr : problems) {
+    PackAMatrix<uint8_t> packA(
+        matrix_op_t::NoTranspose,
+        pr.m,
+        pr.k,
+        pr.A.data(),
+        pr.k,
+        nullptr,
+        pr.groups);
+    fbgemmPacked(
+        packA,
+        *pr.packedB,
+        pr.C_int32_ref.data(),
+        pr.C_int32_ref.data(),
+        pr.n * pr.groups,
+        outputProcObj,
+        0,
+        1);
+  }
+
+  using Args = GroupedGemmArgs<
+      PackAMatrix<uint8_t>,
+      PackBMatrix<int8_t>,
+      int32_t,
+      memCopy<>>;
+  FbgemmThreadPool pool(poolOptions(5));
+  pool.run([&](int thread_id, int num_threads) {
+    vector<unique_ptr<PackAMatrix<uint8_t>>> packAs;
+    vector<Args> gemms;
+    for (auto& pr : problems) {
+      packAs.push_back(make_unique<PackAMatrix<uint8_t>>(
+          matrix_op_t::NoTranspose,
+          pr.m,
+          pr.k,
+          pr.A.data(),
+          pr.k,
+          nullptr,
+          pr.groups));
+      // The output is accumulated in place
+      gemms.push_back(Args{
+          packAs.back().get(),
+          pr.packedB.get(),
+          pr.C_int32.data(),
+          pr.C_int32.data(),
+          static_cast<uint32_t>(pr.n * pr.groups),
+          &outputProcObj});
+    }
+    fbgemmGroupedPacked(
+        gemms.data(), static_cast<int>(gemms.size()), thread_id, num_threads);
+  });
+  for (size_t p = 0; p < problems.size(); ++p) {
+    EXPECT_EQ(problems[p].C_int32, problems[p].C_int32_ref) << "GEMM " << p;
+  }
+}
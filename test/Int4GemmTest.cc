@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include "bench/BenchUtils.h"
+#include "fbgemm/FbgemmInt4.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// m, n, k, group size
+class Int4GemmTest
+    : public testing::TestWithParam<tuple<int, int, int, int>> {};
+
+void checkClose(
+    const aligned_vector<float>& C,
+    const aligned_vector<float>& C_ref,
+    float tolerance) {
+  for (size_t i = 0; i < C.size(); ++i) {
+    EXPECT_NEAR(C[i], C_ref[i], tolerance * max(1.0f, fabs(C_ref[i])))
+        << "at " << i;
+  }
+}
+
+} // anonymous namespace
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    Int4GemmTest,
+    ::testing::Values(
+        make_tuple(1, 64, 128, 32),
+        make_tuple(3, 100, 256, 64),
+        make_tuple(8, 33, 128, 128),
+        make_tuple(13, 16, 64, 32),
+        make_tuple(20, 250, 512, 128),
+        make_tuple(5, 7, 32, 4)));
+
+TEST_P(Int4GemmTest, PackUnpack) {
+  int m, n, k, group_size;
+  tie(m, n, k, group_size) = GetParam();
+  const int num_groups = k / group_size;
+
+  aligned_vector<uint8_t> q(k * n);
+  aligned_vector<float> scales(num_groups * n);
+  aligned_vector<int32_t> zero_points(num_groups * n);
+  randFill<uint8_t>(q, 0, 15);
+  randFill<float>(scales, 0.01f, 0.1f);
+  randFill<int32_t>(zero_points, 0, 15);
+  PackedInt4GemmMatrixB Bp(
+      k, n, group_size, q.data(), scales.data(), zero_points.data());
+
+  aligned_vector<float> B(k * n);
+  Bp.unpack(B.data());
+  for (int kk = 0; kk < k; ++kk) {
+    const int g = kk / group_size;
+    for (int j = 0; j < n; ++j) {
+      ASSERT_EQ(Bp.quantizedValue(kk, j), q[kk * n + j]);
+      EXPECT_EQ(
+          B[kk * n + j],
+          scales[g * n + j] * (q[kk * n + j] - zero_points[g * n + j]));
+    }
+  }
+
+  // Quantizing float weights is within half a step of every group
+  aligned_vector<float> W(k * n);
+  randFill<float>(W, -1.0f, 1.0f);
+  PackedInt4GemmMatrixB Wp(
+      matrix_op_t::NoTranspose, k, n, W.data(), group_size);
+  Wp.unpack(B.data());
+  for (int kk = 0; kk < k; ++kk) {
+    const int g = kk / group_size;
+    for (int j = 0; j < n; ++j) {
+      const float scale = Wp.scales()[g * Wp.paddedCols() + j];
+      EXPECT_LE(fabs(B[kk * n + j] - W[kk * n + j]), scale / 2 + 1e-6f);
+    }
+  }
+
+  // The transposed source gives the same packing
+  aligned_vector<float> Wt(n * k);
+  transpose_matrix(k, n, W.data(), n, Wt.data(), k);
+  PackedInt4GemmMatrixB Wtp(
+      matrix_op_t::Transpose, k, n, Wt.data(), group_size);
+  for (int kk = 0; kk < k; ++kk) {
+    for (int j = 0; j < n; ++j) {
+      EXPECT_EQ(Wtp.quantizedValue(kk, j), Wp.quantizedValue(kk, j));
+    }
+  }
+}
+
+TEST_P(Int4GemmTest, FP32) {
+  int m, n, k, group_size;
+  tie(m, n, k, group_size) = GetParam();
+
+  aligned_vector<float> A(m * k), W(k * n), B(k * n);
+  randFill<float>(A, -1.0f, 1.0f);
+  randFill<float>(W, -1.0f, 1.0f);
+  PackedInt4GemmMatrixB Bp(
+      matrix_op_t::NoTranspose, k, n, W.data(), group_size);
+  Bp.unpack(B.data());
+
+  for (float beta : {0.0f, 0.5f}) {
+    aligned_vector<float> C_init(m * n);
+    randFill<float>(C_init, -1.0f, 1.0f);
+    aligned_vector<float> C_ref(C_init);
+    cblas_sgemm_ref(
+        matrix_op_t::NoTranspose,
+        matrix_op_t::NoTranspose,
+        m,
+        n,
+        k,
+        1.0f,
+        A.data(),
+        k,
+        B.data(),
+        n,
+        beta,
+        C_ref.data(),
+        n);
+
+    for (int num_threads : {1, 3}) {
+      aligned_vector<float> C(C_init);
+      for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+        fbgemmInt4Gemm(
+            m, A.data(), k, Bp, beta, C.data(), n, thread_id, num_threads);
+      }
+      checkClose(C, C_ref, 1e-4f);
+    }
+  }
+}
+
+TEST_P(Int4GemmTest, W4A8) {
+  int m, n, k, group_size;
+  tie(m, n, k, group_size) = GetParam();
+  constexpr float A_scale = 0.02f;
+  constexpr int32_t A_zero_point = 43;
+
+  aligned_vector<uint8_t> A(m * k);
+  aligned_vector<float> A_float(m * k), W(k * n), B(k * n);
+  randFill<uint8_t>(A, 0, 255);
+  for (int i = 0; i < m * k; ++i) {
+    A_float[i] = A_scale * (A[i] - A_zero_point);
+  }
+  randFill<float>(W, -1.0f, 1.0f);
+  PackedInt4GemmMatrixB Bp(
+      matrix_op_t::NoTranspose, k, n, W.data(), group_size);
+  Bp.unpack(B.data());
+
+  for (float beta : {0.0f, 0.5f}) {
+    aligned_vector<float> C_init(m * n);
+    randFill<float>(C_init, -1.0f, 1.0f);
+    aligned_vector<float> C_ref(C_init);
+    cblas_sgemm_ref(
+        matrix_op_t::NoTranspose,
+        matrix_op_t::NoTranspose,
+        m,
+        n,
+        k,
+        1.0f,
+        A_float.data(),
+        k,
+        B.data(),
+        n,
+        beta,
+        C_ref.data(),
+        n);
+
+    for (int num_threads : {1, 3}) {
+      aligned_vector<float> C(C_init);
+      for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+        fbgemmInt4Gemm(
+            m,
+            A.data(),
+            k,
+            A_scale,
+            A_zero_point,
+            Bp,
+            beta,
+            C.data(),
+            n,
+            thread_id,
+            num_threads);
+      }
+      checkClose(C, C_ref, 1e-4f);
+    }
+  }
+}
+
+TEST(Int4GemmPackTest, InvalidGroupSize) {
+  aligned_vector<float> W(96 * 16);
+  EXPECT_THROW(
+      PackedInt4GemmMatrixB(matrix_op_t::NoTranspose, 96, 16, W.data(), 64),
+      std::runtime_error);
+  EXPECT_THROW(
+      PackedInt4GemmMatrixB(matrix_op_t::NoTranspose, 96, 16, W.data(), 6),
+      std::runtime_error);
+}
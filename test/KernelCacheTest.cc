@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fbgemm/FbgemmEmbedding.h"
+#include "fbgemm/FbgemmKernelCache.h"
+#include "fbgemm/Utils.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+string tmpFile(const string& name) {
+  return testing::TempDir() + "fbgemm_kernel_cache_test_" + name;
+}
+
+int countLines(const string& path) {
+  ifstream in(path);
+  string line;
+  int lines = 0;
+  while (getline(in, line)) {
+    ++lines;
+  }
+  return lines;
+}
+
+// Generates and runs a sum pooling kernel over a 1-row table.
+bool runEmbeddingKernel(int block_size) {
+  auto kernel = GenerateEmbeddingSpMDM<float, int64_t>(
+      block_size, /*has_weight=*/false, /*normalize_by_lengths=*/false);
+  vector<float> input(block_size, 1.0f);
+  vector<int64_t> indices = {0, 0, 0};
+  vector<int> offsets = {0, 3};
+  vector<float> out(block_size, 0.0f);
+  bool success = kernel(
+      /*output_size=*/1,
+      indices.size(),
+      /*data_size=*/1,
+      input.data(),
+      indices.data(),
+      offsets.data(),
+      nullptr,
+      out.data());
+  for (float v : out) {
+    success = success && v == 3.0f;
+  }
+  return success;
+}
+
+const vector<int> kBlockSizes = {8, 16, 33, 64};
+
+// Set in the process SaveLoadPrewarm starts to the prefix of the files it
+// wrote.
+constexpr char kFreshProcessEnv[] = "FBGEMM_KERNEL_CACHE_TEST_PREFIX";
+
+// Runs a sum pooling kernel on fixed pseudo random data, returns the output.
+vector<float> poolRandomRows(int block_size) {
+  constexpr int data_size = 10, output_size = 4, index_size = 13;
+  auto kernel = GenerateEmbeddingSpMDM<float, int64_t>(
+      block_size, /*has_weight=*/false, /*normalize_by_lengths=*/false);
+  mt19937 gen(block_size);
+  uniform_real_distribution<float> value(-1.0f, 1.0f);
+  uniform_int_distribution<int64_t> row(0, data_size - 1);
+  vector<float> input(data_size * block_size);
+  for (float& v : input) {
+    v = value(gen);
+  }
+  vector<int64_t> indices(index_size);
+  for (int64_t& idx : indices) {
+    idx = row(gen);
+  }
+  vector<int> offsets = {0, 2, 2, 9, index_size};
+  vector<float> out(output_size * block_size);
+  EXPECT_TRUE(kernel(
+      output_size,
+      index_size,
+      data_size,
+      input.data(),
+      indices.data(),
+      offsets.data(),
+      nullptr,
+      out.data()));
+  return out;
+}
+
+} // namespace
+
+TEST(KernelCacheTest, SaveLoadPrewarm) {
+  const string prefix = tmpFile("save_load_");
+  const string cachePath = prefix + "kernels.bin";
+  const string manifestPath = prefix + "kernels.manifest";
+  const string outputsPath = prefix + "outputs.bin";
+  remove(cachePath.c_str());
+
+  // A missing file enables the cache without loading anything.
+  EXPECT_EQ(fbgemmLoadKernelCache(cachePath), 0);
+  {
+    ofstream os(outputsPath, ios::binary);
+    for (int block_size : kBlockSizes) {
+      const vector<float> out = poolRandomRows(block_size);
+      os.write(
+          reinterpret_cast<const char*>(out.data()),
+          out.size() * sizeof(float));
+    }
+  }
+  ASSERT_TRUE(fbgemmSaveKernelCache(cachePath));
+  ASSERT_TRUE(fbgemmSaveKernelManifest(manifestPath));
+
+  const int numKernels = countLines(manifestPath);
+  const bool jit = fbgemmHasAvx2Support() && !is_asmjit_disabled();
+  if (jit) {
+    EXPECT_GE(numKernels, 4);
+  }
+  // Every kernel in the manifest is persisted in this process.
+  EXPECT_EQ(fbgemmPrewarmKernelCache(manifestPath), numKernels);
+  for (int block_size : kBlockSizes) {
+    EXPECT_TRUE(runEmbeddingKernel(block_size));
+  }
+
+#ifdef __linux__
+  // This process still holds the kernels it JIT'd, so only a new one shows
+  // that the kernels loaded from the file work.
+  if (jit) {
+    const string cmd = string(kFreshProcessEnv) + "=" + prefix + " " +
+        filesystem::read_symlink("/proc/self/exe").string() +
+        " --gtest_filter=KernelCacheTest.LoadInFreshProcess";
+    EXPECT_EQ(system(cmd.c_str()), 0);
+  }
+#endif
+
+  remove(cachePath.c_str());
+  remove(manifestPath.c_str());
+  remove(outputsPath.c_str());
+}
+
+// Run by SaveLoadPrewarm in a new process: the kernels it prewarms from the
+// files SaveLoadPrewarm wrote compute the same as the ones it JIT'd.
+TEST(KernelCacheTest, LoadInFreshProcess) {
+  const char* prefix = getenv(kFreshProcessEnv);
+  if (prefix == nullptr) {
+    GTEST_SKIP() << "only run by KernelCacheTest.SaveLoadPrewarm";
+  }
+  const string manifestPath = string(prefix) + "kernels.manifest";
+  EXPECT_GE(fbgemmLoadKernelCache(string(prefix) + "kernels.bin"), 4);
+  const int numKernels = countLines(manifestPath);
+  EXPECT_EQ(fbgemmPrewarmKernelCache(manifestPath), numKernels);
+
+  const KernelCacheStats before = fbgemmGetKernelCacheStats();
+  ifstream in(string(prefix) + "outputs.bin", ios::binary);
+  for (int block_size : kBlockSizes) {
+    const vector<float> out = poolRandomRows(block_size);
+    vector<float> expected(out.size());
+    in.read(
+        reinterpret_cast<char*>(expected.data()),
+        expected.size() * sizeof(float));
+    ASSERT_TRUE(in.good());
+    EXPECT_EQ(out, expected) << "block_size " << block_size;
+  }
+  // None of the kernels was JIT'd
+  EXPECT_EQ(fbgemmGetKernelCacheStats().misses, before.misses);
+}
+
+TEST(KernelCacheTest, InvalidFiles) {
+  const string corruptPath = tmpFile("corrupt.bin");
+  {
+    ofstream os(corruptPath, ios::binary);
+    os << "not a kernel cache";
+  }
+  EXPECT_EQ(fbgemmLoadKernelCache(corruptPath), -1);
+  EXPECT_EQ(fbgemmPrewarmKernelCache(tmpFile("missing.manifest")), -1);
+
+  // Unknown caches and malformed keys are skipped.
+  const string manifestPath = tmpFile("bad.manifest");
+  {
+    ofstream os(manifestPath);
+    os << "no such cache\t1,2,3\n"
+       << "no tab on this line\n";
+  }
+  EXPECT_EQ(fbgemmPrewarmKernelCache(manifestPath), 0);
+
+  remove(corruptPath.c_str());
+  remove(manifestPath.c_str());
+}
+
+TEST(KernelCacheTest, BoundedCapacity) {
+  if (!fbgemmHasAvx2Support() || is_asmjit_disabled()) {
+    return;
+  }
+  for (auto policy :
+       {KernelCacheEvictionPolicy::LRU, KernelCacheEvictionPolicy::LFU}) {
+    fbgemmSetKernelCacheCapacity(2, policy);
+    const KernelCacheStats before = fbgemmGetKernelCacheStats();
+    // Four kernels cycling through two entries; evicted kernels are put back
+    // without being generated again.
+    for (int block_size : {72, 80, 88, 96, 72, 80}) {
+      EXPECT_TRUE(runEmbeddingKernel(block_size));
+    }
+    const KernelCacheStats after = fbgemmGetKernelCacheStats();
+    EXPECT_GE(after.misses - before.misses, 4);
+    EXPECT_GE(after.evictions - before.evictions, 4);
+    EXPECT_GT(after.evicted, 0);
+
+    // Kernels loaded from a persistent kernel cache are not released.
+    EXPECT_LE(fbgemmReleaseEvictedKernels(), after.evicted);
+    EXPECT_EQ(fbgemmGetKernelCacheStats().evicted, 0);
+    // Released kernels can be requested again.
+    for (int block_size : {72, 80, 88, 96}) {
+      EXPECT_TRUE(runEmbeddingKernel(block_size));
+    }
+    fbgemmReleaseEvictedKernels();
+  }
+  fbgemmSetKernelCacheCapacity(0);
+
+  const KernelCacheStats before = fbgemmGetKernelCacheStats();
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(runEmbeddingKernel(104));
+  }
+  const KernelCacheStats after = fbgemmGetKernelCacheStats();
+  EXPECT_EQ(after.misses - before.misses, 1);
+  EXPECT_GE(after.hits - before.hits, 2);
+}
+
+TEST(KernelCacheTest, Introspection) {
+  if (!fbgemmHasAvx2Support() || is_asmjit_disabled()) {
+    return;
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(runEmbeddingKernel(112));
+  }
+
+  const vector<KernelCacheInfo> infos = fbgemmGetKernelCacheInfo(1);
+  KernelCacheStats total;
+  bool foundHotKey = false;
+  for (const auto& info : infos) {
+    EXPECT_FALSE(info.name.empty());
+    EXPECT_LE(info.hottestKeys.size(), 1);
+    EXPECT_LE(info.hottestKeys.size(), info.stats.entries);
+    for (const auto& key : info.hottestKeys) {
+      foundHotKey = foundHotKey || key.hits > 0;
+    }
+    total.entries += info.stats.entries;
+    total.codeBytes += info.stats.codeBytes;
+    total.codegenNanoseconds += info.stats.codegenNanoseconds;
+  }
+  EXPECT_TRUE(foundHotKey);
+  EXPECT_GT(total.entries, 0);
+  EXPECT_GT(total.codeBytes, 0);
+  EXPECT_GT(total.codegenNanoseconds, 0);
+  EXPECT_EQ(total.entries, fbgemmGetKernelCacheStats().entries);
+
+  const JitMemoryStats memory = fbgemmGetJitMemoryStats();
+  EXPECT_GE(memory.reservedBytes, memory.usedBytes);
+  EXPECT_GT(memory.usedBytes, 0);
+
+  const string json = fbgemmKernelCacheStatsToJson();
+  EXPECT_NE(json.find("\"jit_memory\""), string::npos);
+  EXPECT_NE(json.find("\"hottest_keys\""), string::npos);
+  EXPECT_NE(json.find("112,"), string::npos);
+}
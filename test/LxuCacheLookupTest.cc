@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fbgemm/FbgemmEmbedding.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// tuple of ways, number of sets, and whether indices are 64-bit
+class LxuCacheLookupTest
+    : public testing::TestWithParam<tuple<int, int, bool>> {};
+
+template <typename IndexType>
+void RunAndCompare(
+    const vector<int64_t>& cache_state,
+    int num_sets,
+    int ways,
+    int64_t invalid_index,
+    const vector<int64_t>& linear_indices,
+    const unordered_map<int64_t, int32_t>& expected) {
+  const vector<IndexType> indices(linear_indices.begin(), linear_indices.end());
+  const int64_t n = indices.size();
+  vector<int32_t> locations_ref(n, 0), locations(n, 0);
+
+  const int64_t misses_ref = lxu_cache_lookup_ref(
+      indices.data(),
+      n,
+      cache_state.data(),
+      num_sets,
+      ways,
+      invalid_index,
+      locations_ref.data());
+  const int64_t misses = lxu_cache_lookup(
+      indices.data(),
+      n,
+      cache_state.data(),
+      num_sets,
+      ways,
+      invalid_index,
+      locations.data());
+
+  int64_t expected_misses = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    auto it = expected.find(indices[i]);
+    const int32_t want = it == expected.end() ? -1 : it->second;
+    expected_misses += want == -1 && indices[i] != invalid_index;
+    EXPECT_EQ(locations_ref[i], want)
+        << "reference differs at " << i << " for index " << indices[i];
+    EXPECT_EQ(locations[i], want)
+        << "results differ at " << i << " for index " << indices[i];
+  }
+  EXPECT_EQ(misses_ref, expected_misses);
+  EXPECT_EQ(misses, expected_misses);
+}
+
+} // namespace
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    LxuCacheLookupTest,
+    ::testing::Combine(
+        ::testing::Values(1, 4, 8, 12, 32, 64, 96), // ways
+        ::testing::Values(1, 7, 1000), // number of sets
+        ::testing::Bool())); // 64-bit indices
+
+TEST_P(LxuCacheLookupTest, basicTest) {
+  int ways, num_sets;
+  bool is_index_64b;
+  tie(ways, num_sets, is_index_64b) = GetParam();
+
+  random_device r;
+  default_random_engine generator(r());
+  const int64_t hash_size = 10 * ways * num_sets;
+  const int64_t invalid_index = hash_size;
+  uniform_int_distribution<int64_t> index_dist(0, hash_size - 1);
+
+  // Fill about 3/4 of the ways of every set, at random ways
+  vector<int64_t> cache_state(num_sets * ways, -1);
+  unordered_map<int64_t, int32_t> expected;
+  uniform_int_distribution<int> way_dist(0, ways - 1);
+  for (int64_t k = 0; k < static_cast<int64_t>(cache_state.size()); ++k) {
+    const int64_t idx = index_dist(generator);
+    const int64_t cache_set = lxu_cache_slot(idx, num_sets);
+    const int way = way_dist(generator);
+    int64_t& slot = cache_state[cache_set * ways + way];
+    if (slot == -1 && !expected.count(idx)) {
+      slot = idx;
+      expected[idx] = cache_set * ways + way;
+    }
+  }
+
+  // Half cached indices, the rest uncached or invalid
+  vector<int64_t> linear_indices(1000 + ways);
+  vector<int64_t> cached;
+  for (const auto& kv : expected) {
+    cached.push_back(kv.first);
+  }
+  uniform_int_distribution<int> pick_dist(0, 3);
+  for (auto& idx : linear_indices) {
+    const int pick = pick_dist(generator);
+    if (pick < 2 && !cached.empty()) {
+      idx = cached[generator() % cached.size()];
+    } else if (pick == 2) {
+      idx = index_dist(generator);
+    } else {
+      idx = invalid_index;
+    }
+  }
+
+  if (is_index_64b) {
+    RunAndCompare<int64_t>(
+        cache_state, num_sets, ways, invalid_index, linear_indices, expected);
+  } else {
+    RunAndCompare<int32_t>(
+        cache_state, num_sets, ways, invalid_index, linear_indices, expected);
+  }
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "./TestUtils.h"
+#include "bench/BenchUtils.h"
+#include "fbgemm/Fbgemm.h"
+#include "fbgemm/FbgemmFP16.h"
+#include "fbgemm/FbgemmPackSerialize.h"
+#include "fbgemm/FbgemmSparse.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// Parameter is whether the file is mapped.
+class PackSerializeTest : public testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    // Parameterized test names contain a '/'
+    string name = testing::UnitTest::GetInstance()->current_test_info()->name();
+    replace(name.begin(), name.end(), '/', '_');
+    path_ = testing::TempDir() + "fbgemm_pack_serialize_" + name;
+  }
+
+  void TearDown() override {
+    remove(path_.c_str());
+  }
+
+  string path_;
+};
+
+// Convolutions that take each path of PackWeightsForConv
+vector<conv_param_t<2>> GetConvShapes_() {
+  return {
+      // im2col
+      conv_param_t<2>(2, 32, 64, {14, 14}, 1, {3, 3}, {1, 1}, {1, 1, 1, 1}),
+      // depthwise
+      conv_param_t<2>(2, 32, 32, {14, 14}, 32, {3, 3}, {1, 1}, {1, 1, 1, 1}),
+      // groupwise
+      conv_param_t<2>(2, 32, 32, {10, 10}, 8, {3, 3}, {1, 1}, {1, 1, 1, 1}),
+      // pointwise
+      conv_param_t<2>(2, 32, 48, {7, 7}, 1, {1, 1}, {1, 1}, {0, 0, 0, 0}),
+  };
+}
+
+} // namespace
+
+INSTANTIATE_TEST_CASE_P(InstantiationName, PackSerializeTest, testing::Bool());
+
+TEST_P(PackSerializeTest, PackBMatrix) {
+  constexpr int k = 300, n = 130, groups = 2;
+  aligned_vector<int8_t> B(k * n);
+  randFill<int8_t>(B, -128, 127);
+  BlockingFactors params;
+  params.MCB = 48;
+  params.NCB = 16;
+  params.KCB = 256;
+  params.MR = 1;
+  params.NR = 16;
+  params.ROW_INTERLEAVE = 4;
+  params.NR_MIN = 16;
+
+  PackBMatrix<int8_t> packedB(
+      matrix_op_t::NoTranspose, k, n, B.data(), n, nullptr, groups);
+  PackBMatrix<int8_t> packedBParams(
+      matrix_op_t::Transpose,
+      k,
+      n,
+      B.data(),
+      k / groups,
+      nullptr,
+      groups,
+      &params);
+  PackBMatrix<int8_t, int16_t> packedBAcc16(
+      matrix_op_t::NoTranspose, k, n, B.data(), n, nullptr, groups);
+  {
+    PackedWeightWriter writer(path_);
+    writer.add("b", packedB);
+    writer.add("b_params", packedBParams);
+    writer.add("b_acc16", packedBAcc16);
+    EXPECT_THROW(writer.add("b", packedB), runtime_error);
+  }
+
+  PackedWeightReader reader(path_, GetParam());
+  EXPECT_EQ(reader.names(), vector<string>({"b", "b_params", "b_acc16"}));
+  EXPECT_EQ(reader.blockingFactors("b"), nullptr);
+  const BlockingFactors* loadedParams = reader.blockingFactors("b_params");
+  ASSERT_NE(loadedParams, nullptr);
+  EXPECT_EQ(loadedParams->KCB, params.KCB);
+  EXPECT_EQ(loadedParams->NCB, params.NCB);
+
+  auto loadedB = reader.load<PackBMatrix<int8_t>>("b");
+  auto loadedBParams = reader.load<PackBMatrix<int8_t>>("b_params");
+  auto loadedBAcc16 = reader.load<PackBMatrix<int8_t, int16_t>>("b_acc16");
+  EXPECT_NE(loadedB->getBuf(), packedB.getBuf());
+  EXPECT_TRUE(loadedB->equals(packedB));
+  EXPECT_TRUE(loadedBParams->equals(packedBParams));
+  EXPECT_TRUE(loadedBAcc16->equals(packedBAcc16));
+  EXPECT_TRUE(loadedBParams->isPrePacked());
+  aligned_vector<int8_t> unpacked(k * n);
+  loadedB->unpack(unpacked.data());
+  EXPECT_EQ(unpacked, B);
+  loadedBParams->unpack(unpacked.data(), loadedParams);
+  EXPECT_EQ(unpacked, B);
+  EXPECT_THROW(reader.load<PackBMatrix<int8_t>>("b_acc16"), runtime_error);
+  EXPECT_THROW(reader.load<PackedGemmMatrixFP16>("b"), runtime_error);
+}
+
+TEST_P(PackSerializeTest, PackWeightsForConv) {
+  const auto shapes = GetConvShapes_();
+  vector<aligned_vector<int8_t>> weights;
+  {
+    PackedWeightWriter writer(path_);
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      const auto& conv_p = shapes[i];
+      weights.emplace_back(
+          conv_p.K[0] * conv_p.K[1] * conv_p.IC / conv_p.G * conv_p.OC);
+      randFill<int8_t>(weights.back(), -128, 127);
+      PackWeightsForConv<2> packed(conv_p, weights.back().data());
+      writer.add("conv" + to_string(i), packed);
+    }
+    writer.close();
+  }
+
+  PackedWeightReader reader(path_, GetParam());
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    auto loaded = reader.load<PackWeightsForConv<2>>("conv" + to_string(i));
+    EXPECT_TRUE(loaded->isPackingCompliant(shapes[i])) << "conv " << i;
+    aligned_vector<int8_t> unpacked(weights[i].size());
+    loaded->unpack(unpacked.data());
+    EXPECT_EQ(unpacked, weights[i]) << "conv " << i;
+  }
+  EXPECT_THROW(reader.load<PackWeightsForConv<3>>("conv0"), runtime_error);
+}
+
+TEST_P(PackSerializeTest, PackedGemmMatrixFP16) {
+  constexpr int k = 130, n = 200;
+  aligned_vector<float> B(k * n);
+  randFill<float>(B, -1, 1);
+  PackedGemmMatrixFP16 packedB(matrix_op_t::NoTranspose, k, n, 1.0f, B.data());
+  {
+    PackedWeightWriter writer(path_);
+    writer.add("fp16", packedB);
+  }
+
+  PackedWeightReader reader(path_, GetParam());
+  auto loadedB = reader.load<PackedGemmMatrixFP16>("fp16");
+  ASSERT_EQ(loadedB->matSize(), packedB.matSize());
+  EXPECT_EQ(loadedB->kernelNumColBlocks(), packedB.kernelNumColBlocks());
+  vector<float16> expected(k * n), unpacked(k * n);
+  packedB.unpack(expected.data(), matrix_op_t::NoTranspose);
+  loadedB->unpack(unpacked.data(), matrix_op_t::NoTranspose);
+  EXPECT_EQ(unpacked, expected);
+}
+
+TEST_P(PackSerializeTest, BCSRMatrix) {
+  constexpr int R = 48, C = 100;
+  aligned_vector<int8_t> W(R * C);
+  randFill<int8_t>(W, -128, 127);
+  for (int i = 0; i < R * C; i += 3) {
+    W[i] = 0;
+  }
+  auto bcsr = fbgemmDenseToBCSR<int8_t>(R, C, W.data());
+  {
+    PackedWeightWriter writer(path_);
+    writer.add("bcsr", *bcsr);
+  }
+
+  PackedWeightReader reader(path_, GetParam());
+  auto loaded = reader.load<BCSRMatrix<int8_t>>("bcsr");
+  EXPECT_EQ(loaded->rowBPtr, bcsr->rowBPtr);
+  EXPECT_EQ(loaded->colBIdx, bcsr->colBIdx);
+  EXPECT_EQ(loaded->values, bcsr->values);
+  EXPECT_EQ(loaded->row_offsets, bcsr->row_offsets);
+  aligned_vector<int8_t> unpacked(R * C);
+  loaded->unpack(unpacked.data());
+  EXPECT_EQ(unpacked, W);
+}
+
+TEST_P(PackSerializeTest, InvalidFiles) {
+  EXPECT_THROW(PackedWeightReader(path_, GetParam()), runtime_error);
+  {
+    ofstream out(path_, ios::binary);
+    out << "not a packed weight file, but long enough to hold a header";
+  }
+  EXPECT_THROW(PackedWeightReader(path_, GetParam()), runtime_error);
+
+  {
+    PackedWeightWriter writer(path_);
+  }
+  PackedWeightReader reader(path_, GetParam());
+  EXPECT_TRUE(reader.names().empty());
+  EXPECT_FALSE(reader.contains("b"));
+  EXPECT_THROW(reader.load<PackBMatrix<int8_t>>("b"), runtime_error);
+  EXPECT_THROW(reader.blockingFactors("b"), runtime_error);
+}
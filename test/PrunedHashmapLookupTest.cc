@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fbgemm/FbgemmEmbedding.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// tuple of capacity and load factor in percent
+class PrunedHashmapLookupTest
+    : public testing::TestWithParam<tuple<int, int>> {};
+
+} // namespace
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    PrunedHashmapLookupTest,
+    ::testing::Combine(
+        ::testing::Values(1, 7, 64, 1000, 1 << 16), // capacity
+        ::testing::Values(0, 25, 50, 75, 90, 100))); // load factor
+
+TEST_P(PrunedHashmapLookupTest, basicTest) {
+  int capacity, load;
+  tie(capacity, load) = GetParam();
+
+  random_device r;
+  default_random_engine generator(r());
+  uniform_int_distribution<int32_t> key_dist(
+      numeric_limits<int32_t>::min(), numeric_limits<int32_t>::max());
+
+  // Distinct sparse ids, including the extremes, some of them pruned
+  const int num_inserted = static_cast<int64_t>(capacity) * load / 100;
+  unordered_map<int32_t, int32_t> expected;
+  unordered_set<int32_t> seen;
+  vector<int32_t> sparse_ids, dense_ids;
+  for (int32_t key :
+       {0, 1, numeric_limits<int32_t>::max(), numeric_limits<int32_t>::min()}) {
+    if (static_cast<int>(sparse_ids.size()) < num_inserted) {
+      seen.insert(key);
+      sparse_ids.push_back(key);
+    }
+  }
+  while (static_cast<int>(sparse_ids.size()) < num_inserted) {
+    const int32_t key = key_dist(generator);
+    if (key != -1 && seen.insert(key).second) {
+      sparse_ids.push_back(key);
+    }
+  }
+  for (size_t i = 0; i < sparse_ids.size(); ++i) {
+    const int32_t dense = i % 5 == 4 ? -1 : static_cast<int32_t>(i);
+    dense_ids.push_back(dense);
+    expected[sparse_ids[i]] = dense;
+  }
+  vector<int32_t> hash_table(2 * capacity, -1);
+  pruned_hashmap_insert_ref(
+      sparse_ids.data(),
+      dense_ids.data(),
+      sparse_ids.size(),
+      hash_table.data(),
+      capacity);
+
+  // Queries mix inserted ids, pruned ids, and ids that were never inserted,
+  // with a length that is not a multiple of any vector width
+  const int num_indices = 1000 + capacity % 13;
+  vector<int32_t> indices(num_indices);
+  uniform_int_distribution<int> pick_dist(0, 3);
+  for (auto& idx : indices) {
+    if (!sparse_ids.empty() && pick_dist(generator)) {
+      idx = sparse_ids[generator() % sparse_ids.size()];
+    } else {
+      idx = key_dist(generator);
+    }
+  }
+
+  vector<int32_t> dense_indices_ref(num_indices, 0);
+  vector<int32_t> dense_indices(num_indices, 0);
+  pruned_hashmap_lookup_ref(
+      indices.data(),
+      num_indices,
+      hash_table.data(),
+      capacity,
+      dense_indices_ref.data());
+  pruned_hashmap_lookup(
+      indices.data(),
+      num_indices,
+      hash_table.data(),
+      capacity,
+      dense_indices.data());
+
+  for (int i = 0; i < num_indices; ++i) {
+    auto it = expected.find(indices[i]);
+    const int32_t want = it == expected.end() ? -1 : it->second;
+    EXPECT_EQ(dense_indices_ref[i], want)
+        << "reference differs at " << i << " for id " << indices[i];
+    EXPECT_EQ(dense_indices[i], want)
+        << "results differ at " << i << " for id " << indices[i];
+  }
+}
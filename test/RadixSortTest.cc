@@ -7,9 +7,13 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <random>
+#include <vector>
 
+#include "fbgemm/FbgemmThreadPool.h"
 #include "fbgemm/Utils.h"
 #ifdef _OPENMP
 #include <omp.h>
@@ -78,3 +82,150 @@ TEST(cpuKernelTest, raidx_sort_heap_overflow) {
   omp_set_num_threads(orig_threads);
 #endif
 }
+
+TEST(cpuKernelTest, radix_sort_accelerated) {
+#ifdef _OPENMP
+  const auto orig_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  EXPECT_FALSE(fbgemm::is_radix_sort_accelerated());
+  omp_set_num_threads(2);
+  EXPECT_TRUE(fbgemm::is_radix_sort_accelerated());
+  omp_set_num_threads(orig_threads);
+#else
+  EXPECT_EQ(
+      fbgemm::is_radix_sort_accelerated(),
+      fbgemm::fbgemmGetDefaultThreadPool().numThreads() > 1);
+#endif
+  fbgemm::fbgemmGetDefaultThreadPool().run([](int, int) {
+    EXPECT_FALSE(fbgemm::is_radix_sort_accelerated());
+  });
+}
+
+TEST(cpuKernelTest, radix_sort_parallel_random_test) {
+  std::mt19937 gen(0);
+  // The sizes cover the 8, 11 and 16 bit digits
+  for (const int64_t n : {1000, 100000, (1 << 21) + 3}) {
+    for (const int64_t max_val :
+         {int64_t(255), int64_t(1) << 20, int64_t(1) << 40}) {
+      for (const bool may_be_neg : {false, true}) {
+        std::uniform_int_distribution<int64_t> dist(
+            may_be_neg ? -max_val : 0, max_val);
+        std::vector<int64_t> keys(n), keys_tmp(n);
+        std::vector<int> values(n), values_tmp(n);
+        for (int64_t i = 0; i < n; ++i) {
+          keys[i] = dist(gen);
+          values[i] = i;
+        }
+        std::vector<int64_t> expected_keys = keys;
+        std::vector<int> expected_values = values;
+        std::stable_sort(
+            expected_values.begin(),
+            expected_values.end(),
+            [&](int a, int b) { return keys[a] < keys[b]; });
+        std::sort(expected_keys.begin(), expected_keys.end());
+
+        std::vector<int64_t> keys_only = keys, keys_only_tmp(n);
+        const auto sorted_keys_only = fbgemm::radix_sort_parallel(
+            keys_only.data(), keys_only_tmp.data(), n, max_val, may_be_neg);
+        EXPECT_TRUE(std::equal(
+            expected_keys.begin(), expected_keys.end(), sorted_keys_only));
+
+        const auto [sorted_keys, sorted_values] = fbgemm::radix_sort_parallel(
+            keys.data(),
+            values.data(),
+            keys_tmp.data(),
+            values_tmp.data(),
+            n,
+            max_val,
+            may_be_neg);
+        EXPECT_TRUE(std::equal(
+            expected_keys.begin(), expected_keys.end(), sorted_keys));
+        EXPECT_TRUE(std::equal(
+            expected_values.begin(), expected_values.end(), sorted_values));
+      }
+    }
+  }
+}
+
+TEST(cpuKernelTest, radix_sort_parallel_skip_pass_test) {
+  // All keys have the same upper byte, so only one pass moves them
+  std::array<int, 8> keys = {0x5507, 0x5501, 0x5503, 0x5501,
+                             0x5500, 0x5502, 0x5506, 0x5505};
+  std::array<int, 8> values = {0, 1, 2, 3, 4, 5, 6, 7};
+  std::array<int, 8> keys_tmp, values_tmp;
+  const auto [sorted_keys, sorted_values] = fbgemm::radix_sort_parallel(
+      keys.data(),
+      values.data(),
+      keys_tmp.data(),
+      values_tmp.data(),
+      keys.size(),
+      0xFFFF);
+  EXPECT_EQ(keys_tmp.data(), sorted_keys);
+  EXPECT_EQ(
+      (std::array<int, 8>{
+          0x5500, 0x5501, 0x5501, 0x5502, 0x5503, 0x5505, 0x5506, 0x5507}),
+      keys_tmp);
+  EXPECT_EQ((std::array<int, 8>{4, 1, 3, 5, 2, 7, 6, 0}), values_tmp);
+}
+
+TEST(cpuKernelTest, unique_parallel_test) {
+  const std::vector<int> keys = {4, 1, 9, 4, 4, 1, 2, 9, 0};
+  const int64_t n = keys.size();
+  std::vector<int> unique_keys(n), inverse(n), counts(n), positions(n);
+
+  const auto num_unique = fbgemm::unique_parallel(
+      keys.data(),
+      n,
+      9,
+      unique_keys.data(),
+      inverse.data(),
+      counts.data(),
+      positions.data());
+
+  ASSERT_EQ(5, num_unique);
+  unique_keys.resize(num_unique);
+  counts.resize(num_unique);
+  EXPECT_EQ((std::vector<int>{0, 1, 2, 4, 9}), unique_keys);
+  EXPECT_EQ((std::vector<int>{3, 1, 4, 3, 3, 1, 2, 4, 0}), inverse);
+  EXPECT_EQ((std::vector<int>{1, 2, 1, 3, 2}), counts);
+  EXPECT_EQ((std::vector<int>{8, 1, 5, 6, 0, 3, 4, 2, 7}), positions);
+}
+
+TEST(cpuKernelTest, unique_parallel_random_test) {
+  std::mt19937 gen(1);
+  for (const int64_t n : {1, 7, 1000, 100000}) {
+    for (const int64_t max_val :
+         {int64_t(1), int64_t(200), int64_t(70000), int64_t(1) << 40}) {
+      std::uniform_int_distribution<int64_t> dist(0, max_val);
+      std::vector<int64_t> keys(n);
+      for (auto& k : keys) {
+        k = dist(gen);
+      }
+      std::vector<int64_t> unique_keys(n), inverse(n), counts(n);
+      const auto num_unique = fbgemm::unique_parallel<int64_t, int64_t>(
+          keys.data(),
+          n,
+          max_val,
+          unique_keys.data(),
+          inverse.data(),
+          counts.data());
+
+      std::vector<int64_t> expected_unique = keys;
+      std::sort(expected_unique.begin(), expected_unique.end());
+      expected_unique.erase(
+          std::unique(expected_unique.begin(), expected_unique.end()),
+          expected_unique.end());
+      ASSERT_EQ(expected_unique.size(), num_unique);
+      unique_keys.resize(num_unique);
+      EXPECT_EQ(expected_unique, unique_keys);
+
+      std::vector<int64_t> expected_counts(num_unique, 0);
+      for (int64_t i = 0; i < n; ++i) {
+        ASSERT_EQ(keys[i], unique_keys[inverse[i]]);
+        ++expected_counts[inverse[i]];
+      }
+      counts.resize(num_unique);
+      EXPECT_EQ(expected_counts, counts);
+    }
+  }
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "./TestUtils.h"
+#include "bench/BenchUtils.h"
+#include "fbgemm/FbgemmReplicatedWeights.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// Emulates NUMA nodes for the lifetime of a test.
+class ReplicatedWeightsTest : public testing::Test {
+ protected:
+  static constexpr int kNumNodes = 3;
+
+  void SetUp() override {
+    fbgemmSetEmulatedNumaNodes(kNumNodes);
+  }
+
+  void TearDown() override {
+    fbgemmSetEmulatedNumaNodes(0);
+  }
+};
+
+} // namespace
+
+TEST_F(ReplicatedWeightsTest, NumaNodes) {
+  EXPECT_EQ(fbgemmGetNumNumaNodes(), kNumNodes);
+  EXPECT_TRUE(fbgemmIsNumaEmulated());
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    const int node = fbgemmGetCurrentNumaNode();
+    EXPECT_GE(node, 0);
+    EXPECT_LT(node, kNumNodes);
+  }
+  fbgemmSetEmulatedNumaNodes(0);
+  EXPECT_FALSE(fbgemmIsNumaEmulated());
+  EXPECT_GE(fbgemmGetNumNumaNodes(), 1);
+  EXPECT_GE(fbgemmGetCurrentNumaNode(), 0);
+  EXPECT_LT(fbgemmGetCurrentNumaNode(), fbgemmGetNumNumaNodes());
+}
+
+TEST_F(ReplicatedWeightsTest, PackBMatrix) {
+  constexpr int m = 67, n = 130, k = 256, groups = 2;
+  aligned_vector<uint8_t> A(m * k);
+  aligned_vector<int8_t> B(k * n);
+  randFill<uint8_t>(A, 0, 255);
+  randFill<int8_t>(B, -128, 127);
+
+  PackBMatrix<int8_t> packedB(
+      matrix_op_t::NoTranspose, k, n, B.data(), n, nullptr, groups);
+  ReplicatedPackedWeights<PackBMatrix<int8_t>> replicatedB(
+      matrix_op_t::NoTranspose, k, n, B.data(), n, nullptr, groups);
+  ASSERT_EQ(replicatedB.numReplicas(), kNumNodes);
+
+  for (int node = 0; node < kNumNodes; ++node) {
+    for (int other = 0; other < node; ++other) {
+      EXPECT_NE(
+          replicatedB.replica(node).getBuf(),
+          replicatedB.replica(other).getBuf());
+    }
+    EXPECT_TRUE(replicatedB.replica(node).equals(packedB));
+    aligned_vector<int8_t> unpacked(k * n);
+    replicatedB.replica(node).unpack(unpacked.data());
+    EXPECT_EQ(unpacked, B) << "node " << node;
+  }
+
+  aligned_vector<int32_t> C_ref(m * n * groups);
+  aligned_vector<int32_t> C(C_ref.size());
+  for (auto* out : {&C_ref, &C}) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      PackAMatrix<uint8_t> packA(
+          matrix_op_t::NoTranspose, m, k, A.data(), k, nullptr, groups);
+      DoNothing<int32_t, int32_t> doNothingObj{};
+      memCopy<> outputProcObj(doNothingObj);
+      int num_threads = fbgemm_get_num_threads();
+      int tid = fbgemm_get_thread_num();
+      if (out == &C_ref) {
+        fbgemmPacked(
+            packA,
+            packedB,
+            out->data(),
+            out->data(),
+            n * groups,
+            outputProcObj,
+            tid,
+            num_threads);
+      } else {
+        fbgemmPacked(
+            packA,
+            replicatedB,
+            out->data(),
+            out->data(),
+            n * groups,
+            outputProcObj,
+            tid,
+            num_threads);
+      }
+    }
+  }
+  EXPECT_EQ(C, C_ref);
+}
+
+TEST_F(ReplicatedWeightsTest, RejectsUserBuffer) {
+  constexpr int n = 64, k = 128;
+  aligned_vector<int8_t> B(k * n);
+  randFill<int8_t>(B, -128, 127);
+  aligned_vector<int8_t> pmat(PackBMatrix<int8_t>::packedBufferSize(k, n));
+  using Replicated = ReplicatedPackedWeights<PackBMatrix<int8_t>>;
+  EXPECT_THROW(
+      Replicated(matrix_op_t::NoTranspose, k, n, B.data(), n, pmat.data()),
+      std::runtime_error);
+}
+
+TEST_F(ReplicatedWeightsTest, PackedGemmMatrixFP16) {
+  constexpr int m = 33, n = 200, k = 128;
+  aligned_vector<float> A(m * k);
+  aligned_vector<float> B(k * n);
+  randFill<float>(A, -1, 1);
+  randFill<float>(B, -1, 1);
+
+  PackedGemmMatrixFP16 packedB(matrix_op_t::NoTranspose, k, n, 1.0f, B.data());
+  ReplicatedPackedWeights<PackedGemmMatrixFP16> replicatedB(
+      matrix_op_t::NoTranspose, k, n, 1.0f, B.data());
+  ASSERT_EQ(replicatedB.numReplicas(), kNumNodes);
+
+  aligned_vector<float> C_ref(m * n);
+  aligned_vector<float> C(m * n);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    int num_threads = fbgemm_get_num_threads();
+    int tid = fbgemm_get_thread_num();
+    cblas_gemm_compute(
+        matrix_op_t::NoTranspose,
+        m,
+        A.data(),
+        packedB,
+        0.0f,
+        C_ref.data(),
+        tid,
+        num_threads);
+    cblas_gemm_compute(
+        matrix_op_t::NoTranspose,
+        m,
+        A.data(),
+        replicatedB,
+        0.0f,
+        C.data(),
+        tid,
+        num_threads);
+  }
+  EXPECT_EQ(C, C_ref);
+}
+
+TEST_F(ReplicatedWeightsTest, PackWeightsForConv) {
+  // 3x3 convolution that takes the im2col path
+  conv_param_t<2> conv_p(2, 32, 64, {14, 14}, 1, {3, 3}, {1, 1}, {1, 1, 1, 1});
+  const int kernel_dim = conv_p.K[0] * conv_p.K[1];
+  const int out_size = conv_p.MB * conv_p.OUT_DIM[0] * conv_p.OUT_DIM[1];
+  aligned_vector<uint8_t> A(
+      conv_p.MB * conv_p.IN_DIM[0] * conv_p.IN_DIM[1] * conv_p.IC);
+  aligned_vector<int8_t> B(kernel_dim * conv_p.IC * conv_p.OC);
+  randFill<uint8_t>(A, 0, 255);
+  randFill<int8_t>(B, -128, 127);
+
+  PackWeightsForConv<2> packedB(conv_p, B.data());
+  ReplicatedPackWeightsForConv<2> replicatedB(conv_p, B.data());
+  ASSERT_EQ(replicatedB.numReplicas(), kNumNodes);
+
+  vector<float> C_multiplier = {0.001f};
+  vector<int32_t> B_zero_point = {0};
+  vector<int32_t> col_offsets(conv_p.OC);
+  aligned_vector<uint8_t> C_ref(out_size * conv_p.OC);
+  aligned_vector<uint8_t> C(C_ref.size());
+  aligned_vector<int32_t> C_buffer_ref(C_ref.size());
+  aligned_vector<int32_t> C_buffer(C_ref.size());
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    DoNothing<> doNothingObj{};
+    ReQuantizeOutput<false> outputProcObj(
+        doNothingObj,
+        C_multiplier.data(),
+        /*C_zero_point=*/5,
+        /*Aq_zero_point=*/3,
+        B_zero_point.data(),
+        nullptr, // row offsets
+        col_offsets.data(),
+        nullptr, // bias
+        conv_p.OC,
+        conv_p.G);
+    int num_threads = fbgemm_get_num_threads();
+    int tid = fbgemm_get_thread_num();
+    fbgemmConv(
+        conv_p,
+        A.data(),
+        packedB,
+        C_ref.data(),
+        C_buffer_ref.data(),
+        outputProcObj,
+        tid,
+        num_threads);
+    fbgemmConv(
+        conv_p,
+        A.data(),
+        replicatedB,
+        C.data(),
+        C_buffer.data(),
+        outputProcObj,
+        tid,
+        num_threads);
+  }
+  EXPECT_EQ(C, C_ref);
+}
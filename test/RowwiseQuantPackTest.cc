@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "bench/BenchUtils.h"
+#include "fbgemm/Fbgemm.h"
+#include "fbgemm/QuantUtils.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// m, k, groups
+class RowwiseQuantPackTest
+    : public testing::TestWithParam<tuple<int, int, int>> {};
+class RowwiseQuantGemmTest
+    : public testing::TestWithParam<
+          tuple<matrix_op_t, QuantizationGranularity>> {};
+
+// Per-row quantization parameters the packing is expected to choose
+vector<TensorQuantizationParams>
+rowQParams(int m, int k, const aligned_vector<float>& A) {
+  vector<TensorQuantizationParams> qparams(m);
+  for (int i = 0; i < m; ++i) {
+    const auto minmax =
+        minmax_element(A.begin() + i * k, A.begin() + (i + 1) * k);
+    qparams[i] =
+        ChooseQuantizationParams(*minmax.first, *minmax.second, 0, 255);
+    qparams[i].precision = 8;
+  }
+  return qparams;
+}
+
+} // anonymous namespace
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    RowwiseQuantPackTest,
+    ::testing::Values(
+        make_tuple(1, 64, 1),
+        make_tuple(7, 513, 1),
+        make_tuple(130, 300, 3),
+        make_tuple(33, 1024, 4)));
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    RowwiseQuantGemmTest,
+    ::testing::Combine(
+        ::testing::Values(matrix_op_t::NoTranspose, matrix_op_t::Transpose),
+        ::testing::Values(
+            QuantizationGranularity::TENSOR,
+            QuantizationGranularity::GROUP,
+            QuantizationGranularity::OUT_CHANNEL)));
+
+/**
+ * @brief Packs A block by block, in the order fbgemmPacked does, and checks
+ * the per-row quantization parameters, the packed values, and that the row
+ * offsets are the sums of the packed values of each group.
+ */
+TEST_P(RowwiseQuantPackTest, Pack) {
+  int m, k, groups;
+  tie(m, k, groups) = GetParam();
+  const int k_per_group = k / groups;
+
+  aligned_vector<float> A(m * k);
+  randFill<float>(A, -2.0f, 3.0f);
+  // A row of constants and a row of non-negative values
+  fill(A.begin(), A.begin() + k, 0.5f);
+  if (m > 1) {
+    for (int j = 0; j < k; ++j) {
+      A[k + j] = fabs(A[k + j]);
+    }
+  }
+  const auto qparams = rowQParams(m, k, A);
+
+  for (auto atrans : {matrix_op_t::NoTranspose, matrix_op_t::Transpose}) {
+    aligned_vector<float> A_src(A);
+    if (atrans == matrix_op_t::Transpose) {
+      transpose_matrix(m, k, A.data(), k, A_src.data(), m);
+    }
+    PackAWithRowwiseQuantRowOffset<uint8_t> packA(
+        atrans,
+        m,
+        k,
+        A_src.data(),
+        atrans == matrix_op_t::Transpose ? m : k,
+        nullptr,
+        groups);
+
+    const int mcb = packA.blockRowSize();
+    const int kcb = packA.blockColSize();
+    // Same order as fbgemmPacked: the groups after the first one reuse the
+    // parameters of rows packed several row blocks earlier.
+    for (int g = 0; g < groups; ++g) {
+      for (int i0 = 0; i0 < m; i0 += mcb) {
+        const int rows = min(mcb, m - i0);
+        vector<int32_t> row_sums(rows, 0);
+        for (int kk = 0; kk < k_per_group; kk += kcb) {
+          const int cols = min(kcb, k_per_group - kk);
+          const int j0 = g * k_per_group + kk;
+          block_type_t block{i0, rows, j0, cols};
+          packA.pack(block);
+
+          const uint8_t* buf = packA.getBuf();
+          for (int i = 0; i < rows; ++i) {
+            const auto& q = qparams[i0 + i];
+            ASSERT_FLOAT_EQ(packA.getRowScaleBuffer()[i], q.scale);
+            ASSERT_EQ(packA.getRowZeroPointBuffer()[i], q.zero_point);
+            for (int j = 0; j < cols; ++j) {
+              // Allow halfway cases to round either way
+              const int expected =
+                  Quantize<uint8_t>(A[(i0 + i) * k + j0 + j], q);
+              EXPECT_NEAR(buf[i * kcb + j], expected, 1)
+                  << "row " << i0 + i << " col " << j0 + j;
+              row_sums[i] += buf[i * kcb + j];
+            }
+          }
+        }
+        for (int i = 0; i < rows; ++i) {
+          EXPECT_EQ(packA.getRowOffsetBuffer()[i], row_sums[i])
+              << "row " << i0 + i << " group " << g;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Unit test for fp32 matrix A quantized per row while packing, int8
+ * matrix B, and 32-bit accumulation. Output processing: per-row
+ * requantization for float -> nothing
+ */
+TEST_P(RowwiseQuantGemmTest, FloatInputOutput) {
+  matrix_op_t atrans;
+  QuantizationGranularity q_granularity;
+  tie(atrans, q_granularity) = GetParam();
+
+  // {M, N, K}
+  const vector<vector<int>> shapes = {
+      {1, 128, 512},
+      {6, 2048, 257},
+      {102, 512, 256},
+      {120, 4, 288},
+  };
+  for (const auto& shape : shapes) {
+    for (int groups : {1, 4}) {
+      const int m = shape[0];
+      const int n = shape[1];
+      const int k = shape[2];
+      if (k % groups != 0) {
+        continue;
+      }
+      const int k_per_group = k / groups;
+
+      // Rows have widely different ranges, which is where per-row
+      // quantization helps
+      aligned_vector<float> Afp32(m * k);
+      randFill<float>(Afp32, -1.0f, 1.0f);
+      for (int i = 0; i < m; ++i) {
+        const float row_range = 0.01f + 4.0f * (i % 5);
+        for (int j = 0; j < k; ++j) {
+          Afp32[i * k + j] = Afp32[i * k + j] * row_range + 0.1f * (i % 3);
+        }
+      }
+      const auto qparams = rowQParams(m, k, Afp32);
+
+      // The quantized A isn't known before packing, so keep B small enough
+      // that pairs of u8 * s8 products don't saturate int16
+      aligned_vector<int8_t> Bint8(k * n);
+      randFill<int8_t>(Bint8, -64, 63);
+
+      int ncols_per_quant_group = groups * n;
+      if (q_granularity == QuantizationGranularity::GROUP) {
+        ncols_per_quant_group = n;
+      } else if (q_granularity == QuantizationGranularity::OUT_CHANNEL) {
+        ncols_per_quant_group = 1;
+      }
+      aligned_vector<int32_t> Bint8_zero_point(
+          groups * n / ncols_per_quant_group);
+      randFill(Bint8_zero_point, -50, -10);
+      aligned_vector<float> Bint8_scale(Bint8_zero_point.size());
+      randFill(Bint8_scale, 0.49f / 2, 0.49f * 3 / 2);
+      aligned_vector<float> Bfp32(k * n);
+      for (int i = 0; i < k; ++i) {
+        const int g = i / k_per_group;
+        for (int j = 0; j < n; ++j) {
+          const int quant_group = (g * n + j) / ncols_per_quant_group;
+          Bfp32[i * n + j] = Bint8_scale[quant_group] *
+              (Bint8[i * n + j] - Bint8_zero_point[quant_group]);
+        }
+      }
+
+      vector<int32_t> col_offsets(groups * n);
+      for (int g = 0; g < groups; ++g) {
+        col_offsets_with_zero_pt_s8acc32_ref(
+            k_per_group,
+            n,
+            n,
+            Bint8.data() + g * k_per_group * n,
+            Bint8_zero_point.data() + g * n / ncols_per_quant_group,
+            col_offsets.data() + g * n,
+            ncols_per_quant_group);
+      }
+
+      aligned_vector<float> Cfp32_ref(m * n * groups);
+      aligned_vector<float> Cfp32_fb(Cfp32_ref.size());
+      for (int g = 0; g < groups; ++g) {
+        cblas_sgemm_ref(
+            matrix_op_t::NoTranspose,
+            matrix_op_t::NoTranspose,
+            m,
+            n,
+            k_per_group,
+            1.0f,
+            Afp32.data() + g * k_per_group,
+            k,
+            Bfp32.data() + g * k_per_group * n,
+            n,
+            0.0f,
+            Cfp32_ref.data() + g * n,
+            groups * n);
+      }
+
+      aligned_vector<float> Afp32_src(Afp32);
+      if (atrans == matrix_op_t::Transpose) {
+        transpose_matrix(m, k, Afp32.data(), k, Afp32_src.data(), m);
+      }
+
+      PackBMatrix<int8_t> packedBN(
+          matrix_op_t::NoTranspose, k, n, Bint8.data(), n, nullptr, groups);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        PackAWithRowwiseQuantRowOffset<uint8_t> packAN(
+            atrans,
+            m,
+            k,
+            Afp32_src.data(),
+            (atrans == matrix_op_t::Transpose) ? m : k,
+            nullptr, /*buffer for packed matrix*/
+            groups);
+
+        int num_threads = fbgemm_get_num_threads();
+        int tid = fbgemm_get_thread_num();
+
+        DoNothing<float, float> doNothingObj{};
+        auto run = [&](const auto& outputProcObj) {
+          fbgemmPacked(
+              packAN,
+              packedBN,
+              Cfp32_fb.data(),
+              reinterpret_cast<int32_t*>(Cfp32_fb.data()),
+              groups * n,
+              outputProcObj,
+              tid,
+              num_threads);
+        };
+        if (q_granularity == QuantizationGranularity::TENSOR) {
+          run(ReQuantizeForFloat<false>(
+              doNothingObj,
+              packAN.getRowScaleBuffer(),
+              packAN.getRowZeroPointBuffer(),
+              Bint8_scale.data(),
+              Bint8_zero_point.data(),
+              packAN.getRowOffsetBuffer(),
+              col_offsets.data(),
+              nullptr,
+              groups * n,
+              groups));
+        } else if (q_granularity == QuantizationGranularity::GROUP) {
+          run(ReQuantizeForFloat<false, QuantizationGranularity::GROUP>(
+              doNothingObj,
+              packAN.getRowScaleBuffer(),
+              packAN.getRowZeroPointBuffer(),
+              Bint8_scale.data(),
+              Bint8_zero_point.data(),
+              packAN.getRowOffsetBuffer(),
+              col_offsets.data(),
+              nullptr,
+              groups * n,
+              groups));
+        } else {
+          run(ReQuantizeForFloat<false, QuantizationGranularity::OUT_CHANNEL>(
+              doNothingObj,
+              packAN.getRowScaleBuffer(),
+              packAN.getRowZeroPointBuffer(),
+              Bint8_scale.data(),
+              Bint8_zero_point.data(),
+              packAN.getRowOffsetBuffer(),
+              col_offsets.data(),
+              nullptr,
+              groups * n,
+              groups));
+        }
+      }
+
+      // Rounding every element of row i moves it by at most half a step
+      for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < groups * n; ++j) {
+          const int g = j / n;
+          float abs_sum = 0;
+          for (int kk = 0; kk < k_per_group; ++kk) {
+            abs_sum += fabs(Bfp32[(g * k_per_group + kk) * n + j % n]);
+          }
+          const float c = Cfp32_ref[i * groups * n + j];
+          const float atol =
+              qparams[i].scale / 2 * abs_sum * 1.01f + fabs(c) * 1e-5f + 1e-5f;
+          EXPECT_NEAR(Cfp32_fb[i * groups * n + j], c, atol)
+              << "row " << i << " col " << j;
+        }
+      }
+    } // for each groups
+  } // for each shape
+}
+
+/**
+ * @brief The per-row ReQuantizeForFloat gives the same result on the
+ * reference and vectorized paths.
+ */
+TEST(RowwiseQuantRequantizeTest, PerRowParams) {
+  const int m = 13, n = 37, k = 64;
+  aligned_vector<int32_t> C(m * n), row_offsets(m), col_offsets(n);
+  aligned_vector<int32_t> A_zero_points(m), B_zero_point(n);
+  aligned_vector<float> A_scales(m), B_scale(n), bias(n);
+  randFill<int32_t>(C, -100000, 100000);
+  randFill<int32_t>(row_offsets, 0, 255 * k);
+  randFill<int32_t>(col_offsets, -128 * k, 127 * k);
+  randFill<int32_t>(A_zero_points, 0, 255);
+  randFill<int32_t>(B_zero_point, -20, 20);
+  randFill<float>(A_scales, 0.001f, 0.1f);
+  randFill<float>(B_scale, 0.01f, 0.5f);
+  randFill<float>(bias, -1.0f, 1.0f);
+  A_zero_points[0] = 0;
+
+  DoNothing<float, float> doNothingObj{};
+  ReQuantizeForFloat<false, QuantizationGranularity::OUT_CHANNEL> outputProc(
+      doNothingObj,
+      A_scales.data(),
+      A_zero_points.data(),
+      B_scale.data(),
+      B_zero_point.data(),
+      row_offsets.data(),
+      col_offsets.data(),
+      bias.data(),
+      n);
+
+  aligned_vector<float> C_ref(m * n), C_avx2(m * n);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const int32_t raw = C[i * n + j] - A_zero_points[i] * col_offsets[j] -
+          row_offsets[i] * B_zero_point[j];
+      C_ref[i * n + j] = raw * A_scales[i] * B_scale[j] + bias[j];
+    }
+  }
+
+  block_type_t block{0, m, 0, n};
+  aligned_vector<float> C_scalar(m * n);
+  outputProc.f<inst_set_t::anyarch>(C_scalar.data(), C.data(), block, n, n);
+  for (int i = 0; i < m * n; ++i) {
+    EXPECT_NEAR(C_scalar[i], C_ref[i], 1e-5f * max(1.0f, fabs(C_ref[i])));
+  }
+  if (fbgemmHasAvx2Support()) {
+    outputProc.f<inst_set_t::avx2>(C_avx2.data(), C.data(), block, n, n);
+    for (int i = 0; i < m * n; ++i) {
+      EXPECT_NEAR(C_avx2[i], C_ref[i], 1e-5f * max(1.0f, fabs(C_ref[i])));
+    }
+  }
+}
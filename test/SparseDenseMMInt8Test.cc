@@ -185,3 +185,213 @@ TEST_P(SPMMInt8Test, spInt8) {
         << ctDataIntrin_u8[i] << " at " << i;
   }
 }
+
+// tuple represents M, N, K, non-zeros per group of 4, fuse_relu,
+// QuantizationGranularity and number of threads
+class NMSPMMInt8Test
+    : public testing::TestWithParam<
+          tuple<int, int, int, int, bool, QuantizationGranularity, int>> {};
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    NMSPMMInt8Test,
+    ::testing::Combine(
+        ::testing::ValuesIn({1, 3, 16, 20, 32, 70}), // M
+        ::testing::ValuesIn({1, 7, 16, 20}), // N
+        ::testing::ValuesIn({1, 3, 4, 14, 24, 4001}), // K
+        ::testing::ValuesIn({1, 2}), // nnz
+        ::testing::Bool(), // fuse relu
+        ::testing::ValuesIn(qGranularityVals), // QuantizationGranularity
+        ::testing::ValuesIn({1, 3}))); // num_threads
+
+namespace {
+
+// Packs the N x K weights btData in NNZ:4 format and runs the GEMM with
+// every thread of num_threads, then requantizes the reference result.
+template <bool FUSE_RELU, QuantizationGranularity Q_GRAN, int NNZ>
+void runNMSparseDenseInt8MM(
+    int M,
+    int N,
+    int K,
+    const int8_t* btData,
+    const uint8_t* atData,
+    int32_t* ctDataIntrin_i32,
+    uint8_t* ctDataIntrin_u8,
+    int32_t* ctDataRef,
+    uint8_t* ctDataRef_u8,
+    trRequantizationParams_t& reqParams,
+    int num_threads) {
+  auto nm = fbgemmDenseToNMSparse<NNZ, 4>(N, K, btData);
+  reqParams.weight_row_offsets = nm->row_offsets.data();
+  for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+    fbgemmSparseDenseInt8MM<FUSE_RELU, Q_GRAN>(
+        M,
+        nm,
+        atData,
+        M, // ldb
+        ctDataIntrin_i32,
+        ctDataIntrin_u8,
+        M, // ldc
+        reqParams,
+        false, // accum
+        thread_id,
+        num_threads);
+  }
+
+  block_type_t block{0, N, 0, M};
+  trRequantizeRef<FUSE_RELU, Q_GRAN>(
+      ctDataRef_u8, ctDataRef, block, M, M, reqParams);
+}
+
+template <int NNZ>
+void runNMSparseDenseInt8MM(
+    bool fuse_relu,
+    QuantizationGranularity qGran,
+    int M,
+    int N,
+    int K,
+    const int8_t* btData,
+    const uint8_t* atData,
+    int32_t* ctDataIntrin_i32,
+    uint8_t* ctDataIntrin_u8,
+    int32_t* ctDataRef,
+    uint8_t* ctDataRef_u8,
+    trRequantizationParams_t& reqParams,
+    int num_threads) {
+#define RUN_NM(RELU, QGRAN)                                         \
+  runNMSparseDenseInt8MM<RELU, QuantizationGranularity::QGRAN, NNZ>( \
+      M,                                                            \
+      N,                                                            \
+      K,                                                            \
+      btData,                                                       \
+      atData,                                                       \
+      ctDataIntrin_i32,                                             \
+      ctDataIntrin_u8,                                              \
+      ctDataRef,                                                    \
+      ctDataRef_u8,                                                 \
+      reqParams,                                                    \
+      num_threads)
+  if (fuse_relu) {
+    if (qGran == QuantizationGranularity::TENSOR) {
+      RUN_NM(true, TENSOR);
+    } else {
+      RUN_NM(true, OUT_CHANNEL);
+    }
+  } else {
+    if (qGran == QuantizationGranularity::TENSOR) {
+      RUN_NM(false, TENSOR);
+    } else {
+      RUN_NM(false, OUT_CHANNEL);
+    }
+  }
+#undef RUN_NM
+}
+
+} // anonymous namespace
+
+/**
+ * Test for N:M sparse-dense matrix-matrix multiplication (int8)
+ */
+TEST_P(NMSPMMInt8Test, nmSpInt8) {
+  int M, N, K, nnz, num_threads;
+  bool fuse_relu;
+  QuantizationGranularity qGran;
+  tie(M, N, K, nnz, fuse_relu, qGran, num_threads) = GetParam();
+
+  auto aData = getRandomBlockSparseMatrix<uint8_t>(
+      M, K, 1.0, 1 /* rowBlockSize */, 1 /* colBlockSize */);
+  // Weights are N x K with at most nnz non-zeros in every group of 4 along K
+  auto btData = getRandomNMSparseMatrix<int8_t>(N, K, nnz, 4, -9, 9);
+  auto cData = getRandomBlockSparseMatrix<int32_t>(
+      M, N, 1.0, 1 /* rowBlockSize */, 1 /* colBlockSize */);
+
+  aligned_vector<uint8_t> atData(K * M);
+  aligned_vector<int8_t> bData(K * N);
+  aligned_vector<int32_t> ctDataRef(N * M, 5);
+  aligned_vector<uint8_t> ctDataRef_u8(N * M, 7);
+  aligned_vector<int32_t> ctDataIntrin_i32(N * M, 9);
+  aligned_vector<uint8_t> ctDataIntrin_u8(N * M, 11);
+
+  transpose_matrix(M, K, aData.data(), K, atData.data(), M);
+  transpose_matrix(N, K, btData.data(), K, bData.data(), N);
+
+  matmul_u8i8acc32_ref(
+      M,
+      N,
+      K,
+      K, // lda
+      N, // ldb
+      N, // ldc
+      aData.data(),
+      bData.data(),
+      cData.data());
+  transpose_matrix(M, N, cData.data(), N, ctDataRef.data(), M);
+
+  // output scale and zero point
+  float scale = 128.0f;
+  int32_t zero_point = 2;
+
+  int32_t act_zero_point = 2;
+
+  // symmetric quant for weights
+  aligned_vector<int32_t> weight_zero_point(N);
+  randFill<int32_t>(weight_zero_point, 0, 0);
+
+  aligned_vector<float> act_times_w_scale(N);
+  randFill<float>(act_times_w_scale, -8.0f, 8.0f);
+
+  aligned_vector<float> bias(N);
+  randFill<float>(bias, -8.0f, 8.0f);
+
+  trRequantizationParams_t reqParams = {
+      act_zero_point,
+      weight_zero_point.data(),
+      zero_point,
+      scale,
+      nullptr, // set after packing
+      nullptr,
+      bias.data(),
+      act_times_w_scale.data()};
+
+  if (nnz == 1) {
+    runNMSparseDenseInt8MM<1>(
+        fuse_relu,
+        qGran,
+        M,
+        N,
+        K,
+        btData.data(),
+        atData.data(),
+        ctDataIntrin_i32.data(),
+        ctDataIntrin_u8.data(),
+        ctDataRef.data(),
+        ctDataRef_u8.data(),
+        reqParams,
+        num_threads);
+  } else {
+    runNMSparseDenseInt8MM<2>(
+        fuse_relu,
+        qGran,
+        M,
+        N,
+        K,
+        btData.data(),
+        atData.data(),
+        ctDataIntrin_i32.data(),
+        ctDataIntrin_u8.data(),
+        ctDataRef.data(),
+        ctDataRef_u8.data(),
+        reqParams,
+        num_threads);
+  }
+
+  // Compare results
+  for (size_t i = 0; i < ctDataRef.size(); i++) {
+    EXPECT_EQ(ctDataRef[i], ctDataIntrin_i32[i])
+        << "Results differ ref " << ctDataRef[i] << " and test "
+        << ctDataIntrin_i32[i] << " at " << i;
+    EXPECT_EQ(ctDataRef_u8[i], ctDataIntrin_u8[i])
+        << "Results differ ref " << static_cast<int>(ctDataRef_u8[i])
+        << " and test " << static_cast<int>(ctDataIntrin_u8[i]) << " at " << i;
+  }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fbgemm/FbgemmEmbedding.h"
+#include "fbgemm/Types.h"
+#include "src/RefImplementations.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+// Row lengths around the vector length, to exercise the masked tails
+vector<int> block_sizes{1, 4, 7, 8, 15, 16, 33, 64, 100, 129};
+
+// Parameters are whether the weights are fp16, whether the second momentum
+// is rowwise, and the weight decay.
+class SparseOptimizersTest
+    : public testing::TestWithParam<tuple<bool, bool, float>> {};
+
+template <typename DataType>
+vector<DataType> randomWeights(int n, default_random_engine& generator) {
+  uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  vector<DataType> w(n);
+  for (auto& x : w) {
+    x = convert_from_float_ref<DataType>(dist(generator));
+  }
+  return w;
+}
+
+vector<float>
+randomFloats(int n, float lo, float hi, default_random_engine& generator) {
+  uniform_real_distribution<float> dist(lo, hi);
+  vector<float> x(n);
+  for (auto& val : x) {
+    val = dist(generator);
+  }
+  return x;
+}
+
+template <typename DataType>
+void expectNear(
+    const vector<DataType>& actual,
+    const vector<DataType>& expected,
+    float tol) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    float a = convert_to_float_ref(actual[i]);
+    float e = convert_to_float_ref(expected[i]);
+    EXPECT_NEAR(a, e, tol * max(1.0f, fabs(e))) << "at " << i;
+  }
+}
+
+template <typename DataType>
+void testAdamAndLamb(bool rowwise, float weight_decay, bool lamb) {
+  // fp16 results may be rounded differently when the float ones differ in
+  // their last bits
+  const float tol = is_same<DataType, float16>::value ? 1e-3f : 1e-5f;
+  default_random_engine generator(block_sizes.size());
+  for (int block_size : block_sizes) {
+    auto w = randomWeights<DataType>(block_size, generator);
+    auto m = randomFloats(block_size, -0.1f, 0.1f, generator);
+    auto v = randomFloats(rowwise ? 1 : block_size, 0.0f, 0.1f, generator);
+    auto w_ref = w, m_ref = m, v_ref = v;
+    // Several steps so that errors would accumulate in the momentums
+    for (int64_t iter = 1; iter <= 3; ++iter) {
+      auto g = randomFloats(block_size, -1.0f, 1.0f, generator);
+      auto g_ref = g;
+      if (lamb) {
+        SparseLambRowUpdate(
+            block_size,
+            w.data(),
+            g.data(),
+            m.data(),
+            v.data(),
+            0.1f,
+            1e-5f,
+            0.9f,
+            0.99f,
+            weight_decay,
+            iter,
+            rowwise);
+        sparse_lamb_row_ref(
+            block_size,
+            w_ref.data(),
+            g_ref.data(),
+            m_ref.data(),
+            v_ref.data(),
+            0.1f,
+            1e-5f,
+            0.9f,
+            0.99f,
+            weight_decay,
+            iter,
+            rowwise);
+        expectNear(g, g_ref, 1e-4f);
+      } else {
+        SparseAdamRowUpdate(
+            block_size,
+            w.data(),
+            g.data(),
+            m.data(),
+            v.data(),
+            0.1f,
+            1e-5f,
+            0.9f,
+            0.99f,
+            weight_decay,
+            iter,
+            rowwise);
+        sparse_adam_row_ref(
+            block_size,
+            w_ref.data(),
+            g_ref.data(),
+            m_ref.data(),
+            v_ref.data(),
+            0.1f,
+            1e-5f,
+            0.9f,
+            0.99f,
+            weight_decay,
+            iter,
+            rowwise);
+      }
+      expectNear(m, m_ref, 1e-5f);
+      expectNear(v, v_ref, 1e-5f);
+      expectNear(w, w_ref, tol);
+    }
+  }
+}
+
+template <typename DataType>
+void testLarsSgd(float weight_decay) {
+  const float tol = is_same<DataType, float16>::value ? 1e-3f : 1e-5f;
+  default_random_engine generator(block_sizes.size());
+  for (int block_size : block_sizes) {
+    auto w = randomWeights<DataType>(block_size, generator);
+    auto m = randomFloats(block_size, -0.1f, 0.1f, generator);
+    auto w_ref = w, m_ref = m;
+    for (int iter = 0; iter < 3; ++iter) {
+      auto g = randomFloats(block_size, -1.0f, 1.0f, generator);
+      SparseLarsSgdRowUpdate(
+          block_size, w.data(), g.data(), m.data(), 0.1f, 0.01f, 0.9f,
+          weight_decay);
+      sparse_lars_sgd_row_ref(
+          block_size,
+          w_ref.data(),
+          g.data(),
+          m_ref.data(),
+          0.1f,
+          0.01f,
+          0.9f,
+          weight_decay);
+      expectNear(m, m_ref, 1e-5f);
+      expectNear(w, w_ref, tol);
+    }
+  }
+}
+
+} // namespace
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    SparseOptimizersTest,
+    ::testing::Combine(
+        ::testing::Bool(), // fp16 weights
+        ::testing::Bool(), // rowwise
+        ::testing::Values(0.0f, 0.01f))); // weight decay
+
+TEST_P(SparseOptimizersTest, Adam) {
+  bool fp16, rowwise;
+  float weight_decay;
+  tie(fp16, rowwise, weight_decay) = GetParam();
+  if (fp16) {
+    testAdamAndLamb<float16>(rowwise, weight_decay, /*lamb=*/false);
+  } else {
+    testAdamAndLamb<float>(rowwise, weight_decay, /*lamb=*/false);
+  }
+}
+
+TEST_P(SparseOptimizersTest, Lamb) {
+  bool fp16, rowwise;
+  float weight_decay;
+  tie(fp16, rowwise, weight_decay) = GetParam();
+  if (fp16) {
+    testAdamAndLamb<float16>(rowwise, weight_decay, /*lamb=*/true);
+  } else {
+    testAdamAndLamb<float>(rowwise, weight_decay, /*lamb=*/true);
+  }
+}
+
+TEST_P(SparseOptimizersTest, LarsSgd) {
+  bool fp16, rowwise;
+  float weight_decay;
+  tie(fp16, rowwise, weight_decay) = GetParam();
+  if (rowwise) {
+    GTEST_SKIP() << "LARS-SGD has no rowwise variant";
+  }
+  if (fp16) {
+    testLarsSgd<float16>(weight_decay);
+  } else {
+    testLarsSgd<float>(weight_decay);
+  }
+}
@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <stdexcept>
 
 #include "bench/BenchUtils.h"
 #include "fbgemm/FbgemmSparse.h"
@@ -63,3 +64,67 @@ TEST_P(packUnpackTest, sparseUnpackTest) {
     }
   }
 }
+
+// tuple represents N, K and the number of non-zeros in each group of 4
+class nmPackUnpackTest
+    : public testing::TestWithParam<tuple<int, int, int>> {};
+
+INSTANTIATE_TEST_CASE_P(
+    InstantiationName,
+    nmPackUnpackTest,
+    ::testing::Combine(
+        ::testing::ValuesIn({1, 2, 3, 7, 16, 20}), // N
+        ::testing::ValuesIn({1, 2, 3, 4, 7, 8, 14, 24, 4001, 4096}), // K
+        ::testing::ValuesIn({0, 1, 2}))); // nnz
+
+/**
+ * Test for packing/unpacking of the N:M sparse formats
+ */
+TEST_P(nmPackUnpackTest, nmSparseUnpackTest) {
+  int N, K, nnz;
+  tie(N, K, nnz) = GetParam();
+
+  // wData has at most nnz non-zeros in every group of 4, some groups have
+  // fewer because of zero values
+  auto wData = getRandomNMSparseMatrix<int8_t>(N, K, nnz, 4, -9, 9);
+
+  auto check = [&](const auto& nm) {
+    vector<int8_t> wUnpackedData(N * K, 0);
+    nm->unpack(wUnpackedData.data());
+    for (int j = 0; j < N; ++j) {
+      int32_t sum = 0;
+      for (int k = 0; k < K; ++k) {
+        sum += wData[j * K + k];
+        ASSERT_EQ(wData[j * K + k], wUnpackedData[j * K + k])
+            << "Original and unpacked data elements are not the same at idx ["
+            << j << ", " << k << "]: "
+            << "original: " << static_cast<int>(wData[j * K + k])
+            << " , unpacked: " << static_cast<int>(wUnpackedData[j * K + k]);
+      }
+      EXPECT_EQ(sum, nm->row_offsets[j]) << "row offset of row " << j;
+
+      // Every group keeps exactly NNZ values
+      for (int g = 0; g < nm->numGroups(); ++g) {
+        int bits = 0;
+        for (uint8_t m = nm->meta[j * nm->numGroups() + g]; m; m >>= 1) {
+          bits += m & 1;
+        }
+        EXPECT_EQ(bits, nm->NNZ);
+      }
+    }
+  };
+
+  if (nnz <= 1) {
+    check(fbgemmDenseToNMSparse<1, 4>(N, K, wData.data()));
+  }
+  check(fbgemmDenseToNMSparse<2, 4>(N, K, wData.data()));
+}
+
+TEST(nmPackUnpackTest, tooManyNonZeros) {
+  vector<int8_t> wData = {1, 0, 2, 0, 0, 3, 4, 5};
+  EXPECT_THROW(
+      (fbgemmDenseToNMSparse<2, 4>(1, 8, wData.data())), runtime_error);
+  EXPECT_THROW(
+      (fbgemmDenseToNMSparse<1, 4>(1, 8, wData.data())), runtime_error);
+  EXPECT_NO_THROW((fbgemmDenseToNMSparse<2, 4>(1, 7, wData.data())));
+}
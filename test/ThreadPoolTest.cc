@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "./TestUtils.h"
+#include "bench/BenchUtils.h"
+#include "fbgemm/FbgemmThreadPool.h"
+
+using namespace std;
+using namespace fbgemm;
+
+namespace {
+
+ThreadPoolOptions poolOptions(int num_threads) {
+  ThreadPoolOptions options;
+  options.numThreads = num_threads;
+  return options;
+}
+
+} // namespace
+
+TEST(ThreadPoolTest, RunsEveryThreadOnce) {
+  FbgemmThreadPool pool(poolOptions(4));
+  ASSERT_EQ(pool.numThreads(), 4);
+  // Back to back jobs, some with fewer threads than the pool has
+  for (int num_threads : {4, 2, 4, 1, 3, 4}) {
+    vector<atomic<int>> calls(pool.numThreads());
+    atomic<bool> in_pool{true};
+    pool.run(num_threads, [&](int thread_id, int nthreads) {
+      EXPECT_EQ(nthreads, num_threads);
+      calls[thread_id].fetch_add(1);
+      if (!fbgemmInThreadPool()) {
+        in_pool = false;
+      }
+    });
+    for (int i = 0; i < pool.numThreads(); ++i) {
+      EXPECT_EQ(calls[i].load(), i < num_threads ? 1 : 0) << "thread " << i;
+    }
+    EXPECT_TRUE(in_pool);
+  }
+  EXPECT_FALSE(fbgemmInThreadPool());
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  FbgemmThreadPool pool(poolOptions(3));
+  for (int64_t total_work : {0, 1, 2, 1000}) {
+    vector<atomic<int>> visits(total_work);
+    pool.parallelFor(total_work, [&](int64_t start, int64_t end) {
+      EXPECT_LT(start, end);
+      for (int64_t i = start; i < end; ++i) {
+        visits[i].fetch_add(1);
+      }
+    });
+    for (int64_t i = 0; i < total_work; ++i) {
+      EXPECT_EQ(visits[i].load(), 1) << "item " << i;
+    }
+  }
+}
+
+TEST(ThreadPoolTest, NestedRunStaysOnCaller) {
+  FbgemmThreadPool outer(poolOptions(3));
+  FbgemmThreadPool inner(poolOptions(3));
+  atomic<int> inner_calls{0};
+  outer.run([&](int, int) {
+    const auto caller = this_thread::get_id();
+    for (auto* pool : {&outer, &inner}) {
+      pool->run([&](int thread_id, int num_threads) {
+        EXPECT_EQ(thread_id, 0);
+        EXPECT_EQ(num_threads, 1);
+        EXPECT_EQ(this_thread::get_id(), caller);
+        inner_calls.fetch_add(1);
+      });
+    }
+  });
+  EXPECT_EQ(inner_calls.load(), 2 * outer.numThreads());
+}
+
+TEST(ThreadPoolTest, ConcurrentSubmitters) {
+  FbgemmThreadPool pool(poolOptions(4));
+  constexpr int kSubmitters = 4, kJobs = 200;
+  vector<thread> submitters;
+  for (int s = 0; s < kSubmitters; ++s) {
+    submitters.emplace_back([&] {
+      for (int j = 0; j < kJobs; ++j) {
+        // A job runs on the pool or, while the pool is busy, on the caller
+        atomic<int> calls{0};
+        atomic<int> job_threads{0};
+        pool.run([&](int, int num_threads) {
+          calls.fetch_add(1);
+          job_threads = num_threads;
+        });
+        EXPECT_EQ(calls.load(), job_threads.load());
+      }
+    });
+  }
+  for (auto& t : submitters) {
+    t.join();
+  }
+}
+
+TEST(ThreadPoolTest, Exception) {
+  FbgemmThreadPool pool(poolOptions(4));
+  EXPECT_THROW(
+      pool.run([](int thread_id, int) {
+        if (thread_id == 2) {
+          throw runtime_error("failed");
+        }
+      }),
+      runtime_error);
+  // The pool stays usable
+  atomic<int> calls{0};
+  pool.run([&](int, int) { calls.fetch_add(1); });
+  EXPECT_EQ(calls.load(), pool.numThreads());
+}
+
+TEST(ThreadPoolTest, Scratch) {
+  FbgemmThreadPool pool(poolOptions(2));
+  {
+    FbgemmThreadPool::Scratch scratch(pool, 1000);
+    ASSERT_NE(scratch.data(), nullptr);
+    scratch.data()[999] = 1.0f;
+    // Held until scratch goes out of scope
+    FbgemmThreadPool::Scratch other(pool, 10);
+    EXPECT_EQ(other.data(), nullptr);
+  }
+  FbgemmThreadPool::Scratch scratch(pool, 0);
+  EXPECT_NE(scratch.data(), nullptr);
+}
+
+TEST(ThreadPoolTest, FbgemmPacked) {
+  constexpr int n = 130, k = 256;
+  aligned_vector<int8_t> B(k * n);
+  randFill<int8_t>(B, -128, 127);
+  vector<int32_t> col_offsets(n);
+  for (int j = 0; j < n; ++j) {
+    for (int i = 0; i < k; ++i) {
+      col_offsets[j] += B[i * n + j];
+    }
+  }
+  vector<float> C_multiplier = {0.001f};
+  vector<int32_t> B_zero_point = {2};
+  constexpr int32_t A_zero_point = 3, C_zero_point = 5;
+
+  PackBMatrix<int8_t> packedB(matrix_op_t::NoTranspose, k, n, B.data(), n);
+  FbgemmThreadPool pool(poolOptions(4));
+
+  // Skinny GEMMs split n in register blocks and don't split m
+  for (int m : {67, 1, 16}) {
+    aligned_vector<uint8_t> A(m * k);
+    randFill<uint8_t>(A, 0, 255);
+
+    // Single threaded reference
+    aligned_vector<uint8_t> C_ref(m * n);
+    aligned_vector<int32_t> C_buffer(m * n);
+    {
+      PackAWithRowOffset<uint8_t> packA(
+          matrix_op_t::NoTranspose, m, k, A.data(), k);
+      DoNothing<> doNothingObj{};
+      ReQuantizeOutput<false> outputProcObj(
+          doNothingObj,
+          C_multiplier.data(),
+          C_zero_point,
+          A_zero_point,
+          B_zero_point.data(),
+          packA.getRowOffsetBuffer(),
+          col_offsets.data(),
+          nullptr, // bias
+          n);
+      fbgemmPacked(
+          packA,
+          packedB,
+          C_ref.data(),
+          C_buffer.data(),
+          n,
+          outputProcObj,
+          0,
+          1);
+    }
+
+    aligned_vector<uint8_t> C(m * n);
+    DoNothing<> doNothingObj{};
+    ReQuantizeOutput<false> outputProcObj(
+        doNothingObj,
+        C_multiplier.data(),
+        C_zero_point,
+        A_zero_point,
+        B_zero_point.data(),
+        nullptr, // row offsets of each thread's A are filled in by the pool
+        col_offsets.data(),
+        nullptr, // bias
+        n);
+    fbgemmPacked(
+        pool,
+        [&]() {
+          return PackAWithRowOffset<uint8_t>(
+              matrix_op_t::NoTranspose, m, k, A.data(), k);
+        },
+        packedB,
+        C.data(),
+        C_buffer.data(),
+        n,
+        outputProcObj);
+    EXPECT_EQ(C, C_ref) << "m " << m;
+  }
+}
+
+TEST(ThreadPoolTest, FbgemmPackedRowwiseQuant) {
+  constexpr int n = 72, k = 256, groups = 2;
+  aligned_vector<int8_t> B(k * n);
+  randFill<int8_t>(B, -64, 63);
+  vector<int32_t> col_offsets(groups * n);
+  const int k_per_group = k / groups;
+  for (int g = 0; g < groups; ++g) {
+    for (int j = 0; j < n; ++j) {
+      for (int i = 0; i < k_per_group; ++i) {
+        col_offsets[g * n + j] += B[(g * k_per_group + i) * n + j];
+      }
+    }
+  }
+  vector<float> B_scale = {0.01f};
+  vector<int32_t> B_zero_point = {2};
+
+  PackBMatrix<int8_t> packedB(
+      matrix_op_t::NoTranspose, k, n, B.data(), n, nullptr, groups);
+  FbgemmThreadPool pool(poolOptions(4));
+
+  for (int m : {130, 1}) {
+    // Rows with very different ranges so that mixing up the quantization
+    // parameters of the threads shows
+    aligned_vector<float> A(m * k);
+    randFill<float>(A, -1.0f, 1.0f);
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < k; ++j) {
+        A[i * k + j] *= 1 + i % 7;
+      }
+    }
+    auto makePackA = [&]() {
+      return PackAWithRowwiseQuantRowOffset<uint8_t>(
+          matrix_op_t::NoTranspose, m, k, A.data(), k, nullptr, groups);
+    };
+
+    // Single threaded reference
+    aligned_vector<float> C_ref(m * groups * n);
+    {
+      auto packA = makePackA();
+      DoNothing<float, float> doNothingObj{};
+      ReQuantizeForFloat<false> outputProcObj(
+          doNothingObj,
+          packA.getRowScaleBuffer(),
+          packA.getRowZeroPointBuffer(),
+          B_scale.data(),
+          B_zero_point.data(),
+          packA.getRowOffsetBuffer(),
+          col_offsets.data(),
+          nullptr, // bias
+          groups * n,
+          groups);
+      fbgemmPacked(
+          packA,
+          packedB,
+          C_ref.data(),
+          reinterpret_cast<int32_t*>(C_ref.data()),
+          groups * n,
+          outputProcObj,
+          0,
+          1);
+    }
+
+    // The per-row parameters and row offsets of each thread's A are filled
+    // in by the pool
+    aligned_vector<float> C(m * groups * n);
+    DoNothing<float, float> doNothingObj{};
+    ReQuantizeForFloat<false> outputProcObj(
+        doNothingObj,
+        nullptr,
+        nullptr,
+        B_scale.data(),
+        B_zero_point.data(),
+        nullptr,
+        col_offsets.data(),
+        nullptr, // bias
+        groups * n,
+        groups);
+    fbgemmPacked(
+        pool,
+        makePackA,
+        packedB,
+        C.data(),
+        reinterpret_cast<int32_t*>(C.data()),
+        groups * n,
+        outputProcObj);
+    EXPECT_EQ(C, C_ref) << "m " << m;
+  }
+}
+
+TEST(ThreadPoolTest, PackedGemmMatrixFP16) {
+  constexpr int m = 33, n = 200, k = 128;
+  aligned_vector<float> A(m * k);
+  aligned_vector<float> B(k * n);
+  randFill<float>(A, -1, 1);
+  randFill<float>(B, -1, 1);
+  PackedGemmMatrixFP16 packedB(matrix_op_t::NoTranspose, k, n, 1.0f, B.data());
+
+  aligned_vector<float> C_ref(m * n);
+  aligned_vector<float> C(m * n);
+  cblas_gemm_compute(
+      matrix_op_t::NoTranspose, m, A.data(), packedB, 0.0f, C_ref.data());
+  FbgemmThreadPool pool(poolOptions(4));
+  cblas_gemm_compute(
+      pool, matrix_op_t::NoTranspose, m, A.data(), packedB, 0.0f, C.data());
+  EXPECT_EQ(C, C_ref);
+}
+
+TEST(ThreadPoolTest, PackedGemmMatrixFP16KSplit) {
+  // Skinny GEMMs with fewer column blocks than threads, which also split k.
+  // Small integers keep the sums exact whatever order they are added in.
+  constexpr int n = 40, k = 2000;
+  aligned_vector<int> B_int(k * n);
+  randFill(B_int, -4, 4);
+  aligned_vector<float> B(B_int.begin(), B_int.end());
+  PackedGemmMatrixFP16 packedB(matrix_op_t::NoTranspose, k, n, 1.0f, B.data());
+  FbgemmThreadPool pool(poolOptions(8));
+
+  for (int m : {1, 5, 64}) {
+    aligned_vector<int> A_int(m * k);
+    randFill(A_int, 0, 4);
+    aligned_vector<float> A(A_int.begin(), A_int.end());
+    for (float beta : {0.0f, 0.5f}) {
+      aligned_vector<float> C_ref(m * n, 3.0f);
+      aligned_vector<float> C(C_ref);
+      cblas_gemm_compute(
+          matrix_op_t::NoTranspose, m, A.data(), packedB, beta, C_ref.data());
+      cblas_gemm_compute(
+          pool, matrix_op_t::NoTranspose, m, A.data(), packedB, beta, C.data());
+      EXPECT_EQ(C, C_ref) << "m " << m << " beta " << beta;
+    }
+  }
+}
+
+TEST(ThreadPoolTest, FbgemmConv) {
+  // 3x3 convolution that takes the im2col path
+  conv_param_t<2> conv_p(2, 32, 64, {14, 14}, 1, {3, 3}, {1, 1}, {1, 1, 1, 1});
+  const int kernel_dim = conv_p.K[0] * conv_p.K[1];
+  const int out_size = conv_p.MB * conv_p.OUT_DIM[0] * conv_p.OUT_DIM[1];
+  aligned_vector<uint8_t> A(
+      conv_p.MB * conv_p.IN_DIM[0] * conv_p.IN_DIM[1] * conv_p.IC);
+  aligned_vector<int8_t> B(kernel_dim * conv_p.IC * conv_p.OC);
+  randFill<uint8_t>(A, 0, 255);
+  randFill<int8_t>(B, -128, 127);
+  PackWeightsForConv<2> packedB(conv_p, B.data());
+
+  vector<float> C_multiplier = {0.001f};
+  vector<int32_t> B_zero_point = {1};
+  vector<int32_t> col_offsets(conv_p.OC);
+  aligned_vector<uint8_t> C_ref(out_size * conv_p.OC);
+  aligned_vector<uint8_t> C(C_ref.size());
+  aligned_vector<int32_t> C_buffer(C_ref.size());
+  DoNothing<> doNothingObj{};
+  ReQuantizeOutput<false> outputProcObj(
+      doNothingObj,
+      C_multiplier.data(),
+      /*C_zero_point=*/5,
+      /*Aq_zero_point=*/3,
+      B_zero_point.data(),
+      nullptr, // row offsets
+      col_offsets.data(),
+      nullptr, // bias
+      conv_p.OC,
+      conv_p.G);
+
+  fbgemmConv(
+      conv_p,
+      A.data(),
+      packedB,
+      C_ref.data(),
+      C_buffer.data(),
+      outputProcObj,
+      0,
+      1);
+  FbgemmThreadPool pool(poolOptions(4));
+  fbgemmConv(
+      pool,
+      conv_p,
+      A.data(),
+      packedB,
+      C.data(),
+      C_buffer.data(),
+      outputProcObj);
+  EXPECT_EQ(C, C_ref);
+}